@@ -0,0 +1,128 @@
+/**
+ * Arduino.h - Host stand-in for the Arduino core
+ *
+ * Only on the include path of the native-benchmark environment. Provides
+ * the Arduino calls the UI and screen code makes (Serial output, String,
+ * min/max, millis/micros/delay, ESP.getCycleCount, PI) on top of the C++
+ * standard library, so the renderers build for the host unchanged. The
+ * other headers in host/ stand in for the board (M5Unified), NVS
+ * (Preferences), LittleFS and FreeRTOS, and the *_host.cpp files replace the
+ * WiFi, API and network task implementations. Anything else is deliberately
+ * missing: code that needs it is device-only.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using std::min;
+using std::max;
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+/**
+ * Time since the first call, like the device's time since boot
+ */
+inline uint64_t hostElapsedUs() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+inline uint32_t micros() {
+    return (uint32_t)hostElapsedUs();
+}
+
+inline uint32_t millis() {
+    return (uint32_t)(hostElapsedUs() / 1000);
+}
+
+inline void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// ============================================================================
+// String
+// ============================================================================
+
+/**
+ * String - The part of Arduino's String that Preferences hands back
+ */
+class String {
+public:
+    String(const char* text = "") : _text(text != nullptr ? text : "") {}
+
+    const char* c_str() const {
+        return _text.c_str();
+    }
+
+    unsigned int length() const {
+        return (unsigned int)_text.length();
+    }
+
+private:
+    std::string _text;
+};
+
+// ============================================================================
+// Serial / ESP
+// ============================================================================
+
+/**
+ * HostSerial - Serial output to stdout
+ */
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+
+    void print(const char* text) {
+        fputs(text, stdout);
+    }
+
+    void println(const char* text = "") {
+        puts(text);
+    }
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        int length = vprintf(format, args);
+        va_end(args);
+        return length;
+    }
+};
+
+/**
+ * HostEsp - Cycle counter at the ESP32's 240 MHz, derived from micros()
+ */
+class HostEsp {
+public:
+    uint32_t getCycleCount() {
+        return (uint32_t)(hostElapsedUs() * 240);
+    }
+};
+
+inline HostSerial Serial;
+inline HostEsp ESP;
+
+#endif // HOST_ARDUINO_H
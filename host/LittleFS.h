@@ -0,0 +1,92 @@
+/**
+ * LittleFS.h - Host stand-in for the LittleFS filesystem
+ *
+ * Only on the include path of the native-benchmark environment. Paths are
+ * resolved under data/, the directory PlatformIO builds the LittleFS image
+ * from (pio run -t uploadfs), so avatar blobs and logos read on the host
+ * are the files the device would have. Run from the project directory.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "Arduino.h"
+#include <sys/stat.h>
+
+// Directory that stands for the LittleFS root
+constexpr const char* HOST_LITTLEFS_ROOT = "data";
+
+/**
+ * File - stdio file with the fs::File calls the app makes
+ */
+class File {
+public:
+    explicit File(FILE* file = nullptr) : _file(file) {}
+
+    explicit operator bool() const {
+        return _file != nullptr;
+    }
+
+    size_t size() const {
+        if (_file == nullptr) {
+            return 0;
+        }
+        long position = ftell(_file);
+        fseek(_file, 0, SEEK_END);
+        long length = ftell(_file);
+        fseek(_file, position, SEEK_SET);
+        return length > 0 ? (size_t)length : 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t length) {
+        return _file != nullptr ? fread(buffer, 1, length, _file) : 0;
+    }
+
+    void close() {
+        if (_file != nullptr) {
+            fclose(_file);
+            _file = nullptr;
+        }
+    }
+
+private:
+    FILE* _file;
+};
+
+/**
+ * HostLittleFS - Opens files under HOST_LITTLEFS_ROOT
+ */
+class HostLittleFS {
+public:
+    bool begin(bool = false) {
+        return true;
+    }
+
+    File open(const char* path, const char* mode = "r") {
+        char hostPath[256];
+        hostPathFor(path, hostPath, sizeof(hostPath));
+        // Binary mode: blobs are raw RGB565
+        char hostMode[4];
+        snprintf(hostMode, sizeof(hostMode), "%c%s", mode[0], "b");
+        return File(fopen(hostPath, hostMode));
+    }
+
+    bool exists(const char* path) {
+        char hostPath[256];
+        hostPathFor(path, hostPath, sizeof(hostPath));
+        struct stat info;
+        return stat(hostPath, &info) == 0;
+    }
+
+private:
+    static void hostPathFor(const char* path, char* hostPath, size_t size) {
+        snprintf(hostPath, size, "%s%s%s", HOST_LITTLEFS_ROOT, path[0] == '/' ? "" : "/", path);
+    }
+};
+
+inline HostLittleFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,95 @@
+/**
+ * M5Unified.h - Host stand-in for the M5Unified board layer
+ *
+ * Only on the include path of the native-benchmark environment. M5.Display
+ * is an off-screen canvas that is never allocated, so backlight, sleep and
+ * rotation calls are accepted and nothing reaches a panel; UI and screens
+ * render into the DisplayTarget they are given. Power reports a fixed
+ * battery so frames showing it are the same on every run, and the speaker
+ * is silent.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_M5UNIFIED_H
+#define HOST_M5UNIFIED_H
+
+#include <M5GFX.h>
+#include "Arduino.h"
+
+// ============================================================================
+// HOST BOARD CONFIGURATION
+// ============================================================================
+
+// Battery the header and System Info screen show
+constexpr int HOST_BATTERY_LEVEL = 80;          // Percent
+constexpr int HOST_BATTERY_VOLTAGE_MV = 3980;
+
+// ============================================================================
+// Board Components
+// ============================================================================
+
+/**
+ * HostDisplay - Unallocated canvas with the panel calls the app makes
+ */
+class HostDisplay : public M5Canvas {
+public:
+    void setBrightness(uint8_t) {}
+    void sleep() {}
+    void wakeup() {}
+};
+
+/**
+ * HostPower - Fixed battery, never charging; powerOff() is only logged
+ */
+class HostPower {
+public:
+    int32_t getBatteryLevel() {
+        return HOST_BATTERY_LEVEL;
+    }
+
+    int16_t getBatteryVoltage() {
+        return HOST_BATTERY_VOLTAGE_MV;
+    }
+
+    bool isCharging() {
+        return false;
+    }
+
+    void powerOff() {
+        Serial.println("[Host] powerOff() ignored");
+    }
+};
+
+/**
+ * HostSpeaker - Accepts tones and plays nothing
+ */
+class HostSpeaker {
+public:
+    void setVolume(uint8_t) {}
+
+    bool tone(float, uint32_t) {
+        return true;
+    }
+};
+
+/**
+ * HostM5 - The M5 object: display, power and speaker
+ */
+class HostM5 {
+public:
+    HostDisplay Display;
+    HostPower Power;
+    HostSpeaker Speaker;
+
+    void begin() {}
+
+    void delay(uint32_t ms) {
+        ::delay(ms);
+    }
+};
+
+inline HostM5 M5;
+
+#endif // HOST_M5UNIFIED_H
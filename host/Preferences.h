@@ -0,0 +1,95 @@
+/**
+ * Preferences.h - Host stand-in for the ESP32 NVS Preferences library
+ *
+ * Only on the include path of the native-benchmark environment. Keeps one
+ * namespace of keys in memory for the life of the process, so
+ * PersistenceManager runs unchanged and every run starts from empty NVS
+ * (logged out, defaults), like a freshly flashed device.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+#include <map>
+#include <string>
+
+/**
+ * Preferences - In-memory key/value store with the NVS calls the app makes
+ */
+class Preferences {
+public:
+    bool begin(const char*, bool readOnly = false) {
+        _readOnly = readOnly;
+        return true;
+    }
+
+    void end() {}
+
+    bool clear() {
+        _strings.clear();
+        _numbers.clear();
+        return true;
+    }
+
+    bool remove(const char* key) {
+        _strings.erase(key);
+        _numbers.erase(key);
+        return true;
+    }
+
+    bool isKey(const char* key) {
+        return _strings.count(key) > 0 || _numbers.count(key) > 0;
+    }
+
+    size_t freeEntries() {
+        return 256 - _strings.size() - _numbers.size();
+    }
+
+    // Numbers share one map; each getter narrows to its own type
+    size_t putBool(const char* key, bool value)          { return putNumber(key, value, 1); }
+    size_t putChar(const char* key, int8_t value)        { return putNumber(key, value, 1); }
+    size_t putUChar(const char* key, uint8_t value)      { return putNumber(key, value, 1); }
+    size_t putULong(const char* key, uint32_t value)     { return putNumber(key, value, 4); }
+
+    bool getBool(const char* key, bool defaultValue = false)          { return getNumber(key, defaultValue) != 0; }
+    int8_t getChar(const char* key, int8_t defaultValue = 0)          { return (int8_t)getNumber(key, defaultValue); }
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0)       { return (uint8_t)getNumber(key, defaultValue); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0)     { return (uint32_t)getNumber(key, defaultValue); }
+
+    size_t putString(const char* key, const char* value) {
+        if (_readOnly) {
+            return 0;
+        }
+        _strings[key] = value;
+        return strlen(value);
+    }
+
+    String getString(const char* key, const char* defaultValue = "") {
+        auto it = _strings.find(key);
+        return String(it != _strings.end() ? it->second.c_str() : defaultValue);
+    }
+
+private:
+    std::map<std::string, std::string> _strings;
+    std::map<std::string, int64_t> _numbers;
+    bool _readOnly = false;
+
+    size_t putNumber(const char* key, int64_t value, size_t size) {
+        if (_readOnly) {
+            return 0;
+        }
+        _numbers[key] = value;
+        return size;
+    }
+
+    int64_t getNumber(const char* key, int64_t defaultValue) {
+        auto it = _numbers.find(key);
+        return it != _numbers.end() ? it->second : defaultValue;
+    }
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,207 @@
+/**
+ * api_client_host.cpp - Host ApiClient for the native-benchmark build
+ *
+ * Replaces src/api_client.cpp on the host (no TLS stack or sockets): the
+ * key and family ID setters work, and every API call fails the way it
+ * does on the device without WiFi (API_ERROR_NOT_CONNECTED).
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "api_client.h"
+#include <Arduino.h>
+
+// Error text every failed call carries
+static void notConnected(char* errorMessage, size_t size) {
+    ApiClient::formatHttpError(API_ERROR_NOT_CONNECTED, errorMessage, size);
+}
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+ApiClient::ApiClient()
+    : _network(nullptr)
+    , _mockMode(false)
+    , _port(0)
+    , _secureClient(nullptr)
+    , _responseBuffer(nullptr)
+    , _connectionOpen(false)
+    , _connectionIdleMs(0)
+    , _connectionLinkId(0)
+    , _responseStarted(false)
+    , _addressCache(nullptr)
+    , _control(nullptr)
+    , _phase(ApiRequestPhase::IDLE)
+    , _phaseStartMs(0)
+    , _requestStartMs(0)
+    , _requestReused(false)
+    , _lastError(0)
+    , _mockLoginStartMs(0)
+    , _mockLoginDelayMs(0)
+    , _mockMoreTimeGranted(false)
+    , _mockMoreTimeMinutes(0)
+    , _mockMoreTimeStartMs(0)
+{
+    _baseUrl[0] = '\0';
+    _apiKey[0] = '\0';
+    _familyId[0] = '\0';
+    _host[0] = '\0';
+    _basePath[0] = '\0';
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void ApiClient::begin(NetworkManager& network, const char* baseUrl) {
+    _network = &network;
+    strncpy(_baseUrl, baseUrl, sizeof(_baseUrl) - 1);
+    _baseUrl[sizeof(_baseUrl) - 1] = '\0';
+}
+
+void ApiClient::setApiKey(const char* apiKey) {
+    strncpy(_apiKey, apiKey != nullptr ? apiKey : "", sizeof(_apiKey) - 1);
+    _apiKey[sizeof(_apiKey) - 1] = '\0';
+}
+
+const char* ApiClient::getApiKey() const {
+    return _apiKey;
+}
+
+bool ApiClient::hasApiKey() const {
+    return _apiKey[0] != '\0';
+}
+
+void ApiClient::setFamilyId(const char* familyId) {
+    strncpy(_familyId, familyId != nullptr ? familyId : "", sizeof(_familyId) - 1);
+    _familyId[sizeof(_familyId) - 1] = '\0';
+}
+
+const char* ApiClient::getFamilyId() const {
+    return _familyId;
+}
+
+bool ApiClient::hasFamilyId() const {
+    return _familyId[0] != '\0';
+}
+
+// ============================================================================
+// Request Control
+// ============================================================================
+
+void ApiClient::setRequestControl(ApiRequestControl* control) {
+    _control = control;
+    _lastError = 0;
+}
+
+ApiRequestPhase ApiClient::getPhase() const {
+    return _phase.load();
+}
+
+int ApiClient::getLastError() const {
+    return _lastError;
+}
+
+void ApiClient::setAddressCache(ApiAddressCache* cache) {
+    _addressCache = cache;
+}
+
+void ApiClient::closeIdleConnection() {}
+
+void ApiClient::formatHttpError(int httpCode, char* buffer, size_t bufferSize) {
+    if (httpCode == API_ERROR_NOT_CONNECTED) {
+        snprintf(buffer, bufferSize, "No WiFi connection");
+    } else {
+        snprintf(buffer, bufferSize, "HTTP error: %d", httpCode);
+    }
+}
+
+const ApiClientStats& ApiClient::getStats() const {
+    return _stats;
+}
+
+void ApiClient::printStats() const {
+    Serial.println("[ApiClient] Host build - no requests");
+}
+
+// ============================================================================
+// API Calls
+// ============================================================================
+
+DeviceCodeResponse ApiClient::initiateLogin() {
+    DeviceCodeResponse result;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+LoginPollResult ApiClient::pollLoginStatus(const char*) {
+    LoginPollResult result;
+    result.pending = false;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+void ApiClient::logout() {
+    _apiKey[0] = '\0';
+    _familyId[0] = '\0';
+}
+
+FamilyGroupResult ApiClient::getFamilyGroup() {
+    FamilyGroupResult result;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+bool ApiClient::getFamilyMembers(FamilyMember*, int, int& outCount) {
+    outCount = 0;
+    return false;
+}
+
+AllowanceResult ApiClient::getTodayAllowance(const char*) {
+    AllowanceResult result;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+bool ApiClient::recordScreenTimeUsed(const char*, uint32_t) {
+    return false;
+}
+
+ConsumedTimeResult ApiClient::pushConsumedTime(const char*, uint32_t, time_t) {
+    ConsumedTimeResult result;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+MoreTimeRequestResult ApiClient::requestAdditionalTime(const char*, const char*, uint32_t) {
+    MoreTimeRequestResult result;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+MoreTimePollResult ApiClient::pollMoreTimeStatus(const char*) {
+    MoreTimePollResult result;
+    result.pending = false;
+    notConnected(result.errorMessage, sizeof(result.errorMessage));
+    return result;
+}
+
+// ============================================================================
+// Mock Control
+// ============================================================================
+
+void ApiClient::setMockMode(bool enabled) {
+    _mockMode = enabled;
+}
+
+bool ApiClient::isMockMode() const {
+    return _mockMode;
+}
+
+void ApiClient::setMockLoginDelay(uint32_t delayMs) {
+    _mockLoginDelayMs = delayMs;
+}
+
+void ApiClient::setMockMoreTimeResponse(bool granted, uint32_t additionalMinutes) {
+    _mockMoreTimeGranted = granted;
+    _mockMoreTimeMinutes = additionalMinutes;
+}
@@ -0,0 +1,34 @@
+/**
+ * esp_heap_caps.h - Host stand-in for the ESP-IDF capability allocator
+ *
+ * Only on the include path of the native-benchmark environment. The host
+ * has one heap, so every capability (PSRAM, DMA, internal) is malloc().
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) {
+    return malloc(size);
+}
+
+inline void heap_caps_free(void* pointer) {
+    free(pointer);
+}
+
+inline size_t heap_caps_get_free_size(uint32_t) {
+    return SIZE_MAX;
+}
+
+#endif // HOST_ESP_HEAP_CAPS_H
@@ -0,0 +1,32 @@
+/**
+ * FreeRTOS.h - Host stand-in for the FreeRTOS types the headers name
+ *
+ * Only on the include path of the native-benchmark environment. The host
+ * build runs no tasks: network.h and network_task.h only need their handle
+ * types to declare members, and the host NetworkManager and NetworkTask
+ * (the *_host.cpp files) never create the objects behind them.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+
+typedef struct HostEventGroup* EventGroupHandle_t;
+typedef struct HostQueue* QueueHandle_t;
+typedef struct HostTask* TaskHandle_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+
+#endif // HOST_FREERTOS_H
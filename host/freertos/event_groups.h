@@ -0,0 +1,13 @@
+/**
+ * event_groups.h - Host stand-in, see FreeRTOS.h
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_FREERTOS_EVENT_GROUPS_H
+#define HOST_FREERTOS_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+#endif // HOST_FREERTOS_EVENT_GROUPS_H
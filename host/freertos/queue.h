@@ -0,0 +1,13 @@
+/**
+ * queue.h - Host stand-in, see FreeRTOS.h
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+#endif // HOST_FREERTOS_QUEUE_H
@@ -0,0 +1,13 @@
+/**
+ * task.h - Host stand-in, see FreeRTOS.h
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+#endif // HOST_FREERTOS_TASK_H
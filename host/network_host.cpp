@@ -0,0 +1,143 @@
+/**
+ * network_host.cpp - Host NetworkManager for the native-benchmark build
+ *
+ * Replaces src/network.cpp on the host: there is no radio, so the manager
+ * stays DISCONNECTED, every connect fails straight away and the keep-alive
+ * and polling calls only keep their flags. Screens that show the network
+ * state therefore render their offline frames.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "network.h"
+#include <Arduino.h>
+
+// ============================================================================
+// NetworkManager Implementation
+// ============================================================================
+
+NetworkManager::NetworkManager()
+    : _status(NetworkStatus::DISCONNECTED)
+    , _phase(WifiPhase::IDLE)
+    , _events(nullptr)
+    , _ssid(nullptr)
+    , _password(nullptr)
+    , _channel(0)
+    , _connectStartMs(0)
+    , _phaseStartMs(0)
+    , _associateRetries(0)
+    , _lease(nullptr)
+    , _fastPath(false)
+    , _staticIp(false)
+    , _leaseRenewDue(false)
+    , _leaseRenewing(false)
+    , _leaseRenewStartMs(0)
+    , _linkDhcp(false)
+    , _linkGeneration(0)
+    , _disconnectReason(0)
+    , _statusCallback(nullptr)
+    , _statusUserData(nullptr)
+    , _statusChanged(false)
+    , _lastActivityMs(0)
+    , _keepAliveDurationMs(WIFI_KEEPALIVE_MS)
+    , _pollingMode(false)
+{
+    memset(_bssid, 0, sizeof(_bssid));
+    memset(&_connectStats, 0, sizeof(_connectStats));
+    for (int i = 0; i < 4; i++) {
+        _eventMs[i] = 0;
+    }
+}
+
+bool NetworkManager::begin() {
+    Serial.println("[Network] Host build - no WiFi");
+    return true;
+}
+
+void NetworkManager::update() {}
+
+bool NetworkManager::ensureConnected() {
+    return false;
+}
+
+bool NetworkManager::requestConnection(const char*, const char*) {
+    _connectStats.attempts++;
+    _connectStats.failed++;
+    return false;
+}
+
+bool NetworkManager::waitForConnection(uint32_t) {
+    return false;
+}
+
+WifiPhase NetworkManager::getPhase() const {
+    return _phase.load();
+}
+
+void NetworkManager::setLeaseStore(WifiLease* lease) {
+    _lease = lease;
+}
+
+void NetworkManager::setStatusCallback(NetworkStatusCallback callback, void* userData) {
+    _statusCallback = callback;
+    _statusUserData = userData;
+}
+
+void NetworkManager::dispatchEvents() {}
+
+const WifiConnectStats& NetworkManager::getConnectStats() const {
+    return _connectStats;
+}
+
+void NetworkManager::printConnectStats() const {
+    Serial.println("[Network] Host build - no WiFi connects");
+}
+
+void NetworkManager::extendKeepAlive() {
+    _lastActivityMs = millis();
+}
+
+void NetworkManager::beginPollingMode() {
+    _pollingMode = true;
+}
+
+void NetworkManager::endPollingMode() {
+    _pollingMode = false;
+}
+
+bool NetworkManager::isInPollingMode() const {
+    return _pollingMode.load();
+}
+
+bool NetworkManager::connect(const char* ssid, const char* password, uint32_t) {
+    return requestConnection(ssid, password);
+}
+
+void NetworkManager::disconnect() {}
+
+void NetworkManager::forceDisconnect() {}
+
+NetworkStatus NetworkManager::getStatus() const {
+    return _status.load();
+}
+
+bool NetworkManager::isConnected() const {
+    return false;
+}
+
+int NetworkManager::getSignalStrength() const {
+    return 0;
+}
+
+bool NetworkManager::withConnection(NetworkCallback) {
+    return false;
+}
+
+bool NetworkManager::syncTimeAndSetRTC(bool) {
+    return false;
+}
+
+bool NetworkManager::isNtpSyncNeeded() const {
+    return false;
+}
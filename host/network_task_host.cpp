@@ -0,0 +1,112 @@
+/**
+ * network_task_host.cpp - Host NetworkTask for the native-benchmark build
+ *
+ * Replaces src/network_task.cpp on the host, which has no FreeRTOS to run
+ * the worker on. Every submission is rejected (job ID 0, as when all slots
+ * are taken), so screens stay in the state they were drawn in and no
+ * callback ever runs.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "network_task.h"
+#include "network.h"
+#include <cstring>
+
+// ============================================================================
+// Singleton / Constructor
+// ============================================================================
+
+NetworkTask& NetworkTask::getInstance() {
+    static NetworkTask instance;
+    return instance;
+}
+
+NetworkTask::NetworkTask()
+    : _api(nullptr)
+    , _network(nullptr)
+    , _task(nullptr)
+    , _requests(nullptr)
+    , _completions(nullptr)
+    , _nextId(1)
+    , _outstanding(0)
+{
+    memset(_slotUsed, 0, sizeof(_slotUsed));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool NetworkTask::begin(ApiClient& api, NetworkManager& network) {
+    _api = &api;
+    _network = &network;
+    return false;
+}
+
+void NetworkTask::dispatch() {}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+uint32_t NetworkTask::submitInitiateLogin(NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitPollLogin(const char*, NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitFamilyMembers(NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitTodayAllowance(const char*, NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitPushConsumedTime(const char*, uint32_t, time_t, NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitRequestMoreTime(const char*, const char*, NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitPollMoreTime(const char*, NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+uint32_t NetworkTask::submitSyncTime(NetJobCallback, void*) {
+    _stats.rejected++;
+    return 0;
+}
+
+void NetworkTask::cancel(uint32_t) {}
+
+bool NetworkTask::isBusy() const {
+    return false;
+}
+
+bool NetworkTask::waitIdle(uint32_t) {
+    return true;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const NetworkTaskStats& NetworkTask::getStats() const {
+    return _stats;
+}
+
+void NetworkTask::printStats() const {
+    Serial.printf("[NetworkTask] Host build - %lu jobs rejected\n",
+                  (unsigned long)_stats.rejected);
+}
@@ -0,0 +1,136 @@
+/**
+ * activation_ring.h - Incremental activation ring renderer for Screen Time Tracker
+ *
+ * The activation ring is the thin arc outside the status ring that counts
+ * down the minimum session period. It starts at 12 o'clock and runs
+ * clockwise; each second it gives up a slice at its trailing end.
+ *
+ * Instead of erasing the whole annulus and redrawing the arc every tick,
+ * the renderer remembers how many degrees are on screen and only touches
+ * the slice that changed. The ring pixels are bucketed by degree once in
+ * begin() into a span lookup table (horizontal runs per degree), so no
+ * trigonometry runs per frame.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef ACTIVATION_RING_H
+#define ACTIVATION_RING_H
+
+#include <M5GFX.h>
+#include "config.h"
+#include "compositor.h"  // For DirtyRect
+
+// ============================================================================
+// ACTIVATION RING CONFIGURATION
+// ============================================================================
+
+// Span table capacity (a 3px ring at radius ~30 has ~550 pixels, fewer spans)
+constexpr int ACTIVATION_RING_MAX_SPANS = 720;
+
+// ============================================================================
+// Activation Ring Class
+// ============================================================================
+
+/**
+ * ActivationRingStats - Counters for measuring per-tick drawing cost
+ */
+struct ActivationRingStats {
+    uint32_t updates;           // update() calls that touched pixels
+    uint32_t pixelsTouched;     // Total pixels written
+    uint32_t lastPixels;        // Pixels written by the most recent update
+    uint32_t ringPixels;        // Pixels in the full ring (cost of a full redraw)
+    uint16_t spanCount;         // Entries in the span table
+};
+
+/**
+ * ActivationRing - Degree-indexed ring that redraws only changed slices
+ *
+ * Usage:
+ *   ring.begin(innerRadius, outerRadius);
+ *   DirtyRect touched;
+ *   if (ring.update(gfx, cx, cy, degrees, color, COLOR_BACKGROUND, touched)) {
+ *       compositor.markDirty(touched.x, touched.y, touched.w, touched.h);
+ *   }
+ */
+class ActivationRing {
+public:
+    /**
+     * Constructor
+     */
+    ActivationRing();
+
+    /**
+     * Build the per-degree span table for the ring
+     * @param innerRadius Inner ring radius
+     * @param outerRadius Outer ring radius (inclusive)
+     * @return true if the table was built
+     */
+    bool begin(int innerRadius, int outerRadius);
+
+    /**
+     * Forget what is on screen (after the area was cleared or overdrawn)
+     * The next update() repaints every visible degree.
+     */
+    void invalidate();
+
+    /**
+     * Bring the ring on screen to the given arc
+     * @param gfx Draw target (panel or sprite)
+     * @param centerX Ring center X
+     * @param centerY Ring center Y
+     * @param degrees Arc length from 12 o'clock clockwise (0 = hidden, 360 = full)
+     * @param color Arc color
+     * @param background Color of the area behind the ring
+     * @param touched Set to the bounding box of the pixels written
+     * @return true if any pixels were written
+     */
+    bool update(lgfx::LovyanGFX& gfx, int centerX, int centerY,
+                int degrees, uint16_t color, uint16_t background,
+                DirtyRect& touched);
+
+    /**
+     * Count the ring pixels in an arc (what drawing it from scratch costs)
+     * @param degrees Arc length from 12 o'clock clockwise (0-360)
+     * @return Pixels in the arc, 0 before begin()
+     */
+    uint32_t arcPixels(int degrees) const;
+
+    /**
+     * Get drawing statistics
+     * @return Reference to the running counters
+     */
+    const ActivationRingStats& getStats() const;
+
+    /**
+     * Print drawing statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    /**
+     * Span - Horizontal run of ring pixels, relative to the ring center
+     */
+    struct Span {
+        int8_t dx;
+        int8_t dy;
+        uint8_t length;
+    };
+
+    Span _spans[ACTIVATION_RING_MAX_SPANS];
+    uint16_t _degreeStart[361];     // Spans of degree d: [_degreeStart[d], _degreeStart[d + 1])
+    bool _ready;
+
+    int16_t _drawnDegrees;          // Arc currently on screen
+    int32_t _drawnColor;            // -1 = unknown, repaint everything
+
+    ActivationRingStats _stats;
+
+    // Internal methods
+    uint32_t fillDegrees(lgfx::LovyanGFX& gfx, int centerX, int centerY,
+                         int fromDegree, int toDegree, uint16_t color,
+                         int& minX, int& minY, int& maxX, int& maxY);
+};
+
+#endif // ACTIVATION_RING_H
@@ -0,0 +1,154 @@
+/**
+ * animated_sprite.h - Pre-rendered animation frames for Screen Time Tracker
+ *
+ * Spinners and polling indicators used to clear their area and redraw every
+ * dot with fillCircle() on each animation step. AnimatedSprite renders all
+ * frames of such an animation once, stacked in one PSRAM sprite (each frame
+ * includes its background), and records for every frame the bounding box of
+ * the pixels that differ from the frame before it.
+ *
+ * Playing the animation back is then a blit: when the target already shows
+ * an earlier frame, only the union of the changed boxes since that frame is
+ * pushed; otherwise the whole frame is.
+ *
+ * All animations share one timebase (frameAt()), derived from millis() in
+ * ANIMATION_TICK_MS steps, so spinners on different screens and overlays
+ * advance together instead of each keeping its own timer.
+ *
+ * If the sprite cannot be allocated, draw() renders the frame directly.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef ANIMATED_SPRITE_H
+#define ANIMATED_SPRITE_H
+
+#include <M5GFX.h>
+#include "compositor.h"
+
+// ============================================================================
+// ANIMATION CONFIGURATION
+// ============================================================================
+
+// Shared animation timebase step; animations advance every N ticks
+constexpr uint32_t ANIMATION_TICK_MS = 100;
+
+// Maximum frames per animation
+constexpr int ANIMATED_SPRITE_MAX_FRAMES = 16;
+
+// ============================================================================
+// Animated Sprite Class
+// ============================================================================
+
+/**
+ * AnimatedSpriteStats - Counters readable on the device
+ */
+struct AnimatedSpriteStats {
+    uint32_t fullBlits;         // Whole frames pushed
+    uint32_t deltaBlits;        // Changed boxes pushed
+    uint32_t skippedBlits;      // Requested frame already on the target
+    uint32_t pixelsPushed;      // Total pixels pushed
+    uint32_t lastBlitUs;        // Most recent blit time
+};
+
+/**
+ * AnimatedSprite - N pre-rendered frames played back by changed region
+ *
+ * Usage:
+ *   spinner.begin(23, 23, 8, COLOR_BACKGROUND, renderFrame, this);
+ *   uint8_t frame = AnimatedSprite::frameAt(1, 8);
+ *   spinner.draw(gfx, x, y, frame, drawnFrame);  // drawnFrame -1 after a full repaint
+ */
+class AnimatedSprite {
+public:
+    /**
+     * Frame renderer - draws one frame with its top-left corner at (x, y)
+     * The frame area has already been filled with the background.
+     */
+    typedef void (*FrameRenderer)(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData);
+
+    /**
+     * Constructor
+     */
+    AnimatedSprite();
+
+    /**
+     * Render every frame once into a PSRAM sprite
+     * Safe to call every draw: the frames are only rendered again when the
+     * size, frame count or background changed (or after end()).
+     * @param width Frame width
+     * @param height Frame height
+     * @param frameCount Number of frames (at most ANIMATED_SPRITE_MAX_FRAMES)
+     * @param background RGB565 color behind each frame
+     * @param render Draws one frame
+     * @param userData Passed to render
+     * @return true if the frames are cached
+     */
+    bool begin(int width, int height, int frameCount, uint16_t background,
+               FrameRenderer render, void* userData);
+
+    /**
+     * Free the frames (begin() renders them again)
+     */
+    void end();
+
+    /**
+     * Check if the frames are cached
+     * @return true if draw() blits from the sprite
+     */
+    bool isReady() const;
+
+    /**
+     * Draw a frame
+     * @param gfx Draw target (panel or sprite)
+     * @param x Left edge of the frame on the target
+     * @param y Top edge of the frame on the target
+     * @param frame Frame to show
+     * @param drawnFrame Frame the target already shows at (x, y), or -1
+     * @return Region pushed, relative to (x, y) (empty if nothing changed)
+     */
+    DirtyRect draw(lgfx::LovyanGFX& gfx, int x, int y, int frame, int drawnFrame = -1);
+
+    /**
+     * Get the frame to show now on the shared timebase
+     * @param ticksPerFrame ANIMATION_TICK_MS steps per frame
+     * @param frameCount Frames per cycle
+     * @return 0 .. frameCount - 1
+     */
+    static uint8_t frameAt(uint32_t ticksPerFrame, int frameCount);
+
+    /**
+     * Get animation statistics
+     * @return Reference to the running counters
+     */
+    const AnimatedSpriteStats& getStats() const;
+
+    /**
+     * Print animation statistics to Serial
+     * @param name Animation name for the log line
+     */
+    void printStats(const char* name) const;
+
+private:
+    M5Canvas _sprite;
+    bool _ready;
+
+    int16_t _width;
+    int16_t _height;
+    uint8_t _frameCount;
+    uint16_t _background;
+    FrameRenderer _render;
+    void* _userData;
+
+    // Pixels that differ from the previous frame, relative to the frame origin
+    DirtyRect _changed[ANIMATED_SPRITE_MAX_FRAMES];
+
+    AnimatedSpriteStats _stats;
+
+    // Internal methods
+    void measureChanges();
+    void blit(lgfx::LovyanGFX& gfx, int x, int y, int frame, const DirtyRect& r);
+};
+
+#endif // ANIMATED_SPRITE_H
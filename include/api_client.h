@@ -9,6 +9,14 @@
  * - More-time request submission
  * 
  * Uses real HTTP calls to the Screenie API with ArduinoJson for parsing.
+ * Each call runs as a stepped exchange (connect, send, receive, parse) that
+ * checks its deadline and cancel flag between steps, so the NetworkTask can
+ * abort a request instead of waiting out a slow server.
+ * 
+ * The TLS connection is kept alive between calls (login polling alone makes
+ * one every 5 s), for as long as WiFi stays up and at most the WiFi
+ * keep-alive window. The server address is cached in RTC memory, so the
+ * first request after a wake skips the DNS lookup.
  * 
  * @author Screen Time Tracker
  * @version 2.0
@@ -21,7 +29,9 @@
 #include <stddef.h>
 #include <cstring>
 #include <time.h>
+#include <atomic>
 #include "config.h"
+#include "http_message.h"
 
 // Forward declarations
 class NetworkManager;
@@ -49,6 +59,98 @@ constexpr const char* API_ENDPOINT_GRANT_TEMPLATE = "family/%s/child/%s/grant";
 // Grant status endpoint template: grant/{grantId}
 constexpr const char* API_ENDPOINT_GRANT_STATUS_TEMPLATE = "grant/%s";
 
+// ============================================================================
+// API CLIENT CONFIGURATION
+// ============================================================================
+
+// Longest a single request may take when no deadline is set
+constexpr uint32_t HTTP_TIMEOUT_MS = 10000;
+
+// Wait between receive steps while no data has arrived
+constexpr uint32_t HTTP_RECEIVE_POLL_MS = 5;
+
+// Longest a kept-alive connection is reused after its last response (it is
+// also dropped whenever WiFi reconnects, so this matches the WiFi window)
+constexpr uint32_t HTTP_KEEPALIVE_MS = WIFI_KEEPALIVE_MS;
+
+// Longest the cached server address is used without a fresh DNS lookup
+constexpr uint32_t HTTP_ADDRESS_MAX_AGE_SECS = 3600;
+
+// Request latency histogram: bucket 0 is < 64ms, each next one doubles the
+// bound, the last one collects everything from 4s up
+constexpr int API_LATENCY_BUCKETS = 8;
+constexpr int API_LATENCY_FIRST_BUCKET_SHIFT = 6;
+
+// Transport errors (API_ERROR_*) are defined in http_message.h
+
+// ============================================================================
+// Request Control
+// ============================================================================
+
+/**
+ * ApiRequestPhase - Step an HTTP exchange is in
+ */
+enum class ApiRequestPhase : uint8_t {
+    IDLE,       // No request running
+    CONNECT,    // WiFi, then TCP + TLS handshake
+    SEND,       // Writing the request line, headers and body
+    RECEIVE,    // Reading the status line, headers and body
+    PARSE,      // Parsing the JSON body
+    COUNT
+};
+
+/**
+ * ApiRequestControl - Deadline and cancel flag for the calls made under it
+ * Owned by the caller (a NetworkTask job); cancelled may be set from any task.
+ */
+struct ApiRequestControl {
+    uint32_t deadlineMs;            // millis() by which the call must finish (0 = HTTP_TIMEOUT_MS)
+    std::atomic<bool> cancelled;    // Abort at the next step
+
+    ApiRequestControl()
+        : deadlineMs(0)
+        , cancelled(false)
+    {
+    }
+};
+
+/**
+ * ApiAddressCache - Resolved server address, kept across deep sleep
+ * Plain data so it can live in RTC_DATA_ATTR memory (zeroed on power-up).
+ */
+struct ApiAddressCache {
+    bool valid;
+    char host[64];              // Host name the address belongs to
+    uint32_t address;           // IPv4 address as IPAddress stores it
+    time_t resolvedAt;          // System time of the lookup
+};
+
+/**
+ * ApiClientStats - Request counters and per-phase timings
+ */
+struct ApiClientStats {
+    uint32_t requests;                                      // HTTP exchanges started
+    uint32_t failed;                                        // Transport errors (not cancelled/timed out)
+    uint32_t cancelled;
+    uint32_t timedOut;
+    uint32_t lastPhaseMs[(int)ApiRequestPhase::COUNT];      // Of the last request
+    uint32_t maxPhaseMs[(int)ApiRequestPhase::COUNT];
+    uint32_t totalPhaseMs[(int)ApiRequestPhase::COUNT];
+    
+    // Connections
+    uint32_t handshakes;                                    // New TCP + TLS connections
+    uint32_t reused;                                        // Requests on a kept-alive connection
+    uint32_t staleRetries;                                  // Kept-alive connections found closed mid-request
+    uint32_t dnsLookups;
+    uint32_t addressCacheHits;                              // Connects using the cached address
+    
+    // Whole-request latency (connect to end of parse)
+    uint32_t lastRequestMs;
+    uint32_t maxRequestMs;
+    uint32_t reusedBuckets[API_LATENCY_BUCKETS];            // On a kept-alive connection
+    uint32_t handshakeBuckets[API_LATENCY_BUCKETS];         // Opened a new connection
+};
+
 // ============================================================================
 // API Response Structures
 // ============================================================================
@@ -245,7 +347,9 @@ struct MoreTimePollResult {
  * ApiClient - REST API client for server communication
  * 
  * Manages all HTTP communication with the Screenie API.
- * Uses HTTPClient for requests and ArduinoJson for parsing.
+ * Speaks HTTP/1.1 over WiFiClientSecure and uses ArduinoJson for parsing.
+ * Calls block their caller (the NetworkTask) until done, cancelled or past
+ * the deadline of the ApiRequestControl set with setRequestControl().
  * 
  * Usage:
  *   ApiClient api;
@@ -308,6 +412,59 @@ public:
      */
     bool hasFamilyId() const;
     
+    // ========================================================================
+    // Request Control
+    // ========================================================================
+    
+    /**
+     * Bound the following calls by a deadline and cancel flag
+     * @param control Control to check between steps (nullptr = HTTP_TIMEOUT_MS per request)
+     */
+    void setRequestControl(ApiRequestControl* control);
+    
+    /**
+     * Get the step the current request is in
+     * @return Phase (IDLE between requests)
+     */
+    ApiRequestPhase getPhase() const;
+    
+    /**
+     * Get the error of the last failed exchange since setRequestControl()
+     * @return API_ERROR_* value, or 0 if none failed
+     */
+    int getLastError() const;
+    
+    /**
+     * Set where the resolved server address is kept (RTC memory)
+     * @param cache Storage that survives deep sleep (nullptr = look up each connect)
+     */
+    void setAddressCache(ApiAddressCache* cache);
+    
+    /**
+     * Close the kept-alive connection once it is idle too long, the server
+     * closed it or WiFi went down - call while no request is running
+     */
+    void closeIdleConnection();
+    
+    /**
+     * Get a short message for an HTTP status or transport error
+     * @param httpCode Value returned by an HTTP exchange
+     * @param buffer Output buffer
+     * @param bufferSize Size of output buffer
+     */
+    static void formatHttpError(int httpCode, char* buffer, size_t bufferSize);
+    
+    /**
+     * Get request statistics
+     * @return Reference to the running counters
+     */
+    const ApiClientStats& getStats() const;
+    
+    /**
+     * Print request counters, phase timings, handshakes and latency to Serial
+     */
+    void printStats() const;
+    
     // ========================================================================
     // Authentication (Device-code Flow)
     // ========================================================================
@@ -455,11 +612,32 @@ private:
     char _familyId[32];
     bool _mockMode;
     
+    // Base URL split for the socket: host, port and path prefix
+    char _host[64];
+    uint16_t _port;
+    char _basePath[64];
+    
     // Heap-allocated HTTP client to avoid stack overflow
     // WiFiClientSecure is ~16KB on stack due to SSL buffers
     WiFiClientSecure* _secureClient;
     char* _responseBuffer;  // Heap-allocated response buffer
     
+    // Kept-alive connection
+    bool _connectionOpen;
+    uint32_t _connectionIdleMs;             // millis() of the last response on it
+    uint32_t _connectionLinkId;             // Network link generation when it was opened
+    bool _responseStarted;                  // A byte of the current response arrived
+    ApiAddressCache* _addressCache;
+    
+    // Current request
+    ApiRequestControl* _control;            // nullptr = HTTP_TIMEOUT_MS only
+    std::atomic<ApiRequestPhase> _phase;
+    uint32_t _phaseStartMs;
+    uint32_t _requestStartMs;
+    bool _requestReused;
+    int _lastError;                         // Since setRequestControl(), 0 = none
+    ApiClientStats _stats;
+    
     // Mock state
     uint32_t _mockLoginStartMs;
     uint32_t _mockLoginDelayMs;
@@ -494,6 +672,42 @@ private:
      */
     int httpPost(const char* endpoint, const char* body, char* responseBuffer, size_t bufferSize, bool authenticated = true);
     
+    /**
+     * Run one HTTP exchange: connect, send, receive (leaves the PARSE phase open)
+     * @return HTTP status code, or an API_ERROR_* value
+     */
+    int httpRequest(const char* method, const char* endpoint, const char* body,
+                    char* responseBuffer, size_t bufferSize, bool authenticated);
+    
+    // Connection
+    bool isConnectionReusable();
+    int openConnection(uint32_t deadlineMs);
+    void closeConnection();
+    bool resolveServerAddress(uint32_t& address);
+    
+    // Exchange steps
+    bool sendRequest(const char* method, const char* endpoint, const char* body, bool authenticated);
+    int receiveResponse(char* responseBuffer, size_t bufferSize, uint32_t deadlineMs,
+                        bool headRequest, bool& keepAlive);
+    static int waitForData(void* userData);
+    int checkRequest(uint32_t deadlineMs) const;
+    uint32_t requestDeadline() const;
+    
+    // Phase bookkeeping
+    void enterPhase(ApiRequestPhase phase);
+    int finishExchange(int httpCode);
+    
+    /**
+     * RequestScope - Closes the PARSE phase when a public call returns
+     */
+    class RequestScope {
+    public:
+        explicit RequestScope(ApiClient& client) : _client(client) {}
+        ~RequestScope() { _client.enterPhase(ApiRequestPhase::IDLE); }
+    private:
+        ApiClient& _client;
+    };
+    
     // Date formatting helper
     void getTodayDateString(char* buffer, size_t bufferSize);
     
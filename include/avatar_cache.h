@@ -0,0 +1,141 @@
+/**
+ * avatar_cache.h - Avatar blob cache for Screen Time Tracker
+ *
+ * Avatars are converted at build time (scripts/build_avatars.py) into raw
+ * RGB565 blobs in LittleFS (/avatars/[name]_r[radius].rgb), already scaled,
+ * composited over COLOR_AVATAR_PRIMARY and masked to the avatar circle.
+ * The first draw reads the blob into PSRAM; every draw blits it one circle
+ * span per row using the span tables from the generated avatar_manifest.h.
+ * No PNG is decoded at runtime.
+ *
+ * Entries are keyed by avatar name and radius, and the least recently used
+ * entries are evicted once the byte budget is reached. Names missing from the
+ * manifest are rejected without touching the filesystem, and unreadable
+ * blobs are remembered so the fallback path doesn't retry every draw.
+ *
+ * Shared by UI (main screen) and SelectChildScreen.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef AVATAR_CACHE_H
+#define AVATAR_CACHE_H
+
+#include <M5GFX.h>
+#include "config.h"
+
+// ============================================================================
+// AVATAR CACHE CONFIGURATION
+// ============================================================================
+
+// Maximum number of cached avatars (loaded or known-unusable)
+constexpr int AVATAR_CACHE_MAX_ENTRIES = 12;
+
+// Byte budget for loaded blobs (~4KB per 25px-radius avatar)
+constexpr uint32_t AVATAR_CACHE_BUDGET_BYTES = 48 * 1024;
+
+// Maximum avatar name length (matches UserSession/FamilyMember avatarName)
+constexpr int AVATAR_CACHE_NAME_LEN = 32;
+
+// ============================================================================
+// Avatar Cache Class
+// ============================================================================
+
+struct AvatarBlobShape;  // Generated in avatar_manifest.h
+
+/**
+ * AvatarCacheStats - Counters readable on the device
+ */
+struct AvatarCacheStats {
+    uint32_t hits;              // Draws served from the cache
+    uint32_t misses;            // Draws that required a lookup/load
+    uint32_t loads;             // Blobs read from LittleFS successfully
+    uint32_t evictions;         // Entries evicted to stay within budget
+    uint32_t totalLoadUs;       // Sum of blob load times
+    uint32_t lastLoadUs;        // Most recent blob load time
+    uint32_t maxLoadUs;         // Slowest blob load
+    uint32_t blits;             // Avatars blitted from the cache
+    uint32_t lastBlitUs;        // Most recent blit time
+    uint32_t bytesUsed;         // Bytes currently held by loaded entries
+};
+
+/**
+ * AvatarCache - LRU cache of prebuilt, circle-masked avatar blobs
+ *
+ * Usage:
+ *   if (!AvatarCache::getInstance().draw(gfx, avatarName, x, y, AVATAR_RADIUS)) {
+ *       // draw initial-letter fallback
+ *   }
+ */
+class AvatarCache {
+public:
+    /**
+     * Get the singleton instance
+     * @return Reference to the AvatarCache singleton
+     */
+    static AvatarCache& getInstance();
+
+    /**
+     * Draw an avatar centered at (centerX, centerY) inside its circle
+     * Loads and caches the blob on first use.
+     * @param gfx Draw target (panel or sprite)
+     * @param avatarName Avatar filename, with or without .png extension
+     * @param centerX Circle center X
+     * @param centerY Circle center Y
+     * @param radius Circle radius (must be one of the radii blobs were built for)
+     * @return true if the avatar was drawn, false if no blob is available
+     */
+    bool draw(lgfx::LovyanGFX& gfx, const char* avatarName,
+              int centerX, int centerY, int radius);
+
+    /**
+     * Release all cached entries
+     */
+    void clear();
+
+    /**
+     * Get cache statistics
+     * @return Reference to the running counters
+     */
+    const AvatarCacheStats& getStats() const;
+
+    /**
+     * Print cache statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    AvatarCache();
+    AvatarCache(const AvatarCache&) = delete;
+    AvatarCache& operator=(const AvatarCache&) = delete;
+
+    /**
+     * Entry - One cached avatar (pixels == nullptr means the blob is unusable)
+     */
+    struct Entry {
+        bool used;
+        char name[AVATAR_CACHE_NAME_LEN];
+        int16_t radius;
+        uint16_t* pixels;       // Circle spans of RGB565 pixels, row by row
+        uint32_t bytes;
+        uint32_t lastUsed;      // LRU tick
+    };
+
+    Entry _entries[AVATAR_CACHE_MAX_ENTRIES];
+    uint32_t _tick;
+    AvatarCacheStats _stats;
+
+    // Internal methods
+    Entry* find(const char* key, int radius);
+    Entry* allocateEntry(uint32_t bytesNeeded);
+    void releaseEntry(Entry& entry);
+    bool load(Entry& entry, const AvatarBlobShape& shape, const char* blobPath);
+    void blit(lgfx::LovyanGFX& gfx, const AvatarBlobShape& shape,
+              const uint16_t* pixels, int centerX, int centerY);
+    bool streamFromFile(lgfx::LovyanGFX& gfx, const AvatarBlobShape& shape,
+                        const char* blobPath, int centerX, int centerY);
+    static void makeKey(const char* avatarName, char* key, size_t keySize);
+};
+
+#endif // AVATAR_CACHE_H
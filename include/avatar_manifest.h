@@ -0,0 +1,80 @@
+/**
+ * avatar_manifest.h - Generated avatar blob manifest
+ *
+ * GENERATED by scripts/build_avatars.py - do not edit by hand.
+ *
+ * Lists the avatars converted to circle-masked RGB565 blobs and the
+ * per-row circle span tables used to blit them.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef AVATAR_MANIFEST_H
+#define AVATAR_MANIFEST_H
+
+#include <stdint.h>
+
+// Blob files: /avatars/<name>_r<radius>.rgb
+constexpr const char* AVATAR_BLOB_EXTENSION = ".rgb";
+
+// Background the PNGs were composited over (COLOR_AVATAR_PRIMARY)
+constexpr uint16_t AVATAR_BLOB_BACKGROUND = 0xF2D8;
+
+// ============================================================================
+// Circle span tables (half-width per row, dy = -r .. +r)
+// ============================================================================
+
+constexpr uint8_t AVATAR_SPANS_R25[51] = {
+    5, 8, 11, 12, 14, 15, 17, 18, 19, 19, 20, 21, 21, 22, 23, 23,
+    23, 24, 24, 24, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 24,
+    24, 24, 23, 23, 23, 22, 21, 21, 20, 19, 19, 18, 17, 15, 14, 12,
+    11, 8, 5,
+};
+
+/**
+ * AvatarBlobShape - Circle geometry of one blob radius
+ */
+struct AvatarBlobShape {
+    int16_t radius;
+    const uint8_t* spans;       // radius * 2 + 1 entries
+    uint32_t pixelCount;        // Pixels stored in each blob
+};
+
+constexpr int AVATAR_BLOB_SHAPE_COUNT = 1;
+constexpr AvatarBlobShape AVATAR_BLOB_SHAPES[AVATAR_BLOB_SHAPE_COUNT] = {
+    { 25, AVATAR_SPANS_R25, 2053 },
+};
+
+// ============================================================================
+// Available avatars (name without extension)
+// ============================================================================
+
+constexpr int AVATAR_BLOB_NAME_COUNT = 23;
+constexpr const char* AVATAR_BLOB_NAMES[AVATAR_BLOB_NAME_COUNT] = {
+    "1F344_color",
+    "1F348_color",
+    "1F353_color",
+    "1F369_color",
+    "1F3B1_color",
+    "1F414_color",
+    "1F42D_color",
+    "1F431_color",
+    "1F436_color",
+    "1F437_color",
+    "1F438_color",
+    "1F439_color",
+    "1F5FF_color",
+    "1F680_color",
+    "1F94E_color",
+    "1F95E_color",
+    "1F9C1_color",
+    "1F9F8_color",
+    "1FA86_color",
+    "1FAB7_color",
+    "26BD_color",
+    "26F8_color",
+    "E283_color",
+};
+
+#endif // AVATAR_MANIFEST_H
@@ -0,0 +1,207 @@
+/**
+ * compositor.h - Off-screen sprite compositor for Screen Time Tracker
+ *
+ * Provides a full-screen 240x135 RGB565 sprite (allocated in PSRAM) that
+ * screens draw into instead of drawing straight to the panel. Regions that
+ * change are recorded as dirty rectangles, and flush() pushes only those
+ * regions over SPI. This removes the visible flicker of fillRect-then-redraw
+ * and keeps the per-tick SPI traffic proportional to what actually changed.
+ *
+ * If the sprite cannot be allocated, target() falls back to the panel so
+ * callers can draw unconditionally.
+ *
+ * With COMPOSITOR_DMA_FLUSH, flush() copies the dirty regions into two small
+ * DMA-capable staging buffers in turn and pushes them with pushImageDMA():
+ * one buffer transfers while the next is filled, and the last transfer runs
+ * on while the caller goes on to poll buttons and render the next frame.
+ * The sprite itself stays in PSRAM, which SPI DMA cannot read.
+ *
+ * With COMPOSITOR_PALETTE_8BPP the sprite is 8 bits per pixel (RGB332, ~32KB
+ * instead of ~64KB). LovyanGFX converts every draw into it, so callers are
+ * unchanged; flush() expands dirty rows to RGB565 through COMPOSITOR_PALETTE
+ * (palette_data.h, generated from the COLOR_* constants so UI colors come
+ * out exact) into a staging buffer that is then pushed. Images (avatars)
+ * are limited to the 256 RGB332 colors in this mode.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "display_target.h"
+#include "config.h"
+
+// ============================================================================
+// COMPOSITOR CONFIGURATION
+// ============================================================================
+
+// Maximum number of distinct dirty rectangles tracked per frame.
+// Further rectangles are merged into the nearest existing one.
+constexpr int COMPOSITOR_MAX_DIRTY_RECTS = 8;
+
+// Pixels per DMA staging buffer (two are allocated in internal RAM)
+constexpr int COMPOSITOR_DMA_CHUNK_PIXELS = SCREEN_WIDTH * 16;
+
+// Pixels per palette expansion buffer (one, in internal RAM)
+constexpr int COMPOSITOR_STAGE_PIXELS = SCREEN_WIDTH * 16;
+
+// ============================================================================
+// Compositor Class
+// ============================================================================
+
+/**
+ * DirtyRect - Screen region that needs to be pushed to the panel
+ */
+struct DirtyRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+/**
+ * CompositorStats - Counters for measuring flush cost on the device
+ */
+struct CompositorStats {
+    uint32_t flushCount;        // Number of flush() calls that pushed pixels
+    uint32_t rectsPushed;       // Total dirty rectangles pushed
+    uint32_t pixelsPushed;      // Total pixels pushed to the panel
+    uint32_t lastFlushPixels;   // Pixels pushed by the most recent flush
+    uint32_t lastFlushUs;       // Duration of the most recent flush
+    uint32_t dmaFlushes;        // Flushes pushed over DMA
+    uint32_t lastBlockedCycles; // CPU cycles the last DMA flush spent waiting on the bus
+    uint32_t lastReclaimedCycles; // Blocking cycles the last DMA flush avoided
+    uint64_t reclaimedCycles;   // Total blocking cycles avoided by DMA flushes
+    uint64_t flushUs;           // Total time spent in flush()
+    uint32_t lastStageUs;       // Time the last flush spent filling staging buffers
+    uint32_t framebufferBytes;  // Sprite size (16bpp or 8bpp)
+    uint32_t stagingBytes;      // Internal RAM used for staging buffers
+};
+
+/**
+ * Compositor - Off-screen framebuffer with dirty-rectangle flushing
+ *
+ * Usage:
+ *   compositor.begin();
+ *   lgfx::LovyanGFX& gfx = compositor.target();
+ *   gfx.fillRect(x, y, w, h, color);
+ *   compositor.markDirty(x, y, w, h);
+ *   compositor.flush();
+ */
+class Compositor {
+public:
+    /**
+     * Constructor
+     * @param display Reference to the panel the sprite is pushed to
+     */
+    explicit Compositor(DisplayTarget& display);
+
+    /**
+     * Destructor - frees the staging buffers
+     */
+    ~Compositor();
+
+    /**
+     * Allocate the off-screen sprite in PSRAM
+     * Safe to call more than once.
+     * @return true if the sprite is available
+     */
+    bool begin();
+
+    /**
+     * Check if the off-screen sprite is allocated
+     * @return true if drawing goes to the sprite, false if it goes to the panel
+     */
+    bool isReady() const;
+
+    /**
+     * Get the surface to draw on
+     * @return The off-screen sprite, or the panel if the sprite is unavailable
+     */
+    lgfx::LovyanGFX& target();
+
+    /**
+     * Record a region that must be pushed on the next flush()
+     * The rectangle is clipped to the screen; overlapping rectangles merge.
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width
+     * @param h Height
+     */
+    void markDirty(int x, int y, int w, int h);
+
+    /**
+     * Mark the whole screen dirty
+     */
+    void markAllDirty();
+
+    /**
+     * Check if there are pending dirty regions
+     * @return true if flush() would push pixels
+     */
+    bool hasDirtyRegions() const;
+
+    /**
+     * Push all dirty regions from the sprite to the panel and clear the list
+     * Does nothing (other than clearing the list) when drawing directly to the panel.
+     * With COMPOSITOR_DMA_FLUSH the last region may still be transferring on return.
+     */
+    void flush();
+
+    /**
+     * Wait for a DMA flush still in progress and release the bus
+     * Called by flush() itself; other panel writes wait via waitDisplay().
+     */
+    void finishFlush();
+
+    /**
+     * Get flush statistics
+     * @return Reference to the running counters
+     */
+    const CompositorStats& getStats() const;
+
+    /**
+     * Print flush statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    DisplayTarget& _display;
+    M5Canvas _canvas;
+    bool _ready;
+
+    DirtyRect _dirty[COMPOSITOR_MAX_DIRTY_RECTS];
+    int _dirtyCount;
+
+    CompositorStats _stats;
+
+#if COMPOSITOR_DMA_FLUSH
+    lgfx::swap565_t* _dmaBuffers[2];
+    int _dmaBufferIndex;
+    bool _dmaInFlight;
+    uint32_t _syncCyclesPerKpx;   // Blocking push cost per 1024 px, measured on the first flush
+
+    void pushRectDMA(const DirtyRect& r, uint32_t& blockedCycles);
+#endif
+
+#if COMPOSITOR_PALETTE_8BPP
+    uint16_t _paletteLut[256];    // COMPOSITOR_PALETTE in panel byte order, in internal RAM
+    lgfx::swap565_t* _stageBuffer;
+
+    void pushRectStaged(const DirtyRect& r);
+#endif
+
+#if COMPOSITOR_DMA_FLUSH || COMPOSITOR_PALETTE_8BPP
+    // Copy (or expand) rows of a dirty rect into a staging buffer
+    void stageRows(lgfx::swap565_t* dst, const DirtyRect& r, int y, int rows);
+#endif
+
+    // Internal methods
+    static bool overlaps(const DirtyRect& a, const DirtyRect& b);
+    static void merge(DirtyRect& into, const DirtyRect& other);
+    static uint32_t area(const DirtyRect& r);
+};
+
+#endif // COMPOSITOR_H
@@ -26,6 +26,19 @@ constexpr int SCREEN_HEIGHT = 135;
 constexpr int DISPLAY_ROTATION = 1;  // Landscape mode
 constexpr int DISPLAY_BRIGHTNESS = 60;  // 0-255
 
+// Push compositor frames with DMA so the CPU keeps running while pixels
+// transfer (pio run -e m5stickc-plus2-dma). See Compositor::flush().
+#ifndef COMPOSITOR_DMA_FLUSH
+  #define COMPOSITOR_DMA_FLUSH 0
+#endif
+
+// Keep the compositor framebuffer at 8 bits per pixel (RGB332, half the
+// memory) and expand it to RGB565 through the palette generated from the
+// COLOR_* constants below while pushing (pio run -e m5stickc-plus2-palette).
+#ifndef COMPOSITOR_PALETTE_8BPP
+  #define COMPOSITOR_PALETTE_8BPP 0
+#endif
+
 // ============================================================================
 // COLOR PALETTE - Professional dark theme
 // ============================================================================
@@ -197,6 +210,17 @@ constexpr uint32_t NTP_SYNC_TIMEOUT_MS = 8000;       // 8 seconds
 // WiFi Lifecycle Management (R5)
 constexpr uint32_t WIFI_KEEPALIVE_MS = 120000;     // Keep WiFi alive for 120 seconds (2 mins) after last operation (R5.2)
 
+// WiFi connect state machine (scan -> associate -> DHCP)
+constexpr uint32_t WIFI_SCAN_MS_PER_CHANNEL = 120;  // Active scan dwell per channel
+constexpr uint8_t WIFI_ASSOCIATE_RETRIES = 1;       // Extra association attempts before failing
+
+// Fast reconnect after deep sleep: the last AP and DHCP lease are kept in
+// RTC memory and reused (no scan, static IP) while the lease is this young,
+// and never past half the lease time the DHCP server granted
+constexpr uint32_t WIFI_FAST_CONNECT_TIMEOUT_MS = 3000;  // Then fall back to a full connect
+constexpr uint32_t WIFI_LEASE_MAX_AGE_SECS = 12 * 3600;   // Well inside a typical 24h lease
+constexpr uint32_t WIFI_LEASE_RENEW_TIMEOUT_MS = 8000;   // DHCP after a fast connect, else keep the borrowed IP
+
 // NTP Sync Frequency Control (Phase 6.7)
 // Only sync with NTP if this many hours have passed since last sync
 constexpr uint8_t NTP_SYNC_INTERVAL_HOURS = 72;
@@ -228,6 +252,9 @@ constexpr const char* APP_VERSION = "1.0.2";
 // Menu activation flash duration (ms)
 constexpr uint32_t MENU_FLASH_DURATION_MS = 150;
 
+// Menu scroll to the next item (ms)
+constexpr uint32_t MENU_SCROLL_DURATION_MS = 120;
+
 // Screen refresh rate limiting (ms)
 constexpr uint32_t MIN_REFRESH_INTERVAL_MS = 100;
 
@@ -252,4 +279,36 @@ constexpr int BUTTON_A_GPIO_NUM = 37;
 // Power hold GPIO (keep power mosfet on during deep sleep)
 constexpr int POWER_HOLD_GPIO_NUM = 4;
 
+// ============================================================================
+// RENDER PROFILER
+// ============================================================================
+
+// Per-section render timings with an on-device overlay (hold A + B) and a
+// Serial report (see RenderProfiler). 0 compiles every profiling hook away.
+#ifndef RENDER_PROFILER
+  #define RENDER_PROFILER 1
+#endif
+
+// ============================================================================
+// RENDER BENCHMARK
+// ============================================================================
+
+// Render every screen into an in-memory framebuffer at boot and report
+// per-frame cost and golden checksums (pio run -e m5stickc-plus2-benchmark)
+#ifndef RENDER_BENCHMARK
+  #define RENDER_BENCHMARK 0
+#endif
+
+// Main screen timer ticks rendered by the benchmark
+constexpr int RENDER_BENCHMARK_TICKS = 20;
+
+// Golden checksums on LittleFS (missing frames are recorded and fail the
+// run; delete to re-record)
+constexpr const char* RENDER_BENCHMARK_GOLDEN_PATH = "/bench/golden.txt";
+
+// Goldens of the host build (pio run -e native-benchmark -t exec), relative
+// to the directory it runs in (the project directory under PlatformIO)
+constexpr const char* RENDER_BENCHMARK_NATIVE_GOLDEN_DIR = "bench";
+constexpr const char* RENDER_BENCHMARK_NATIVE_GOLDEN_PATH = "bench/golden_native.txt";
+
 #endif // CONFIG_H
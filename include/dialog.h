@@ -16,7 +16,9 @@
 #ifndef DIALOG_H
 #define DIALOG_H
 
-#include <M5GFX.h>
+#include "display_target.h"
+#include "text_layout.h"
+#include "animated_sprite.h"
 #include <stdint.h>
 
 // Maximum lengths for dialog content
@@ -68,9 +70,9 @@ class Dialog {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit Dialog(M5GFX& display);
+    explicit Dialog(DisplayTarget& display);
     
     /**
      * Destructor
@@ -161,10 +163,17 @@ public:
     
     /**
      * Draw the dialog
-     * Should be called after state changes or input
+     * Should be called after state changes or input. When only the spinner
+     * advanced, just the spinner area is redrawn.
      */
     void draw();
     
+    /**
+     * Force the next draw() to repaint the whole dialog
+     * Call when something else has drawn over the screen.
+     */
+    void invalidate();
+    
     /**
      * Check if dialog needs redraw
      * @return true if draw() should be called
@@ -224,7 +233,7 @@ public:
     void invokePendingCallback();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     
     // Dialog content
     char _title[DIALOG_MAX_TITLE_LEN];
@@ -245,11 +254,12 @@ private:
     
     // Progress state
     float _progress;  // 0.0-1.0 or -1 for indeterminate
-    uint8_t _spinnerFrame;  // For indeterminate spinner animation
-    uint32_t _lastSpinnerUpdateMs;
+    uint8_t _spinnerFrame;  // Spinner frame on screen (indeterminate progress)
+    AnimatedSprite _spinner;  // Pre-rendered spinner frames
     
     // Drawing state
     bool _needsRedraw;
+    TextLayout _messageLayout;  // Word-wrapped _message, recomputed only when it changes
     
     // Deferred callback state (for screen redraw before callback execution)
     bool _hasPendingCallback;
@@ -261,7 +271,8 @@ private:
     void drawMessage();
     void drawButtons();
     void drawProgressBar();
-    void drawSpinner();
+    void drawSpinner(bool frameOnly);
+    static void renderSpinnerFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData);
     void drawHint();
     
     // Helper to invoke callback and dismiss
@@ -0,0 +1,26 @@
+/**
+ * display_target.h - Display abstraction for Screen Time Tracker
+ *
+ * Everything that renders (UI, Dialog, ScreenManager, the screens) draws
+ * through a DisplayTarget instead of the M5GFX panel type. DisplayTarget is
+ * the LovyanGFX drawing base shared by the panel (M5.Display) and by every
+ * off-screen canvas (M5Canvas), so the same rendering code can be pointed
+ * at the LCD or at an in-memory RGB565 framebuffer (see FrameCapture).
+ *
+ * Device-only calls (backlight brightness, sleep) stay on M5.Display.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef DISPLAY_TARGET_H
+#define DISPLAY_TARGET_H
+
+#include <M5GFX.h>
+
+/**
+ * DisplayTarget - Drawing surface: the panel or an off-screen canvas
+ */
+using DisplayTarget = lgfx::LovyanGFX;
+
+#endif // DISPLAY_TARGET_H
@@ -0,0 +1,45 @@
+/**
+ * font_subsets.h - Build-time subsetted fonts for Screen Time Tracker
+ *
+ * scripts/build_fonts.py copies the glyphs a font actually renders out of
+ * the M5GFX GFXFF font into the generated font_subsets_data.h, for fonts
+ * whose text is fixed at compile time. The subset keeps the GFXfont format,
+ * so it draws (and looks glyphs up by direct index) exactly like the full
+ * font; the glyphs never drawn are left out of flash.
+ *
+ * Fonts that print runtime text (names, messages) are used in full. Until
+ * the generator has run, the FONT_* pointers below name the full fonts.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef FONT_SUBSETS_H
+#define FONT_SUBSETS_H
+
+#include <M5GFX.h>
+
+#if __has_include("font_subsets_data.h")
+  #define FONT_SUBSETS_GENERATED 1
+#else
+  #define FONT_SUBSETS_GENERATED 0
+#endif
+
+#if FONT_SUBSETS_GENERATED
+namespace font_subsets {
+    extern const lgfx::GFXfont FreeSansBold24pt7b;
+}
+#endif
+
+// ============================================================================
+// FONTS IN USE
+// ============================================================================
+
+// Countdown timer: digits, ':' and "LOTS!" (UI::formatTime)
+#if FONT_SUBSETS_GENERATED
+constexpr const lgfx::IFont* FONT_TIMER = &font_subsets::FreeSansBold24pt7b;
+#else
+constexpr const lgfx::IFont* FONT_TIMER = &fonts::FreeSansBold24pt7b;
+#endif
+
+#endif // FONT_SUBSETS_H
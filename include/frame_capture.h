@@ -0,0 +1,88 @@
+/**
+ * frame_capture.h - In-memory display backend for Screen Time Tracker
+ *
+ * A headless DisplayTarget: a full-screen 240x135 RGB565 canvas (PSRAM on
+ * the device, the heap on the host) that UI, Dialog and the screens can
+ * render into exactly as they would render to the panel. After each frame, endFrame() compares the canvas
+ * with the previous frame (pixels changed) and computes a checksum that can
+ * be compared against a recorded golden value.
+ *
+ * Used by RenderBenchmark; nothing here touches the LCD, so it also builds
+ * for the host (native-benchmark environment).
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include "display_target.h"
+#include "config.h"
+
+// ============================================================================
+// Frame Capture Class
+// ============================================================================
+
+/**
+ * FrameResult - What one captured frame cost and looked like
+ */
+struct FrameResult {
+    uint32_t checksum;          // FNV-1a over the RGB565 framebuffer
+    uint32_t changedPixels;     // Pixels that differ from the previous frame
+};
+
+/**
+ * FrameCapture - Off-screen framebuffer that screens can render into
+ *
+ * Usage:
+ *   capture.begin();
+ *   SyncScreen screen(capture.target());
+ *   screen.draw();
+ *   FrameResult result = capture.endFrame();
+ */
+class FrameCapture {
+public:
+    /**
+     * Constructor
+     */
+    FrameCapture();
+
+    /**
+     * Destructor - releases the canvas and snapshot buffer
+     */
+    ~FrameCapture();
+
+    /**
+     * Allocate the canvas and the previous-frame snapshot
+     * @return true if both buffers are available
+     */
+    bool begin();
+
+    /**
+     * Get the draw target
+     * @return Canvas to pass to UI, Dialog or a screen constructor
+     */
+    DisplayTarget& target();
+
+    /**
+     * Clear the canvas and the snapshot to a color
+     * @param color RGB565 fill color
+     */
+    void clear(uint16_t color);
+
+    /**
+     * Finish a frame: diff against the previous frame and checksum it
+     * @return Checksum and changed-pixel count of the frame
+     */
+    FrameResult endFrame();
+
+private:
+    M5Canvas _canvas;
+    uint16_t* _previous;        // Snapshot of the last finished frame
+
+    // Internal methods
+    const uint16_t* pixels();
+};
+
+#endif // FRAME_CAPTURE_H
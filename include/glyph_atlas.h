@@ -0,0 +1,118 @@
+/**
+ * glyph_atlas.h - Pre-rendered glyph atlas for Screen Time Tracker
+ *
+ * Rasterizes a small set of glyphs (e.g. "0123456789:") once, in several
+ * colors, into a single off-screen sprite. Drawing a glyph afterwards is a
+ * clipped sprite blit of one cell instead of re-rasterizing the font.
+ *
+ * Each cell is the glyph's advance width by a fixed cell height, filled with
+ * the background color, so a blit fully replaces whatever was in the cell.
+ *
+ * Layout: one row per color, glyphs left to right in the order given.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <M5GFX.h>
+#include "config.h"
+
+// ============================================================================
+// GLYPH ATLAS CONFIGURATION
+// ============================================================================
+
+// Maximum glyphs and colors per atlas
+constexpr int GLYPH_ATLAS_MAX_GLYPHS = 16;
+constexpr int GLYPH_ATLAS_MAX_COLORS = 4;
+
+// ============================================================================
+// Glyph Atlas Class
+// ============================================================================
+
+/**
+ * GlyphAtlas - Sprite holding pre-rendered glyph cells
+ *
+ * Usage:
+ *   static const uint16_t colors[] = { COLOR_TEXT_PRIMARY, COLOR_ACCENT_WARNING };
+ *   atlas.begin(&fonts::FreeSansBold24pt7b, "0123456789:", colors, 2,
+ *               COLOR_BACKGROUND, 44);
+ *   int x = 12;
+ *   x += atlas.drawGlyph(gfx, '1', 0, x, 61);
+ */
+class GlyphAtlas {
+public:
+    /**
+     * Constructor
+     */
+    GlyphAtlas();
+
+    /**
+     * Rasterize the glyphs into the atlas sprite (PSRAM)
+     * @param font Font to render with
+     * @param glyphs Characters to include (max GLYPH_ATLAS_MAX_GLYPHS)
+     * @param colors Foreground colors, one atlas row each (max GLYPH_ATLAS_MAX_COLORS)
+     * @param colorCount Number of colors
+     * @param background Cell background color
+     * @param cellHeight Height of each cell in pixels (glyph drawn at the cell top)
+     * @return true if the atlas is ready
+     */
+    bool begin(const lgfx::IFont* font, const char* glyphs,
+               const uint16_t* colors, int colorCount,
+               uint16_t background, int cellHeight);
+
+    /**
+     * Check if the atlas was rendered successfully
+     * @return true if drawGlyph() can be used
+     */
+    bool isReady() const;
+
+    /**
+     * Check if a character is in the atlas
+     * @param c Character to look up
+     * @return true if the glyph was pre-rendered
+     */
+    bool hasGlyph(char c) const;
+
+    /**
+     * Get the cell width (advance) of a glyph
+     * @param c Character to look up
+     * @return Width in pixels, 0 if not in the atlas
+     */
+    int glyphWidth(char c) const;
+
+    /**
+     * Get the cell height
+     * @return Height in pixels
+     */
+    int cellHeight() const;
+
+    /**
+     * Blit one glyph cell to the target
+     * @param gfx Draw target (panel or sprite)
+     * @param c Character to draw
+     * @param colorIndex Index into the colors passed to begin()
+     * @param x Cell left edge on the target
+     * @param y Cell top edge on the target
+     * @return Cell width drawn, 0 if the glyph or color is not in the atlas
+     */
+    int drawGlyph(lgfx::LovyanGFX& gfx, char c, int colorIndex, int x, int y);
+
+private:
+    M5Canvas _sprite;
+    bool _ready;
+
+    char _glyphs[GLYPH_ATLAS_MAX_GLYPHS];
+    int16_t _glyphX[GLYPH_ATLAS_MAX_GLYPHS];      // Cell left edge in the atlas
+    int16_t _glyphWidth[GLYPH_ATLAS_MAX_GLYPHS];  // Cell width (glyph advance)
+    int _glyphCount;
+    int _colorCount;
+    int _cellHeight;
+
+    // Internal methods
+    int indexOf(char c) const;
+};
+
+#endif // GLYPH_ATLAS_H
@@ -0,0 +1,141 @@
+/**
+ * header.h - Cached header strip for Screen Time Tracker
+ *
+ * The 240x24 header (bar, logo, title, Wi-Fi and battery indicators) looks
+ * the same on every screen that shows it, and changes only when the title,
+ * the network status or the battery level does. HeaderLayer composes it once
+ * into a small PSRAM sprite and blits that strip wherever a header is drawn -
+ * the main screen compositor or the panel - without re-running the title
+ * font setup.
+ *
+ * Status changes recompose only the Wi-Fi or battery sub-rectangle of the
+ * layer, and drawIndicators() pushes just those two icons to a target that
+ * already shows the header. The battery level is sampled by the caller
+ * (every BATTERY_UPDATE_INTERVAL_MS) instead of on every draw.
+ *
+ * Shared by UI (main screen) and HeaderWidget (widget screens).
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HEADER_H
+#define HEADER_H
+
+#include <M5GFX.h>
+#include "config.h"
+#include "network.h"
+#include "icon_atlas.h"
+
+// ============================================================================
+// HEADER CONFIGURATION
+// ============================================================================
+
+// Gap between header items and from the screen edges
+constexpr int HEADER_ITEM_GAP = 6;
+
+// Maximum title length kept for change detection (including terminator)
+constexpr int HEADER_TITLE_MAX_LEN = 32;
+
+// ============================================================================
+// Header Layer Class
+// ============================================================================
+
+/**
+ * HeaderLayerStats - Counters readable on the device
+ */
+struct HeaderLayerStats {
+    uint32_t composes;          // Full layer renders (title changed or first use)
+    uint32_t indicatorUpdates;  // Wi-Fi/battery sub-rectangles recomposed
+    uint32_t stripBlits;        // Whole strip pushed to a target
+    uint32_t indicatorBlits;    // Indicator-only pushes to a target
+};
+
+/**
+ * HeaderLayer - Pre-composed header strip
+ *
+ * Usage:
+ *   header.begin();
+ *   header.setBatteryLevel(M5.Power.getBatteryLevel());
+ *   header.setNetworkStatus(status);
+ *   header.draw(gfx, "Settings");       // whole strip
+ *   header.setNetworkStatus(newStatus);
+ *   header.drawIndicators(gfx);         // just the Wi-Fi and battery icons
+ */
+class HeaderLayer {
+public:
+    /**
+     * Constructor
+     */
+    HeaderLayer();
+
+    /**
+     * Allocate the layer sprite in PSRAM
+     * Without it, draw() renders the header directly on the target.
+     * @return true if the layer is available
+     */
+    bool begin();
+
+    /**
+     * Set the network status shown by the Wi-Fi indicator
+     * @param status Current network status
+     * @return true if the indicator changed
+     */
+    bool setNetworkStatus(NetworkStatus status);
+
+    /**
+     * Set the battery level shown by the battery indicator
+     * @param level Battery percentage (0-100)
+     * @return true if the number of lit bars changed
+     */
+    bool setBatteryLevel(int level);
+
+    /**
+     * Draw the whole header strip
+     * @param gfx Draw target (panel or sprite)
+     * @param title Title shown next to the logo
+     */
+    void draw(lgfx::LovyanGFX& gfx, const char* title);
+
+    /**
+     * Draw only the Wi-Fi and battery indicators
+     * For targets that already show the header strip.
+     * @param gfx Draw target (panel or sprite)
+     */
+    void drawIndicators(lgfx::LovyanGFX& gfx);
+
+    /**
+     * Get layer statistics
+     * @return Reference to the running counters
+     */
+    const HeaderLayerStats& getStats() const;
+
+    /**
+     * Print layer statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    M5Canvas _canvas;
+    bool _ready;
+
+    // State the layer was composed with
+    bool _composed;
+    char _title[HEADER_TITLE_MAX_LEN];
+    Icon _composedWifi;
+    Icon _composedBattery;
+
+    // State to show
+    Icon _wifiIcon;
+    Icon _batteryIcon;
+
+    HeaderLayerStats _stats;
+
+    // Internal methods
+    void compose(const char* title);
+    void renderStrip(lgfx::LovyanGFX& gfx, int y, const char* title);
+    void renderIndicators(lgfx::LovyanGFX& gfx, int y);
+    void drawChargingBolt(lgfx::LovyanGFX& gfx, int batteryX, int batteryY);
+};
+
+#endif // HEADER_H
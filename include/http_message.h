@@ -0,0 +1,166 @@
+/**
+ * http_message.h - HTTP/1.1 message framing for Screen Time Tracker
+ *
+ * The request header and response parsing ApiClient speaks over its TLS
+ * connection, kept apart from WiFiClientSecure so the host tests
+ * (test/test_http_message, "pio test -e native") can feed it canned bytes:
+ *
+ * - formatHttpRequestHeader() writes the request line and headers
+ * - HttpResponseReader reads a status line, headers and a Content-Length,
+ *   chunked or read-until-close body from an HttpStream into the caller's
+ *   buffer; a body that does not fit is read to its end and dropped, and
+ *   the read fails with API_ERROR_TOO_LARGE rather than return part of it;
+ *   1xx interim responses are skipped, and 204, 304 and HEAD responses
+ *   never have a body whatever their headers say (RFC 7230 3.3.3)
+ *
+ * Whenever no data is available the reader calls the idle callback, which
+ * waits a little and returns 0, or returns an error (deadline, cancel) to
+ * abort the read.
+ *
+ * Plain C++: no Arduino headers, so it builds for the native test env.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef HTTP_MESSAGE_H
+#define HTTP_MESSAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// HTTP MESSAGE CONFIGURATION
+// ============================================================================
+
+// Transport errors returned in place of an HTTP status (always negative)
+constexpr int API_ERROR_NOT_CONNECTED = -1;   // WiFi unavailable
+constexpr int API_ERROR_CONNECT = -2;         // TCP/TLS connect failed
+constexpr int API_ERROR_SEND = -3;            // Request write failed
+constexpr int API_ERROR_RESPONSE = -4;        // Connection closed or malformed response
+constexpr int API_ERROR_CANCELLED = -5;       // ApiRequestControl::cancelled was set
+constexpr int API_ERROR_TIMED_OUT = -6;       // Deadline passed
+constexpr int API_ERROR_TOO_LARGE = -7;       // Body did not fit the response buffer
+
+// Longest header or chunk-size line kept (longer lines are cut)
+constexpr size_t HTTP_LINE_SIZE = 256;
+
+// ============================================================================
+// Byte Stream
+// ============================================================================
+
+/**
+ * HttpStream - The part of Arduino's Client the reader needs
+ */
+class HttpStream {
+public:
+    virtual ~HttpStream() {}
+
+    /**
+     * Bytes that can be read without waiting
+     */
+    virtual int available() = 0;
+
+    /**
+     * Read one byte
+     * @return Byte value, or -1 if none
+     */
+    virtual int read() = 0;
+
+    /**
+     * Read up to size bytes
+     * @return Bytes read, or -1 on error
+     */
+    virtual int read(uint8_t* buffer, size_t size) = 0;
+
+    /**
+     * Check whether the peer may still send data
+     */
+    virtual bool connected() = 0;
+};
+
+/**
+ * Idle callback - called while waiting for data
+ * @param userData User-provided context pointer
+ * @return 0 to keep waiting, or an API_ERROR_* value to abort the read
+ */
+typedef int (*HttpIdleCallback)(void* userData);
+
+// ============================================================================
+// Request
+// ============================================================================
+
+/**
+ * Write an HTTP/1.1 request line and headers, up to the blank line
+ * @param buffer Output buffer
+ * @param bufferSize Size of output buffer
+ * @param method "GET", "POST", ...
+ * @param host Host header value
+ * @param basePath Path prefix of the API (e.g. "/api/")
+ * @param endpoint Endpoint below it
+ * @param apiKey X-API-Key value (nullptr = none)
+ * @param bodyLength Content-Length (-1 = no body)
+ * @return Header length, or -1 if it does not fit
+ */
+int formatHttpRequestHeader(char* buffer, size_t bufferSize, const char* method,
+                            const char* host, const char* basePath, const char* endpoint,
+                            const char* apiKey, long bodyLength);
+
+// ============================================================================
+// Response
+// ============================================================================
+
+/**
+ * HttpResponseReader - Reads one response from an HttpStream
+ *
+ * Usage:
+ *   HttpResponseReader reader(stream, onIdle, this);
+ *   bool keepAlive;
+ *   int httpCode = reader.read(buffer, sizeof(buffer), keepAlive);
+ */
+class HttpResponseReader {
+public:
+    /**
+     * Constructor
+     * @param stream Connection to read from
+     * @param idle Called whenever no data is available
+     * @param userData Context pointer passed to idle
+     */
+    HttpResponseReader(HttpStream& stream, HttpIdleCallback idle, void* userData = nullptr);
+
+    /**
+     * Read a status line, headers and body
+     * @param buffer Body output (always null-terminated)
+     * @param bufferSize Size of buffer
+     * @param keepAlive Set to whether the connection can carry another request
+     * @param headRequest true if the request was a HEAD (no body follows)
+     * @return HTTP status code, or an API_ERROR_* value
+     */
+    int read(char* buffer, size_t bufferSize, bool& keepAlive, bool headRequest = false);
+
+    /**
+     * Check whether any byte of the response arrived
+     * @return false if the connection closed (or the read was aborted) first
+     */
+    bool responseStarted() const;
+
+private:
+    HttpStream& _stream;
+    HttpIdleCallback _idle;
+    void* _userData;
+    bool _started;
+
+    // Body being read
+    char* _body;
+    size_t _bodySize;
+    size_t _stored;
+    bool _overflowed;               // Sticky: nothing is stored after the first miss
+
+    // Internal methods
+    int readStatusLine(char* line, size_t lineSize, bool& persistent);
+    int readLine(char* line, size_t lineSize);
+    int readBytes(char* out, size_t count);
+    int readBodyBytes(size_t count);
+};
+
+#endif // HTTP_MESSAGE_H
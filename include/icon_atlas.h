@@ -0,0 +1,98 @@
+/**
+ * icon_atlas.h - Run-length encoded icon blitter for Screen Time Tracker
+ *
+ * The header logo, Wi-Fi and battery indicators and the pagination chevrons
+ * are rasterized at build time (scripts/build_icons.py) into the generated
+ * icon_atlas_data.h: an RGB565 palette plus one byte per run of same-colored
+ * pixels, stored in flash.
+ *
+ * draw() opens an address window the size of the icon and streams each run
+ * into it with writeColor(), so the runs go straight into the SPI stream (or
+ * the sprite) without expanding the icon into a pixel buffer first. Icons
+ * include their background, so a blit fully replaces the bounding box.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef ICON_ATLAS_H
+#define ICON_ATLAS_H
+
+#include <M5GFX.h>
+#include "icon_atlas_data.h"
+
+// ============================================================================
+// Icon Atlas Class
+// ============================================================================
+
+/**
+ * IconAtlasStats - Counters readable on the device
+ */
+struct IconAtlasStats {
+    uint32_t blits;             // Icons drawn
+    uint32_t runs;              // Runs streamed
+    uint32_t pixels;            // Pixels written
+    uint32_t clippedBlits;      // Icons partly outside the clip rect (drawn per span)
+    uint32_t lastBlitUs;        // Most recent blit time
+};
+
+/**
+ * IconAtlas - Blits icons from the generated RLE atlas
+ *
+ * Usage:
+ *   IconAtlas::getInstance().draw(gfx, Icon::LOGO, x, y);
+ */
+class IconAtlas {
+public:
+    /**
+     * Get the singleton instance
+     * @return Reference to the IconAtlas singleton
+     */
+    static IconAtlas& getInstance();
+
+    /**
+     * Draw an icon with its top-left corner at (x, y)
+     * @param gfx Draw target (panel or sprite)
+     * @param icon Icon to draw
+     * @param x Left edge
+     * @param y Top edge
+     */
+    void draw(lgfx::LovyanGFX& gfx, Icon icon, int x, int y);
+
+    /**
+     * Get the width of an icon
+     * @param icon Icon to look up
+     * @return Width in pixels
+     */
+    static int width(Icon icon);
+
+    /**
+     * Get the height of an icon
+     * @param icon Icon to look up
+     * @return Height in pixels
+     */
+    static int height(Icon icon);
+
+    /**
+     * Get blit statistics
+     * @return Reference to the running counters
+     */
+    const IconAtlasStats& getStats() const;
+
+    /**
+     * Print blit statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    IconAtlas();
+    IconAtlas(const IconAtlas&) = delete;
+    IconAtlas& operator=(const IconAtlas&) = delete;
+
+    IconAtlasStats _stats;
+
+    // Internal methods
+    void drawClipped(lgfx::LovyanGFX& gfx, const IconAtlasEntry& entry, int x, int y);
+};
+
+#endif // ICON_ATLAS_H
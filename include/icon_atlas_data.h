@@ -0,0 +1,109 @@
+/**
+ * icon_atlas_data.h - Generated icon atlas
+ *
+ * GENERATED by scripts/build_icons.py - do not edit by hand.
+ *
+ * Run-length encoded RGB565 icons: one byte per run, palette index in
+ * the high nibble, run length - 1 in the low nibble, in raster order.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef ICON_ATLAS_DATA_H
+#define ICON_ATLAS_DATA_H
+
+#include <stdint.h>
+
+/**
+ * Icon - Atlas entries
+ */
+enum class Icon : uint8_t {
+    LOGO,
+    WIFI_DISCONNECTED,
+    WIFI_CONNECTING,
+    WIFI_CONNECTED,
+    WIFI_ERROR,
+    BATTERY_0,
+    BATTERY_1,
+    BATTERY_2,
+    BATTERY_3,
+    BATTERY_4,
+    CHEVRON_LEFT,
+    CHEVRON_RIGHT,
+    CHEVRON_LARGE_LEFT,
+    CHEVRON_LARGE_RIGHT,
+    COUNT
+};
+
+/**
+ * IconAtlasEntry - Size and run range of one icon
+ */
+struct IconAtlasEntry {
+    uint8_t width;
+    uint8_t height;
+    uint16_t firstRun;          // Index into ICON_ATLAS_RUNS
+    uint16_t runCount;
+};
+
+constexpr int ICON_ATLAS_PALETTE_SIZE = 10;
+constexpr uint16_t ICON_ATLAS_PALETTE[ICON_ATLAS_PALETTE_SIZE] = {
+    0xC86E, 0xFFFF, 0x4208, 0xB5B6, 0xFD20, 0x07E0, 0xF800, 0x1082,
+    0xD6BA, 0xC84D,
+};
+
+constexpr IconAtlasEntry ICON_ATLAS_ENTRIES[(int)Icon::COUNT] = {
+    { 22, 14, 0, 45 },  // LOGO
+    { 25, 17, 45, 46 },  // WIFI_DISCONNECTED
+    { 25, 17, 91, 51 },  // WIFI_CONNECTING
+    { 25, 17, 142, 64 },  // WIFI_CONNECTED
+    { 25, 17, 206, 52 },  // WIFI_ERROR
+    { 12, 15, 258, 15 },  // BATTERY_0
+    { 12, 15, 273, 15 },  // BATTERY_1
+    { 12, 15, 288, 15 },  // BATTERY_2
+    { 12, 15, 303, 15 },  // BATTERY_3
+    { 12, 15, 318, 15 },  // BATTERY_4
+    { 11, 22, 333, 44 },  // CHEVRON_LEFT
+    { 11, 22, 377, 44 },  // CHEVRON_RIGHT
+    { 14, 25, 421, 50 },  // CHEVRON_LARGE_LEFT
+    { 14, 25, 471, 50 },  // CHEVRON_LARGE_RIGHT
+};
+
+constexpr int ICON_ATLAS_RUN_COUNT = 521;
+constexpr uint8_t ICON_ATLAS_RUNS[ICON_ATLAS_RUN_COUNT] = {
+    0x00, 0x1F, 0x13, 0x00, 0x1F, 0x1F, 0x1F, 0x20, 0x12, 0x20, 0x14, 0x20, 0x12, 0x20, 0x16, 0x20,
+    0x12, 0x20, 0x14, 0x20, 0x12, 0x20, 0x17, 0x22, 0x16, 0x22, 0x18, 0x22, 0x16, 0x22, 0x1F, 0x1F,
+    0x1F, 0x17, 0x26, 0x1E, 0x26, 0x1F, 0x1F, 0x1F, 0x12, 0x00, 0x1F, 0x13, 0x00, 0x3F, 0x3F, 0x3F,
+    0x31, 0x00, 0x3F, 0x36, 0x02, 0x3F, 0x34, 0x04, 0x3F, 0x32, 0x05, 0x35, 0x04, 0x37, 0x06, 0x3F,
+    0x30, 0x08, 0x3E, 0x0A, 0x3C, 0x0B, 0x3C, 0x0C, 0x3A, 0x0E, 0x38, 0x0F, 0x00, 0x36, 0x0F, 0x01,
+    0x36, 0x0F, 0x02, 0x34, 0x0F, 0x04, 0x32, 0x0F, 0x06, 0x30, 0x0B, 0x4F, 0x4F, 0x4F, 0x41, 0x00,
+    0x4F, 0x46, 0x02, 0x4A, 0x00, 0x48, 0x04, 0x48, 0x00, 0x48, 0x05, 0x47, 0x00, 0x49, 0x06, 0x45,
+    0x00, 0x49, 0x08, 0x43, 0x00, 0x49, 0x0A, 0x4C, 0x0B, 0x4C, 0x0C, 0x4A, 0x0E, 0x48, 0x0F, 0x00,
+    0x46, 0x0F, 0x01, 0x46, 0x0F, 0x02, 0x44, 0x0F, 0x04, 0x42, 0x0F, 0x06, 0x40, 0x0B, 0x5F, 0x5F,
+    0x5F, 0x51, 0x00, 0x58, 0x02, 0x5A, 0x02, 0x56, 0x00, 0x52, 0x00, 0x58, 0x04, 0x55, 0x00, 0x52,
+    0x00, 0x57, 0x05, 0x55, 0x00, 0x52, 0x00, 0x57, 0x06, 0x54, 0x00, 0x52, 0x00, 0x56, 0x08, 0x53,
+    0x00, 0x52, 0x00, 0x55, 0x0A, 0x53, 0x02, 0x55, 0x0B, 0x5C, 0x0C, 0x5A, 0x0E, 0x58, 0x0F, 0x00,
+    0x56, 0x0F, 0x01, 0x56, 0x0F, 0x02, 0x54, 0x0F, 0x04, 0x52, 0x0F, 0x06, 0x50, 0x0B, 0x6F, 0x6F,
+    0x6F, 0x61, 0x00, 0x69, 0x00, 0x6B, 0x02, 0x68, 0x00, 0x6A, 0x04, 0x67, 0x00, 0x69, 0x05, 0x67,
+    0x00, 0x69, 0x06, 0x66, 0x00, 0x68, 0x08, 0x6E, 0x0A, 0x64, 0x00, 0x66, 0x0B, 0x6C, 0x0C, 0x6A,
+    0x0E, 0x68, 0x0F, 0x00, 0x66, 0x0F, 0x01, 0x66, 0x0F, 0x02, 0x64, 0x0F, 0x04, 0x62, 0x0F, 0x06,
+    0x60, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F,
+    0x23, 0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x1F, 0x1F, 0x13,
+    0x2F, 0x2F, 0x23, 0x0B, 0x2F, 0x2F, 0x23, 0x0B, 0x1F, 0x1F, 0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x2F,
+    0x2F, 0x23, 0x0B, 0x1F, 0x1F, 0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x1F, 0x1F,
+    0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x0B, 0x1F, 0x1F, 0x13, 0x79, 0x80, 0x78,
+    0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77,
+    0x81, 0x77, 0x81, 0x78, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79,
+    0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x80, 0x80, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81,
+    0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x79, 0x81, 0x78, 0x81,
+    0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81, 0x77, 0x81,
+    0x77, 0x81, 0x78, 0x80, 0x79, 0x7B, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A,
+    0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7C,
+    0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C,
+    0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91,
+    0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91, 0x7C, 0x91,
+    0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91,
+    0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7A, 0x91, 0x7B,
+};
+
+#endif // ICON_ATLAS_DATA_H
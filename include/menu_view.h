@@ -0,0 +1,175 @@
+/**
+ * menu_view.h - Cached rendering of the dropdown menu for Screen Time Tracker
+ *
+ * The menu used to clear its area and print the previous, selected and next
+ * labels with FreeSansBold12pt7b on every selection change, then block for
+ * MENU_FLASH_DURATION_MS while the activated label showed in green.
+ *
+ * MenuView renders every item label once into a 1bpp PSRAM strip, one row of
+ * MENU_ITEM_PITCH per item (gap included, so rows tile without seams). The
+ * visible slots are blits from that strip with the palette set to the slot's
+ * color (gray, white for the selection, green for the flash), so no font is
+ * rasterized while navigating:
+ *
+ * - draw() shows the menu at rest (full area, chevron included)
+ * - scroll() starts a MENU_SCROLL_DURATION_MS ease-out from the last shown
+ *   selection to the current one; update() pushes each frame
+ * - flash() shows the selection in the flash color; update() returns true
+ *   once MENU_FLASH_DURATION_MS has passed, and the caller activates the item
+ *
+ * The strip is rebuilt only when the labels change. If it cannot be
+ * allocated, rows are printed directly (same layout).
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef MENU_VIEW_H
+#define MENU_VIEW_H
+
+#include <M5GFX.h>
+#include "config.h"
+#include "menu.h"
+
+// ============================================================================
+// MENU VIEW CONFIGURATION
+// ============================================================================
+
+// Slot layout of the menu: three slots of (content height / 3), 8px apart
+constexpr int MENU_ITEM_GAP = 8;
+constexpr int MENU_ITEM_AREA_HEIGHT =
+    (MENU_HEIGHT - (2 * MENU_PADDING) - MENU_CHEVRON_AREA_HEIGHT) / MENU_VISIBLE_ITEMS;
+constexpr int MENU_ITEM_PITCH = MENU_ITEM_AREA_HEIGHT + MENU_ITEM_GAP;
+
+// Text top of the selected (middle) slot; the others are one pitch away
+constexpr int MENU_SELECTED_TEXT_Y =
+    MENU_Y + MENU_PADDING - 24 + MENU_ITEM_PITCH + (MENU_ITEM_AREA_HEIGHT + 12) / 2;
+
+// Rows scroll between the header and the chevron area
+constexpr int MENU_ITEMS_BOTTOM = MENU_Y + MENU_HEIGHT - MENU_CHEVRON_AREA_HEIGHT;
+
+// Labels are truncated to this many characters
+constexpr int MENU_LABEL_MAX_CHARS = 18;
+
+// ============================================================================
+// Menu View Class
+// ============================================================================
+
+/**
+ * MenuViewStats - Counters readable on the device
+ */
+struct MenuViewStats {
+    uint32_t stripBuilds;       // Label strip renders (font rasterization)
+    uint32_t fullDraws;         // Menu drawn at rest
+    uint32_t scrollFrames;      // Scroll animation frames pushed
+    uint32_t flashes;           // Activation flashes shown
+    uint32_t lastFrameUs;       // Most recent draw or scroll frame time
+};
+
+/**
+ * MenuView - Draws a DropdownMenu from a pre-rendered label strip
+ *
+ * Usage:
+ *   menuView.draw(gfx, menu);             // menu opened or screen repainted
+ *   menu.selectNext();
+ *   menuView.scroll(gfx, menu);           // animate to the new selection
+ *   menuView.flash(gfx, menu);            // button A
+ *   if (menuView.update(gfx, menu)) {     // every loop
+ *       menu.activateSelected();          // flash finished
+ *   }
+ */
+class MenuView {
+public:
+    /**
+     * Constructor
+     */
+    MenuView();
+
+    /**
+     * Draw the menu at rest (cancels a running scroll or flash)
+     * @param gfx Draw target
+     * @param menu Menu to draw
+     */
+    void draw(lgfx::LovyanGFX& gfx, const DropdownMenu& menu);
+
+    /**
+     * Animate from the selection last shown to the current one
+     * Falls back to draw() if the menu was not on screen or the selection
+     * moved by more than one item.
+     * @param gfx Draw target
+     * @param menu Menu whose selection changed
+     */
+    void scroll(lgfx::LovyanGFX& gfx, const DropdownMenu& menu);
+
+    /**
+     * Show the selected item in the flash color
+     * The caller activates the item when update() reports the flash done.
+     * @param gfx Draw target
+     * @param menu Menu whose selection is being activated
+     */
+    void flash(lgfx::LovyanGFX& gfx, const DropdownMenu& menu);
+
+    /**
+     * Push the next scroll frame and time the flash
+     * Call every loop while the menu is visible.
+     * @param gfx Draw target
+     * @param menu Menu being shown
+     * @return true once, when the flash has finished
+     */
+    bool update(lgfx::LovyanGFX& gfx, const DropdownMenu& menu);
+
+    /**
+     * Check if a flash is showing (input should wait for it)
+     * @return true between flash() and the update() that ends it
+     */
+    bool isFlashing() const;
+
+    /**
+     * Check if a scroll is in progress
+     * @return true while update() still has frames to push
+     */
+    bool isScrolling() const;
+
+    /**
+     * Get menu view statistics
+     * @return Reference to the running counters
+     */
+    const MenuViewStats& getStats() const;
+
+    /**
+     * Print menu view statistics to Serial
+     * @param name Menu name for the log line
+     */
+    void printStats(const char* name) const;
+
+private:
+    M5Canvas _strip;
+    bool _ready;
+    uint32_t _labelsKey;            // Hash of the labels in the strip
+    int _itemCount;
+
+    // Selection on screen (-1 = menu not drawn by us)
+    int _shownIndex;
+
+    // Scroll animation: rows are offset by _scrollFrom px at start, 0 at rest
+    bool _scrolling;
+    int _scrollFrom;
+    int _drawnOffset;
+    uint32_t _scrollStartMs;
+
+    bool _flashing;
+    uint32_t _flashStartMs;
+
+    MenuViewStats _stats;
+
+    // Internal methods
+    static uint32_t labelsKey(const DropdownMenu& menu);
+    static void truncateLabel(const DropdownMenu& menu, int index, char* label);
+    void prepare(const DropdownMenu& menu);
+    void pushFrame(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int offset, uint16_t selectedColor);
+    void drawRows(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int offset, uint16_t selectedColor);
+    void drawRow(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int index, int y, uint16_t color);
+    void drawChevron(lgfx::LovyanGFX& gfx);
+};
+
+#endif // MENU_VIEW_H
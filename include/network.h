@@ -13,6 +13,20 @@
  * - Polling mode to keep WiFi active during login/more-time (R5.5)
  * - NTP sync frequency control (only sync if interval exceeded)
  * 
+ * Connecting is an event-driven state machine (scan -> associate -> DHCP):
+ * WiFi events only record what happened, and the state machine advances
+ * on the network task, which sleeps on an event group instead of polling
+ * WiFi.status(). Each phase is timed, and status changes reach the UI
+ * through a callback run from dispatchEvents() on the UI thread.
+ * 
+ * After a full connect the AP (BSSID, channel) and the DHCP lease are
+ * written to a WifiLease kept in RTC memory by main.cpp. The next connect,
+ * typically after deep sleep, goes straight to that AP with the lease as
+ * a static IP (no scan, no DHCP) and falls back to a full connect if that
+ * fails. Once the network task is idle after a fast connect, the interface
+ * goes back to DHCP to renew the lease, which is then saved again. Connect
+ * times are kept in separate histograms for the two paths.
+ * 
  * @author Screen Time Tracker
  * @version 2.0
  */
@@ -22,7 +36,11 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <time.h>
 #include <functional>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
 #include "config.h"
 
 /**
@@ -35,6 +53,72 @@ enum class NetworkStatus {
     ERROR
 };
 
+/**
+ * WifiPhase - Where the connection state machine is
+ */
+enum class WifiPhase : uint8_t {
+    IDLE,           // Not connected, not connecting
+    SCAN,           // Scanning for the SSID (picks channel and BSSID)
+    ASSOCIATE,      // Authenticating / associating with the AP
+    DHCP,           // Associated, waiting for an IP address
+    CONNECTED,      // Got an IP
+    FAILED          // Last attempt failed (next request starts over)
+};
+
+// Connect-time histogram buckets: bucket 0 is < 128ms, each next one
+// doubles the bound, the last one collects everything from 8s up
+constexpr int WIFI_CONNECT_BUCKETS = 8;
+constexpr int WIFI_CONNECT_FIRST_BUCKET_SHIFT = 7;
+
+/**
+ * WifiLease - Last good AP and DHCP lease, kept across deep sleep
+ * Plain data so it can live in RTC_DATA_ATTR memory (zeroed on power-up).
+ */
+struct WifiLease {
+    bool valid;
+    char ssid[33];              // Network the lease belongs to
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;                // IPv4 addresses as IPAddress stores them
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns1;
+    uint32_t dns2;
+    time_t obtainedAt;          // System time when DHCP handed it out
+    uint32_t leaseSecs;         // Lease time the server granted (0 = unknown)
+};
+
+/**
+ * WifiConnectStats - Connect attempts and per-phase timings
+ */
+struct WifiConnectStats {
+    uint32_t attempts;
+    uint32_t connected;
+    uint32_t failed;            // Timed out or association failed
+    uint32_t dropped;           // Lost while connected
+    uint32_t lastPhaseMs[3];    // Scan, associate, DHCP of the last connect
+    uint32_t maxPhaseMs[3];
+    uint32_t totalPhaseMs[3];
+    uint32_t lastConnectMs;     // Request to IP
+    uint32_t maxConnectMs;
+    
+    // Fast reconnect (cached AP + static lease) versus full connect
+    uint32_t fastAttempts;
+    uint32_t fastConnected;
+    uint32_t fastFallbacks;     // Fast attempts that fell back to a full connect
+    uint32_t leaseRenewals;     // DHCP renewals after a fast connect
+    uint32_t leaseRenewFailures;
+    uint32_t fastBuckets[WIFI_CONNECT_BUCKETS];     // Request to IP
+    uint32_t fullBuckets[WIFI_CONNECT_BUCKETS];     // Request to IP (includes a failed fast try)
+};
+
+/**
+ * Status callback - runs on the UI thread from dispatchEvents()
+ * @param status New connection status
+ * @param userData User-provided context pointer
+ */
+typedef void (*NetworkStatusCallback)(NetworkStatus status, void* userData);
+
 /**
  * SyncStatus - Synchronization status
  */
@@ -85,11 +169,76 @@ public:
 
     /**
      * Ensure WiFi is connected, auto-connecting if needed (R5.1)
-     * Resets the keep-alive timer on each call (R5.3).
+     * Resets the keep-alive timer on each call (R5.3). Blocks the calling
+     * task (the network task) until connected or WIFI_CONNECT_TIMEOUT_MS.
      * @return true if connected (or now connected)
      */
     bool ensureConnected();
 
+    // ========================================================================
+    // Connection state machine
+    // ========================================================================
+    
+    /**
+     * Start connecting without waiting (no-op if connected or connecting)
+     * Call from the network task; the phases advance in waitForConnection()
+     * and update().
+     * @param ssid Network SSID
+     * @param password Network password
+     * @return true if connected or connecting, false if WiFi is not configured
+     */
+    bool requestConnection(const char* ssid = WIFI_SSID, const char* password = WIFI_PASSWORD);
+
+    /**
+     * Wait for a requested connection, sleeping on WiFi events
+     * Gives up (and stops the attempt) after timeoutMs.
+     * @param timeoutMs Longest wait
+     * @return true if connected
+     */
+    bool waitForConnection(uint32_t timeoutMs = WIFI_CONNECT_TIMEOUT_MS);
+
+    /**
+     * Get the connection phase
+     * @return Current WifiPhase
+     */
+    WifiPhase getPhase() const;
+
+    /**
+     * Set where the last good AP and lease are kept (RTC memory)
+     * @param lease Storage that survives deep sleep (nullptr = always full connect)
+     */
+    void setLeaseStore(WifiLease* lease);
+
+    /**
+     * Set the callback told about status changes (connecting, ready, lost)
+     * @param callback Function to call from dispatchEvents() (nullptr = none)
+     * @param userData Context pointer passed to the callback
+     */
+    void setStatusCallback(NetworkStatusCallback callback, void* userData = nullptr);
+
+    /**
+     * Deliver a pending status change to the callback - call from the UI thread
+     */
+    void dispatchEvents();
+
+    /**
+     * Get connect statistics
+     * @return Reference to the running counters
+     */
+    const WifiConnectStats& getConnectStats() const;
+
+    /**
+     * Get the link generation - changes whenever sockets opened before may
+     * be dead: every new connection, and a lease renewal that moved the IP
+     * @return Generation counter (compare for equality only)
+     */
+    uint32_t getLinkGeneration() const { return _linkGeneration; }
+
+    /**
+     * Print connect counters, phase timings and fast/full histograms to Serial
+     */
+    void printConnectStats() const;
+
     /**
      * Extend keep-alive timer without new connection
      * Use when performing operations that should keep WiFi alive.
@@ -124,6 +273,7 @@ public:
     /**
      * Connect to WiFi network (manual control)
      * Prefer using ensureConnected() for automatic management.
+     * Same as requestConnection() followed by waitForConnection().
      * @param ssid Network SSID
      * @param password Network password
      * @param timeoutMs Connection timeout in milliseconds
@@ -203,14 +353,45 @@ public:
     bool isNtpSyncNeeded() const;
 
 private:
-    NetworkStatus _status;
+    std::atomic<NetworkStatus> _status;
+    
+    // Connection state machine (advanced on the network task only)
+    std::atomic<WifiPhase> _phase;
+    EventGroupHandle_t _events;         // Set by the WiFi event handler
+    const char* _ssid;
+    const char* _password;
+    uint8_t _channel;                   // From the scan (0 = let the driver pick)
+    uint8_t _bssid[6];
+    uint32_t _connectStartMs;
+    uint32_t _phaseStartMs;
+    uint8_t _associateRetries;
+    WifiConnectStats _connectStats;
+    
+    // Fast reconnect
+    WifiLease* _lease;
+    bool _fastPath;                     // This attempt uses the cached lease
+    bool _staticIp;                     // The STA interface has a static config
+    bool _leaseRenewDue;                // Fast connect done; renew when idle
+    bool _leaseRenewing;                // DHCP running on a connected link
+    uint32_t _leaseRenewStartMs;
+    bool _linkDhcp;                     // We started lwIP DHCP on the link
+    std::atomic<uint32_t> _linkGeneration;  // Read by ApiClient on its task
     
-    // Keep-alive state (R5.2-R5.4)
-    uint32_t _lastActivityMs;          // Last network activity timestamp
+    // Written by the WiFi event handler before it sets the event's bit
+    volatile uint32_t _eventMs[4];
+    volatile uint8_t _disconnectReason;
+    
+    // Status change notification (UI thread)
+    NetworkStatusCallback _statusCallback;
+    void* _statusUserData;
+    std::atomic<bool> _statusChanged;
+    
+    // Keep-alive state (R5.2-R5.4); activity is recorded on both threads
+    std::atomic<uint32_t> _lastActivityMs;  // Last network activity timestamp
     uint32_t _keepAliveDurationMs;     // How long to keep WiFi after last op
     
-    // Polling mode (R5.5)
-    bool _pollingMode;                 // If true, skip auto-disconnect
+    // Polling mode (R5.5); set on the UI thread, read on the network task
+    std::atomic<bool> _pollingMode;    // If true, skip auto-disconnect
     
     // WiFi configuration status
     bool _wifiNotConfigured = false;   // True if credentials not set up
@@ -223,8 +404,21 @@ public:
     bool isWifiNotConfigured() const { return _wifiNotConfigured; }
 
 private:
-    // Internal helper
+    // Internal helpers
     void resetKeepAliveTimer();
+    void setStatus(NetworkStatus status);
+    void handleWifiEvent(int event, uint8_t reason);
+    void advance();
+    void startScan();
+    void startAssociation();
+    bool isLeaseUsable(const char* ssid) const;
+    void startFastConnect();
+    void fallBackToFullConnect(const char* why);
+    void saveLease();
+    void startLeaseRenewal();
+    void checkLeaseRenewal();
+    void enterPhase(WifiPhase phase, uint32_t atMs);
+    void failConnection(const char* why);
 };
 
 /**
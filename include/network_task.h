@@ -0,0 +1,303 @@
+/**
+ * network_task.h - Background network worker for Screen Time Tracker
+ *
+ * Every ApiClient call used to run inside loop(): with a 10 s HTTP timeout on
+ * top of a WiFi connect, fetching the allowance on MainScreen::onEnter, asking
+ * for more time, pushing a finished session or polling for a login froze the
+ * screen and dropped button presses for as long as the server took.
+ *
+ * NetworkTask runs all network work (ApiClient calls, WiFi keep-alive and
+ * NTP sync) on a FreeRTOS task pinned to core 0, next to the WiFi stack:
+ *
+ * - the UI thread fills a NetJob slot and posts its index to the request
+ *   queue (submit*() returns at once with a job ID, 0 if nothing was free)
+ * - the task runs the job to completion and posts the index to the
+ *   completion queue; while idle it runs the WiFi keep-alive and closes an
+ *   idle API connection
+ * - dispatch(), called from loop(), hands each finished job to its callback
+ *   on the UI thread and frees the slot
+ *
+ * Each job has a deadline counted from submission. The task hands it to
+ * ApiClient with the job's cancel flag, so an HTTP exchange stops at its
+ * next step once either one trips; a job still queued by then is not run
+ * at all. Job IDs are the request handles: cancel(id) drops the callback
+ * and aborts the job wherever it is.
+ *
+ * Jobs run one at a time, in submission order. ApiClient and NetworkManager
+ * are only touched from the task once it has started, apart from the API key
+ * and family ID setters, which are only called while the job that needs them
+ * is not in flight.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "api_client.h"
+
+// Forward declarations
+class NetworkManager;
+
+// ============================================================================
+// NETWORK TASK CONFIGURATION
+// ============================================================================
+
+// Core 0 runs the WiFi stack; the Arduino loop runs on core 1
+constexpr BaseType_t NET_TASK_CORE = 0;
+
+// Same stack as the Arduino loop task that used to make these calls
+// (ARDUINO_LOOP_STACK_SIZE in platformio.ini); the TLS handshake runs on it
+constexpr uint32_t NET_TASK_STACK_SIZE = 16384;
+constexpr UBaseType_t NET_TASK_PRIORITY = 1;
+
+// Jobs queued or in flight at once (each slot holds the largest result)
+constexpr int NET_TASK_MAX_JOBS = 4;
+
+// Keep-alive check interval while the task has nothing to do
+constexpr uint32_t NET_TASK_IDLE_MS = 250;
+
+// Longest wait for queued jobs (e.g. a session push) before deep sleep
+constexpr uint32_t NET_TASK_SLEEP_DRAIN_MS = 15000;
+
+// Job deadlines from submission: queue wait, a WiFi connect and the HTTP
+// exchange. A poll is worthless once the next one is due.
+constexpr uint32_t NET_JOB_TIMEOUT_MS = 30000;
+constexpr uint32_t NET_POLL_TIMEOUT_MS = 15000;
+
+// ============================================================================
+// Network Job
+// ============================================================================
+
+/**
+ * NetJobType - Network operations the task can run
+ */
+enum class NetJobType : uint8_t {
+    INITIATE_LOGIN,         // ApiClient::initiateLogin()
+    POLL_LOGIN,             // ApiClient::pollLoginStatus(arg)
+    FAMILY_MEMBERS,         // ApiClient::getFamilyMembers() (children only)
+    TODAY_ALLOWANCE,        // ApiClient::getTodayAllowance(arg)
+    PUSH_CONSUMED_TIME,     // ApiClient::pushConsumedTime(arg, minutes, startTime)
+    REQUEST_MORE_TIME,      // ApiClient::requestAdditionalTime(arg, childName)
+    POLL_MORE_TIME,         // ApiClient::pollMoreTimeStatus(arg)
+    SYNC_TIME,              // NetworkManager::syncTimeAndSetRTC()
+    COUNT
+};
+
+/**
+ * NetJobStatus - How a job ended
+ */
+enum class NetJobStatus : uint8_t {
+    COMPLETED,      // Ran; the result says whether the call succeeded
+    CANCELLED,      // cancel() before or while it ran (callback not called)
+    TIMED_OUT       // Deadline passed before or while it ran (result failed)
+};
+
+struct NetJob;
+
+/**
+ * Completion callback - runs on the UI thread from dispatch()
+ * @param job The finished job; read the result member for its type
+ * @param userData User-provided context pointer
+ */
+typedef void (*NetJobCallback)(const NetJob& job, void* userData);
+
+/**
+ * NetJob - One network operation, its arguments and its result
+ */
+struct NetJob {
+    NetJobType type;
+    uint32_t id;
+    NetJobCallback callback;            // nullptr = fire and forget (or cancelled)
+    void* userData;
+
+    // Handle state: deadline and cancel flag (ApiClient checks both)
+    ApiRequestControl control;
+    NetJobStatus status;
+
+    // Arguments
+    char arg[32];                       // Pairing code, child ID or grant ID
+    char childName[32];                 // REQUEST_MORE_TIME
+    uint32_t minutes;                   // PUSH_CONSUMED_TIME
+    time_t startTime;                   // PUSH_CONSUMED_TIME
+
+    // Timing (millis)
+    uint32_t queuedMs;
+    uint32_t startedMs;
+    uint32_t finishedMs;
+
+    // Result, by type (constructed by the task when the job runs)
+    union {
+        DeviceCodeResponse deviceCode;  // INITIATE_LOGIN
+        LoginPollResult loginPoll;      // POLL_LOGIN
+        FamilyGroupResult family;       // FAMILY_MEMBERS
+        AllowanceResult allowance;      // TODAY_ALLOWANCE
+        ConsumedTimeResult consumed;    // PUSH_CONSUMED_TIME
+        MoreTimeRequestResult moreTime; // REQUEST_MORE_TIME
+        MoreTimePollResult moreTimePoll;// POLL_MORE_TIME
+        bool timeSynced;                // SYNC_TIME
+    };
+
+    NetJob() {
+        reset();
+    }
+
+    // Clear for reuse (the cancel flag makes jobs non-copyable)
+    void reset() {
+        type = NetJobType::COUNT;
+        id = 0;
+        callback = nullptr;
+        userData = nullptr;
+        control.deadlineMs = 0;
+        control.cancelled.store(false);
+        status = NetJobStatus::COMPLETED;
+        arg[0] = '\0';
+        childName[0] = '\0';
+        minutes = 0;
+        startTime = 0;
+        queuedMs = 0;
+        startedMs = 0;
+        finishedMs = 0;
+    }
+};
+
+// ============================================================================
+// Network Task Class
+// ============================================================================
+
+/**
+ * NetworkTaskStats - Counters readable on the device
+ */
+struct NetworkTaskStats {
+    uint32_t submitted;         // Jobs queued
+    uint32_t rejected;          // Submissions with no free slot
+    uint32_t completed;         // Jobs handed back through dispatch()
+    uint32_t cancelled;         // Jobs cancelled before they finished
+    uint32_t timedOut;          // Jobs past their deadline
+    uint32_t lastWaitMs;        // Queue time of the last job
+    uint32_t maxWaitMs;
+    uint32_t lastRunMs;         // Run time of the last job
+    uint32_t maxRunMs;
+};
+
+/**
+ * NetworkTask - Runs network jobs on core 0 and returns results to loop()
+ *
+ * Usage:
+ *   NetworkTask::getInstance().begin(apiClient, networkManager);
+ *
+ *   NetworkTask::getInstance().submitTodayAllowance(childId, onAllowance, this);
+ *   ...
+ *   static void onAllowance(const NetJob& job, void* userData) {
+ *       if (job.allowance.success) { ... }
+ *   }
+ *
+ *   // In loop()
+ *   NetworkTask::getInstance().dispatch();
+ */
+class NetworkTask {
+public:
+    /**
+     * Get the singleton instance
+     * @return Reference to the NetworkTask singleton
+     */
+    static NetworkTask& getInstance();
+
+    /**
+     * Create the queues and start the task
+     * @param api ApiClient the jobs call
+     * @param network NetworkManager the task keeps alive
+     * @return true if the task is running
+     */
+    bool begin(ApiClient& api, NetworkManager& network);
+
+    /**
+     * Hand finished jobs to their callbacks - call every loop iteration
+     * Also runs the WiFi keep-alive if the task could not be started.
+     */
+    void dispatch();
+
+    // ========================================================================
+    // Submission (UI thread) - each returns the job ID, or 0 if not queued
+    // ========================================================================
+
+    uint32_t submitInitiateLogin(NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitPollLogin(const char* pairingCode, NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitFamilyMembers(NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitTodayAllowance(const char* childId, NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitPushConsumedTime(const char* childId, uint32_t minutes, time_t startTime,
+                                    NetJobCallback callback = nullptr, void* userData = nullptr);
+    uint32_t submitRequestMoreTime(const char* childId, const char* childName,
+                                   NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitPollMoreTime(const char* grantId, NetJobCallback callback, void* userData = nullptr);
+    uint32_t submitSyncTime(NetJobCallback callback, void* userData = nullptr);
+
+    /**
+     * Cancel a job - its callback is dropped; a queued job is skipped and a
+     * running one aborts at its next step
+     * @param jobId ID returned by a submit call (0 and finished jobs are ignored)
+     */
+    void cancel(uint32_t jobId);
+
+    /**
+     * Check if any job is queued, running or waiting for dispatch()
+     * @return true if a slot is in use
+     */
+    bool isBusy() const;
+
+    /**
+     * Wait for the task to finish every queued job (e.g. before deep sleep)
+     * Callbacks are not run; dispatch() delivers them as usual.
+     * @param timeoutMs Longest wait
+     * @return true if the task went idle in time
+     */
+    bool waitIdle(uint32_t timeoutMs);
+
+    /**
+     * Get network task statistics
+     * @return Reference to the running counters
+     */
+    const NetworkTaskStats& getStats() const;
+
+    /**
+     * Print network task statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    NetworkTask();
+    NetworkTask(const NetworkTask&) = delete;
+    NetworkTask& operator=(const NetworkTask&) = delete;
+
+    ApiClient* _api;
+    NetworkManager* _network;
+    TaskHandle_t _task;
+    QueueHandle_t _requests;            // Slot indices, UI -> task
+    QueueHandle_t _completions;         // Slot indices, task -> UI
+
+    NetJob _jobs[NET_TASK_MAX_JOBS];
+    bool _slotUsed[NET_TASK_MAX_JOBS];  // Owned by the UI thread
+    uint32_t _nextId;
+
+    // Jobs submitted and not yet finished by the task
+    std::atomic<int> _outstanding;
+
+    NetworkTaskStats _stats;
+
+    // Internal methods
+    NetJob* acquire(NetJobType type, NetJobCallback callback, void* userData);
+    uint32_t enqueue(NetJob* job);
+    void run(NetJob& job);
+    void fail(NetJob& job, const char* message);
+    static void taskMain(void* param);
+    static const char* typeName(NetJobType type);
+};
+
+#endif // NETWORK_TASK_H
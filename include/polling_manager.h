@@ -6,7 +6,8 @@
  * - More-time request approval
  * 
  * Handles polling intervals, timeouts, and callbacks.
- * Call update() every loop iteration for non-blocking polling.
+ * Call update() every loop iteration for non-blocking polling; the polls
+ * themselves run on the NetworkTask, one at a time.
  * 
  * @author Screen Time Tracker
  * @version 1.0
@@ -22,6 +23,9 @@
 // Forward declarations
 class ApiClient;
 class NetworkManager;
+struct NetJob;
+struct LoginPollResult;
+struct MoreTimePollResult;
 
 // ============================================================================
 // Polling Types and Callbacks
@@ -236,6 +240,7 @@ private:
     // Timing
     uint32_t _startTimeMs;             // When polling started
     uint32_t _lastPollMs;              // Last poll timestamp
+    uint32_t _jobId;                   // NetworkTask job of the poll in flight (0 = none)
     
     // Configuration (milliseconds)
     uint32_t _loginPollIntervalMs;
@@ -246,6 +251,10 @@ private:
     // Internal methods
     void pollLogin();
     void pollMoreTime();
+    static void onLoginPolled(const NetJob& job, void* userData);
+    static void onMoreTimePolled(const NetJob& job, void* userData);
+    void handleLoginPoll(const LoginPollResult& apiResult);
+    void handleMoreTimePoll(const MoreTimePollResult& apiResult);
     void completePolling(const PollingResult& result);
     uint32_t getCurrentInterval() const;
     uint32_t getCurrentTimeout() const;
@@ -0,0 +1,114 @@
+/**
+ * render_benchmark.h - Golden-frame render benchmark for Screen Time Tracker
+ *
+ * Built into the m5stickc-plus2-benchmark environment (RENDER_BENCHMARK),
+ * where it runs at boot, and into the native-benchmark environment, where
+ * it runs on the host. It renders, into a FrameCapture instead of the LCD:
+ * - a Dialog overlay
+ * - a full compositor frame and RENDER_BENCHMARK_TICKS small dirty-region
+ *   flushes, drawn straight through the Compositor
+ * - one avatar drawn the old way (PNG read and decoded per draw) and from
+ *   the AvatarCache blob (span blit), with the per-draw time of each
+ * - the activation ring over a full MINIMUM_SESSION_DURATION_SECONDS
+ *   countdown, drawn the old way (360-degree fillArc clear plus the arc)
+ *   and by ActivationRing::update, with pixels and time per tick of each
+ * - every ScreenType, each from a fresh screen instance (draw() only, so
+ *   no onEnter() network or sync side effects)
+ * - UI::drawMainScreen and RENDER_BENCHMARK_TICKS main-screen timer ticks
+ *   via UI::updateDynamicElements
+ * On the host the power, network and NVS dependencies of the screens come
+ * from the stand-ins in host/ (fixed battery, no WiFi, empty NVS).
+ *
+ * For each frame it prints render time, pixels changed, bytes pushed, the
+ * pixels and primitives counted by the RenderProfiler hooks, and the frame
+ * checksum, and checks the checksum against the golden file (LittleFS on
+ * the device, the project directory on the host). Frames missing from the
+ * golden file are recorded and fail the run, so a fresh checkout with no
+ * goldens never passes by recording everything; rerun to compare. The
+ * RenderProfiler is reset at the start, and its per-section report for the
+ * run is printed at the end.
+ *
+ * The UI clock is pinned (UI::setFixedTime) so dates are the same on every
+ * run; frames showing battery or Wi-Fi state only match goldens recorded
+ * under the same conditions.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef RENDER_BENCHMARK_H
+#define RENDER_BENCHMARK_H
+
+#include "frame_capture.h"
+#include "config.h"
+
+// ============================================================================
+// RENDER BENCHMARK CONFIGURATION
+// ============================================================================
+
+// Maximum frames compared against the golden file per run
+constexpr int RENDER_BENCHMARK_MAX_FRAMES = 64;
+
+// Maximum frame name length ("compositor_tick_19")
+constexpr int RENDER_BENCHMARK_NAME_LEN = 24;
+
+// ============================================================================
+// Render Benchmark Class
+// ============================================================================
+
+/**
+ * RenderBenchmark - Renders every screen headlessly and checks golden frames
+ *
+ * Usage:
+ *   #if RENDER_BENCHMARK
+ *   RenderBenchmark benchmark;
+ *   benchmark.run();
+ *   #endif
+ */
+class RenderBenchmark {
+public:
+    /**
+     * Constructor
+     */
+    RenderBenchmark();
+
+    /**
+     * Render all frames, print the report and update the golden file
+     * @return true if every frame had a golden and matched it
+     */
+    bool run();
+
+private:
+    /**
+     * Golden - Expected checksum of one named frame
+     */
+    struct Golden {
+        char name[RENDER_BENCHMARK_NAME_LEN];
+        uint32_t checksum;
+    };
+
+    FrameCapture _capture;
+    Golden _goldens[RENDER_BENCHMARK_MAX_FRAMES];
+    int _goldenCount;
+    bool _goldensChanged;
+
+    uint32_t _frames;
+    uint32_t _mismatches;
+    uint32_t _missing;                  // Frames with no golden (recorded this run)
+    uint32_t _frameStartUs;
+    uint32_t _frameStartPixels;         // RenderProfiler totals at beginFrame()
+    uint32_t _frameStartPrimitives;
+
+    // Internal methods
+    void renderComponents(DisplayTarget& target);
+    void renderAvatars(DisplayTarget& target);
+    void renderActivationRing(DisplayTarget& target);
+    void renderScreens(DisplayTarget& target);
+    void beginFrame();
+    void endFrame(const char* name, uint32_t bytesPushed);
+    void loadGoldens();
+    void saveGoldens();
+    Golden* findGolden(const char* name);
+};
+
+#endif // RENDER_BENCHMARK_H
@@ -0,0 +1,265 @@
+/**
+ * render_profiler.h - Scoped render-time profiler for Screen Time Tracker
+ *
+ * RENDER_PROFILE_SCOPE(section) at the top of a render function records,
+ * when the scope closes, the call's duration into that section's fixed-size
+ * log2 histogram, along with the pixels and drawing primitives counted while
+ * it was open. Scopes nest (a frame contains a screen's drawFrame(), which
+ * contains UI::updateDynamicElements(), which contains the compositor flush),
+ * and each one is charged inclusively.
+ *
+ * Pixels and primitives are reported where the work happens through
+ * RENDER_PROFILE_PIXELS() / RENDER_PROFILE_PRIMITIVES(): compositor flushes,
+ * sprite, icon, avatar and header blits, ring slices and menu rows count
+ * pixels; widget repaints count as primitives only, so blits they contain
+ * are not counted twice.
+ *
+ * Holding buttons A and B together toggles an overlay with the last and
+ * worst frame time and the sections that took the most time in total; the
+ * same data, with histograms, is printed to Serial on toggle and with the
+ * other render stats every 5 minutes.
+ *
+ * Built in by default (a scope costs two micros() calls); build with
+ * -DRENDER_PROFILER=0 to compile every hook away.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef RENDER_PROFILER_H
+#define RENDER_PROFILER_H
+
+#include <M5GFX.h>
+#include "config.h"
+
+// ============================================================================
+// RENDER PROFILER CONFIGURATION
+// ============================================================================
+
+// Histogram buckets: bucket 0 is < 128us, each next one doubles the bound,
+// the last one collects everything from 128ms up
+constexpr int RENDER_PROFILE_BUCKETS = 12;
+constexpr int RENDER_PROFILE_FIRST_BUCKET_SHIFT = 7;
+
+// Deepest scope nesting tracked
+constexpr int RENDER_PROFILE_MAX_DEPTH = 8;
+
+// Sections listed on the overlay
+constexpr int RENDER_PROFILE_OVERLAY_TOP = 3;
+
+// Hold A + B this long to toggle the overlay (past the click threshold, so
+// neither button also clicks)
+constexpr uint32_t RENDER_PROFILE_CHORD_MS = 600;
+
+// Overlay refresh while shown (ms)
+constexpr uint32_t RENDER_PROFILE_OVERLAY_REFRESH_MS = 500;
+
+// Overlay box, top-left corner of the panel
+constexpr int RENDER_PROFILE_OVERLAY_X = 0;
+constexpr int RENDER_PROFILE_OVERLAY_Y = 0;
+constexpr int RENDER_PROFILE_OVERLAY_W = 150;
+constexpr int RENDER_PROFILE_OVERLAY_H = 44;
+
+// ============================================================================
+// Render Profiler Class
+// ============================================================================
+
+/**
+ * RenderSection - Profiled render functions
+ * The SCREEN_* entries follow ScreenType order (ScreenManager checks this).
+ */
+enum class RenderSection : uint8_t {
+    FRAME,              // ScreenManager::renderFrame() - one scheduled frame
+    DIALOG,             // Dialog::draw()
+    MAIN_FULL,          // UI::drawMainScreen()
+    MAIN_DYNAMIC,       // UI::updateDynamicElements()
+    MAIN_RESTORE,       // UI::restoreMainScreen()
+    COMPOSITOR_FLUSH,   // Compositor::flush()
+    MENU,               // MenuView draw / scroll / flash frames
+    SCREEN_MAIN,        // Screen::drawFrame() per ScreenType
+    SCREEN_LOGIN,
+    SCREEN_SELECT_CHILD,
+    SCREEN_SYNC_PROGRESS,
+    SCREEN_SYSTEM_INFO,
+    SCREEN_SETTINGS,
+    SCREEN_BRIGHTNESS,
+    SCREEN_PARENT,
+    COUNT
+};
+
+/**
+ * RenderSectionStats - Per-section counters and duration histogram
+ */
+struct RenderSectionStats {
+    uint32_t calls;
+    uint32_t totalUs;
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint32_t pixels;            // Pixels pushed or painted inside the section
+    uint32_t primitives;        // Blits / widget paints inside the section
+    uint32_t buckets[RENDER_PROFILE_BUCKETS];
+};
+
+/**
+ * RenderProfiler - Collects render timings and shows them on the device
+ *
+ * Usage:
+ *   void UI::drawMainScreen(...) {
+ *       RENDER_PROFILE_SCOPE(RenderSection::MAIN_FULL);
+ *       ...
+ *       RENDER_PROFILE_PIXELS(w * h);
+ *   }
+ */
+class RenderProfiler {
+public:
+    /**
+     * Get the singleton instance
+     * @return Reference to the RenderProfiler singleton
+     */
+    static RenderProfiler& getInstance();
+
+    /**
+     * Open a section (use RENDER_PROFILE_SCOPE instead)
+     * @param section Section being entered
+     */
+    void begin(RenderSection section);
+
+    /**
+     * Close the innermost open section and record it
+     */
+    void end();
+
+    /**
+     * Count pixels pushed or painted by the open sections
+     * @param pixels Pixel count
+     */
+    void countPixels(uint32_t pixels);
+
+    /**
+     * Count drawing primitives issued by the open sections
+     * @param primitives Primitive count
+     */
+    void countPrimitives(uint32_t primitives);
+
+    /**
+     * Get the pixels counted since boot (reset() leaves it running)
+     * @return Running pixel total; the difference across a frame is its cost
+     */
+    uint32_t totalPixels() const;
+
+    /**
+     * Get the primitives counted since boot
+     * @return Running primitive total
+     */
+    uint32_t totalPrimitives() const;
+
+    /**
+     * Show or hide the overlay
+     * @param visible Whether drawOverlay() draws
+     */
+    void setOverlayVisible(bool visible);
+
+    /**
+     * Check if the overlay is shown
+     * @return true if visible
+     */
+    bool isOverlayVisible() const;
+
+    /**
+     * Draw the overlay on top of the frame just rendered (no-op when hidden)
+     * @param gfx Draw target (the panel)
+     */
+    void drawOverlay(lgfx::LovyanGFX& gfx);
+
+    /**
+     * Get the counters of one section
+     * @param section Section to read
+     * @return Reference to the running counters
+     */
+    const RenderSectionStats& getStats(RenderSection section) const;
+
+    /**
+     * Get a section's display name
+     * @param section Section to name
+     * @return Short name, e.g. "main_dynamic"
+     */
+    static const char* sectionName(RenderSection section);
+
+    /**
+     * Estimate a percentile from a section's histogram
+     * @param section Section to read
+     * @param percent Percentile (e.g. 95)
+     * @return Upper bound of the bucket holding it, in us (0 if no calls)
+     */
+    uint32_t percentileUs(RenderSection section, int percent) const;
+
+    /**
+     * Print every section with calls, times, counts and histogram to Serial
+     */
+    void printReport() const;
+
+    /**
+     * Clear all counters
+     */
+    void reset();
+
+private:
+    RenderProfiler();
+    RenderProfiler(const RenderProfiler&) = delete;
+    RenderProfiler& operator=(const RenderProfiler&) = delete;
+
+    /**
+     * OpenScope - A section entered and not yet closed
+     */
+    struct OpenScope {
+        RenderSection section;
+        uint32_t startUs;
+        uint32_t startPixels;
+        uint32_t startPrimitives;
+    };
+
+    RenderSectionStats _stats[(int)RenderSection::COUNT];
+    OpenScope _open[RENDER_PROFILE_MAX_DEPTH];
+    int _depth;
+
+    // Running totals; each scope charges the difference since it opened
+    uint32_t _pixels;
+    uint32_t _primitives;
+
+    bool _overlayVisible;
+
+    // Internal methods
+    static int bucketFor(uint32_t us);
+    static uint32_t bucketLimitUs(int bucket);
+};
+
+/**
+ * RenderProfileScope - Records its section from construction to destruction
+ */
+class RenderProfileScope {
+public:
+    explicit RenderProfileScope(RenderSection section) {
+        RenderProfiler::getInstance().begin(section);
+    }
+    ~RenderProfileScope() {
+        RenderProfiler::getInstance().end();
+    }
+    RenderProfileScope(const RenderProfileScope&) = delete;
+    RenderProfileScope& operator=(const RenderProfileScope&) = delete;
+};
+
+// ============================================================================
+// Instrumentation Hooks
+// ============================================================================
+
+#if RENDER_PROFILER
+  #define RENDER_PROFILE_SCOPE(section) RenderProfileScope _renderProfileScope(section)
+  #define RENDER_PROFILE_PIXELS(pixels) RenderProfiler::getInstance().countPixels(pixels)
+  #define RENDER_PROFILE_PRIMITIVES(count) RenderProfiler::getInstance().countPrimitives(count)
+#else
+  #define RENDER_PROFILE_SCOPE(section) ((void)0)
+  #define RENDER_PROFILE_PIXELS(pixels) ((void)0)
+  #define RENDER_PROFILE_PRIMITIVES(count) ((void)0)
+#endif
+
+#endif // RENDER_PROFILER_H
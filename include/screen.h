@@ -8,6 +8,11 @@
  * the menu in onEnter() and destroys it in onExit(). The screen handles
  * all menu-related button routing internally.
  * 
+ * Screens do not have to draw immediately when their state changes. They
+ * call requestRedraw() (whole screen) or requestRedraw(region), and the
+ * ScreenManager frame scheduler renders the screen once per frame deadline
+ * via drawFrame(), however many requests were made in between.
+ * 
  * @author Screen Time Tracker
  * @version 1.0
  */
@@ -16,9 +21,11 @@
 #define SCREEN_H
 
 #include <M5GFX.h>
+#include "compositor.h"  // For DirtyRect
 
-// Forward declaration
+// Forward declarations
 class DropdownMenu;
+class ScreenManager;
 
 /**
  * Screen - Abstract base class for all screens
@@ -56,6 +63,13 @@ public:
      */
     virtual void onResume() {}
     
+    /**
+     * Called when a dialog drawn over this screen is dismissed
+     * Screens that keep their last frame off-screen can restore it instead
+     * of redrawing. Default implementation calls onResume().
+     */
+    virtual void onOverlayClosed() { onResume(); }
+    
     // ========================================================================
     // Per-Frame Methods
     // ========================================================================
@@ -72,6 +86,15 @@ public:
      */
     virtual void draw() = 0;
     
+    /**
+     * Called by the ScreenManager frame scheduler to render one frame
+     * Default implementation calls draw().
+     * @param full true if the whole screen was requested
+     * @param region Union of the regions requested since the last frame
+     *               (the whole screen if full)
+     */
+    virtual void drawFrame(bool full, const DirtyRect& region) { draw(); }
+    
     // ========================================================================
     // Input Handling
     // ========================================================================
@@ -141,6 +164,38 @@ public:
      * @return true if menu is visible
      */
     virtual bool isMenuVisible() const { return false; }
+    
+    // ========================================================================
+    // Frame Scheduling
+    // ========================================================================
+    
+    /**
+     * Attach the frame scheduler that renders this screen
+     * Called by ScreenManager::registerScreen().
+     * @param scheduler Screen manager, or nullptr to draw immediately
+     */
+    void attachScheduler(ScreenManager* scheduler) { _scheduler = scheduler; }
+
+protected:
+    /**
+     * Request a redraw of the whole screen on the next frame
+     * Draws immediately if no scheduler is attached. Ignored while
+     * another screen is active (it is redrawn on enter/resume anyway).
+     */
+    void requestRedraw();
+    
+    /**
+     * Request a redraw of a region on the next frame
+     * Requests within one frame are merged into a single drawFrame() call.
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width
+     * @param h Height
+     */
+    void requestRedraw(int x, int y, int w, int h);
+
+private:
+    ScreenManager* _scheduler = nullptr;
 };
 
 #endif // SCREEN_H
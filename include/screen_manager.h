@@ -4,6 +4,11 @@
  * Orchestrates which screen is active, manages screen transitions,
  * handles overlays (dialogs, menus), and routes button inputs.
  * 
+ * Also acts as the frame scheduler: screens and overlays request redraws
+ * (whole screen or a region) instead of drawing immediately, and draw()
+ * renders at most one frame per FRAME_INTERVAL_MS with all requests made
+ * since the previous frame merged together.
+ * 
  * @author Screen Time Tracker
  * @version 1.0
  */
@@ -11,13 +16,36 @@
 #ifndef SCREEN_MANAGER_H
 #define SCREEN_MANAGER_H
 
-#include <M5GFX.h>
+#include "display_target.h"
 #include "screen.h"
 #include "dialog.h"
 
 // Maximum number of screens in the navigation history stack
 constexpr int MAX_HISTORY_DEPTH = 8;
 
+// ============================================================================
+// FRAME SCHEDULER CONFIGURATION
+// ============================================================================
+
+// Minimum time between frames; also the budget for rendering one frame
+constexpr uint32_t FRAME_INTERVAL_MS = 33;
+
+// update() interval for screens that don't need frequent updates
+constexpr uint32_t SCREEN_IDLE_UPDATE_MS = 250;
+
+/**
+ * FrameStats - Counters for measuring frame cost on the device
+ */
+struct FrameStats {
+    uint32_t frames;            // Frames rendered
+    uint32_t requests;          // Redraw requests received
+    uint32_t coalesced;         // Requests merged into an already pending frame
+    uint32_t missedDeadlines;   // Frames finished more than FRAME_INTERVAL_MS after becoming due
+    uint32_t lastFrameUs;       // Render time of the most recent frame
+    uint32_t maxFrameUs;        // Longest render time seen
+    uint64_t totalFrameUs;      // Sum of render times (for the average)
+};
+
 /**
  * ScreenType - Enumeration of all available screens
  */
@@ -48,9 +76,9 @@ class ScreenManager {
 public:
     /**
      * Constructor
-     * @param display Reference to the M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit ScreenManager(M5GFX& display);
+    explicit ScreenManager(DisplayTarget& display);
     
     /**
      * Destructor - cleans up screen instances
@@ -115,11 +143,54 @@ public:
     void update();
     
     /**
-     * Draw the current screen
-     * Should be called when display refresh is needed
+     * Render a frame if one is pending and its deadline has come
+     * Should be called every loop iteration. Renders the dialog if one is
+     * visible, otherwise the current screen via Screen::drawFrame().
      */
     void draw();
     
+    // ========================================================================
+    // Frame Scheduling
+    // ========================================================================
+    
+    /**
+     * Request a redraw of the whole screen on the next frame
+     */
+    void requestRedraw();
+    
+    /**
+     * Request a redraw of a region on the next frame
+     * Regions requested before the frame is rendered are merged.
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width
+     * @param h Height
+     */
+    void requestRedraw(int x, int y, int w, int h);
+    
+    /**
+     * Render the pending frame now, ignoring the frame deadline
+     * Use before blocking work so the screen is up to date while waiting.
+     */
+    void flushFrame();
+    
+    /**
+     * Check if a frame is waiting to be rendered
+     * @return true if a redraw was requested since the last frame
+     */
+    bool hasPendingFrame() const;
+    
+    /**
+     * Get frame statistics
+     * @return Reference to the running counters
+     */
+    const FrameStats& getFrameStats() const;
+    
+    /**
+     * Print frame statistics to Serial
+     */
+    void printFrameStats() const;
+    
     // ========================================================================
     // Input Routing
     // ========================================================================
@@ -204,7 +275,7 @@ public:
     bool isDialogVisible() const;
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     
     // Screen registry - pointers to screen instances (not owned)
     Screen* _screens[static_cast<int>(ScreenType::COUNT)];
@@ -219,6 +290,20 @@ private:
     // Overlay state
     Dialog _dialog;      // Shared dialog instance
     
+    // Frame scheduler state
+    bool _framePending;          // A redraw was requested
+    bool _fullFramePending;      // ...and it covers the whole screen
+    DirtyRect _pendingRegion;    // Union of requested regions
+    uint32_t _frameDueMs;        // When the pending frame became due
+    uint32_t _nextFrameMs;       // Earliest time the next frame may render
+    uint32_t _lastIdleUpdateMs;  // Last update() of a non-frequent screen
+    FrameStats _frameStats;
+    
+    /**
+     * Render the pending frame and update the frame statistics
+     */
+    void renderFrame();
+    
     /**
      * Push current screen to history stack
      */
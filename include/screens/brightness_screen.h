@@ -12,7 +12,8 @@
 #define BRIGHTNESS_SCREEN_H
 
 #include "../screen.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
@@ -46,9 +47,9 @@ class BrightnessScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit BrightnessScreen(M5GFX& display);
+    explicit BrightnessScreen(DisplayTarget& display);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -100,18 +101,23 @@ public:
     static uint8_t getCurrentLevel();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     ScreenManager* _screenManager;
     
     // Current brightness level (0-indexed internally, displayed as 1-4)
     uint8_t _currentLevel;
     
+    // Widgets
+    WidgetTree _widgets;
+    LabelWidget _title;
+    RectWidget _levels[BRIGHTNESS_LEVEL_COUNT];
+    LabelWidget _hint;
+    
     // Drawing helpers
+    void setupWidgets();
+    void updateWidgets();
     void drawBackground();
-    void drawTitle();
-    void drawBrightnessIndicator();
     void drawChevrons();
-    void drawInstructions();
     
     // Brightness control
     void cycleBrightness();
@@ -15,13 +15,17 @@
 
 #include "../screen.h"
 #include "../menu.h"
+#include "../menu_view.h"
 #include "../polling_manager.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../animated_sprite.h"
 
 // Forward declarations
 class ScreenManager;
 class ApiClient;
 class PollingManager;
+struct NetJob;
+struct DeviceCodeResponse;
 
 /**
  * LoginState - Current state of the login process
@@ -51,9 +55,9 @@ class LoginScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit LoginScreen(M5GFX& display);
+    explicit LoginScreen(DisplayTarget& display);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -78,6 +82,7 @@ public:
     void onResume() override;
     void update() override;
     void draw() override;
+    void drawFrame(bool full, const DirtyRect& region) override;
     
     // ========================================================================
     // Input Handling
@@ -123,7 +128,7 @@ public:
     
     /**
      * Initiate login using ApiClient
-     * Gets device code and starts polling for completion.
+     * Gets device code on the NetworkTask, then starts polling for completion.
      */
     void initiateLogin();
     
@@ -134,19 +139,21 @@ public:
     void simulateMockLogin();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     ScreenManager* _screenManager;
     ApiClient* _apiClient;
     PollingManager* _pollingManager;
     
     // Owned menu (just Sleep option)
     DropdownMenu _menu;
+    MenuView _menuView;  // Cached labels, scroll animation
     
     // Login state
     LoginState _state;
     char _pairingCode[16];        // Numeric code (e.g., "482915")
     char _deviceCode[32];         // Device code for polling
     char _errorMessage[64];
+    uint32_t _initiateJobId;      // NetworkTask job fetching the codes (0 = none)
     
     // QR code data
     static constexpr int QR_MAX_VERSION = 4;  // Version 4 = 33x33 modules, fits URLs up to ~78 chars
@@ -155,23 +162,55 @@ private:
     int _qrSize;  // Actual size after generation
     bool _qrGenerated;
     
-    // Animation
-    uint32_t _lastAnimationMs;
+    // Encode the URL uppercased so it fits alphanumeric mode (fewer modules).
+    // Scheme and host are case-insensitive; the pairing route must be too.
+    static constexpr bool QR_UPPERCASE_URL = true;
+    
+    // QR area left of the pairing code, including the white quiet zone.
+    // Modules are scaled to the largest whole pixel size that fits.
+    static constexpr int QR_AREA_X = 9;
+    static constexpr int QR_AREA_Y = 24;
+    static constexpr int QR_AREA_SIZE = 87;
+    static constexpr int QR_QUIET_ZONE_MODULES = 2;
+    
+    // QR rendered once per code (quiet zone included), then blitted on each draw
+    M5Canvas _qrSprite;
+    int _qrModuleSize;
+    
+    // Animation (shared AnimatedSprite timebase)
     uint8_t _animationFrame;
-    static constexpr uint32_t ANIMATION_INTERVAL_MS = 400;
+    uint8_t _drawnAnimationFrame;  // Frame the polling indicator shows
+    AnimatedSprite _dots;          // Pre-rendered polling indicator frames
+    static constexpr uint32_t ANIMATION_TICKS_PER_FRAME = 4;  // 400ms
+    static constexpr int ANIMATION_FRAMES = 4;
+    
+    // Polling indicator area (one pre-rendered frame; steps push only changed dots)
+    static constexpr int DOTS_Y = 118;
+    static constexpr int DOTS_START_X = SCREEN_WIDTH / 2 - 20;
+    static constexpr int DOTS_AREA_X = DOTS_START_X - 5;
+    static constexpr int DOTS_AREA_Y = DOTS_Y - 5;
+    static constexpr int DOTS_AREA_W = 50;
+    static constexpr int DOTS_AREA_H = 15;
     
     // Drawing methods
     void drawBackground();
     void drawTitle();
     void drawQRCode();
     void drawPairingCode();
-    void drawPollingIndicator();
+    void drawPollingIndicator(bool frameOnly);
+    static void renderDotsFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData);
     void drawErrorState();
     void drawInstructions();
     
     // QR code generation
     bool generateQRCode(const char* url);
     bool getQRModule(int x, int y) const;
+    void renderQRCode();
+    void drawQRSpans(lgfx::LovyanGFX& gfx, int x, int y) const;
+    
+    // Login initiation callback (NetworkTask)
+    static void onLoginInitiated(const NetJob& job, void* userData);
+    void handleLoginInitiated(const DeviceCodeResponse& response);
     
     // Polling callback (static to work with PollingManager)
     static void onLoginPollResult(const PollingResult& result, void* userData);
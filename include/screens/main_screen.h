@@ -27,6 +27,9 @@ class ScreenManager;
 class ApiClient;
 class PollingManager;
 class NetworkManager;
+struct NetJob;
+struct AllowanceResult;
+struct MoreTimeRequestResult;
 
 /**
  * MainScreen - Primary screen time display
@@ -52,11 +55,11 @@ class MainScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      * @param sessionManager Reference to the session manager
      * @param ui Reference to the UI class (for existing drawing methods)
      */
-    MainScreen(M5GFX& display, SessionManager& sessionManager, UI& ui);
+    MainScreen(DisplayTarget& display, SessionManager& sessionManager, UI& ui);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -84,8 +87,10 @@ public:
     void onEnter() override;
     void onExit() override;
     void onResume() override;
+    void onOverlayClosed() override;
     void update() override;
     void draw() override;
+    void drawFrame(bool full, const DirtyRect& region) override;
     
     // ========================================================================
     // Input Handling
@@ -141,7 +146,8 @@ public:
 
     /**
      * Request more screen time
-     * Submits request to API and starts polling for approval.
+     * Submits request to API (on the NetworkTask) and starts polling for
+     * approval once it has been accepted.
      */
     void requestMoreTime();
     
@@ -158,7 +164,7 @@ public:
     void showTimeUpDialog();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     SessionManager& _sessionManager;
     ScreenTimer& _timer;  // Convenience reference (from SessionManager)
     UI& _ui;  // Reference to existing UI for drawing methods
@@ -172,10 +178,29 @@ private:
     
     bool _isPollingForMoreTime;  // Visual indicator in UI
     uint32_t _lastDisplayUpdateMs;
+    bool _restorePending;  // Next frame restores the retained frame (overlay closed)
+    
+    // Why the allowance is being fetched - decides what its result shows
+    enum class AllowanceFetch : uint8_t {
+        ENTER,      // No cached allowance on entry (retry dialog on failure)
+        NEW_DAY,    // Day changed ("New day!" or retry dialog)
+        RETRY,      // Retry dialog pressed (dialog again on failure)
+        GRANT,      // More time granted (add locally on failure)
+        REFRESH     // Refresh menu item (after the time sync)
+    };
+    
+    // NetworkTask jobs in flight (0 = none)
+    uint32_t _allowanceJobId;
+    AllowanceFetch _allowanceFetch;
+    uint32_t _grantMinutes;         // Minutes granted, for the GRANT fallback
+    uint32_t _moreTimeJobId;
+    uint32_t _syncJobId;
+    bool _refreshTimeSynced;
     
     // Menu setup and actions
     void setupMenu();
     void destroyMenu();
+    void activateMenuItem();  // Once the activation flash has played
     
     // Menu action callbacks (static for use as function pointers)
     static void onMenuRefreshSync(int itemIndex, void* userData);
@@ -186,6 +211,8 @@ private:
     
     // Menu action implementations
     void doRefreshSync();
+    static void onRefreshTimeSynced(const NetJob& job, void* userData);
+    void finishRefreshSync(bool allowanceSuccess);
     void doSleepNow();
     void doSettings();
     void doParent();
@@ -193,10 +220,34 @@ private:
     // API integration
     
     /**
-     * Fetch today's allowance from the API
-     * @return true if successfully fetched, false on error
+     * Fetch today's allowance from the API on the NetworkTask
+     * The result is applied and handled per reason in finishAllowanceFetch().
+     * @param reason What the fetch is for
+     */
+    void fetchAllowanceFromApi(AllowanceFetch reason);
+    
+    /**
+     * NetworkTask completion for the allowance fetch
+     */
+    static void onAllowanceFetched(const NetJob& job, void* userData);
+    
+    /**
+     * Apply a fetched allowance to the timer and app state
+     * @return true if the fetch succeeded
      */
-    bool fetchAllowanceFromApi();
+    bool applyAllowance(const AllowanceResult& result);
+    
+    /**
+     * Show the outcome of an allowance fetch for its reason
+     * @param success Whether the allowance was fetched
+     */
+    void finishAllowanceFetch(bool success);
+    
+    /**
+     * Check if this is the screen being shown (results can arrive later)
+     * @return true if MAIN is the current screen
+     */
+    bool isCurrentScreen() const;
     
     /**
      * Show a "Try Again" dialog when allowance fetch fails
@@ -211,6 +262,7 @@ private:
     
     // Drawing methods
     void drawFullScreen();
+    bool restoreScreen();
     void updateDynamicElements();
     void drawWifiWarning();
     
@@ -223,6 +275,10 @@ private:
     // Minimum session dialog callback
     static void onMinimumSessionDialogResult(DialogResult result, void* userData);
     
+    // More-time request submission callback (NetworkTask)
+    static void onMoreTimeRequested(const NetJob& job, void* userData);
+    void handleMoreTimeRequest(const MoreTimeRequestResult& result);
+    
     // More-time polling callback
     static void onMoreTimePollResult(const PollingResult& result, void* userData);
     void handleMoreTimeResult(const PollingResult& result);
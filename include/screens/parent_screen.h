@@ -14,7 +14,8 @@
 #include "../screen.h"
 #include "../menu.h"
 #include "../ui.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
@@ -47,11 +48,11 @@ class ParentScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      * @param ui Reference to UI for drawing
      * @param timer Reference to ScreenTimer for reset functionality
      */
-    ParentScreen(M5GFX& display, UI& ui, ScreenTimer& timer);
+    ParentScreen(DisplayTarget& display, UI& ui, ScreenTimer& timer);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -84,12 +85,12 @@ public:
     
     const char* getTitle() const override { return "Parent"; }
     bool showsHeader() const override { return true; }
-    bool needsFrequentUpdates() const override { return false; }
+    bool needsFrequentUpdates() const override { return _ui.isMenuAnimating(); }  // Menu scroll/flash
     bool hasMenu() const override { return _isUnlocked; }
     bool isMenuVisible() const override { return _menu.isVisible(); }
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     UI& _ui;
     ScreenTimer& _timer;
     ScreenManager* _screenManager;
@@ -106,16 +107,22 @@ private:
     // Expected sequence: 0=A, 1=B
     static constexpr uint8_t EXPECTED_SEQUENCE[SEQUENCE_LENGTH] = {0, 0, 0, 0, 0, 1, 0};
     
+    // Widgets
+    WidgetTree _widgets;
+    HeaderWidget _header;
+    LabelWidget _title;
+    LabelWidget _instruction;
+    LabelWidget _hint;
+    
     // Menu setup and teardown
     void setupMenu();
     void destroyMenu();
+    void activateMenuItem();  // Once the activation flash has played
     
     // Drawing helpers
+    void setupWidgets();
+    void updateInstruction();
     void drawBackground();
-    void drawHeader();
-    void drawTitle();
-    void drawInstruction();
-    void drawHint();
     void drawMenu();
     
     // Sequence handling
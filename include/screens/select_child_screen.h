@@ -4,6 +4,10 @@
  * Displays a paged list of family members (children) for selection.
  * Shows one child at a time with avatar and name, with chevron arrows
  * indicating pagination.
+ *
+ * Each child's card (avatar, name, page dots and chevrons) is rendered into
+ * a PSRAM sprite. While the screen is idle the next and previous cards are
+ * rendered ahead, so paging with B / Power is a single blit.
  * 
  * @author Screen Time Tracker
  * @version 1.0
@@ -15,13 +19,29 @@
 #include "../screen.h"
 #include "../app_state.h"
 #include "../api_client.h"  // For FamilyMember struct
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
+struct NetJob;
 
 // Note: FamilyMember struct is defined in api_client.h
 
+/**
+ * ChildCardStats - Paging counters readable on the device
+ * Latencies run from the button press to the completed frame.
+ */
+struct ChildCardStats {
+    uint32_t prerenders;        // Cards rendered ahead while idle
+    uint32_t hits;              // Pages shown from a pre-rendered card
+    uint32_t misses;            // Pages whose card was rendered on demand
+    uint32_t lastHitUs;         // Most recent page from a ready card
+    uint32_t maxHitUs;
+    uint32_t lastMissUs;        // Most recent page rendered on demand
+    uint32_t maxMissUs;
+};
+
 /**
  * SelectChildScreen - Family member selection screen
  * 
@@ -41,9 +61,9 @@ class SelectChildScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit SelectChildScreen(M5GFX& display);
+    explicit SelectChildScreen(DisplayTarget& display);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -94,13 +114,14 @@ public:
     void loadMockMembers();
     
     /**
-     * Load family members from API
-     * @return true if successful
+     * Load family members from API on the NetworkTask
+     * The list is shown when the job completes (mock data if it fails).
+     * @return true if the request was queued
      */
     bool loadMembersFromApi();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     ScreenManager* _screenManager;
     ApiClient* _apiClient;
     
@@ -112,6 +133,7 @@ private:
     
     // Loading state
     bool _loading;
+    uint32_t _membersJobId;  // NetworkTask job loading the members (0 = none)
     
     // Layout constants
     static constexpr int TITLE_Y = 12;
@@ -122,16 +144,52 @@ private:
     static constexpr int CHEVRON_LEFT_X = 20;
     static constexpr int CHEVRON_RIGHT_X = 220;
     
+    // Card area: avatar border top down to the last row of the page dots
+    // (centered at SCREEN_HEIGHT - 12), full width so the chevrons are included
+    static constexpr int CARD_Y = AVATAR_CENTER_Y - AVATAR_LARGE_RADIUS - 1;
+    static constexpr int CARD_HEIGHT = SCREEN_HEIGHT - 12 + 5 - CARD_Y;
+    
+    // Cards kept: current, next and previous (~42KB each in PSRAM)
+    static constexpr int CARD_CACHE_SIZE = 3;
+    
+    // Widgets
+    WidgetTree _widgets;
+    LabelWidget _title;
+    LabelWidget _status;
+    
+    // Card painters (not in the tree; laid out on the panel or in a card sprite)
+    LabelWidget _name;
+    PageDotsWidget _dots;
+    AvatarWidget _avatar;
+    
+    // Pre-rendered cards, by member index (-1 = free)
+    M5Canvas _cards[CARD_CACHE_SIZE];
+    int _cardMember[CARD_CACHE_SIZE];
+    int _shownCard;              // Member whose card is on the panel (-1 = none)
+    uint32_t _pageStartUs;       // Button press awaiting its frame (0 = none)
+    bool _cardsUnavailable;      // Sprite allocation failed; paint cards in place
+    ChildCardStats _cardStats;
+    
+    // Member loading (NetworkTask completion)
+    static void onMembersLoaded(const NetJob& job, void* userData);
+    bool applyMembers(const FamilyGroupResult& result);
+    void finishLoading();
+    
     // Drawing methods
+    void setupWidgets();
+    void updateWidgets();
     void drawBackground();
-    void drawTitle();
-    void drawCurrentChild();
-    void drawAvatar(char initial, const char* avatarName, int centerX, int centerY, int radius);
-    void drawName(const char* name);
-    void drawChevrons();
-    void drawChevronLeft(int x, int y);
-    void drawChevronRight(int x, int y);
-    void drawLoadingState();
+    void drawChevrons(lgfx::LovyanGFX& gfx, int top);
+    
+    // Card cache
+    void layoutCard(int top);
+    void paintCard(lgfx::LovyanGFX& gfx, int index, int top);
+    int findCard(int index) const;
+    int renderCard(int index);
+    bool drawCard(int index);
+    void prerenderNeighbors();
+    void releaseCards();
+    void printCardStats() const;
     
     // Navigation
     void selectNext();
@@ -15,7 +15,8 @@
 #include "../menu.h"
 #include "../ui.h"
 #include "../dialog.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
@@ -42,10 +43,10 @@ class SettingsScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      * @param ui Reference to UI for menu drawing
      */
-    SettingsScreen(M5GFX& display, UI& ui);
+    SettingsScreen(DisplayTarget& display, UI& ui);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -78,24 +79,29 @@ public:
     
     const char* getTitle() const override { return "Settings"; }
     bool showsHeader() const override { return true; }
-    bool needsFrequentUpdates() const override { return false; }
+    bool needsFrequentUpdates() const override { return _ui.isMenuAnimating(); }  // Menu scroll/flash
     bool hasMenu() const override { return true; }
     bool isMenuVisible() const override { return _menu.isVisible(); }
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     UI& _ui;
     ScreenManager* _screenManager;
     DropdownMenu _menu;
     
+    // Widgets
+    WidgetTree _widgets;
+    HeaderWidget _header;
+    LabelWidget _placeholder;
+    
     // Menu setup and teardown
     void setupMenu();
     void destroyMenu();
+    void activateMenuItem();  // Once the activation flash has played
     
     // Drawing helpers
+    void setupWidgets();
     void drawBackground();
-    void drawHeader();
-    void drawPlaceholderText();
     void drawMenu();
     
     // Menu action callbacks (static for use as function pointers)
@@ -12,7 +12,8 @@
 #define SYNC_SCREEN_H
 
 #include "../screen.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
@@ -31,9 +32,9 @@ class SyncScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit SyncScreen(M5GFX& display);
+    explicit SyncScreen(DisplayTarget& display);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -97,19 +98,16 @@ public:
     void reset();
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     ScreenManager* _screenManager;
     
     // State
-    char _message[64];
-    float _progress;
     bool _showSpinner;
     bool _showProgress;
     
-    // Animation
-    uint32_t _lastAnimationMs;
+    // Animation (shared AnimatedSprite timebase)
     uint8_t _spinnerFrame;
-    static constexpr uint32_t SPINNER_INTERVAL_MS = 100;
+    static constexpr uint32_t SPINNER_TICKS_PER_FRAME = 1;  // 100ms
     static constexpr int SPINNER_FRAMES = 8;
     
     // Layout
@@ -120,11 +118,16 @@ private:
     static constexpr int PROGRESS_HEIGHT = 8;
     static constexpr int PROGRESS_WIDTH = 160;
     
+    // Widgets
+    WidgetTree _widgets;
+    RingWidget _spinner;
+    ProgressBarWidget _progressBar;
+    LabelWidget _message;
+    
     // Drawing methods
+    void setupWidgets();
+    void updateVisibility();
     void drawBackground();
-    void drawSpinner();
-    void drawProgressBar();
-    void drawMessage();
 };
 
 #endif // SYNC_SCREEN_H
@@ -12,7 +12,8 @@
 #define SYSTEM_INFO_SCREEN_H
 
 #include "../screen.h"
-#include <M5GFX.h>
+#include "../display_target.h"
+#include "../widget.h"
 
 // Forward declarations
 class ScreenManager;
@@ -33,9 +34,9 @@ class SystemInfoScreen : public Screen {
 public:
     /**
      * Constructor
-     * @param display Reference to M5GFX display
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit SystemInfoScreen(M5GFX& display);
+    explicit SystemInfoScreen(DisplayTarget& display);
     
     /**
      * Set the screen manager (for navigation callbacks)
@@ -71,19 +72,25 @@ public:
     bool needsFrequentUpdates() const override { return false; }
 
 private:
-    M5GFX& _display;
+    DisplayTarget& _display;
     ScreenManager* _screenManager;
     
     // Cached battery info (read on enter)
     int _batteryLevel;      // Percentage 0-100
     int _batteryVoltage;    // Voltage in mV
     
+    // Widgets: one label/value pair per info row
+    static constexpr int ROW_COUNT = 4;
+    WidgetTree _widgets;
+    LabelWidget _rowLabels[ROW_COUNT];
+    LabelWidget _rowValues[ROW_COUNT];
+    LabelWidget _hint;
+    
     // Drawing helpers
+    void setupWidgets();
+    void updateWidgets();
     void drawBackground();
     void drawTitle();
-    void drawBatteryInfo();
-    void drawVersionInfo();
-    void drawExitHint();
     
     // Helper to go back to previous screen
     void exitScreen();
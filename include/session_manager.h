@@ -25,6 +25,7 @@
 // Forward declarations
 class ApiClient;
 class ScreenTimer;
+struct NetJob;
 
 /**
  * SessionSnapshot - Portable state for saving/restoring sessions
@@ -221,11 +222,17 @@ private:
     
     /**
      * Push a completed session to the API
-     * Fire-and-forget operation - failures are logged but don't block.
+     * Fire-and-forget operation queued on the NetworkTask - failures are
+     * logged but don't block.
      * @param durationSeconds Session duration in seconds
      * @param startTime When the session started
      */
     void pushSessionToApi(uint32_t durationSeconds, time_t startTime);
+    
+    /**
+     * Log the outcome of a session push (NetworkTask completion)
+     */
+    static void onSessionPushed(const NetJob& job, void* userData);
 };
 
 #endif // SESSION_MANAGER_H
@@ -0,0 +1,105 @@
+/**
+ * text_layout.h - Cached word-wrap layout for Screen Time Tracker
+ *
+ * Breaks a message into lines that fit a given width once, and keeps the
+ * result until the message, font, width or line limit changes. Redrawing
+ * the same text (dialog redraws, spinner frames) then only prints the
+ * cached lines instead of measuring every word again with textWidth().
+ *
+ * Lines break at spaces; a word wider than the whole line is broken
+ * between characters. '\n' always starts a new line.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include "display_target.h"
+
+// ============================================================================
+// TEXT LAYOUT CONFIGURATION
+// ============================================================================
+
+// Maximum text length laid out (including terminator); longer text is truncated
+constexpr int TEXT_LAYOUT_MAX_LEN = 256;
+
+// Maximum lines kept per layout
+constexpr int TEXT_LAYOUT_MAX_LINES = 8;
+
+// ============================================================================
+// Text Layout Class
+// ============================================================================
+
+/**
+ * TextLayout - Word-wrapped lines for one (text, font, width) key
+ *
+ * Usage:
+ *   _layout.layout(gfx, message, &fonts::Font0, areaWidth);  // no-op if unchanged
+ *   gfx.setTextColor(color);
+ *   _layout.draw(gfx, x, y, 12);
+ */
+class TextLayout {
+public:
+    /**
+     * Constructor - starts with no layout
+     */
+    TextLayout();
+
+    /**
+     * Lay out text, reusing the cached lines if nothing changed
+     * Sets the font on gfx (needed to measure the text).
+     * @param gfx Target used to measure text
+     * @param text Text to lay out
+     * @param font Font the text is drawn with
+     * @param maxWidth Maximum line width in pixels
+     * @param maxLines Lines kept; text beyond the last line is dropped
+     * @return true if the lines were recomputed, false if the cache was used
+     */
+    bool layout(lgfx::LovyanGFX& gfx, const char* text, const lgfx::IFont* font,
+                int maxWidth, int maxLines = TEXT_LAYOUT_MAX_LINES);
+
+    /**
+     * Get the number of laid out lines
+     * @return Line count
+     */
+    int getLineCount() const;
+
+    /**
+     * Get one laid out line
+     * @param index 0 .. getLineCount() - 1
+     * @return Line text (empty string if out of range)
+     */
+    const char* getLine(int index) const;
+
+    /**
+     * Print the cached lines
+     * The caller sets the text color; the font is set from the layout.
+     * @param gfx Draw target
+     * @param x Cursor X of every line
+     * @param y Cursor Y of the first line
+     * @param lineHeight Distance between lines
+     */
+    void draw(lgfx::LovyanGFX& gfx, int x, int y, int lineHeight) const;
+
+private:
+    // Cache key
+    char _source[TEXT_LAYOUT_MAX_LEN];
+    const lgfx::IFont* _font;
+    int16_t _maxWidth;
+    int8_t _maxLines;
+    bool _valid;
+
+    // Lines stored back to back, each null-terminated
+    char _lines[TEXT_LAYOUT_MAX_LEN + TEXT_LAYOUT_MAX_LINES];
+    uint16_t _lineOffsets[TEXT_LAYOUT_MAX_LINES];
+    int _lineCount;
+    int _used;
+
+    // Internal methods
+    int measure(lgfx::LovyanGFX& gfx, int start, int end);
+    void addLine(int start, int end);
+};
+
+#endif // TEXT_LAYOUT_H
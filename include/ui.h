@@ -9,7 +9,7 @@
  * - Button hints
  * - Info dialogs
  * 
- * Uses M5GFX for all graphics operations.
+ * Draws through a DisplayTarget (M5GFX panel or off-screen canvas).
  * 
  * @author Screen Time Tracker
  * @version 1.0
@@ -18,8 +18,14 @@
 #ifndef UI_H
 #define UI_H
 
-#include <M5GFX.h>
+#include "display_target.h"
 #include "config.h"
+#include "activation_ring.h"
+#include "compositor.h"
+#include "glyph_atlas.h"
+#include "header.h"
+#include "menu_view.h"
+#include "text_layout.h"
 #include "network.h"
 #include "timer.h"  // For TimerState enum
 
@@ -31,15 +37,16 @@ class DropdownMenu;
  * UI class - Manages all display rendering
  * 
  * This class is responsible for drawing all UI elements on the M5StickC Plus2
- * display. It uses double buffering via sprite for smooth updates.
+ * display. The main screen is composed in an off-screen sprite and only the
+ * dirty regions are pushed to the panel (see Compositor).
  */
 class UI {
 public:
     /**
      * Constructor - Initialize UI with display reference
-     * @param display Reference to M5GFX display object
+     * @param display Display target (panel or off-screen canvas)
      */
-    explicit UI(M5GFX& display);
+    explicit UI(DisplayTarget& display);
 
     /**
      * Initialize the display and prepare for rendering
@@ -47,6 +54,13 @@ public:
      */
     void begin();
 
+    /**
+     * Pin the clock behind the date and activation labels, so frames
+     * rendered for golden checksums do not depend on when they ran
+     * @param now Time to show, or 0 to follow the system clock
+     */
+    void setFixedTime(time_t now);
+
     /**
      * Draw the complete main screen
      * @param timer Reference to timer for time values
@@ -71,12 +85,61 @@ public:
      */
     void updateDynamicElements(const ScreenTimer& timer, bool isTimerRunning);
 
+    /**
+     * Put the last composed main screen back on the panel after an overlay
+     * Dialogs, menus and notifications draw on the panel only, so the
+     * compositor sprite still holds the main frame. Refreshes the header
+     * indicators and the dynamic elements in the sprite, then pushes it -
+     * no avatar decode or full recompose.
+     * @param timer Reference to timer for time values
+     * @param userName Child name the frame must show
+     * @param userInitial Avatar initial the frame must show
+     * @param avatarName Avatar PNG filename the frame must show
+     * @param isTimerRunning True if countdown is active
+     * @param networkStatus Current network status for header indicator
+     * @return false if there is no matching frame (call drawMainScreen())
+     */
+    bool restoreMainScreen(const ScreenTimer& timer,
+                           const char* userName,
+                           char userInitial,
+                           const char* avatarName,
+                           bool isTimerRunning,
+                           NetworkStatus networkStatus = NetworkStatus::DISCONNECTED);
+
     /**
      * Draw the dropdown menu overlay
      * @param menu Reference to the menu to draw
      */
     void drawMenu(const DropdownMenu& menu);
 
+    /**
+     * Scroll the menu overlay to its new selection
+     * Call after selectNext()/selectPrevious(); updateMenu() plays the frames.
+     * @param menu Reference to the menu whose selection changed
+     */
+    void scrollMenu(const DropdownMenu& menu);
+
+    /**
+     * Advance the menu scroll and flash animations
+     * Call from the screen's update() while the menu is visible.
+     * @param menu Reference to the menu being shown
+     * @return true when an activation flash has finished (activate the item now)
+     */
+    bool updateMenu(const DropdownMenu& menu);
+
+    /**
+     * Check if an activation flash is showing
+     * @return true until updateMenu() reports the flash finished
+     */
+    bool isMenuFlashing() const;
+
+    /**
+     * Check if the menu has a scroll or flash in progress
+     * Static screens use this to get update() every loop meanwhile.
+     * @return true while updateMenu() has frames to push or a flash to time
+     */
+    bool isMenuAnimating() const;
+
     /**
      * Clear the menu area and restore underlying UI
      * @param timer Reference to timer for redraw
@@ -95,6 +158,7 @@ public:
 
     /**
      * Flash a menu item to indicate activation
+     * Returns immediately; updateMenu() reports when the flash is over.
      * @param menu Reference to menu
      * @param itemIndex Index of item to flash
      */
@@ -151,13 +215,38 @@ public:
      */
     bool needsFullRedraw() const;
 
+    /**
+     * Get the main screen compositor (for flush statistics)
+     * @return Reference to the compositor
+     */
+    const Compositor& getCompositor() const;
+
+    /**
+     * Get the activation ring renderer (for pixels-touched statistics)
+     * @return Reference to the activation ring
+     */
+    const ActivationRing& getActivationRing() const;
+
+    /**
+     * Get the cached header layer (for compose/blit statistics)
+     * @return Reference to the header layer
+     */
+    const HeaderLayer& getHeader() const;
+
+    /**
+     * Get the menu view (for strip/scroll statistics)
+     * @return Reference to the menu view
+     */
+    const MenuView& getMenuView() const;
+
     // ========================================================================
     // Shared Header Drawing
     // ========================================================================
     
     /**
      * Draw the standard app header bar
-     * Can be used by any screen that wants the common header.
+     * Can be used by any screen that wants the common header. Blits the
+     * cached header layer; only a new title recomposes it.
      * @param appName App/screen name to display
      */
     void drawHeader(const char* appName);
@@ -178,11 +267,19 @@ public:
     void drawStandardHeader(const char* title, NetworkStatus networkStatus);
 
 private:
-    M5GFX& _display;
-    M5Canvas _canvas;  // For double buffering if needed
+    DisplayTarget& _display;
+    lgfx::LovyanGFX* _gfx;     // Current draw target (compositor sprite or panel)
+    Compositor _compositor;    // Off-screen framebuffer for the main screen
+    ActivationRing _activationRing;  // Incremental minimum-session arc
+    GlyphAtlas _timerAtlas;    // Pre-rendered countdown digits (one row per timer color)
+    HeaderLayer _header;       // Cached header strip shared by all screens
+    MenuView _menuView;        // Cached menu labels, scroll and flash animation
+    TextLayout _notificationLayout;  // Cached word wrap of the last notification
+    TextLayout _infoDialogLayout;    // Cached word wrap of the last info dialog message
     
     bool _needsFullRedraw;
     uint32_t _lastUpdateMs;
+    time_t _fixedTime;          // 0 = system clock (see setFixedTime)
     bool _infoDialogVisible;
     NetworkStatus _currentNetworkStatus;
     
@@ -194,25 +291,43 @@ private:
     float _lastDrawnProgress;
     bool _lastDrawnRunning;
     
+    // Countdown cells currently on screen (empty = drawn as text, redraw all)
+    char _drawnTimerText[8];
+    int8_t _drawnTimerColor;
+    
+    // Main frame retained in the compositor sprite (for restoreMainScreen)
+    bool _mainFrameValid;
+    uint32_t _mainFrameKey;
+    
     // Private drawing methods
     void drawDateInHeader();
     void drawDateOnMainScreen();
     void drawAvatar(char initial, const char* userName, const char* avatarName, int x, int y);
     void drawChildName(const char* userName, int x, int y);
     void drawTimerDisplay(uint32_t remainingSeconds, TimerState state);
+    bool drawTimerCells(const char* timeText, uint16_t timerColor, int timerX, int timerY);
     void drawProgressBar(const ScreenTimer& timer);
-    void clearActivationRing(const ScreenTimer &timer);
     void drawStatusRing(const ScreenTimer& timer);
+    void drawActivationRing(const ScreenTimer& timer);
+    
+    // Redraw changed dynamic elements into the sprite and mark them dirty
+    // Returns false if nothing changed.
+    bool composeDynamicElements(const ScreenTimer& timer, bool isTimerRunning);
     
     // Internal version of drawNetworkStatusInHeader that uses cached status
     void drawNetworkStatusInHeader();
     
+    // Push changed header indicators to the panel and the retained main frame
+    void updateHeaderIndicators();
+    
     // Helper methods
+    time_t currentTime() const;
     void formatTime(uint32_t seconds, char* buffer, size_t bufferSize);
+    uint32_t mainFrameKey(const char* userName, char userInitial, const char* avatarName);
     uint16_t getProgressColor(float progress);
+    uint16_t getStatusRingColor(const ScreenTimer& timer);
     void getDayOfWeekStr(int dayOfWeek, char* buffer);
     void getMonthStr(int month, char* buffer);
-    char getNetworkStatusChar(NetworkStatus status);
 };
 
 #endif // UI_H
@@ -0,0 +1,516 @@
+/**
+ * widget.h - Retained-mode widgets for Screen Time Tracker
+ *
+ * Screens describe their layout once as a set of widgets (labels, rects,
+ * avatars, progress bars, rings, the header). Each widget owns its bounds
+ * and only invalidates itself when one of its inputs actually changes, e.g.
+ * setText() with the same string is a no-op.
+ *
+ * A WidgetTree repaints either everything (after invalidateAll(), used on
+ * enter/resume and after overlays) or only the invalidated widgets, each
+ * cleared to its background inside its own bounds first. Screens therefore
+ * no longer fillScreen() on every state change.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef WIDGET_H
+#define WIDGET_H
+
+#include "display_target.h"
+#include "compositor.h"
+#include "animated_sprite.h"
+#include "network.h"
+#include "config.h"
+
+// Forward declarations
+class UI;
+
+// ============================================================================
+// WIDGET CONFIGURATION
+// ============================================================================
+
+// Maximum widgets registered with one WidgetTree
+constexpr int WIDGET_TREE_MAX_WIDGETS = 16;
+
+// Maximum label length (including terminator)
+constexpr int WIDGET_LABEL_MAX_LEN = 64;
+
+// Maximum avatar filename length (matches FamilyMember::avatarName)
+constexpr int WIDGET_AVATAR_NAME_LEN = 32;
+
+// ============================================================================
+// Widget Base Class
+// ============================================================================
+
+/**
+ * WidgetAlign - Horizontal text alignment relative to the text anchor
+ */
+enum class WidgetAlign {
+    LEFT,       // Anchor is the left edge of the text
+    CENTER,     // Anchor is the horizontal center of the text
+    RIGHT       // Anchor is the right edge of the text
+};
+
+/**
+ * Widget - A screen element that knows its bounds and when it is stale
+ *
+ * Subclasses implement paint(); setters call invalidate() only when the
+ * value changes.
+ */
+class Widget {
+public:
+    /**
+     * Constructor - starts visible, dirty, with empty bounds
+     */
+    Widget();
+
+    virtual ~Widget() {}
+
+    /**
+     * Set the region this widget clears and paints into
+     * Invalidates the widget if the bounds changed.
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width
+     * @param h Height
+     */
+    void setBounds(int x, int y, int w, int h);
+
+    /**
+     * Get the widget bounds
+     * @return Region cleared before each partial repaint
+     */
+    const DirtyRect& getBounds() const;
+
+    /**
+     * Set the color the bounds are cleared to
+     * @param color RGB565 background color
+     */
+    void setBackground(uint16_t color);
+
+    /**
+     * Show or hide the widget
+     * Hiding clears its bounds on the next repaint.
+     * @param visible Whether the widget is painted
+     */
+    void setVisible(bool visible);
+
+    /**
+     * Check if the widget is painted
+     * @return true if visible
+     */
+    bool isVisible() const;
+
+    /**
+     * Mark the widget as needing a repaint
+     */
+    void invalidate();
+
+    /**
+     * Check if the widget needs a repaint
+     * @return true if invalidated since the last render()
+     */
+    bool isDirty() const;
+
+    /**
+     * Repaint the widget if it is dirty (or unconditionally on a full repaint)
+     * @param gfx Draw target
+     * @param full true if the whole screen was just cleared by the caller
+     * @return Pixels covered by the repaint (0 if nothing was drawn)
+     */
+    uint32_t render(lgfx::LovyanGFX& gfx, bool full);
+
+protected:
+    DirtyRect _bounds;
+    uint16_t _background;
+
+    /**
+     * Draw the widget contents
+     * @param gfx Draw target
+     */
+    virtual void paint(lgfx::LovyanGFX& gfx) = 0;
+
+    /**
+     * Clear the widget bounds before a partial repaint or when hidden
+     * @param gfx Draw target
+     */
+    virtual void clear(lgfx::LovyanGFX& gfx);
+
+private:
+    bool _visible;
+    bool _dirty;
+};
+
+// ============================================================================
+// Widgets
+// ============================================================================
+
+/**
+ * LabelWidget - Single line of text
+ *
+ * The text anchor is separate from the bounds so the bounds can cover the
+ * widest text the label will show (old text is cleared on change).
+ */
+class LabelWidget : public Widget {
+public:
+    LabelWidget();
+
+    /**
+     * Set font, color and alignment
+     * @param font Font to draw with
+     * @param color RGB565 text color
+     * @param align Alignment relative to the anchor
+     */
+    void setStyle(const lgfx::IFont* font, uint16_t color, WidgetAlign align);
+
+    /**
+     * Set the text anchor (cursor position)
+     * @param x Anchor X (left, center or right edge depending on alignment)
+     * @param y Cursor Y
+     */
+    void setAnchor(int x, int y);
+
+    /**
+     * Set the text; invalidates only if it differs from the current text
+     * @param text Text to show (truncated to WIDGET_LABEL_MAX_LEN - 1)
+     */
+    void setText(const char* text);
+
+    /**
+     * Set the text color; invalidates only if it changed
+     * @param color RGB565 text color
+     */
+    void setColor(uint16_t color);
+
+    /**
+     * Get the current text
+     * @return Label text
+     */
+    const char* getText() const;
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+
+private:
+    char _text[WIDGET_LABEL_MAX_LEN];
+    const lgfx::IFont* _font;
+    uint16_t _color;
+    WidgetAlign _align;
+    int16_t _anchorX;
+    int16_t _anchorY;
+};
+
+/**
+ * RectWidget - Filled (optionally rounded) rectangle covering its bounds
+ */
+class RectWidget : public Widget {
+public:
+    RectWidget();
+
+    /**
+     * Set the fill color; invalidates only if it changed
+     * @param color RGB565 fill color
+     */
+    void setColor(uint16_t color);
+
+    /**
+     * Set the corner radius
+     * @param radius Corner radius in pixels (0 = square)
+     */
+    void setRadius(int radius);
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+
+private:
+    uint16_t _color;
+    int16_t _radius;
+};
+
+/**
+ * ProgressBarWidget - Rounded track with a proportional fill and border
+ */
+class ProgressBarWidget : public Widget {
+public:
+    ProgressBarWidget();
+
+    /**
+     * Set track, fill and border colors
+     * @param track RGB565 track color
+     * @param fill RGB565 fill color
+     * @param border RGB565 border color
+     */
+    void setColors(uint16_t track, uint16_t fill, uint16_t border);
+
+    /**
+     * Set progress; invalidates only if the fill width in pixels changed
+     * @param progress 0.0 - 1.0 (clamped)
+     */
+    void setProgress(float progress);
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+
+private:
+    uint16_t _trackColor;
+    uint16_t _fillColor;
+    uint16_t _borderColor;
+    int16_t _fillWidth;
+};
+
+/**
+ * RingWidget - Circular track with a rotating arc of dots (spinner)
+ *
+ * The bounds are derived from the center and radius. Every arc position is
+ * pre-rendered once into an AnimatedSprite; advancing the frame pushes only
+ * the pixels that changed since the frame on screen.
+ */
+class RingWidget : public Widget {
+public:
+    RingWidget();
+
+    /**
+     * Set the ring geometry; also sets the bounds
+     * @param centerX Center X
+     * @param centerY Center Y
+     * @param radius Track radius
+     */
+    void setGeometry(int centerX, int centerY, int radius);
+
+    /**
+     * Set track and arc colors
+     * @param track RGB565 track color
+     * @param arc RGB565 arc color
+     */
+    void setColors(uint16_t track, uint16_t arc);
+
+    /**
+     * Set the number of animation positions around the ring
+     * @param frames Positions per revolution
+     */
+    void setFrameCount(uint8_t frames);
+
+    /**
+     * Set the arc position; invalidates only if it changed
+     * @param frame 0 .. frameCount - 1
+     */
+    void setFrame(uint8_t frame);
+
+    /**
+     * Print frame cache statistics to Serial
+     * @param name Animation name for the log line
+     */
+    void printStats(const char* name) const;
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+    void clear(lgfx::LovyanGFX& gfx) override;
+
+private:
+    int16_t _centerX;
+    int16_t _centerY;
+    int16_t _radius;
+    uint16_t _trackColor;
+    uint16_t _arcColor;
+    uint8_t _frameCount;
+    uint8_t _frame;
+
+    // Pre-rendered frames and what the target shows
+    AnimatedSprite _frames;
+    int8_t _paintedFrame;   // Frame on screen, -1 if cleared
+    bool _frameOnly;        // Only the frame changed since the last paint
+    bool _deltaPaint;       // This partial repaint may push just the changes
+
+    void paintFrame(lgfx::LovyanGFX& gfx, int centerX, int centerY, int frame);
+    static void renderFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData);
+};
+
+/**
+ * AvatarWidget - Circular avatar from AvatarCache, or a lettered fallback
+ *
+ * The bounds are derived from the center and radius (including border).
+ */
+class AvatarWidget : public Widget {
+public:
+    AvatarWidget();
+
+    /**
+     * Set the avatar geometry; also sets the bounds
+     * @param centerX Center X
+     * @param centerY Center Y
+     * @param radius Avatar radius
+     */
+    void setGeometry(int centerX, int centerY, int radius);
+
+    /**
+     * Set the avatar; invalidates only if name or initial changed
+     * @param avatarName Avatar filename (may be empty)
+     * @param initial Fallback letter when no blob is available
+     */
+    void setAvatar(const char* avatarName, char initial);
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+
+private:
+    char _avatarName[WIDGET_AVATAR_NAME_LEN];
+    char _initial;
+    int16_t _centerX;
+    int16_t _centerY;
+    int16_t _radius;
+};
+
+/**
+ * PageDotsWidget - Row of page indicator dots
+ */
+class PageDotsWidget : public Widget {
+public:
+    PageDotsWidget();
+
+    /**
+     * Set the center line of the dot row
+     * @param centerX Horizontal center of the row
+     * @param centerY Dot center Y
+     */
+    void setCenter(int centerX, int centerY);
+
+    /**
+     * Set page count and current page; invalidates only if either changed
+     * @param count Number of dots
+     * @param index Highlighted dot
+     */
+    void setPages(int count, int index);
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+
+private:
+    int16_t _centerX;
+    int16_t _centerY;
+    int16_t _count;
+    int16_t _index;
+
+    static constexpr int DOT_RADIUS = 3;
+    static constexpr int DOT_SPACING = 10;
+};
+
+/**
+ * HeaderWidget - The standard header bar drawn by UI::drawStandardHeader()
+ *
+ * UI draws the header to its own target, so this widget is only useful on
+ * screens that draw to the same display as UI.
+ */
+class HeaderWidget : public Widget {
+public:
+    /**
+     * Constructor
+     * @param ui UI instance that draws the header
+     */
+    explicit HeaderWidget(UI& ui);
+
+    /**
+     * Set the header title
+     * @param title Static title string (pointer is kept)
+     */
+    void setTitle(const char* title);
+
+    /**
+     * Set the network status; invalidates only if it changed
+     * @param status Current network status
+     */
+    void setNetworkStatus(NetworkStatus status);
+
+protected:
+    void paint(lgfx::LovyanGFX& gfx) override;
+    void clear(lgfx::LovyanGFX& gfx) override;
+
+private:
+    UI& _ui;
+    const char* _title;
+    NetworkStatus _networkStatus;
+};
+
+// ============================================================================
+// Widget Tree
+// ============================================================================
+
+/**
+ * WidgetTreeStats - Counters for measuring repaint cost on the device
+ */
+struct WidgetTreeStats {
+    uint32_t fullRepaints;      // render() calls that repainted every widget
+    uint32_t partialRepaints;   // render() calls that repainted dirty widgets only
+    uint32_t widgetsPainted;    // Total widgets repainted
+    uint32_t pixelsPainted;     // Total pixels covered by repainted widgets
+};
+
+/**
+ * WidgetTree - The set of widgets making up one screen
+ *
+ * Usage:
+ *   _widgets.add(_title);
+ *   _title.setText("Hello");           // invalidates _title
+ *   if (_widgets.needsFullRepaint()) { fill background, static decorations }
+ *   _widgets.render(_display);         // repaints only what changed
+ */
+class WidgetTree {
+public:
+    /**
+     * Constructor - the first render() is a full repaint
+     */
+    WidgetTree();
+
+    /**
+     * Register a widget (not owned; must outlive the tree)
+     * @param widget Widget to add, painted in insertion order
+     * @return false if WIDGET_TREE_MAX_WIDGETS is reached
+     */
+    bool add(Widget& widget);
+
+    /**
+     * Request a full repaint (screen entered, resumed or overdrawn)
+     */
+    void invalidateAll();
+
+    /**
+     * Check if the next render() repaints everything
+     * The caller must clear the screen and draw static decorations first.
+     * @return true if a full repaint is pending
+     */
+    bool needsFullRepaint() const;
+
+    /**
+     * Check if render() would draw anything
+     * @return true if a full repaint is pending or any widget is dirty
+     */
+    bool hasDirtyWidgets() const;
+
+    /**
+     * Repaint pending widgets
+     * @param gfx Draw target
+     * @return Number of widgets repainted
+     */
+    int render(lgfx::LovyanGFX& gfx);
+
+    /**
+     * Get repaint statistics
+     * @return Reference to the running counters
+     */
+    const WidgetTreeStats& getStats() const;
+
+    /**
+     * Print repaint statistics to Serial
+     * @param name Screen name used as the log prefix
+     */
+    void printStats(const char* name) const;
+
+private:
+    Widget* _widgets[WIDGET_TREE_MAX_WIDGETS];
+    int _count;
+    bool _fullRepaint;
+    WidgetTreeStats _stats;
+};
+
+#endif // WIDGET_H
@@ -0,0 +1,272 @@
+"""
+build_avatars.py - Build-time avatar preprocessing for Screen Time Tracker
+
+Converts every data/avatars/*.png into raw RGB565 blobs that the firmware can
+blit without decoding a PNG:
+
+- One blob per avatar per radius used by the UI (AVATAR_RADIUS in config.h,
+  AVATAR_LARGE_RADIUS in the screen headers), scaled to a 2r x 2r square.
+- Each blob is alpha-composited over COLOR_AVATAR_PRIMARY and masked to the
+  avatar circle: only the pixels inside the circle are stored, row by row,
+  as little-endian RGB565.
+- include/avatar_manifest.h is regenerated with the avatar names, the radii
+  and the per-row circle span tables the blitter uses to walk the blob.
+
+Blobs are written next to the PNGs as /avatars/<name>_r<radius>.rgb and are
+uploaded with the rest of the filesystem image (pio run -t uploadfs).
+
+Runs automatically before each PlatformIO build (extra_scripts = pre:...),
+or by hand:  python scripts/build_avatars.py
+
+@author Screen Time Tracker
+@version 1.0
+"""
+
+import math
+import os
+import re
+import struct
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+
+AVATAR_DIR = os.path.join(PROJECT_DIR, "data", "avatars")
+MANIFEST_PATH = os.path.join(PROJECT_DIR, "include", "avatar_manifest.h")
+CONFIG_PATH = os.path.join(PROJECT_DIR, "include", "config.h")
+SCREENS_DIR = os.path.join(PROJECT_DIR, "include", "screens")
+
+BLOB_EXTENSION = ".rgb"
+
+
+# ============================================================================
+# Configuration parsing
+# ============================================================================
+
+def read_text(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return f.read()
+
+
+def find_radii():
+    """Collect every avatar radius constant used by the UI."""
+    sources = [CONFIG_PATH]
+    sources += [os.path.join(SCREENS_DIR, n) for n in sorted(os.listdir(SCREENS_DIR)) if n.endswith(".h")]
+
+    radii = set()
+    for path in sources:
+        for match in re.finditer(r"\bAVATAR_(?:LARGE_)?RADIUS\s*=\s*(\d+)\s*;", read_text(path)):
+            radii.add(int(match.group(1)))
+
+    if not radii:
+        raise RuntimeError("No AVATAR_RADIUS constants found")
+    return sorted(radii)
+
+
+def find_avatar_primary():
+    """Read COLOR_AVATAR_PRIMARY (RGB565) from config.h and expand to RGB888."""
+    match = re.search(r"COLOR_AVATAR_PRIMARY\s*=\s*(0x[0-9A-Fa-f]+)", read_text(CONFIG_PATH))
+    if not match:
+        raise RuntimeError("COLOR_AVATAR_PRIMARY not found in config.h")
+
+    value = int(match.group(1), 16)
+    r = (value >> 11) & 0x1F
+    g = (value >> 5) & 0x3F
+    b = value & 0x1F
+    return (r * 255 // 31, g * 255 // 63, b * 255 // 31)
+
+
+# ============================================================================
+# Circle geometry
+# ============================================================================
+
+def circle_spans(radius):
+    """Half-width of the circle for each row, top (dy = -r) to bottom (dy = +r).
+
+    Uses the same inclusion test as a midpoint circle fill (x^2 + y^2 <= r^2 + r)
+    so the masked avatar meets the status ring drawn at radius + 1.
+    """
+    limit = radius * radius + radius
+    return [math.isqrt(limit - dy * dy) if dy * dy <= limit else 0
+            for dy in range(-radius, radius + 1)]
+
+
+def span_pixel_count(spans):
+    return sum(2 * hw + 1 for hw in spans)
+
+
+# ============================================================================
+# Conversion
+# ============================================================================
+
+def to_rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def convert(image_module, png_path, blob_path, radius, spans, background):
+    Image = image_module
+    size = radius * 2 + 1
+
+    source = Image.open(png_path).convert("RGBA")
+    if source.size != (radius * 2, radius * 2):
+        source = source.resize((radius * 2, radius * 2), Image.LANCZOS)
+
+    # Same placement as the old drawPng path: image top-left at (cx - r, cy - r)
+    canvas = Image.new("RGBA", (size, size), background + (255,))
+    canvas.alpha_composite(source, (0, 0))
+    pixels = canvas.load()
+
+    out = bytearray()
+    for row, hw in enumerate(spans):
+        for x in range(radius - hw, radius + hw + 1):
+            r, g, b, _ = pixels[x, row]
+            out += struct.pack("<H", to_rgb565(r, g, b))
+
+    with open(blob_path, "wb") as f:
+        f.write(out)
+    return len(out)
+
+
+def load_pillow():
+    try:
+        from PIL import Image
+        return Image
+    except ImportError:
+        if env is None:
+            raise RuntimeError("Pillow is required: pip install pillow")
+        env.Execute("$PYTHONEXE -m pip install pillow")  # noqa: F821
+        from PIL import Image
+        return Image
+
+
+# ============================================================================
+# Manifest
+# ============================================================================
+
+def write_manifest(names, radii, background):
+    lines = [
+        "/**",
+        " * avatar_manifest.h - Generated avatar blob manifest",
+        " *",
+        " * GENERATED by scripts/build_avatars.py - do not edit by hand.",
+        " *",
+        " * Lists the avatars converted to circle-masked RGB565 blobs and the",
+        " * per-row circle span tables used to blit them.",
+        " *",
+        " * @author Screen Time Tracker",
+        " * @version 1.0",
+        " */",
+        "",
+        "#ifndef AVATAR_MANIFEST_H",
+        "#define AVATAR_MANIFEST_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "// Blob files: /avatars/<name>_r<radius>" + BLOB_EXTENSION,
+        "constexpr const char* AVATAR_BLOB_EXTENSION = \"%s\";" % BLOB_EXTENSION,
+        "",
+        "// Background the PNGs were composited over (COLOR_AVATAR_PRIMARY)",
+        "constexpr uint16_t AVATAR_BLOB_BACKGROUND = 0x%04X;" % to_rgb565(*background),
+        "",
+        "// ============================================================================",
+        "// Circle span tables (half-width per row, dy = -r .. +r)",
+        "// ============================================================================",
+        "",
+    ]
+
+    for radius in radii:
+        spans = circle_spans(radius)
+        lines.append("constexpr uint8_t AVATAR_SPANS_R%d[%d] = {" % (radius, len(spans)))
+        for i in range(0, len(spans), 16):
+            lines.append("    " + ", ".join(str(v) for v in spans[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines += [
+        "/**",
+        " * AvatarBlobShape - Circle geometry of one blob radius",
+        " */",
+        "struct AvatarBlobShape {",
+        "    int16_t radius;",
+        "    const uint8_t* spans;       // radius * 2 + 1 entries",
+        "    uint32_t pixelCount;        // Pixels stored in each blob",
+        "};",
+        "",
+        "constexpr int AVATAR_BLOB_SHAPE_COUNT = %d;" % len(radii),
+        "constexpr AvatarBlobShape AVATAR_BLOB_SHAPES[AVATAR_BLOB_SHAPE_COUNT] = {",
+    ]
+    for radius in radii:
+        lines.append("    { %d, AVATAR_SPANS_R%d, %d }," % (radius, radius, span_pixel_count(circle_spans(radius))))
+    lines += [
+        "};",
+        "",
+        "// ============================================================================",
+        "// Available avatars (name without extension)",
+        "// ============================================================================",
+        "",
+        "constexpr int AVATAR_BLOB_NAME_COUNT = %d;" % len(names),
+        "constexpr const char* AVATAR_BLOB_NAMES[AVATAR_BLOB_NAME_COUNT] = {",
+    ]
+    for name in names:
+        lines.append("    \"%s\"," % name)
+    lines += [
+        "};",
+        "",
+        "#endif // AVATAR_MANIFEST_H",
+        "",
+    ]
+
+    content = "\n".join(lines)
+    if os.path.exists(MANIFEST_PATH) and read_text(MANIFEST_PATH) == content:
+        return False
+    with open(MANIFEST_PATH, "w", encoding="utf-8", newline="\n") as f:
+        f.write(content)
+    return True
+
+
+# ============================================================================
+# Entry point
+# ============================================================================
+
+def build():
+    radii = find_radii()
+    background = find_avatar_primary()
+    names = sorted(os.path.splitext(n)[0] for n in os.listdir(AVATAR_DIR) if n.lower().endswith(".png"))
+
+    image_module = None
+    converted = 0
+    total_png = 0
+    total_blob = 0
+
+    for name in names:
+        png_path = os.path.join(AVATAR_DIR, name + ".png")
+        total_png += os.path.getsize(png_path)
+
+        for radius in radii:
+            blob_path = os.path.join(AVATAR_DIR, "%s_r%d%s" % (name, radius, BLOB_EXTENSION))
+            expected = span_pixel_count(circle_spans(radius)) * 2
+
+            # Skip blobs that are newer than their PNG and the right size
+            if (os.path.exists(blob_path)
+                    and os.path.getmtime(blob_path) >= os.path.getmtime(png_path)
+                    and os.path.getsize(blob_path) == expected):
+                total_blob += expected
+                continue
+
+            if image_module is None:
+                image_module = load_pillow()
+            total_blob += convert(image_module, png_path, blob_path, radius, circle_spans(radius), background)
+            converted += 1
+
+    manifest_changed = write_manifest(names, radii, background)
+
+    print("[build_avatars] %d avatars, radii %s: %d blobs converted, PNG %d bytes -> blobs %d bytes%s"
+          % (len(names), radii, converted, total_png, total_blob,
+             ", manifest updated" if manifest_changed else ""))
+
+
+build()
@@ -0,0 +1,299 @@
+"""
+build_fonts.py - Build-time font subsetting for Screen Time Tracker
+
+Emits a subsetted copy of each font whose text is fixed at compile time
+(SUBSETS below), carrying only the glyphs actually rendered, and lists the
+other fonts referenced from src/ and include/:
+
+- FreeSansBold24pt7b draws the countdown only: the timer atlas glyphs
+  (TIMER_ATLAS_GLYPHS in src/ui.cpp) and whatever UI::formatTime() can
+  print besides its numeric conversions ("LOTS!").
+- Every other font prints runtime text (names, messages, notifications) and
+  keeps its full range; they are listed in the build output.
+
+A subset keeps the GFXfont layout LovyanGFX already uses: glyphs are looked
+up by direct index (glyph[c - first]), with the range narrowed to the first
+and last needed character. Characters inside the range that are never drawn
+keep an empty entry so the index stays direct; their bitmaps are dropped.
+
+The glyph data is read from the GFXFF font headers of the M5GFX library
+installed by PlatformIO (.pio/libdeps/<env>/M5GFX). include/font_subsets_data.h
+is regenerated from them; it is not committed (see .gitignore). Until the
+library is installed, no header is written and the firmware falls back to
+the full fonts (see font_subsets.h). Once it is installed, a SUBSETS font
+that cannot be subsetted fails the build instead of silently falling back.
+
+Runs automatically before each PlatformIO build (extra_scripts = pre:...),
+or by hand:  python scripts/build_fonts.py
+
+@author Screen Time Tracker
+@version 1.0
+"""
+
+import glob
+import os
+import re
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+    LIBDEPS_DIRS = [os.path.join(env["PROJECT_LIBDEPS_DIR"], env["PIOENV"])]  # noqa: F821
+except NameError:
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+    LIBDEPS_DIRS = []
+
+SRC_DIR = os.path.join(PROJECT_DIR, "src")
+SCAN_DIRS = [SRC_DIR, os.path.join(PROJECT_DIR, "include")]
+UI_PATH = os.path.join(SRC_DIR, "ui.cpp")
+SUBSETS_PATH = os.path.join(PROJECT_DIR, "include", "font_subsets_data.h")
+
+LIBDEPS_DIRS += sorted(glob.glob(os.path.join(PROJECT_DIR, ".pio", "libdeps", "*")))
+
+# Size of lgfx::GFXglyph (uint32_t offset + 5 bytes, padded)
+GLYPH_BYTES = 12
+
+
+# ============================================================================
+# Source scanning
+# ============================================================================
+
+def read_text(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return f.read()
+
+
+def find_used_fonts():
+    """Every fonts::Name referenced from src/ and include/."""
+    used = set()
+    for scan_dir in SCAN_DIRS:
+        for root, _, files in os.walk(scan_dir):
+            for name in files:
+                # The generated header names the subsets, not the fonts in use
+                if name.endswith((".cpp", ".h")) and os.path.join(root, name) != SUBSETS_PATH:
+                    used.update(re.findall(r"fonts::(\w+)", read_text(os.path.join(root, name))))
+    return sorted(used)
+
+
+def function_body(source, signature):
+    """Text of the function starting at signature, up to its closing brace."""
+    start = source.find(signature)
+    if start < 0:
+        sys.exit("[build_fonts] %s not found" % signature)
+    depth = 0
+    for i in range(source.index("{", start), len(source)):
+        if source[i] == "{":
+            depth += 1
+        elif source[i] == "}":
+            depth -= 1
+            if depth == 0:
+                return source[start:i]
+    return source[start:]
+
+
+def timer_charset():
+    """Characters the countdown font can render."""
+    ui = read_text(UI_PATH)
+    match = re.search(r"TIMER_ATLAS_GLYPHS\s*=\s*\"([^\"]*)\"", ui)
+    if not match:
+        sys.exit("[build_fonts] TIMER_ATLAS_GLYPHS not found in src/ui.cpp")
+    chars = set(match.group(1))
+
+    # Literal text of formatTime()'s output, without the printf conversions
+    # (numeric conversions only ever produce digits)
+    body = function_body(ui, "void UI::formatTime(")
+    for call in re.findall(r"snprintf\([^;]*?\"((?:[^\"\\]|\\.)*)\"", body):
+        chars.update(re.sub(r"%[-0 #+]*\d*(?:hh|h|ll|l)?[diuxX]", "", call))
+    return "".join(sorted(chars))
+
+
+# Fonts whose text is known at build time: name -> charset function
+SUBSETS = {
+    "FreeSansBold24pt7b": timer_charset,
+}
+
+
+# ============================================================================
+# GFXFF parsing
+# ============================================================================
+
+def find_m5gfx():
+    """M5GFX library directory, or None until PlatformIO has installed it."""
+    for libdeps in LIBDEPS_DIRS:
+        matches = glob.glob(os.path.join(libdeps, "M5GFX*", "src", "lgfx"))
+        if matches:
+            return os.path.dirname(os.path.dirname(matches[0]))
+    return None
+
+
+def find_font_source(name):
+    for libdeps in LIBDEPS_DIRS:
+        matches = glob.glob(os.path.join(libdeps, "*", "src", "lgfx", "Fonts", "GFXFF", name + ".h"))
+        if matches:
+            return matches[0]
+    return None
+
+
+def parse_gfxfont(path, name):
+    text = read_text(path)
+
+    match = re.search(name + r"Bitmaps\[\][^{]*\{(.*?)\};", text, re.S)
+    bitmaps = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", match.group(1))]
+
+    match = re.search(name + r"Glyphs\[\][^{]*\{(.*?)\};", text, re.S)
+    glyphs = [tuple(int(v) for v in g) for g in re.findall(
+        r"\{\s*(\d+),\s*(\d+),\s*(\d+),\s*(\d+),\s*(-?\d+),\s*(-?\d+)\s*\}", match.group(1))]
+
+    match = re.search(r"GFXfont\s+" + name + r"\b[^{]*\{[^}]*?(0x[0-9A-Fa-f]+),\s*(0x[0-9A-Fa-f]+),\s*(\d+)\s*\}",
+                      text, re.S)
+    first, last, y_advance = int(match.group(1), 16), int(match.group(2), 16), int(match.group(3))
+
+    if len(glyphs) != last - first + 1:
+        sys.exit("[build_fonts] %s: %d glyphs for range 0x%02X-0x%02X" % (name, len(glyphs), first, last))
+    return bitmaps, glyphs, first, last, y_advance
+
+
+def subset_font(name, charset, source):
+    bitmaps, glyphs, first, last, y_advance = parse_gfxfont(source, name)
+
+    codes = sorted(ord(c) for c in charset if first <= ord(c) <= last)
+    missing = [c for c in charset if not first <= ord(c) <= last]
+    if missing:
+        sys.exit("[build_fonts] %s has no glyph for %r" % (name, "".join(missing)))
+
+    sub_first, sub_last = codes[0], codes[-1]
+    sub_bitmaps = []
+    sub_glyphs = []
+    for code in range(sub_first, sub_last + 1):
+        offset, width, height, x_advance, x_offset, y_offset = glyphs[code - first]
+        if code in codes:
+            length = (width * height + 7) // 8
+            sub_glyphs.append((len(sub_bitmaps), width, height, x_advance, x_offset, y_offset, code))
+            sub_bitmaps += bitmaps[offset:offset + length]
+        else:
+            # Never drawn - keep the slot so lookup stays glyph[c - first]
+            sub_glyphs.append((0, 0, 0, 0, 0, 0, code))
+
+    full_bytes = len(bitmaps) + len(glyphs) * GLYPH_BYTES
+    sub_bytes = len(sub_bitmaps) + len(sub_glyphs) * GLYPH_BYTES
+    return {
+        "name": name,
+        "charset": charset,
+        "bitmaps": sub_bitmaps,
+        "glyphs": sub_glyphs,
+        "first": sub_first,
+        "last": sub_last,
+        "y_advance": y_advance,
+        "full_glyphs": len(glyphs),
+        "full_bytes": full_bytes,
+        "sub_bytes": sub_bytes,
+    }
+
+
+# ============================================================================
+# Header generation
+# ============================================================================
+
+def glyph_comment(code):
+    char = chr(code)
+    return "0x%02X '%s'" % (code, char) if char not in "\\'" else "0x%02X" % code
+
+
+def write_subsets(subsets):
+    lines = [
+        "/**",
+        " * font_subsets_data.h - Subsetted GFX fonts",
+        " *",
+        " * GENERATED by scripts/build_fonts.py - do not edit by hand.",
+        " * Glyph data copied from the M5GFX GFXFF fonts, reduced to the",
+        " * characters the firmware renders with each font.",
+        " *",
+        " * @author Screen Time Tracker",
+        " * @version 1.0",
+        " */",
+        "",
+        "#ifndef FONT_SUBSETS_DATA_H",
+        "#define FONT_SUBSETS_DATA_H",
+        "",
+        "#include <M5GFX.h>",
+        "",
+        "namespace font_subsets {",
+    ]
+    for font in subsets:
+        name = font["name"]
+        lines += [
+            "",
+            "// %s: \"%s\" (%d of %d glyphs, %d -> %d bytes)" % (
+                name, font["charset"], len(font["charset"]), font["full_glyphs"],
+                font["full_bytes"], font["sub_bytes"]),
+            "const uint8_t %sBitmaps[] PROGMEM = {" % name,
+        ]
+        bitmaps = font["bitmaps"]
+        for i in range(0, len(bitmaps), 12):
+            lines.append("    " + ", ".join("0x%02X" % v for v in bitmaps[i:i + 12]) + ",")
+        lines += [
+            "};",
+            "",
+            "const lgfx::GFXglyph %sGlyphs[] PROGMEM = {" % name,
+        ]
+        for offset, width, height, x_advance, x_offset, y_offset, code in font["glyphs"]:
+            lines.append("    { %5d, %3d, %3d, %3d, %4d, %4d },  // %s" % (
+                offset, width, height, x_advance, x_offset, y_offset, glyph_comment(code)))
+        lines += [
+            "};",
+            "",
+            "const lgfx::GFXfont %s PROGMEM = {" % name,
+            "    (uint8_t *)%sBitmaps," % name,
+            "    (lgfx::GFXglyph *)%sGlyphs," % name,
+            "    0x%02X, 0x%02X, %d" % (font["first"], font["last"], font["y_advance"]),
+            "};",
+        ]
+    lines += [
+        "",
+        "}  // namespace font_subsets",
+        "",
+        "#endif // FONT_SUBSETS_DATA_H",
+        "",
+    ]
+
+    content = "\n".join(lines)
+    if os.path.exists(SUBSETS_PATH) and read_text(SUBSETS_PATH) == content:
+        return False
+    with open(SUBSETS_PATH, "w", encoding="utf-8", newline="\n") as f:
+        f.write(content)
+    return True
+
+
+# ============================================================================
+# Entry point
+# ============================================================================
+
+def build():
+    for name in find_used_fonts():
+        if name not in SUBSETS:
+            print("[build_fonts] %s: full range (renders runtime text)" % name)
+
+    # Subset every SUBSETS font: font_subsets.h refers to them, so they are
+    # in use whether or not a fonts:: reference is left to scan for
+    if find_m5gfx() is None:
+        print("[build_fonts] M5GFX not installed yet - using the full fonts")
+        return
+
+    subsets = []
+    for name in sorted(SUBSETS):
+        source = find_font_source(name)
+        if source is None:
+            sys.exit("[build_fonts] %s: no GFXFF source in the installed M5GFX" % name)
+
+        font = subset_font(name, SUBSETS[name](), source)
+        subsets.append(font)
+        print("[build_fonts] %s: \"%s\" -> %d of %d glyph slots, 0x%02X-0x%02X, %d -> %d bytes flash"
+              % (name, font["charset"], len(font["glyphs"]), font["full_glyphs"],
+                 font["first"], font["last"], font["full_bytes"], font["sub_bytes"]))
+
+    if write_subsets(subsets):
+        print("[build_fonts] %s updated" % os.path.relpath(SUBSETS_PATH, PROJECT_DIR))
+
+
+build()
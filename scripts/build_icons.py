@@ -0,0 +1,392 @@
+"""
+build_icons.py - Build-time icon atlas for Screen Time Tracker
+
+Rasterizes the small UI icons that used to be drawn from primitives on every
+frame (header logo, Wi-Fi triangle per network status, battery bars per
+level, pagination chevrons) into one run-length encoded RGB565 atlas:
+
+- Each icon is drawn here with the same primitives the firmware used
+  (fillRect, fillTriangle, drawLine, Font0 glyphs), over the background it
+  is always shown on, so a blit fully replaces its bounding box.
+- Colors are read from include/config.h and collected into one palette
+  (at most 16 entries).
+- Pixels are stored in raster order as one byte per run: palette index in
+  the high nibble, run length - 1 in the low nibble. The blitter opens an
+  address window and streams each run with writeColor(), so an icon costs
+  one window and a few dozen runs instead of per-pixel or per-line calls.
+
+include/icon_atlas_data.h is regenerated with the palette, the run table and
+the Icon enum. The atlas lives in flash; nothing is uploaded to the
+filesystem.
+
+Runs automatically before each PlatformIO build (extra_scripts = pre:...),
+or by hand:  python scripts/build_icons.py
+
+@author Screen Time Tracker
+@version 1.0
+"""
+
+import os
+import re
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+
+CONFIG_PATH = os.path.join(PROJECT_DIR, "include", "config.h")
+ATLAS_PATH = os.path.join(PROJECT_DIR, "include", "icon_atlas_data.h")
+
+MAX_PALETTE = 16
+MAX_RUN = 16
+
+# Font0 (5x7 GLCD) glyphs used on the Wi-Fi indicator, one byte per column,
+# bit 0 = top row
+FONT0_GLYPHS = {
+    "-": (0x08, 0x08, 0x08, 0x08, 0x08),
+    "/": (0x20, 0x10, 0x08, 0x04, 0x02),
+    "O": (0x3E, 0x41, 0x41, 0x41, 0x3E),
+    "!": (0x00, 0x00, 0x5F, 0x00, 0x00),
+}
+
+
+# ============================================================================
+# Configuration parsing
+# ============================================================================
+
+def read_text(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return f.read()
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def find_colors():
+    """Read every COLOR_* constant (hex or RGB565(r, g, b)) from config.h."""
+    colors = {}
+    pattern = r"constexpr\s+uint16_t\s+(COLOR_\w+)\s*=\s*([^;]+);"
+    for name, value in re.findall(pattern, read_text(CONFIG_PATH)):
+        value = value.strip()
+        match = re.match(r"RGB565\(\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*\)", value)
+        if match:
+            colors[name] = rgb565(*(int(v) for v in match.groups()))
+        elif re.match(r"0x[0-9A-Fa-f]+$", value):
+            colors[name] = int(value, 16)
+    return colors
+
+
+# ============================================================================
+# Rasterizer (mirrors the LovyanGFX primitives the icons replaced)
+# ============================================================================
+
+class Bitmap:
+    def __init__(self, width, height, background):
+        self.width = width
+        self.height = height
+        self.pixels = [[background] * width for _ in range(height)]
+
+    def pixel(self, x, y, color):
+        if 0 <= x < self.width and 0 <= y < self.height:
+            self.pixels[y][x] = color
+
+    def fill_rect(self, x, y, w, h, color):
+        for yy in range(y, y + h):
+            for xx in range(x, x + w):
+                self.pixel(xx, yy, color)
+
+    def hline(self, x, y, w, color):
+        self.fill_rect(x, y, w, 1, color)
+
+    def line(self, x0, y0, x1, y1, color):
+        """Bresenham line, endpoints included."""
+        dx = abs(x1 - x0)
+        dy = -abs(y1 - y0)
+        sx = 1 if x0 < x1 else -1
+        sy = 1 if y0 < y1 else -1
+        err = dx + dy
+        while True:
+            self.pixel(x0, y0, color)
+            if x0 == x1 and y0 == y1:
+                break
+            e2 = 2 * err
+            if e2 >= dy:
+                err += dy
+                x0 += sx
+            if e2 <= dx:
+                err += dx
+                y0 += sy
+
+    def fill_triangle(self, x0, y0, x1, y1, x2, y2, color):
+        """Scanline triangle fill (Adafruit GFX ordering and rounding)."""
+        if y0 > y1:
+            x0, y0, x1, y1 = x1, y1, x0, y0
+        if y1 > y2:
+            x1, y1, x2, y2 = x2, y2, x1, y1
+        if y0 > y1:
+            x0, y0, x1, y1 = x1, y1, x0, y0
+
+        if y0 == y2:
+            a = min(x0, x1, x2)
+            b = max(x0, x1, x2)
+            self.hline(a, y0, b - a + 1, color)
+            return
+
+        def cdiv(n, d):
+            # C integer division (truncates toward zero)
+            q = abs(n) // abs(d)
+            return q if (n >= 0) == (d > 0) else -q
+
+        dx01, dy01 = x1 - x0, y1 - y0
+        dx02, dy02 = x2 - x0, y2 - y0
+        dx12, dy12 = x2 - x1, y2 - y1
+        sa = sb = 0
+
+        last = y1 if y1 == y2 else y1 - 1
+        y = y0
+        while y <= last:
+            a = x0 + cdiv(sa, dy01)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx01
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.hline(a, y, b - a + 1, color)
+            y += 1
+
+        sa = dx12 * (y - y1)
+        sb = dx02 * (y - y0)
+        while y <= y2:
+            a = x1 + cdiv(sa, dy12)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx12
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.hline(a, y, b - a + 1, color)
+            y += 1
+
+    def glyph(self, char, x, y, color):
+        """Font0 glyph with a transparent background."""
+        for col, bits in enumerate(FONT0_GLYPHS[char]):
+            for row in range(8):
+                if bits & (1 << row):
+                    self.pixel(x + col, y + row, color)
+
+
+# ============================================================================
+# Icons
+# ============================================================================
+
+def build_logo(c):
+    # 22x14 rounded rectangle (radius 2 leaves only the corner pixels out)
+    bmp = Bitmap(22, 14, c["COLOR_HEADER_BG"])
+    bmp.fill_rect(0, 0, 22, 14, c["COLOR_TEXT_PRIMARY"])
+    for x, y in ((0, 0), (21, 0), (0, 13), (21, 13)):
+        bmp.pixel(x, y, c["COLOR_HEADER_BG"])
+
+    # Closed eyes (upward arcs) and mouth
+    eyes = 0x4208
+    eye_y = 3
+    for i in range(-2, 3):
+        offset = 2 - (i * i) // 2
+        for eye_x in (6, 16):
+            bmp.pixel(eye_x + i, eye_y + offset, eyes)
+            bmp.pixel(eye_x + i, eye_y + offset + 1, eyes)
+    bmp.line(8, eye_y + 6, 14, eye_y + 6, eyes)
+    bmp.line(8, eye_y + 7, 14, eye_y + 7, eyes)
+    return bmp
+
+
+def build_wifi(c, color_name, status_char):
+    # Triangle pointing down (24 wide, 16 tall, endpoints inclusive)
+    bmp = Bitmap(25, 17, c["COLOR_HEADER_BG"])
+    bmp.fill_triangle(0, 0, 24, 0, 12, 16, c[color_name])
+    # Status character centered near the top (Font0 advance is 6px)
+    bmp.glyph(status_char, (24 - 6) // 2, 2, c["COLOR_HEADER_BG"])
+    return bmp
+
+
+def build_battery(c, bars_lit):
+    # Four 12x3 bars with 1px gaps, bottom bars lit first
+    bmp = Bitmap(12, 15, c["COLOR_HEADER_BG"])
+    for i in range(4):
+        bar_index = 3 - i
+        color = 0xFFFF if bar_index < bars_lit else 0x4208
+        bmp.fill_rect(0, i * 4, 12, 3, color)
+    return bmp
+
+
+def build_chevron(c, pointing_left):
+    # SelectChildScreen pagination: two 10px diagonals, doubled 1px down
+    bmp = Bitmap(11, 22, c["COLOR_BACKGROUND"])
+    color = c["COLOR_TEXT_SECONDARY"]
+    tip, tail = (0, 10) if pointing_left else (10, 0)
+    for offset in (0, 1):
+        bmp.line(tail, offset, tip, 10 + offset, color)
+        bmp.line(tip, 10 + offset, tail, 20 + offset, color)
+    return bmp
+
+
+def build_chevron_large(c, pointing_left):
+    # BrightnessScreen arrows: two 12px diagonals, doubled 1px right
+    bmp = Bitmap(14, 25, c["COLOR_BACKGROUND"])
+    color = c["COLOR_ACCENT_PRIMARY"]
+    tip, tail = (0, 12) if pointing_left else (12, 0)
+    for offset in (0, 1):
+        bmp.line(tail + offset, 0, tip + offset, 12, color)
+        bmp.line(tip + offset, 12, tail + offset, 24, color)
+    return bmp
+
+
+def build_icons(c):
+    """(enum name, bitmap) in Icon enum order."""
+    return [
+        ("LOGO", build_logo(c)),
+        ("WIFI_DISCONNECTED", build_wifi(c, "COLOR_TEXT_MUTED", "-")),
+        ("WIFI_CONNECTING", build_wifi(c, "COLOR_ACCENT_WARNING", "/")),
+        ("WIFI_CONNECTED", build_wifi(c, "COLOR_ACCENT_SUCCESS", "O")),
+        ("WIFI_ERROR", build_wifi(c, "COLOR_ACCENT_DANGER", "!")),
+        ("BATTERY_0", build_battery(c, 0)),
+        ("BATTERY_1", build_battery(c, 1)),
+        ("BATTERY_2", build_battery(c, 2)),
+        ("BATTERY_3", build_battery(c, 3)),
+        ("BATTERY_4", build_battery(c, 4)),
+        ("CHEVRON_LEFT", build_chevron(c, True)),
+        ("CHEVRON_RIGHT", build_chevron(c, False)),
+        ("CHEVRON_LARGE_LEFT", build_chevron_large(c, True)),
+        ("CHEVRON_LARGE_RIGHT", build_chevron_large(c, False)),
+    ]
+
+
+# ============================================================================
+# Encoding
+# ============================================================================
+
+def encode(bitmap, palette):
+    """Raster-order runs: (palette index << 4) | (length - 1)."""
+    out = bytearray()
+    flat = [color for row in bitmap.pixels for color in row]
+    i = 0
+    while i < len(flat):
+        color = flat[i]
+        length = 1
+        while i + length < len(flat) and flat[i + length] == color and length < MAX_RUN:
+            length += 1
+        if color not in palette:
+            palette.append(color)
+            if len(palette) > MAX_PALETTE:
+                raise RuntimeError("Icon atlas needs more than %d colors" % MAX_PALETTE)
+        out.append((palette.index(color) << 4) | (length - 1))
+        i += length
+    return out
+
+
+# ============================================================================
+# Atlas header
+# ============================================================================
+
+def write_atlas(icons, palette, runs, entries):
+    lines = [
+        "/**",
+        " * icon_atlas_data.h - Generated icon atlas",
+        " *",
+        " * GENERATED by scripts/build_icons.py - do not edit by hand.",
+        " *",
+        " * Run-length encoded RGB565 icons: one byte per run, palette index in",
+        " * the high nibble, run length - 1 in the low nibble, in raster order.",
+        " *",
+        " * @author Screen Time Tracker",
+        " * @version 1.0",
+        " */",
+        "",
+        "#ifndef ICON_ATLAS_DATA_H",
+        "#define ICON_ATLAS_DATA_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "/**",
+        " * Icon - Atlas entries",
+        " */",
+        "enum class Icon : uint8_t {",
+    ]
+    for name, _ in icons:
+        lines.append("    %s," % name)
+    lines += [
+        "    COUNT",
+        "};",
+        "",
+        "/**",
+        " * IconAtlasEntry - Size and run range of one icon",
+        " */",
+        "struct IconAtlasEntry {",
+        "    uint8_t width;",
+        "    uint8_t height;",
+        "    uint16_t firstRun;          // Index into ICON_ATLAS_RUNS",
+        "    uint16_t runCount;",
+        "};",
+        "",
+        "constexpr int ICON_ATLAS_PALETTE_SIZE = %d;" % len(palette),
+        "constexpr uint16_t ICON_ATLAS_PALETTE[ICON_ATLAS_PALETTE_SIZE] = {",
+    ]
+    for i in range(0, len(palette), 8):
+        lines.append("    " + ", ".join("0x%04X" % v for v in palette[i:i + 8]) + ",")
+    lines += [
+        "};",
+        "",
+        "constexpr IconAtlasEntry ICON_ATLAS_ENTRIES[(int)Icon::COUNT] = {",
+    ]
+    for (name, bitmap), (first, count) in zip(icons, entries):
+        lines.append("    { %d, %d, %d, %d },  // %s" % (bitmap.width, bitmap.height, first, count, name))
+    lines += [
+        "};",
+        "",
+        "constexpr int ICON_ATLAS_RUN_COUNT = %d;" % len(runs),
+        "constexpr uint8_t ICON_ATLAS_RUNS[ICON_ATLAS_RUN_COUNT] = {",
+    ]
+    for i in range(0, len(runs), 16):
+        lines.append("    " + ", ".join("0x%02X" % v for v in runs[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        "#endif // ICON_ATLAS_DATA_H",
+        "",
+    ]
+
+    content = "\n".join(lines)
+    if os.path.exists(ATLAS_PATH) and read_text(ATLAS_PATH) == content:
+        return False
+    with open(ATLAS_PATH, "w", encoding="utf-8", newline="\n") as f:
+        f.write(content)
+    return True
+
+
+# ============================================================================
+# Entry point
+# ============================================================================
+
+def build():
+    icons = build_icons(find_colors())
+
+    palette = []
+    runs = bytearray()
+    entries = []
+    raw_bytes = 0
+    for _, bitmap in icons:
+        encoded = encode(bitmap, palette)
+        entries.append((len(runs), len(encoded)))
+        runs += encoded
+        raw_bytes += bitmap.width * bitmap.height * 2
+
+    changed = write_atlas(icons, palette, runs, entries)
+
+    print("[build_icons] %d icons, %d colors: RGB565 %d bytes -> RLE %d bytes%s"
+          % (len(icons), len(palette), raw_bytes, len(runs) + len(palette) * 2,
+             ", atlas updated" if changed else ""))
+
+
+build()
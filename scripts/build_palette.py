@@ -0,0 +1,167 @@
+"""
+build_palette.py - Build-time compositor palette for Screen Time Tracker
+
+With COMPOSITOR_PALETTE_8BPP the compositor keeps its framebuffer at one byte
+per pixel. LovyanGFX already converts every draw (fills, text, pushImage,
+pushSprite from RGB565 sprites) to RGB332 when the target sprite is 8-bit, so
+drawing code stays unchanged; this script generates the table flush() uses to
+expand each byte back to RGB565 on its way to the panel.
+
+- Every RGB332 slot defaults to the color LovyanGFX itself would expand it
+  to (bits replicated), so avatars and other images keep a usable 256-color
+  rendering.
+- Each COLOR_* constant in include/config.h overrides the slot it converts
+  to, so UI colors reach the panel exactly as defined. When two constants
+  share a slot the first one in config.h wins; the clashes are reported (they
+  are near-identical shades by construction of RGB332).
+
+include/palette_data.h is regenerated with the 256-entry table. It is only
+compiled in with COMPOSITOR_PALETTE_8BPP.
+
+Runs automatically before each PlatformIO build (extra_scripts = pre:...),
+or by hand:  python scripts/build_palette.py
+
+@author Screen Time Tracker
+@version 1.0
+"""
+
+import os
+import re
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0])))
+
+CONFIG_PATH = os.path.join(PROJECT_DIR, "include", "config.h")
+PALETTE_PATH = os.path.join(PROJECT_DIR, "include", "palette_data.h")
+
+
+# ============================================================================
+# Configuration parsing
+# ============================================================================
+
+def read_text(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return f.read()
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def find_colors():
+    """Read every COLOR_* constant (hex or RGB565(r, g, b)) from config.h, in order."""
+    colors = []
+    pattern = r"constexpr\s+uint16_t\s+(COLOR_\w+)\s*=\s*([^;]+);"
+    for name, value in re.findall(pattern, read_text(CONFIG_PATH)):
+        value = value.strip()
+        match = re.match(r"RGB565\(\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*\)", value)
+        if match:
+            colors.append((name, rgb565(*(int(v) for v in match.groups()))))
+        elif re.match(r"0x[0-9A-Fa-f]+$", value):
+            colors.append((name, int(value, 16)))
+    return colors
+
+
+# ============================================================================
+# Color conversion (mirrors LovyanGFX's RGB565 <-> RGB332 conversions)
+# ============================================================================
+
+def rgb565_to_rgb332(c):
+    return ((c >> 8) & 0xE0) | ((c >> 6) & 0x1C) | ((c >> 3) & 0x03)
+
+
+def rgb332_to_rgb565(i):
+    r3 = (i >> 5) & 0x07
+    g3 = (i >> 2) & 0x07
+    b2 = i & 0x03
+    r = (r3 << 5) | (r3 << 2) | (r3 >> 1)
+    g = (g3 << 5) | (g3 << 2) | (g3 >> 1)
+    b = b2 * 0x55
+    return rgb565(r, g, b)
+
+
+# ============================================================================
+# Header generation
+# ============================================================================
+
+def write_palette(palette, owners, clashes):
+    lines = [
+        "/**",
+        " * palette_data.h - RGB332 -> RGB565 expansion table for the 8bpp compositor",
+        " *",
+        " * GENERATED by scripts/build_palette.py - do not edit by hand.",
+        " * Slots holding a COLOR_* constant from config.h expand to it exactly;",
+        " * every other slot expands the way LovyanGFX would.",
+        " *",
+        " * @author Screen Time Tracker",
+        " * @version 1.0",
+        " */",
+        "",
+        "#ifndef PALETTE_DATA_H",
+        "#define PALETTE_DATA_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "// UI colors placed exactly:",
+    ]
+    for slot in sorted(owners):
+        lines.append("//   0x%02X  %s" % (slot, ", ".join(owners[slot])))
+    if clashes:
+        lines.append("// Sharing a slot (first listed wins):")
+        for clash in clashes:
+            lines.append("//   " + clash)
+    lines += [
+        "",
+        "constexpr int COMPOSITOR_PALETTE_SIZE = 256;",
+        "constexpr uint16_t COMPOSITOR_PALETTE[COMPOSITOR_PALETTE_SIZE] = {",
+    ]
+    for i in range(0, len(palette), 8):
+        lines.append("    " + ", ".join("0x%04X" % v for v in palette[i:i + 8]) + ",")
+    lines += [
+        "};",
+        "",
+        "#endif // PALETTE_DATA_H",
+        "",
+    ]
+
+    content = "\n".join(lines)
+    if os.path.exists(PALETTE_PATH) and read_text(PALETTE_PATH) == content:
+        return False
+    with open(PALETTE_PATH, "w", encoding="utf-8", newline="\n") as f:
+        f.write(content)
+    return True
+
+
+# ============================================================================
+# Entry point
+# ============================================================================
+
+def build():
+    palette = [rgb332_to_rgb565(i) for i in range(256)]
+    owners = {}
+    clashes = []
+
+    for name, color in find_colors():
+        slot = rgb565_to_rgb332(color)
+        if slot not in owners:
+            owners[slot] = [name]
+            palette[slot] = color
+        elif palette[slot] == color:
+            owners[slot].append(name)
+        else:
+            owners[slot].append(name)
+            clashes.append("%s -> %s" % (name, owners[slot][0]))
+
+    changed = write_palette(palette, owners, clashes)
+
+    print("[build_palette] %d UI colors in %d slots (%d clashing): 240x135 framebuffer %d -> %d bytes%s"
+          % (sum(len(v) for v in owners.values()), len(owners), len(clashes),
+             240 * 135 * 2, 240 * 135, ", palette updated" if changed else ""))
+
+
+build()
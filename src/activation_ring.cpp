@@ -0,0 +1,232 @@
+/**
+ * activation_ring.cpp - Incremental activation ring renderer implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "activation_ring.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <math.h>
+
+// Degree of a pixel offset, clockwise from 12 o'clock (screen Y grows down)
+static int degreeOf(int dx, int dy) {
+    float angle = atan2f((float)dx, (float)-dy) * 180.0f / (float)M_PI;
+    if (angle < 0.0f) {
+        angle += 360.0f;
+    }
+    int degree = (int)angle;
+    return degree >= 360 ? 359 : degree;
+}
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+ActivationRing::ActivationRing()
+    : _ready(false)
+    , _drawnDegrees(0)
+    , _drawnColor(-1)
+{
+    memset(_spans, 0, sizeof(_spans));
+    memset(_degreeStart, 0, sizeof(_degreeStart));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool ActivationRing::begin(int innerRadius, int outerRadius) {
+    if (_ready) {
+        return true;
+    }
+
+    // Pixel centers between innerRadius - 0.5 and outerRadius + 0.5
+    const int innerLimit = (2 * innerRadius - 1) * (2 * innerRadius - 1);
+    const int outerLimit = (2 * outerRadius + 1) * (2 * outerRadius + 1);
+
+    // Scratch for the two passes (raster order keeps each degree's runs sorted)
+    static uint16_t spanCount[360];
+    static int8_t lastDx[360];
+    static int8_t lastDy[360];
+
+    // Pass 1: count spans per degree, then pass 2: fill them in
+    for (int pass = 0; pass < 2; pass++) {
+        memset(spanCount, 0, sizeof(spanCount));
+        memset(lastDy, 0x7F, sizeof(lastDy));
+
+        for (int dy = -outerRadius; dy <= outerRadius; dy++) {
+            for (int dx = -outerRadius; dx <= outerRadius; dx++) {
+                int distance = 4 * (dx * dx + dy * dy);
+                if (distance < innerLimit || distance >= outerLimit) {
+                    continue;
+                }
+
+                int degree = degreeOf(dx, dy);
+                bool extends = (spanCount[degree] > 0 && lastDy[degree] == dy &&
+                                lastDx[degree] == dx - 1);
+                lastDx[degree] = (int8_t)dx;
+                lastDy[degree] = (int8_t)dy;
+
+                if (pass == 1) {
+                    if (extends) {
+                        _spans[_degreeStart[degree] + spanCount[degree] - 1].length++;
+                        continue;
+                    }
+                    Span& span = _spans[_degreeStart[degree] + spanCount[degree]];
+                    span.dx = (int8_t)dx;
+                    span.dy = (int8_t)dy;
+                    span.length = 1;
+                } else {
+                    _stats.ringPixels++;
+                }
+
+                if (!extends) {
+                    spanCount[degree]++;
+                }
+            }
+        }
+
+        if (pass == 0) {
+            // Prefix sums give each degree its slice of the table
+            uint32_t total = 0;
+            for (int d = 0; d < 360; d++) {
+                _degreeStart[d] = (uint16_t)total;
+                total += spanCount[d];
+            }
+            _degreeStart[360] = (uint16_t)total;
+
+            if (total > (uint32_t)ACTIVATION_RING_MAX_SPANS) {
+                Serial.printf("[ActivationRing] Span table too small (%lu spans)\n",
+                              (unsigned long)total);
+                return false;
+            }
+            _stats.spanCount = (uint16_t)total;
+        }
+    }
+
+    _ready = true;
+    Serial.printf("[ActivationRing] %u spans, %lu pixels (r%d-%d)\n",
+                  (unsigned)_stats.spanCount, (unsigned long)_stats.ringPixels,
+                  innerRadius, outerRadius);
+    return true;
+}
+
+void ActivationRing::invalidate() {
+    _drawnDegrees = 0;
+    _drawnColor = -1;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+bool ActivationRing::update(lgfx::LovyanGFX& gfx, int centerX, int centerY,
+                            int degrees, uint16_t color, uint16_t background,
+                            DirtyRect& touched) {
+    if (!_ready) {
+        return false;
+    }
+
+    if (degrees < 0) {
+        degrees = 0;
+    } else if (degrees > 360) {
+        degrees = 360;
+    }
+
+    int minX = INT16_MAX, minY = INT16_MAX, maxX = INT16_MIN, maxY = INT16_MIN;
+    uint32_t pixels = 0;
+
+    if (_drawnColor != (int32_t)color) {
+        // Color changed (or nothing known): repaint the whole visible arc
+        if (degrees > 0) {
+            pixels += fillDegrees(gfx, centerX, centerY, 0, degrees, color,
+                                  minX, minY, maxX, maxY);
+        }
+    } else if (degrees > _drawnDegrees) {
+        pixels += fillDegrees(gfx, centerX, centerY, _drawnDegrees, degrees, color,
+                              minX, minY, maxX, maxY);
+    }
+
+    // Erase only the slice given up since the last frame
+    if (degrees < _drawnDegrees) {
+        pixels += fillDegrees(gfx, centerX, centerY, degrees, _drawnDegrees, background,
+                              minX, minY, maxX, maxY);
+    }
+
+    _drawnDegrees = (int16_t)degrees;
+    _drawnColor = (degrees > 0) ? (int32_t)color : -1;
+
+    if (pixels == 0) {
+        return false;
+    }
+
+    touched.x = (int16_t)minX;
+    touched.y = (int16_t)minY;
+    touched.w = (int16_t)(maxX - minX + 1);
+    touched.h = (int16_t)(maxY - minY + 1);
+
+    _stats.updates++;
+    _stats.pixelsTouched += pixels;
+    _stats.lastPixels = pixels;
+    RENDER_PROFILE_PIXELS(pixels);
+    RENDER_PROFILE_PRIMITIVES(1);
+    return true;
+}
+
+uint32_t ActivationRing::arcPixels(int degrees) const {
+    if (!_ready || degrees <= 0) {
+        return 0;
+    }
+    if (degrees > 360) {
+        degrees = 360;
+    }
+
+    uint32_t pixels = 0;
+    for (int i = 0; i < _degreeStart[degrees]; i++) {
+        pixels += _spans[i].length;
+    }
+    return pixels;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const ActivationRingStats& ActivationRing::getStats() const {
+    return _stats;
+}
+
+void ActivationRing::printStats() const {
+    uint32_t avgPixels = _stats.updates > 0 ? _stats.pixelsTouched / _stats.updates : 0;
+
+    Serial.println("[ActivationRing] === RING STATS ===");
+    Serial.printf("  Updates: %lu, pixels touched: %lu (avg %lu, last %lu)\n",
+                  (unsigned long)_stats.updates, (unsigned long)_stats.pixelsTouched,
+                  (unsigned long)avgPixels, (unsigned long)_stats.lastPixels);
+    Serial.printf("  Full ring: %lu pixels in %u spans\n",
+                  (unsigned long)_stats.ringPixels, (unsigned)_stats.spanCount);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+uint32_t ActivationRing::fillDegrees(lgfx::LovyanGFX& gfx, int centerX, int centerY,
+                                     int fromDegree, int toDegree, uint16_t color,
+                                     int& minX, int& minY, int& maxX, int& maxY) {
+    uint32_t pixels = 0;
+
+    for (int i = _degreeStart[fromDegree]; i < _degreeStart[toDegree]; i++) {
+        const Span& span = _spans[i];
+        int x = centerX + span.dx;
+        int y = centerY + span.dy;
+        gfx.drawFastHLine(x, y, span.length, color);
+        pixels += span.length;
+
+        if (x < minX) minX = x;
+        if (y < minY) minY = y;
+        if (x + span.length - 1 > maxX) maxX = x + span.length - 1;
+        if (y > maxY) maxY = y;
+    }
+
+    return pixels;
+}
@@ -0,0 +1,214 @@
+/**
+ * animated_sprite.cpp - Pre-rendered animation frames implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "animated_sprite.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cstring>
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+AnimatedSprite::AnimatedSprite()
+    : _ready(false)
+    , _width(0)
+    , _height(0)
+    , _frameCount(0)
+    , _background(0)
+    , _render(nullptr)
+    , _userData(nullptr)
+{
+    memset(_changed, 0, sizeof(_changed));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool AnimatedSprite::begin(int width, int height, int frameCount, uint16_t background,
+                           FrameRenderer render, void* userData) {
+    frameCount = std::max(1, std::min(frameCount, ANIMATED_SPRITE_MAX_FRAMES));
+    if (_ready) {
+        if (width == _width && height == _height && frameCount == _frameCount &&
+            background == _background) {
+            return true;
+        }
+        end();
+    }
+
+    _width = (int16_t)width;
+    _height = (int16_t)height;
+    _frameCount = (uint8_t)frameCount;
+    _background = background;
+    _render = render;
+    _userData = userData;
+
+    // Frames stacked vertically, e.g. 51x51 x 8 frames = ~41KB
+    _sprite.setPsram(true);
+    _sprite.setColorDepth(16);
+    if (_sprite.createSprite(_width, _height * _frameCount) == nullptr) {
+        Serial.println("[AnimatedSprite] Sprite allocation failed - drawing frames directly");
+        return false;
+    }
+
+    _sprite.fillSprite(_background);
+    for (int frame = 0; frame < _frameCount; frame++) {
+        _render(_sprite, frame, 0, frame * _height, _userData);
+    }
+    measureChanges();
+
+    _ready = true;
+    return true;
+}
+
+void AnimatedSprite::end() {
+    if (_ready) {
+        _sprite.deleteSprite();
+        _ready = false;
+    }
+}
+
+bool AnimatedSprite::isReady() const {
+    return _ready;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+DirtyRect AnimatedSprite::draw(lgfx::LovyanGFX& gfx, int x, int y, int frame, int drawnFrame) {
+    DirtyRect region = { 0, 0, _width, _height };
+    if (_frameCount == 0) {
+        return { 0, 0, 0, 0 };
+    }
+    frame %= _frameCount;
+
+    if (!_ready) {
+        // No cached frames - render this one in place
+        gfx.fillRect(x, y, _width, _height, _background);
+        _render(gfx, frame, x, y, _userData);
+        _stats.fullBlits++;
+        return region;
+    }
+
+    if (drawnFrame >= 0 && drawnFrame < _frameCount) {
+        if (drawnFrame == frame) {
+            _stats.skippedBlits++;
+            return { 0, 0, 0, 0 };
+        }
+
+        // Everything that changed on the way from drawnFrame to frame
+        region = { 0, 0, 0, 0 };
+        int f = drawnFrame;
+        do {
+            f = (f + 1) % _frameCount;
+            const DirtyRect& c = _changed[f];
+            if (c.w == 0) {
+                continue;
+            }
+            if (region.w == 0) {
+                region = c;
+                continue;
+            }
+            int16_t right = std::max(region.x + region.w, c.x + c.w);
+            int16_t bottom = std::max(region.y + region.h, c.y + c.h);
+            region.x = std::min(region.x, c.x);
+            region.y = std::min(region.y, c.y);
+            region.w = right - region.x;
+            region.h = bottom - region.y;
+        } while (f != frame);
+        _stats.deltaBlits++;
+    } else {
+        _stats.fullBlits++;
+    }
+
+    if (region.w > 0) {
+        uint32_t startUs = micros();
+        blit(gfx, x, y, frame, region);
+        _stats.pixelsPushed += (uint32_t)region.w * region.h;
+        _stats.lastBlitUs = micros() - startUs;
+        RENDER_PROFILE_PIXELS((uint32_t)region.w * region.h);
+        RENDER_PROFILE_PRIMITIVES(1);
+    }
+    return region;
+}
+
+uint8_t AnimatedSprite::frameAt(uint32_t ticksPerFrame, int frameCount) {
+    if (ticksPerFrame == 0 || frameCount <= 0) {
+        return 0;
+    }
+    return (uint8_t)((millis() / (ANIMATION_TICK_MS * ticksPerFrame)) % frameCount);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const AnimatedSpriteStats& AnimatedSprite::getStats() const {
+    return _stats;
+}
+
+void AnimatedSprite::printStats(const char* name) const {
+    Serial.printf("[AnimatedSprite] %s: %lu full, %lu delta, %lu skipped, %lu px, last %lu us\n",
+                  name,
+                  (unsigned long)_stats.fullBlits,
+                  (unsigned long)_stats.deltaBlits,
+                  (unsigned long)_stats.skippedBlits,
+                  (unsigned long)_stats.pixelsPushed,
+                  (unsigned long)_stats.lastBlitUs);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+void AnimatedSprite::measureChanges() {
+    const uint16_t* pixels = (const uint16_t*)_sprite.getBuffer();
+
+    for (int frame = 0; frame < _frameCount; frame++) {
+        int prev = (frame + _frameCount - 1) % _frameCount;
+        const uint16_t* cur = pixels + frame * _height * _width;
+        const uint16_t* old = pixels + prev * _height * _width;
+
+        int minX = _width, minY = _height, maxX = -1, maxY = -1;
+        for (int y = 0; y < _height; y++) {
+            for (int x = 0; x < _width; x++) {
+                if (cur[y * _width + x] != old[y * _width + x]) {
+                    minX = std::min(minX, x);
+                    maxX = std::max(maxX, x);
+                    minY = std::min(minY, y);
+                    maxY = std::max(maxY, y);
+                }
+            }
+        }
+
+        if (maxX < 0) {
+            _changed[frame] = { 0, 0, 0, 0 };
+        } else {
+            _changed[frame] = { (int16_t)minX, (int16_t)minY,
+                                (int16_t)(maxX - minX + 1), (int16_t)(maxY - minY + 1) };
+        }
+    }
+}
+
+void AnimatedSprite::blit(lgfx::LovyanGFX& gfx, int x, int y, int frame, const DirtyRect& r) {
+    // Push the frame stack through a clip rect limited to the changed box,
+    // keeping any clip the caller had set
+    int32_t clipX, clipY, clipW, clipH;
+    gfx.getClipRect(&clipX, &clipY, &clipW, &clipH);
+
+    int left = std::max<int>(x + r.x, clipX);
+    int top = std::max<int>(y + r.y, clipY);
+    int right = std::min<int>(x + r.x + r.w, clipX + clipW);
+    int bottom = std::min<int>(y + r.y + r.h, clipY + clipH);
+    if (right <= left || bottom <= top) {
+        return;
+    }
+
+    gfx.setClipRect(left, top, right - left, bottom - top);
+    _sprite.pushSprite(&gfx, x, y - frame * _height);
+    gfx.setClipRect(clipX, clipY, clipW, clipH);
+}
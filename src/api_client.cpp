@@ -1,8 +1,15 @@
 /**
  * api_client.cpp - REST API Client implementation
  * 
- * Uses HTTPClient for HTTP requests and ArduinoJson for JSON parsing.
- * Implements real API calls to the Screenie backend.
+ * Speaks HTTP/1.1 over WiFiClientSecure (framing in http_message.cpp) and
+ * uses ArduinoJson for JSON parsing. Implements real API calls to the
+ * Screenie backend.
+ * 
+ * WiFiClientSecure runs the whole TLS handshake inside connect() with a
+ * fresh mbedTLS context, so there is no hook to offer a saved session
+ * ticket. Handshakes are saved instead by keeping the connection open
+ * between requests; after a wake the first connect still does a full
+ * handshake, but to the cached address without a DNS lookup.
  * 
  * @author Screen Time Tracker
  * @version 2.0
@@ -11,8 +18,8 @@
 #include "api_client.h"
 #include "network.h"
 #include <Arduino.h>
-#include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include <WiFi.h>
 #include <WiFiClientSecure.h>
 #include <cstring>
 #include <time.h>
@@ -21,12 +28,20 @@
 // Initialize static counter for unique mock device codes
 uint32_t ApiClient::_mockDeviceCodeCounter = 1000;
 
-// HTTP timeout in milliseconds
-constexpr uint32_t HTTP_TIMEOUT_MS = 10000;
-
 // Response buffer size (increased to handle larger API responses like screentime)
 constexpr size_t RESPONSE_BUFFER_SIZE = 8192;
 
+// Histogram bucket for a request time (see API_LATENCY_BUCKETS)
+static int latencyBucketFor(uint32_t ms) {
+    int bucket = 0;
+    uint32_t limit = 1u << API_LATENCY_FIRST_BUCKET_SHIFT;
+    while (bucket < API_LATENCY_BUCKETS - 1 && ms >= limit) {
+        bucket++;
+        limit <<= 1;
+    }
+    return bucket;
+}
+
 // ============================================================================
 // Constructor / Initialization
 // ============================================================================
@@ -34,8 +49,20 @@ constexpr size_t RESPONSE_BUFFER_SIZE = 8192;
 ApiClient::ApiClient()
     : _network(nullptr)
     , _mockMode(false)  // Default to real API mode
+    , _port(443)
     , _secureClient(nullptr)
     , _responseBuffer(nullptr)
+    , _connectionOpen(false)
+    , _connectionIdleMs(0)
+    , _connectionLinkId(0)
+    , _responseStarted(false)
+    , _addressCache(nullptr)
+    , _control(nullptr)
+    , _phase(ApiRequestPhase::IDLE)
+    , _phaseStartMs(0)
+    , _requestStartMs(0)
+    , _requestReused(false)
+    , _lastError(0)
     , _mockLoginStartMs(0)
     , _mockLoginDelayMs(8000)
     , _mockMoreTimeGranted(true)
@@ -45,6 +72,9 @@ ApiClient::ApiClient()
     _baseUrl[0] = '\0';
     _apiKey[0] = '\0';
     _familyId[0] = '\0';
+    _host[0] = '\0';
+    _basePath[0] = '\0';
+    memset(&_stats, 0, sizeof(_stats));
     
     // Allocate on heap to avoid stack overflow
     // WiFiClientSecure uses ~16KB for SSL buffers
@@ -60,6 +90,31 @@ void ApiClient::begin(NetworkManager& network, const char* baseUrl) {
     strncpy(_baseUrl, baseUrl, sizeof(_baseUrl) - 1);
     _baseUrl[sizeof(_baseUrl) - 1] = '\0';
     
+    // Split "https://host[:port]/path/" for the socket and the request line
+    const char* rest = _baseUrl;
+    if (strncmp(rest, "https://", 8) == 0) {
+        rest += 8;
+    } else {
+        Serial.println("[ApiClient] WARNING: Base URL is not https - requests will fail");
+    }
+    const char* slash = strchr(rest, '/');
+    size_t hostLen = slash ? (size_t)(slash - rest) : strlen(rest);
+    if (hostLen >= sizeof(_host)) {
+        hostLen = sizeof(_host) - 1;
+    }
+    memcpy(_host, rest, hostLen);
+    _host[hostLen] = '\0';
+    
+    _port = 443;
+    char* colon = strchr(_host, ':');
+    if (colon != nullptr) {
+        _port = (uint16_t)atoi(colon + 1);
+        *colon = '\0';
+    }
+    
+    strncpy(_basePath, slash ? slash : "/", sizeof(_basePath) - 1);
+    _basePath[sizeof(_basePath) - 1] = '\0';
+    
     Serial.printf("[ApiClient] Initialized with base URL: %s\n", _baseUrl);
     Serial.printf("[ApiClient] Mock mode: %s\n", _mockMode ? "ENABLED" : "DISABLED");
 }
@@ -108,119 +163,432 @@ bool ApiClient::ensureConnected() {
 }
 
 int ApiClient::httpGet(const char* endpoint, char* responseBuffer, size_t bufferSize, bool authenticated) {
-    if (!ensureConnected()) {
-        Serial.println("[ApiClient] Cannot make GET request - not connected");
-        return -1;
-    }
-    
-    // Build full URL
-    char url[256];
-    snprintf(url, sizeof(url), "%s%s", _baseUrl, endpoint);
-    
-    Serial.printf("[ApiClient] GET %s\n", url);
-    
-    // Use heap-allocated WiFiClientSecure to avoid stack overflow
-    HTTPClient http;
-    http.setTimeout(HTTP_TIMEOUT_MS);
-    
-    if (!http.begin(*_secureClient, url)) {
-        Serial.println("[ApiClient] Failed to begin HTTP connection");
-        return -2;
-    }
-    
-    // Add headers
-    http.addHeader("Content-Type", "application/json");
-    http.addHeader("Accept", "application/json");
-    
-    if (authenticated && hasApiKey()) {
-        http.addHeader("X-API-Key", _apiKey);
+    return httpRequest("GET", endpoint, nullptr, responseBuffer, bufferSize, authenticated);
+}
+
+int ApiClient::httpPost(const char* endpoint, const char* body, char* responseBuffer, size_t bufferSize, bool authenticated) {
+    if (body && body[0]) {
+        Serial.printf("[ApiClient] Body: %s\n", body);
     }
-    
-    // Make request
-    int httpCode = http.GET();
-    
-    if (httpCode > 0) {
-        // Got a response
-        String payload = http.getString();
-        size_t len = payload.length();
-        if (len >= bufferSize) {
-            len = bufferSize - 1;
+    return httpRequest("POST", endpoint, body ? body : "", responseBuffer, bufferSize, authenticated);
+}
+
+// ============================================================================
+// HTTP Exchange
+// ============================================================================
+
+int ApiClient::httpRequest(const char* method, const char* endpoint, const char* body,
+                           char* responseBuffer, size_t bufferSize, bool authenticated) {
+    responseBuffer[0] = '\0';
+    uint32_t deadlineMs = requestDeadline();
+    _stats.requests++;
+
+    Serial.printf("[ApiClient] %s %s%s\n", method, _baseUrl, endpoint);
+
+    int httpCode;
+    for (bool retried = false; ; retried = true) {
+        // Connect: WiFi first, then the kept-alive connection or a new
+        // TCP + TLS handshake within the time left
+        enterPhase(ApiRequestPhase::CONNECT);
+        if (!ensureConnected()) {
+            Serial.printf("[ApiClient] Cannot make %s request - not connected\n", method);
+            return finishExchange(API_ERROR_NOT_CONNECTED);
         }
-        memcpy(responseBuffer, payload.c_str(), len);
-        responseBuffer[len] = '\0';
-        
-        Serial.printf("[ApiClient] Response (%d): %s\n", httpCode, 
-                      len > 200 ? "(truncated)" : responseBuffer);
-    } else {
-        Serial.printf("[ApiClient] GET failed, error: %s\n", http.errorToString(httpCode).c_str());
+        int error = checkRequest(deadlineMs);
+        if (error != 0) {
+            return finishExchange(error);
+        }
+
+        _requestReused = isConnectionReusable();
+        if (_requestReused) {
+            _stats.reused++;
+        } else {
+            closeConnection();
+            error = openConnection(deadlineMs);
+            if (error != 0) {
+                return finishExchange(error);
+            }
+        }
+
+        // Send
+        enterPhase(ApiRequestPhase::SEND);
+        error = checkRequest(deadlineMs);
+        if (error == 0 && !sendRequest(method, endpoint, body, authenticated)) {
+            error = API_ERROR_SEND;
+        }
+        if (error == API_ERROR_SEND && _requestReused && !retried) {
+            // The server dropped the idle connection; nothing was processed
+            Serial.println("[ApiClient] Kept-alive connection closed, reconnecting");
+            _stats.staleRetries++;
+            closeConnection();
+            continue;
+        }
+        if (error != 0) {
+            closeConnection();
+            return finishExchange(error);
+        }
+
+        // Receive
+        enterPhase(ApiRequestPhase::RECEIVE);
+        bool keepAlive = false;
+        httpCode = receiveResponse(responseBuffer, bufferSize, deadlineMs,
+                                   strcmp(method, "HEAD") == 0, keepAlive);
+        // keepAlive is only set once the whole response was read (an
+        // oversized body is drained), so the connection is still in step
+        if (keepAlive) {
+            _connectionIdleMs = millis();
+        } else {
+            closeConnection();
+        }
+
+        // Closed before a byte of the response: safe to repeat a GET
+        if (httpCode == API_ERROR_RESPONSE && !_responseStarted && _requestReused && !retried &&
+            strcmp(method, "GET") == 0) {
+            Serial.println("[ApiClient] Kept-alive connection closed, retrying");
+            _stats.staleRetries++;
+            continue;
+        }
+        break;
+    }
+
+    if (httpCode < 0) {
         responseBuffer[0] = '\0';
+        char message[32];
+        formatHttpError(httpCode, message, sizeof(message));
+        Serial.printf("[ApiClient] %s failed, error: %s\n", method, message);
+        return finishExchange(httpCode);
     }
-    
-    http.end();
+
+    Serial.printf("[ApiClient] Response (%d): %s\n", httpCode,
+                  strlen(responseBuffer) > 200 ? "(truncated)" : responseBuffer);
+
+    // The caller parses the body; its RequestScope closes the phase
+    enterPhase(ApiRequestPhase::PARSE);
     return httpCode;
 }
 
-int ApiClient::httpPost(const char* endpoint, const char* body, char* responseBuffer, size_t bufferSize, bool authenticated) {
-    if (!ensureConnected()) {
-        Serial.println("[ApiClient] Cannot make POST request - not connected");
-        return -1;
+bool ApiClient::sendRequest(const char* method, const char* endpoint, const char* body, bool authenticated) {
+    char header[512];
+    size_t bodyLength = body ? strlen(body) : 0;
+    int length = formatHttpRequestHeader(header, sizeof(header), method, _host, _basePath, endpoint,
+                                         authenticated && hasApiKey() ? _apiKey : nullptr,
+                                         body != nullptr ? (long)bodyLength : -1);
+    if (length < 0) {
+        Serial.println("[ApiClient] Request header too long");
+        return false;
     }
-    
-    // Build full URL
-    char url[256];
-    snprintf(url, sizeof(url), "%s%s", _baseUrl, endpoint);
-    
-    Serial.printf("[ApiClient] POST %s\n", url);
-    if (body && body[0]) {
-        Serial.printf("[ApiClient] Body: %s\n", body);
+
+    if (_secureClient->write((const uint8_t*)header, length) != (size_t)length) {
+        return false;
     }
-    
-    // Use heap-allocated WiFiClientSecure to avoid stack overflow
-    HTTPClient http;
-    http.setTimeout(HTTP_TIMEOUT_MS);
-    
-    if (!http.begin(*_secureClient, url)) {
-        Serial.println("[ApiClient] Failed to begin HTTP connection");
-        return -2;
+    if (bodyLength > 0 &&
+        _secureClient->write((const uint8_t*)body, bodyLength) != bodyLength) {
+        return false;
     }
-    
-    // Add headers
-    http.addHeader("Content-Type", "application/json");
-    http.addHeader("Accept", "application/json");
-    
-    if (authenticated && hasApiKey()) {
-        http.addHeader("X-API-Key", _apiKey);
+    return true;
+}
+
+namespace {
+
+// WiFiClientSecure as the response reader's byte stream
+class SecureClientStream : public HttpStream {
+public:
+    explicit SecureClientStream(WiFiClientSecure& client) : _client(client) {}
+    int available() override { return _client.available(); }
+    int read() override { return _client.read(); }
+    int read(uint8_t* buffer, size_t size) override { return _client.read(buffer, size); }
+    bool connected() override { return _client.connected(); }
+
+private:
+    WiFiClientSecure& _client;
+};
+
+// Context of waitForData()
+struct ReceiveWait {
+    const ApiClient* client;
+    uint32_t deadlineMs;
+};
+
+}  // namespace
+
+int ApiClient::receiveResponse(char* responseBuffer, size_t bufferSize, uint32_t deadlineMs,
+                               bool headRequest, bool& keepAlive) {
+    SecureClientStream stream(*_secureClient);
+    ReceiveWait wait = { this, deadlineMs };
+    HttpResponseReader reader(stream, waitForData, &wait);
+
+    int httpCode = reader.read(responseBuffer, bufferSize, keepAlive, headRequest);
+    _responseStarted = reader.responseStarted();
+    return httpCode;
+}
+
+int ApiClient::waitForData(void* userData) {
+    const ReceiveWait* wait = static_cast<const ReceiveWait*>(userData);
+    int error = wait->client->checkRequest(wait->deadlineMs);
+    if (error != 0) {
+        return error;
     }
-    
-    // Make request
-    int httpCode;
-    if (body && body[0]) {
-        httpCode = http.POST(body);
+    delay(HTTP_RECEIVE_POLL_MS);
+    return 0;
+}
+
+// ============================================================================
+// Connection
+// ============================================================================
+
+bool ApiClient::isConnectionReusable() {
+    if (!_connectionOpen) {
+        return false;
+    }
+    // WiFi reconnected or the IP changed since (the link generation), idle too
+    // long, closed by the server, or the last response was not fully read
+    return _network != nullptr &&
+           _network->getLinkGeneration() == _connectionLinkId &&
+           millis() - _connectionIdleMs <= HTTP_KEEPALIVE_MS &&
+           _secureClient->connected() &&
+           _secureClient->available() == 0;
+}
+
+int ApiClient::openConnection(uint32_t deadlineMs) {
+    uint32_t address = 0;
+    time_t now = time(nullptr);
+    bool fromCache = _addressCache != nullptr && _addressCache->valid &&
+                     strcmp(_addressCache->host, _host) == 0 &&
+                     now >= _addressCache->resolvedAt &&
+                     (uint32_t)(now - _addressCache->resolvedAt) <= HTTP_ADDRESS_MAX_AGE_SECS;
+    if (fromCache) {
+        address = _addressCache->address;
+        _stats.addressCacheHits++;
+    } else if (!resolveServerAddress(address)) {
+        return API_ERROR_CONNECT;
+    }
+
+    for (;;) {
+        int error = checkRequest(deadlineMs);
+        if (error != 0) {
+            return error;
+        }
+
+        // TCP connect and TLS handshake within the time left (host for SNI)
+        uint32_t remainingSecs = (deadlineMs - millis()) / 1000 + 1;
+        _secureClient->setTimeout(remainingSecs);
+        _secureClient->setHandshakeTimeout(remainingSecs);
+        if (_secureClient->connect(IPAddress(address), _port, _host, nullptr, nullptr, nullptr)) {
+            break;
+        }
+        Serial.printf("[ApiClient] Connect to %s:%u failed\n", _host, _port);
+
+        error = checkRequest(deadlineMs);
+        if (!fromCache || error != 0) {
+            return error != 0 ? error : API_ERROR_CONNECT;
+        }
+
+        // The cached address may have moved; look it up and try once more
+        fromCache = false;
+        _addressCache->valid = false;
+        if (!resolveServerAddress(address)) {
+            return API_ERROR_CONNECT;
+        }
+    }
+
+    _stats.handshakes++;
+    _connectionOpen = true;
+    _connectionLinkId = _network->getLinkGeneration();
+    return 0;
+}
+
+void ApiClient::closeConnection() {
+    if (_connectionOpen) {
+        _secureClient->stop();
+        _connectionOpen = false;
+    }
+}
+
+bool ApiClient::resolveServerAddress(uint32_t& address) {
+    IPAddress resolved;
+    _stats.dnsLookups++;
+    if (!WiFi.hostByName(_host, resolved)) {
+        Serial.printf("[ApiClient] DNS lookup for %s failed\n", _host);
+        return false;
+    }
+    address = (uint32_t)resolved;
+
+    if (_addressCache != nullptr) {
+        strncpy(_addressCache->host, _host, sizeof(_addressCache->host) - 1);
+        _addressCache->host[sizeof(_addressCache->host) - 1] = '\0';
+        _addressCache->address = address;
+        _addressCache->resolvedAt = time(nullptr);
+        _addressCache->valid = true;
+    }
+    return true;
+}
+
+void ApiClient::setAddressCache(ApiAddressCache* cache) {
+    _addressCache = cache;
+}
+
+void ApiClient::closeIdleConnection() {
+    if (_connectionOpen && !isConnectionReusable()) {
+        Serial.println("[ApiClient] Closing idle connection");
+        closeConnection();
+    }
+}
+
+int ApiClient::checkRequest(uint32_t deadlineMs) const {
+    if (_control != nullptr && _control->cancelled.load()) {
+        return API_ERROR_CANCELLED;
+    }
+    if ((int32_t)(millis() - deadlineMs) >= 0) {
+        return API_ERROR_TIMED_OUT;
+    }
+    return 0;
+}
+
+uint32_t ApiClient::requestDeadline() const {
+    if (_control != nullptr && _control->deadlineMs != 0) {
+        return _control->deadlineMs;
+    }
+    return millis() + HTTP_TIMEOUT_MS;
+}
+
+// ============================================================================
+// Request Control
+// ============================================================================
+
+void ApiClient::setRequestControl(ApiRequestControl* control) {
+    _control = control;
+    _lastError = 0;
+}
+
+ApiRequestPhase ApiClient::getPhase() const {
+    return _phase.load();
+}
+
+int ApiClient::getLastError() const {
+    return _lastError;
+}
+
+void ApiClient::enterPhase(ApiRequestPhase phase) {
+    uint32_t now = millis();
+    ApiRequestPhase current = _phase.load();
+    if (phase == current) {
+        return;
+    }
+
+    if (current == ApiRequestPhase::IDLE) {
+        // A new request: the last-request timings start over
+        memset(_stats.lastPhaseMs, 0, sizeof(_stats.lastPhaseMs));
+        _requestStartMs = now;
+        _requestReused = false;
     } else {
-        httpCode = http.POST("");  // Empty body
+        uint32_t elapsed = now - _phaseStartMs;
+        int index = (int)current;
+        _stats.lastPhaseMs[index] = elapsed;
+        _stats.totalPhaseMs[index] += elapsed;
+        if (elapsed > _stats.maxPhaseMs[index]) {
+            _stats.maxPhaseMs[index] = elapsed;
+        }
     }
-    
-    if (httpCode > 0) {
-        // Got a response
-        String payload = http.getString();
-        size_t len = payload.length();
-        if (len >= bufferSize) {
-            len = bufferSize - 1;
+
+    if (phase == ApiRequestPhase::IDLE) {
+        // Request done (or failed): whole-request latency
+        uint32_t requestMs = now - _requestStartMs;
+        _stats.lastRequestMs = requestMs;
+        if (requestMs > _stats.maxRequestMs) {
+            _stats.maxRequestMs = requestMs;
         }
-        memcpy(responseBuffer, payload.c_str(), len);
-        responseBuffer[len] = '\0';
-        
-        Serial.printf("[ApiClient] Response (%d): %s\n", httpCode,
-                      len > 200 ? "(truncated)" : responseBuffer);
+        int bucket = latencyBucketFor(requestMs);
+        if (_requestReused) {
+            _stats.reusedBuckets[bucket]++;
+        } else {
+            _stats.handshakeBuckets[bucket]++;
+        }
+    }
+
+    _phase.store(phase);
+    _phaseStartMs = now;
+}
+
+int ApiClient::finishExchange(int httpCode) {
+    if (httpCode == API_ERROR_CANCELLED) {
+        _stats.cancelled++;
+    } else if (httpCode == API_ERROR_TIMED_OUT) {
+        _stats.timedOut++;
     } else {
-        Serial.printf("[ApiClient] POST failed, error: %s\n", http.errorToString(httpCode).c_str());
-        responseBuffer[0] = '\0';
+        _stats.failed++;
     }
-    
-    http.end();
+    _lastError = httpCode;
+    enterPhase(ApiRequestPhase::IDLE);
     return httpCode;
 }
 
+void ApiClient::formatHttpError(int httpCode, char* buffer, size_t bufferSize) {
+    switch (httpCode) {
+        case API_ERROR_NOT_CONNECTED: strncpy(buffer, "No WiFi connection", bufferSize - 1); break;
+        case API_ERROR_CONNECT:       strncpy(buffer, "Server unreachable", bufferSize - 1); break;
+        case API_ERROR_SEND:          strncpy(buffer, "Send failed", bufferSize - 1); break;
+        case API_ERROR_RESPONSE:      strncpy(buffer, "Bad response", bufferSize - 1); break;
+        case API_ERROR_CANCELLED:     strncpy(buffer, "Cancelled", bufferSize - 1); break;
+        case API_ERROR_TIMED_OUT:     strncpy(buffer, "Timed out", bufferSize - 1); break;
+        case API_ERROR_TOO_LARGE:     strncpy(buffer, "Response too large", bufferSize - 1); break;
+        default:
+            snprintf(buffer, bufferSize, "HTTP error: %d", httpCode);
+            return;
+    }
+    buffer[bufferSize - 1] = '\0';
+}
+
+const ApiClientStats& ApiClient::getStats() const {
+    return _stats;
+}
+
+void ApiClient::printStats() const {
+    static const char* const PHASE_NAMES[(int)ApiRequestPhase::COUNT] = {
+        "idle", "connect", "send", "receive", "parse"
+    };
+
+    Serial.printf("[ApiClient] Requests: %lu (%lu failed, %lu cancelled, %lu timed out)\n",
+                  (unsigned long)_stats.requests, (unsigned long)_stats.failed,
+                  (unsigned long)_stats.cancelled, (unsigned long)_stats.timedOut);
+    if (_stats.requests == 0) {
+        return;
+    }
+    for (int i = (int)ApiRequestPhase::CONNECT; i < (int)ApiRequestPhase::COUNT; i++) {
+        Serial.printf("[ApiClient]   %-8s last %5lu ms, avg %5lu ms, max %5lu ms\n",
+                      PHASE_NAMES[i],
+                      (unsigned long)_stats.lastPhaseMs[i],
+                      (unsigned long)(_stats.totalPhaseMs[i] / _stats.requests),
+                      (unsigned long)_stats.maxPhaseMs[i]);
+    }
+
+    Serial.printf("[ApiClient]   %lu TLS handshakes, %lu reused connections, %lu stale retries\n",
+                  (unsigned long)_stats.handshakes, (unsigned long)_stats.reused,
+                  (unsigned long)_stats.staleRetries);
+    Serial.printf("[ApiClient]   %lu DNS lookups, %lu cached address connects\n",
+                  (unsigned long)_stats.dnsLookups, (unsigned long)_stats.addressCacheHits);
+    Serial.printf("[ApiClient]   request  last %5lu ms, max %5lu ms\n",
+                  (unsigned long)_stats.lastRequestMs, (unsigned long)_stats.maxRequestMs);
+    Serial.print("[ApiClient]   latency ms ");
+    for (int i = 0; i < API_LATENCY_BUCKETS; i++) {
+        if (i < API_LATENCY_BUCKETS - 1) {
+            Serial.printf(" <%-5lu", 1ul << (API_LATENCY_FIRST_BUCKET_SHIFT + i));
+        } else {
+            Serial.print(" more");
+        }
+    }
+    Serial.println();
+    Serial.print("[ApiClient]   reused     ");
+    for (int i = 0; i < API_LATENCY_BUCKETS; i++) {
+        Serial.printf(" %-6lu", (unsigned long)_stats.reusedBuckets[i]);
+    }
+    Serial.println();
+    Serial.print("[ApiClient]   handshake  ");
+    for (int i = 0; i < API_LATENCY_BUCKETS; i++) {
+        Serial.printf(" %-6lu", (unsigned long)_stats.handshakeBuckets[i]);
+    }
+    Serial.println();
+}
+
 void ApiClient::getTodayDateString(char* buffer, size_t bufferSize) {
     // Get current time from RTC
     auto dt = M5.Rtc.getDateTime();
@@ -253,14 +621,14 @@ DeviceCodeResponse ApiClient::initiateLogin() {
     }
     
     DeviceCodeResponse response;
+    RequestScope scope(*this);
     
     // GET /api/pairing/devicecode (use heap-allocated buffer)
     int httpCode = httpGet(API_ENDPOINT_DEVICE_CODE, _responseBuffer, RESPONSE_BUFFER_SIZE, false);
     
     if (httpCode != 200) {
         response.success = false;
-        snprintf(response.errorMessage, sizeof(response.errorMessage), 
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, response.errorMessage, sizeof(response.errorMessage));
         return response;
     }
     
@@ -315,6 +683,7 @@ LoginPollResult ApiClient::pollLoginStatus(const char* pairingCode) {
     }
     
     LoginPollResult result;
+    RequestScope scope(*this);
     
     // Build endpoint: POST /api/pairing/devicecode/{pairingCode}
     char endpoint[128];
@@ -325,8 +694,7 @@ LoginPollResult ApiClient::pollLoginStatus(const char* pairingCode) {
     if (httpCode != 200) {
         result.success = false;
         result.pending = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         return result;
     }
     
@@ -412,14 +780,14 @@ FamilyGroupResult ApiClient::getFamilyGroup() {
     }
     
     FamilyGroupResult result;
+    RequestScope scope(*this);
     
     // GET /api/family
     int httpCode = httpGet(API_ENDPOINT_FAMILY, _responseBuffer, RESPONSE_BUFFER_SIZE, true);
     
     if (httpCode != 200) {
         result.success = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         return result;
     }
     
@@ -551,6 +919,7 @@ AllowanceResult ApiClient::getTodayAllowance(const char* childId) {
     }
     
     AllowanceResult result;
+    RequestScope scope(*this);
     
     // Check we have family ID
     if (!hasFamilyId()) {
@@ -574,8 +943,7 @@ AllowanceResult ApiClient::getTodayAllowance(const char* childId) {
     
     if (httpCode != 200) {
         result.success = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         return result;
     }
     
@@ -679,6 +1047,8 @@ ConsumedTimeResult ApiClient::pushConsumedTime(const char* childId, uint32_t ses
         return result;
     }
     
+    RequestScope scope(*this);
+    
     // Format sessionStartTime as ISO 8601 string: "YYYY-MM-DD HH:MM:SSZ"
     struct tm* timeInfo = gmtime(&sessionStartTime);
     char startedAtStr[32];
@@ -708,8 +1078,7 @@ ConsumedTimeResult ApiClient::pushConsumedTime(const char* childId, uint32_t ses
         Serial.printf("[ApiClient] Session pushed successfully (HTTP %d)\n", httpCode);
     } else {
         result.success = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         Serial.printf("[ApiClient] pushConsumedTime failed: HTTP %d\n", httpCode);
     }
     
@@ -731,6 +1100,7 @@ MoreTimeRequestResult ApiClient::requestAdditionalTime(const char* childId,
     }
     
     MoreTimeRequestResult result;
+    RequestScope scope(*this);
     
     // Check we have family ID
     if (!hasFamilyId()) {
@@ -772,8 +1142,7 @@ MoreTimeRequestResult ApiClient::requestAdditionalTime(const char* childId,
     
     if (httpCode != 200 && httpCode != 201) {
         result.success = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         return result;
     }
     
@@ -815,6 +1184,7 @@ MoreTimePollResult ApiClient::pollMoreTimeStatus(const char* requestId) {
     }
     
     MoreTimePollResult result;
+    RequestScope scope(*this);
     
     // Build endpoint: grant/{grantId}
     char endpoint[128];
@@ -825,8 +1195,7 @@ MoreTimePollResult ApiClient::pollMoreTimeStatus(const char* requestId) {
     if (httpCode != 200) {
         result.success = false;
         result.pending = false;
-        snprintf(result.errorMessage, sizeof(result.errorMessage),
-                 "HTTP error: %d", httpCode);
+        formatHttpError(httpCode, result.errorMessage, sizeof(result.errorMessage));
         return result;
     }
     
@@ -0,0 +1,313 @@
+/**
+ * avatar_cache.cpp - Avatar blob cache implementation
+ *
+ * Loads the prebuilt circle-masked RGB565 blobs (see scripts/build_avatars.py)
+ * into PSRAM and blits them one circle span per row. No PNG decoding happens
+ * at runtime.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "avatar_cache.h"
+#include "avatar_manifest.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <esp_heap_caps.h>
+
+// Prefer PSRAM, fall back to internal RAM on boards without it
+static void* allocBuffer(size_t bytes) {
+    void* buffer = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buffer == nullptr) {
+        buffer = heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    }
+    return buffer;
+}
+
+// Find the generated circle geometry for a radius
+static const AvatarBlobShape* findShape(int radius) {
+    for (int i = 0; i < AVATAR_BLOB_SHAPE_COUNT; i++) {
+        if (AVATAR_BLOB_SHAPES[i].radius == radius) {
+            return &AVATAR_BLOB_SHAPES[i];
+        }
+    }
+    return nullptr;
+}
+
+// Check the generated manifest before touching the filesystem
+static bool isInManifest(const char* key) {
+    for (int i = 0; i < AVATAR_BLOB_NAME_COUNT; i++) {
+        if (strcmp(AVATAR_BLOB_NAMES[i], key) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Singleton / Constructor
+// ============================================================================
+
+AvatarCache& AvatarCache::getInstance() {
+    static AvatarCache instance;
+    return instance;
+}
+
+AvatarCache::AvatarCache()
+    : _tick(0)
+{
+    memset(_entries, 0, sizeof(_entries));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+bool AvatarCache::draw(lgfx::LovyanGFX& gfx, const char* avatarName,
+                       int centerX, int centerY, int radius) {
+    if (avatarName == nullptr || avatarName[0] == '\0') {
+        return false;
+    }
+
+    const AvatarBlobShape* shape = findShape(radius);
+    if (shape == nullptr) {
+        Serial.printf("[AvatarCache] No blobs built for radius %d\n", radius);
+        return false;
+    }
+
+    char key[AVATAR_CACHE_NAME_LEN];
+    makeKey(avatarName, key, sizeof(key));
+
+    _tick++;
+
+    // Fast path - already loaded (or known to be missing)
+    Entry* entry = find(key, radius);
+    if (entry != nullptr) {
+        entry->lastUsed = _tick;
+        _stats.hits++;
+        if (entry->pixels == nullptr) {
+            return false;
+        }
+        blit(gfx, *shape, entry->pixels, centerX, centerY);
+        return true;
+    }
+
+    _stats.misses++;
+
+    if (!isInManifest(key)) {
+        return false;
+    }
+
+    // Construct full path: /avatars/[key]_r[radius].rgb
+    char blobPath[64];
+    snprintf(blobPath, sizeof(blobPath), "/avatars/%s_r%d%s", key, radius, AVATAR_BLOB_EXTENSION);
+
+    uint32_t bytes = shape->pixelCount * sizeof(uint16_t);
+    entry = allocateEntry(bytes);
+    if (entry == nullptr) {
+        return streamFromFile(gfx, *shape, blobPath, centerX, centerY);
+    }
+
+    entry->used = true;
+    strncpy(entry->name, key, sizeof(entry->name) - 1);
+    entry->name[sizeof(entry->name) - 1] = '\0';
+    entry->radius = (int16_t)radius;
+    entry->lastUsed = _tick;
+
+    entry->pixels = (uint16_t*)allocBuffer(bytes);
+    if (entry->pixels == nullptr) {
+        releaseEntry(*entry);
+        return streamFromFile(gfx, *shape, blobPath, centerX, centerY);
+    }
+    entry->bytes = bytes;
+    _stats.bytesUsed += bytes;
+
+    if (!load(*entry, *shape, blobPath)) {
+        // Keep a negative entry so the fallback doesn't hit the filesystem again
+        heap_caps_free(entry->pixels);
+        entry->pixels = nullptr;
+        _stats.bytesUsed -= entry->bytes;
+        entry->bytes = 0;
+        return false;
+    }
+
+    blit(gfx, *shape, entry->pixels, centerX, centerY);
+    return true;
+}
+
+void AvatarCache::clear() {
+    for (int i = 0; i < AVATAR_CACHE_MAX_ENTRIES; i++) {
+        if (_entries[i].used) {
+            releaseEntry(_entries[i]);
+        }
+    }
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const AvatarCacheStats& AvatarCache::getStats() const {
+    return _stats;
+}
+
+void AvatarCache::printStats() const {
+    uint32_t avgLoadUs = _stats.loads > 0 ? _stats.totalLoadUs / _stats.loads : 0;
+
+    Serial.println("[AvatarCache] === CACHE STATS ===");
+    Serial.printf("  Hits: %lu, misses: %lu, evictions: %lu\n",
+                  (unsigned long)_stats.hits, (unsigned long)_stats.misses,
+                  (unsigned long)_stats.evictions);
+    Serial.printf("  Blob loads: %lu, avg %lu us, max %lu us, last %lu us\n",
+                  (unsigned long)_stats.loads, (unsigned long)avgLoadUs,
+                  (unsigned long)_stats.maxLoadUs, (unsigned long)_stats.lastLoadUs);
+    Serial.printf("  Blits: %lu, last %lu us\n",
+                  (unsigned long)_stats.blits, (unsigned long)_stats.lastBlitUs);
+    Serial.printf("  Bytes used: %lu / %lu\n",
+                  (unsigned long)_stats.bytesUsed, (unsigned long)AVATAR_CACHE_BUDGET_BYTES);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+AvatarCache::Entry* AvatarCache::find(const char* key, int radius) {
+    for (int i = 0; i < AVATAR_CACHE_MAX_ENTRIES; i++) {
+        Entry& entry = _entries[i];
+        if (entry.used && entry.radius == radius && strcmp(entry.name, key) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+AvatarCache::Entry* AvatarCache::allocateEntry(uint32_t bytesNeeded) {
+    if (bytesNeeded > AVATAR_CACHE_BUDGET_BYTES) {
+        return nullptr;
+    }
+
+    while (true) {
+        Entry* freeSlot = nullptr;
+        Entry* oldest = nullptr;
+
+        for (int i = 0; i < AVATAR_CACHE_MAX_ENTRIES; i++) {
+            Entry& entry = _entries[i];
+            if (!entry.used) {
+                if (freeSlot == nullptr) {
+                    freeSlot = &entry;
+                }
+            } else if (oldest == nullptr || entry.lastUsed < oldest->lastUsed) {
+                oldest = &entry;
+            }
+        }
+
+        if (freeSlot != nullptr && _stats.bytesUsed + bytesNeeded <= AVATAR_CACHE_BUDGET_BYTES) {
+            return freeSlot;
+        }
+
+        if (oldest == nullptr) {
+            return nullptr;
+        }
+
+        Serial.printf("[AvatarCache] Evicting %s\n", oldest->name);
+        releaseEntry(*oldest);
+        _stats.evictions++;
+    }
+}
+
+void AvatarCache::releaseEntry(Entry& entry) {
+    if (entry.pixels != nullptr) {
+        heap_caps_free(entry.pixels);
+    }
+    _stats.bytesUsed -= entry.bytes;
+    memset(&entry, 0, sizeof(entry));
+}
+
+bool AvatarCache::load(Entry& entry, const AvatarBlobShape& shape, const char* blobPath) {
+    uint32_t startUs = micros();
+    size_t expected = shape.pixelCount * sizeof(uint16_t);
+
+    File blobFile = LittleFS.open(blobPath, "r");
+    if (!blobFile) {
+        Serial.printf("[AvatarCache] Avatar blob not found: %s (run uploadfs?)\n", blobPath);
+        return false;
+    }
+
+    size_t bytesRead = 0;
+    if (blobFile.size() == expected) {
+        bytesRead = blobFile.read((uint8_t*)entry.pixels, expected);
+    }
+    blobFile.close();
+
+    if (bytesRead != expected) {
+        Serial.printf("[AvatarCache] Bad avatar blob: %s (%u bytes, expected %u)\n",
+                      blobPath, (unsigned)bytesRead, (unsigned)expected);
+        return false;
+    }
+
+    uint32_t elapsedUs = micros() - startUs;
+    _stats.loads++;
+    _stats.totalLoadUs += elapsedUs;
+    _stats.lastLoadUs = elapsedUs;
+    if (elapsedUs > _stats.maxLoadUs) {
+        _stats.maxLoadUs = elapsedUs;
+    }
+
+    Serial.printf("[AvatarCache] Loaded %s in %lu us\n", blobPath, (unsigned long)elapsedUs);
+    return true;
+}
+
+void AvatarCache::blit(lgfx::LovyanGFX& gfx, const AvatarBlobShape& shape,
+                       const uint16_t* pixels, int centerX, int centerY) {
+    uint32_t startUs = micros();
+    int top = centerY - shape.radius;
+
+    // One span per row, blob stores exactly these pixels back to back
+    for (int row = 0; row < shape.radius * 2 + 1; row++) {
+        int halfWidth = shape.spans[row];
+        int width = halfWidth * 2 + 1;
+        gfx.pushImage(centerX - halfWidth, top + row, width, 1,
+                      reinterpret_cast<const lgfx::rgb565_t*>(pixels));
+        pixels += width;
+    }
+
+    _stats.blits++;
+    _stats.lastBlitUs = micros() - startUs;
+    RENDER_PROFILE_PIXELS(shape.pixelCount);
+    RENDER_PROFILE_PRIMITIVES(1);
+}
+
+bool AvatarCache::streamFromFile(lgfx::LovyanGFX& gfx, const AvatarBlobShape& shape,
+                                 const char* blobPath, int centerX, int centerY) {
+    // Out of cache memory - blit straight from the file one row at a time
+    File blobFile = LittleFS.open(blobPath, "r");
+    if (!blobFile || blobFile.size() != shape.pixelCount * sizeof(uint16_t)) {
+        Serial.printf("[AvatarCache] Avatar blob not usable: %s\n", blobPath);
+        return false;
+    }
+
+    uint16_t rowBuffer[256 * 2 + 1];
+    int top = centerY - shape.radius;
+    for (int row = 0; row < shape.radius * 2 + 1; row++) {
+        int halfWidth = shape.spans[row];
+        int width = halfWidth * 2 + 1;
+        blobFile.read((uint8_t*)rowBuffer, width * sizeof(uint16_t));
+        gfx.pushImage(centerX - halfWidth, top + row, width, 1,
+                      reinterpret_cast<const lgfx::rgb565_t*>(rowBuffer));
+    }
+    blobFile.close();
+    return true;
+}
+
+void AvatarCache::makeKey(const char* avatarName, char* key, size_t keySize) {
+    // Normalise "1F3B1_color.png" and "1F3B1_color" to the same key
+    strncpy(key, avatarName, keySize - 1);
+    key[keySize - 1] = '\0';
+
+    size_t len = strlen(key);
+    if (len > 4 && strcmp(&key[len - 4], ".png") == 0) {
+        key[len - 4] = '\0';
+    }
+}
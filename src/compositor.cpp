@@ -0,0 +1,445 @@
+/**
+ * compositor.cpp - Off-screen sprite compositor implementation
+ *
+ * Keeps a PSRAM sprite the size of the panel plus a small list of dirty
+ * rectangles, and pushes only those rectangles on flush() - synchronously,
+ * or through ping-pong DMA staging buffers with COMPOSITOR_DMA_FLUSH. With
+ * COMPOSITOR_PALETTE_8BPP the sprite holds RGB332 and is expanded through
+ * the generated palette while staging.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "compositor.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <algorithm>
+#if COMPOSITOR_DMA_FLUSH || COMPOSITOR_PALETTE_8BPP
+#include <esp_heap_caps.h>
+#endif
+#if COMPOSITOR_PALETTE_8BPP
+#include "palette_data.h"
+#endif
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+Compositor::Compositor(DisplayTarget& display)
+    : _display(display)
+    , _canvas(&display)
+    , _ready(false)
+    , _dirtyCount(0)
+#if COMPOSITOR_DMA_FLUSH
+    , _dmaBuffers{ nullptr, nullptr }
+    , _dmaBufferIndex(0)
+    , _dmaInFlight(false)
+    , _syncCyclesPerKpx(0)
+#endif
+#if COMPOSITOR_PALETTE_8BPP
+    , _stageBuffer(nullptr)
+#endif
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+Compositor::~Compositor() {
+#if COMPOSITOR_DMA_FLUSH
+    finishFlush();
+    for (int i = 0; i < 2; i++) {
+        if (_dmaBuffers[i] != nullptr) {
+            heap_caps_free(_dmaBuffers[i]);
+            _dmaBuffers[i] = nullptr;
+        }
+    }
+#endif
+#if COMPOSITOR_PALETTE_8BPP
+    if (_stageBuffer != nullptr) {
+        heap_caps_free(_stageBuffer);
+        _stageBuffer = nullptr;
+    }
+#endif
+}
+
+bool Compositor::begin() {
+    if (_ready) {
+        return true;
+    }
+
+    // 240x135 RGB565 = ~64KB, keep it out of internal RAM
+    _canvas.setPsram(true);
+    _canvas.setColorDepth(16);
+
+#if COMPOSITOR_PALETTE_8BPP
+    // The expansion buffer has to exist before the sprite can drop to 8bpp
+    _stageBuffer = (lgfx::swap565_t*)heap_caps_malloc(
+        COMPOSITOR_STAGE_PIXELS * sizeof(lgfx::swap565_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (_stageBuffer != nullptr) {
+        for (int i = 0; i < COMPOSITOR_PALETTE_SIZE; i++) {
+            uint16_t c = COMPOSITOR_PALETTE[i];
+            _paletteLut[i] = (uint16_t)((c >> 8) | (c << 8));
+        }
+        _canvas.setColorDepth(8);
+        _stats.stagingBytes += COMPOSITOR_STAGE_PIXELS * sizeof(lgfx::swap565_t);
+    } else {
+        Serial.println("[Compositor] Palette buffer allocation failed - using a 16bpp sprite");
+    }
+#endif
+
+    if (_canvas.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT) == nullptr) {
+        Serial.println("[Compositor] Sprite allocation failed - drawing direct to panel");
+        _ready = false;
+        return false;
+    }
+
+    _canvas.fillSprite(COLOR_BACKGROUND);
+    _ready = true;
+    _stats.framebufferBytes = SCREEN_WIDTH * SCREEN_HEIGHT * (_canvas.getColorDepth() & 0xFF) / 8;
+    markAllDirty();
+
+#if COMPOSITOR_DMA_FLUSH
+    // SPI DMA can only read internal RAM, so stage dirty regions there
+    for (int i = 0; i < 2; i++) {
+        _dmaBuffers[i] = (lgfx::swap565_t*)heap_caps_malloc(
+            COMPOSITOR_DMA_CHUNK_PIXELS * sizeof(lgfx::swap565_t), MALLOC_CAP_DMA);
+    }
+    if (_dmaBuffers[0] == nullptr || _dmaBuffers[1] == nullptr) {
+        Serial.println("[Compositor] DMA buffer allocation failed - flushing synchronously");
+        for (int i = 0; i < 2; i++) {
+            heap_caps_free(_dmaBuffers[i]);
+            _dmaBuffers[i] = nullptr;
+        }
+    } else {
+        _stats.stagingBytes += 2 * COMPOSITOR_DMA_CHUNK_PIXELS * sizeof(lgfx::swap565_t);
+        Serial.printf("[Compositor] DMA flush enabled: 2 x %u bytes\n",
+                      (unsigned)(COMPOSITOR_DMA_CHUNK_PIXELS * sizeof(lgfx::swap565_t)));
+    }
+#endif
+
+    Serial.printf("[Compositor] Sprite ready: %dx%d %dbpp (%lu bytes)\n",
+                  SCREEN_WIDTH, SCREEN_HEIGHT, (int)(_canvas.getColorDepth() & 0xFF),
+                  (unsigned long)_stats.framebufferBytes);
+    return true;
+}
+
+bool Compositor::isReady() const {
+    return _ready;
+}
+
+lgfx::LovyanGFX& Compositor::target() {
+    if (_ready) {
+        return _canvas;
+    }
+    return _display;
+}
+
+// ============================================================================
+// Dirty Region Tracking
+// ============================================================================
+
+void Compositor::markDirty(int x, int y, int w, int h) {
+    // Clip to screen
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > SCREEN_WIDTH) { w = SCREEN_WIDTH - x; }
+    if (y + h > SCREEN_HEIGHT) { h = SCREEN_HEIGHT - y; }
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    DirtyRect rect = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+
+    for (;;) {
+        // Absorb every existing rectangle that overlaps the new one. The
+        // merged rectangle grows, so keep scanning until nothing else overlaps.
+        bool mergedAny = true;
+        while (mergedAny) {
+            mergedAny = false;
+            for (int i = 0; i < _dirtyCount; i++) {
+                if (overlaps(_dirty[i], rect)) {
+                    merge(rect, _dirty[i]);
+                    _dirty[i] = _dirty[--_dirtyCount];
+                    mergedAny = true;
+                    break;
+                }
+            }
+        }
+
+        if (_dirtyCount < COMPOSITOR_MAX_DIRTY_RECTS) {
+            _dirty[_dirtyCount++] = rect;
+            return;
+        }
+
+        // List is full - merge with the rectangle that grows the least, then
+        // absorb whatever the grown rectangle now overlaps. Each pass takes
+        // one entry out of the list, so this ends with room for it.
+        int bestIndex = 0;
+        uint32_t bestGrowth = UINT32_MAX;
+        for (int i = 0; i < _dirtyCount; i++) {
+            DirtyRect candidate = _dirty[i];
+            merge(candidate, rect);
+            uint32_t growth = area(candidate) - area(_dirty[i]);
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                bestIndex = i;
+            }
+        }
+        merge(rect, _dirty[bestIndex]);
+        _dirty[bestIndex] = _dirty[--_dirtyCount];
+    }
+}
+
+void Compositor::markAllDirty() {
+    _dirty[0] = { 0, 0, (int16_t)SCREEN_WIDTH, (int16_t)SCREEN_HEIGHT };
+    _dirtyCount = 1;
+}
+
+bool Compositor::hasDirtyRegions() const {
+    return _dirtyCount > 0;
+}
+
+// ============================================================================
+// Flushing
+// ============================================================================
+
+void Compositor::flush() {
+    if (_dirtyCount == 0) {
+        return;
+    }
+    RENDER_PROFILE_SCOPE(RenderSection::COMPOSITOR_FLUSH);
+
+    if (!_ready) {
+        // Everything was drawn straight to the panel already
+        _dirtyCount = 0;
+        _display.display();
+        return;
+    }
+
+    uint32_t startUs = micros();
+    uint32_t pixels = 0;
+    _stats.lastStageUs = 0;
+
+#if COMPOSITOR_DMA_FLUSH
+    // The first flush runs synchronously to measure what a blocking push
+    // costs per pixel; later DMA flushes report the cycles they save
+    if (_dmaBuffers[0] != nullptr && _syncCyclesPerKpx > 0) {
+        uint32_t blockedCycles = 0;
+
+        // The previous frame's last region may still be transferring
+        uint32_t waitStart = ESP.getCycleCount();
+        finishFlush();
+        blockedCycles += ESP.getCycleCount() - waitStart;
+
+        // Held until the next flush so the last transfer runs in the background
+        _display.startWrite();
+        for (int i = 0; i < _dirtyCount; i++) {
+            pushRectDMA(_dirty[i], blockedCycles);
+            pixels += area(_dirty[i]);
+        }
+        _dmaInFlight = true;
+
+        uint32_t syncCycles = (uint32_t)(((uint64_t)pixels * _syncCyclesPerKpx) >> 10);
+        uint32_t reclaimed = syncCycles > blockedCycles ? syncCycles - blockedCycles : 0;
+
+        _stats.flushCount++;
+        _stats.dmaFlushes++;
+        _stats.rectsPushed += _dirtyCount;
+        _stats.pixelsPushed += pixels;
+        _stats.lastFlushPixels = pixels;
+        _stats.lastFlushUs = micros() - startUs;
+        _stats.flushUs += _stats.lastFlushUs;
+        _stats.lastBlockedCycles = blockedCycles;
+        _stats.lastReclaimedCycles = reclaimed;
+        _stats.reclaimedCycles += reclaimed;
+        RENDER_PROFILE_PIXELS(pixels);
+        RENDER_PROFILE_PRIMITIVES(_dirtyCount);
+
+        _dirtyCount = 0;
+        return;
+    }
+    uint32_t startCycles = ESP.getCycleCount();
+#endif
+
+    _display.waitDisplay();
+    _display.startWrite();
+
+    for (int i = 0; i < _dirtyCount; i++) {
+        const DirtyRect& r = _dirty[i];
+
+#if COMPOSITOR_PALETTE_8BPP
+        if (_stageBuffer != nullptr) {
+            pushRectStaged(r);
+            pixels += area(r);
+            continue;
+        }
+#endif
+        // Pushing the whole sprite through a clip rect only transfers the
+        // clipped window, read directly out of the sprite buffer
+        _display.setClipRect(r.x, r.y, r.w, r.h);
+        _canvas.pushSprite(&_display, 0, 0);
+        pixels += area(r);
+    }
+
+    _display.clearClipRect();
+    _display.endWrite();
+    _display.display();
+
+#if COMPOSITOR_DMA_FLUSH
+    if (_syncCyclesPerKpx == 0 && pixels > 0) {
+        uint32_t cycles = ESP.getCycleCount() - startCycles;
+        _syncCyclesPerKpx = (uint32_t)(((uint64_t)cycles << 10) / pixels);
+        Serial.printf("[Compositor] Blocking push: %lu cycles per 1024 px\n",
+                      (unsigned long)_syncCyclesPerKpx);
+    }
+#endif
+
+    _stats.flushCount++;
+    _stats.rectsPushed += _dirtyCount;
+    _stats.pixelsPushed += pixels;
+    _stats.lastFlushPixels = pixels;
+    _stats.lastFlushUs = micros() - startUs;
+    _stats.flushUs += _stats.lastFlushUs;
+    RENDER_PROFILE_PIXELS(pixels);
+    RENDER_PROFILE_PRIMITIVES(_dirtyCount);
+
+    _dirtyCount = 0;
+}
+
+void Compositor::finishFlush() {
+#if COMPOSITOR_DMA_FLUSH
+    if (!_dmaInFlight) {
+        return;
+    }
+    _display.waitDMA();
+    _display.endWrite();
+    _display.display();
+    _dmaInFlight = false;
+#endif
+}
+
+#if COMPOSITOR_DMA_FLUSH
+void Compositor::pushRectDMA(const DirtyRect& r, uint32_t& blockedCycles) {
+    int rowsPerChunk = std::max(1, COMPOSITOR_DMA_CHUNK_PIXELS / (int)r.w);
+
+    for (int y = r.y; y < r.y + r.h; y += rowsPerChunk) {
+        int rows = std::min(rowsPerChunk, r.y + r.h - y);
+
+        // Starting the previous transfer waited for the one before it, so
+        // this buffer is no longer being read
+        lgfx::swap565_t* dst = _dmaBuffers[_dmaBufferIndex];
+        stageRows(dst, r, y, rows);
+
+        // Returns once the transfer has started; only waiting for the
+        // previous transfer to finish counts as blocked
+        uint32_t pushStart = ESP.getCycleCount();
+        _display.pushImageDMA(r.x, y, r.w, rows, dst);
+        blockedCycles += ESP.getCycleCount() - pushStart;
+
+        _dmaBufferIndex ^= 1;
+    }
+}
+#endif
+
+#if COMPOSITOR_PALETTE_8BPP
+void Compositor::pushRectStaged(const DirtyRect& r) {
+    int rowsPerChunk = std::max(1, COMPOSITOR_STAGE_PIXELS / (int)r.w);
+
+    for (int y = r.y; y < r.y + r.h; y += rowsPerChunk) {
+        int rows = std::min(rowsPerChunk, r.y + r.h - y);
+        stageRows(_stageBuffer, r, y, rows);
+        _display.pushImage(r.x, y, r.w, rows, _stageBuffer);
+    }
+}
+#endif
+
+#if COMPOSITOR_DMA_FLUSH || COMPOSITOR_PALETTE_8BPP
+void Compositor::stageRows(lgfx::swap565_t* dst, const DirtyRect& r, int y, int rows) {
+    uint32_t startUs = micros();
+
+#if COMPOSITOR_PALETTE_8BPP
+    if (_stageBuffer != nullptr) {
+        // One RGB332 byte per pixel, expanded to RGB565 in panel byte order
+        const uint8_t* src = (const uint8_t*)_canvas.getBuffer();
+        uint16_t* out = (uint16_t*)dst;
+        for (int row = 0; row < rows; row++) {
+            const uint8_t* in = src + (y + row) * SCREEN_WIDTH + r.x;
+            for (int x = 0; x < r.w; x++) {
+                *out++ = _paletteLut[in[x]];
+            }
+        }
+        _stats.lastStageUs += micros() - startUs;
+        return;
+    }
+#endif
+
+    // 16-bit sprites store pixels in panel byte order, so staging is a plain copy
+    const lgfx::swap565_t* src = (const lgfx::swap565_t*)_canvas.getBuffer();
+    for (int row = 0; row < rows; row++) {
+        memcpy(dst + row * r.w, src + (y + row) * SCREEN_WIDTH + r.x,
+               r.w * sizeof(lgfx::swap565_t));
+    }
+    _stats.lastStageUs += micros() - startUs;
+}
+#endif
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const CompositorStats& Compositor::getStats() const {
+    return _stats;
+}
+
+void Compositor::printStats() const {
+    uint32_t avgPixels = _stats.flushCount > 0 ? _stats.pixelsPushed / _stats.flushCount : 0;
+    uint32_t usPerKpx = _stats.pixelsPushed > 0
+        ? (uint32_t)((_stats.flushUs * 1000) / _stats.pixelsPushed) : 0;
+
+    Serial.println("[Compositor] === FLUSH STATS ===");
+    Serial.printf("  Framebuffer: %lu bytes (%s), staging: %lu bytes\n",
+                  (unsigned long)_stats.framebufferBytes,
+                  _stats.framebufferBytes < SCREEN_WIDTH * SCREEN_HEIGHT * 2 ? "8bpp palette" : "RGB565",
+                  (unsigned long)_stats.stagingBytes);
+    Serial.printf("  Flushes: %lu, rects: %lu\n",
+                  (unsigned long)_stats.flushCount, (unsigned long)_stats.rectsPushed);
+    Serial.printf("  Pixels pushed: %lu total, %lu avg/flush (%lu bytes)\n",
+                  (unsigned long)_stats.pixelsPushed, (unsigned long)avgPixels,
+                  (unsigned long)(avgPixels * 2));
+    Serial.printf("  Last flush: %lu px in %lu us (%lu us staging), %lu us per 1000 px avg\n",
+                  (unsigned long)_stats.lastFlushPixels, (unsigned long)_stats.lastFlushUs,
+                  (unsigned long)_stats.lastStageUs, (unsigned long)usPerKpx);
+#if COMPOSITOR_DMA_FLUSH
+    uint32_t avgReclaimed = _stats.dmaFlushes > 0
+        ? (uint32_t)(_stats.reclaimedCycles / _stats.dmaFlushes) : 0;
+    Serial.printf("  DMA flushes: %lu, reclaimed %lu cycles/frame avg, last %lu (blocked %lu)\n",
+                  (unsigned long)_stats.dmaFlushes, (unsigned long)avgReclaimed,
+                  (unsigned long)_stats.lastReclaimedCycles,
+                  (unsigned long)_stats.lastBlockedCycles);
+#endif
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+bool Compositor::overlaps(const DirtyRect& a, const DirtyRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+void Compositor::merge(DirtyRect& into, const DirtyRect& other) {
+    int left = std::min(into.x, other.x);
+    int top = std::min(into.y, other.y);
+    int right = std::max(into.x + into.w, other.x + other.w);
+    int bottom = std::max(into.y + into.h, other.y + other.h);
+
+    into.x = (int16_t)left;
+    into.y = (int16_t)top;
+    into.w = (int16_t)(right - left);
+    into.h = (int16_t)(bottom - top);
+}
+
+uint32_t Compositor::area(const DirtyRect& r) {
+    return (uint32_t)r.w * (uint32_t)r.h;
+}
@@ -9,6 +9,7 @@
 
 #include "dialog.h"
 #include "config.h"
+#include "render_profiler.h"
 #include <Arduino.h>
 #include <cstring>
 
@@ -35,9 +36,11 @@ static constexpr int DIALOG_BUTTON_CORNER_RADIUS = 4;
 static constexpr int DIALOG_PROGRESS_HEIGHT = 10;
 static constexpr int DIALOG_PROGRESS_MARGIN = 20;
 
-// Spinner animation
+// Spinner animation (shared AnimatedSprite timebase)
 static constexpr int DIALOG_SPINNER_SIZE = 16;
-static constexpr uint32_t DIALOG_SPINNER_INTERVAL_MS = 100;
+static constexpr int DIALOG_SPINNER_EXTENT = DIALOG_SPINNER_SIZE / 2 + 3;  // Dots at every angle
+static constexpr int DIALOG_SPINNER_FRAMES = 8;
+static constexpr uint32_t DIALOG_SPINNER_TICKS_PER_FRAME = 1;  // 100ms
 
 // Colors (using existing palette from config.h)
 static constexpr uint16_t DIALOG_BG_COLOR = COLOR_HEADER_BG;
@@ -56,7 +59,7 @@ static constexpr uint16_t DIALOG_HINT_COLOR = COLOR_TEXT_MUTED;
 // Constructor
 // ============================================================================
 
-Dialog::Dialog(M5GFX& display)
+Dialog::Dialog(DisplayTarget& display)
     : _display(display)
     , _buttonCount(0)
     , _type(DialogType::INFO)
@@ -68,7 +71,6 @@ Dialog::Dialog(M5GFX& display)
     , _userData(nullptr)
     , _progress(-1.0f)
     , _spinnerFrame(0)
-    , _lastSpinnerUpdateMs(0)
     , _needsRedraw(false)
     , _hasPendingCallback(false)
     , _pendingResult(DialogResult::NONE)
@@ -160,8 +162,7 @@ void Dialog::showProgress(const char* title, const char* message) {
     _callback = nullptr;
     _userData = nullptr;
     _progress = -1.0f;  // Indeterminate
-    _spinnerFrame = 0;
-    _lastSpinnerUpdateMs = millis();
+    _spinnerFrame = AnimatedSprite::frameAt(DIALOG_SPINNER_TICKS_PER_FRAME, DIALOG_SPINNER_FRAMES);
     _needsRedraw = true;
     
     Serial.printf("[Dialog] showProgress: '%s'\n", title);
@@ -240,10 +241,19 @@ void Dialog::handleButtonB() {
 
 void Dialog::draw() {
     if (!_visible) return;
+    RENDER_PROFILE_SCOPE(RenderSection::DIALOG);
     
     _display.waitDisplay();
     _display.startWrite();
     
+    // Spinner frame only - the frame, title and message are already on screen
+    if (!_needsRedraw && _type == DialogType::PROGRESS && _buttonCount == 0 && _progress < 0) {
+        drawSpinner(true);
+        _display.endWrite();
+        _display.display();
+        return;
+    }
+    
     // Clear screen with background
     _display.fillScreen(COLOR_BACKGROUND);
     
@@ -253,7 +263,7 @@ void Dialog::draw() {
     
     if (_type == DialogType::PROGRESS && _buttonCount == 0) {
         if (_progress < 0) {
-            drawSpinner();
+            drawSpinner(false);
         } else {
             drawProgressBar();
         }
@@ -267,10 +277,14 @@ void Dialog::draw() {
     _needsRedraw = false;
 }
 
+void Dialog::invalidate() {
+    _needsRedraw = true;
+}
+
 bool Dialog::needsRedraw() const {
     if (_type == DialogType::PROGRESS && _progress < 0 && _visible) {
-        // Spinner needs periodic updates
-        return (millis() - _lastSpinnerUpdateMs >= DIALOG_SPINNER_INTERVAL_MS);
+        // Spinner needs an update whenever the shared timebase moves on
+        return AnimatedSprite::frameAt(DIALOG_SPINNER_TICKS_PER_FRAME, DIALOG_SPINNER_FRAMES) != _spinnerFrame;
     }
     return _needsRedraw;
 }
@@ -330,38 +344,11 @@ void Dialog::drawMessage() {
     int messageY = dialogY + DIALOG_TITLE_HEIGHT + DIALOG_PADDING;
     int messageWidth = dialogWidth - (DIALOG_PADDING * 2);
     
-    _display.setTextColor(DIALOG_TEXT_SECONDARY_COLOR);
-    _display.setFont(&fonts::Font0);
-    _display.setTextSize(1);
+    // Word wrap is only recomputed when the message changes
+    _messageLayout.layout(_display, _message, &fonts::Font0, messageWidth);
     
-    // Simple word-wrap text drawing
-    int currentX = messageX;
-    int currentY = messageY;
-    int lineHeight = 12;
-    
-    for (size_t i = 0; i < strlen(_message); i++) {
-        char c = _message[i];
-        
-        if (c == '\n') {
-            currentY += lineHeight;
-            currentX = messageX;
-            continue;
-        }
-        
-        // Get character width
-        char charStr[2] = {c, '\0'};
-        int charWidth = _display.textWidth(charStr);
-        
-        // Check if we need to wrap
-        if (currentX + charWidth > messageX + messageWidth) {
-            currentY += lineHeight;
-            currentX = messageX;
-        }
-        
-        _display.setCursor(currentX, currentY);
-        _display.print(c);
-        currentX += charWidth;
-    }
+    _display.setTextColor(DIALOG_TEXT_SECONDARY_COLOR);
+    _messageLayout.draw(_display, messageX, messageY, 12);
 }
 
 void Dialog::drawButtons() {
@@ -456,7 +443,7 @@ void Dialog::drawProgressBar() {
     }
 }
 
-void Dialog::drawSpinner() {
+void Dialog::drawSpinner(bool frameOnly) {
     int dialogX = DIALOG_MARGIN;
     int dialogY = DIALOG_MARGIN;
     int dialogWidth = SCREEN_WIDTH - (DIALOG_MARGIN * 2);
@@ -466,28 +453,35 @@ void Dialog::drawSpinner() {
     int spinnerX = dialogX + dialogWidth / 2;
     int spinnerY = dialogY + dialogHeight - DIALOG_SPINNER_SIZE - 20;
     
+    // Frames are rendered once; a frame step pushes only the dots that changed
+    int size = DIALOG_SPINNER_EXTENT * 2 + 1;
+    _spinner.begin(size, size, DIALOG_SPINNER_FRAMES, DIALOG_BG_COLOR, renderSpinnerFrame, nullptr);
+    
+    uint8_t frame = AnimatedSprite::frameAt(DIALOG_SPINNER_TICKS_PER_FRAME, DIALOG_SPINNER_FRAMES);
+    _spinner.draw(_display, spinnerX - DIALOG_SPINNER_EXTENT, spinnerY - DIALOG_SPINNER_EXTENT,
+                  frame, frameOnly ? _spinnerFrame : -1);
+    _spinnerFrame = frame;
+}
+
+void Dialog::renderSpinnerFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData) {
+    int spinnerX = x + DIALOG_SPINNER_EXTENT;
+    int spinnerY = y + DIALOG_SPINNER_EXTENT;
+    
     // Simple rotating dots animation
-    int dotCount = 8;
+    int dotCount = DIALOG_SPINNER_FRAMES;
     int radius = DIALOG_SPINNER_SIZE / 2;
     int dotRadius = 2;
     
     for (int i = 0; i < dotCount; i++) {
-        float angle = (2.0f * PI * i / dotCount) + (_spinnerFrame * 0.5f);
+        float angle = (2.0f * PI * i / dotCount) + (frame * 0.5f);
         int dotX = spinnerX + (int)(radius * cos(angle));
         int dotY = spinnerY + (int)(radius * sin(angle));
         
         // Fade dots based on position relative to current frame
-        uint16_t color = (i == (_spinnerFrame % dotCount)) ? 
+        uint16_t color = (i == (frame % dotCount)) ? 
                          DIALOG_TEXT_COLOR : DIALOG_TEXT_SECONDARY_COLOR;
         
-        _display.fillCircle(dotX, dotY, dotRadius, color);
-    }
-    
-    // Update spinner frame
-    uint32_t now = millis();
-    if (now - _lastSpinnerUpdateMs >= DIALOG_SPINNER_INTERVAL_MS) {
-        _spinnerFrame = (_spinnerFrame + 1) % dotCount;
-        _lastSpinnerUpdateMs = now;
+        gfx.fillCircle(dotX, dotY, dotRadius, color);
     }
 }
 
@@ -0,0 +1,15 @@
+/**
+ * font_subsets.cpp - Storage for the generated font subsets
+ *
+ * The only translation unit that includes font_subsets_data.h, so each
+ * subset is stored in flash once.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "font_subsets.h"
+
+#if FONT_SUBSETS_GENERATED
+#include "font_subsets_data.h"
+#endif
@@ -0,0 +1,118 @@
+/**
+ * frame_capture.cpp - In-memory display backend implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "frame_capture.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+#endif
+
+static constexpr size_t FRAME_PIXELS = (size_t)SCREEN_WIDTH * SCREEN_HEIGHT;
+
+// Snapshot buffer: PSRAM on the device, the ordinary heap on the host
+static uint16_t* allocateSnapshot() {
+#ifdef ARDUINO
+    return (uint16_t*)heap_caps_malloc(FRAME_PIXELS * sizeof(uint16_t),
+                                       MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return (uint16_t*)malloc(FRAME_PIXELS * sizeof(uint16_t));
+#endif
+}
+
+static void freeSnapshot(uint16_t* snapshot) {
+#ifdef ARDUINO
+    heap_caps_free(snapshot);
+#else
+    free(snapshot);
+#endif
+}
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+FrameCapture::FrameCapture()
+    : _previous(nullptr)
+{
+}
+
+FrameCapture::~FrameCapture() {
+    if (_previous != nullptr) {
+        freeSnapshot(_previous);
+    }
+    _canvas.deleteSprite();
+}
+
+bool FrameCapture::begin() {
+    if (_previous != nullptr) {
+        return true;
+    }
+
+    _canvas.setColorDepth(16);
+    _canvas.setPsram(true);
+    if (_canvas.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT) == nullptr) {
+        Serial.println("[FrameCapture] Canvas allocation failed");
+        return false;
+    }
+
+    _previous = allocateSnapshot();
+    if (_previous == nullptr) {
+        Serial.println("[FrameCapture] Snapshot allocation failed");
+        _canvas.deleteSprite();
+        return false;
+    }
+
+    clear(COLOR_BACKGROUND);
+    return true;
+}
+
+// ============================================================================
+// Capture
+// ============================================================================
+
+DisplayTarget& FrameCapture::target() {
+    return _canvas;
+}
+
+void FrameCapture::clear(uint16_t color) {
+    _canvas.fillSprite(color);
+    if (_previous != nullptr) {
+        memcpy(_previous, pixels(), FRAME_PIXELS * sizeof(uint16_t));
+    }
+}
+
+FrameResult FrameCapture::endFrame() {
+    FrameResult result = { 2166136261u, 0 };
+    if (_previous == nullptr) {
+        return result;
+    }
+
+    const uint16_t* current = pixels();
+    for (size_t i = 0; i < FRAME_PIXELS; i++) {
+        uint16_t pixel = current[i];
+        if (pixel != _previous[i]) {
+            result.changedPixels++;
+            _previous[i] = pixel;
+        }
+        // FNV-1a, one byte at a time
+        result.checksum = (result.checksum ^ (pixel & 0xFF)) * 16777619u;
+        result.checksum = (result.checksum ^ (pixel >> 8)) * 16777619u;
+    }
+
+    return result;
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+const uint16_t* FrameCapture::pixels() {
+    return static_cast<const uint16_t*>(_canvas.getBuffer());
+}
@@ -0,0 +1,138 @@
+/**
+ * glyph_atlas.cpp - Pre-rendered glyph atlas implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "glyph_atlas.h"
+#include <Arduino.h>
+#include <algorithm>
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+GlyphAtlas::GlyphAtlas()
+    : _ready(false)
+    , _glyphCount(0)
+    , _colorCount(0)
+    , _cellHeight(0)
+{
+    memset(_glyphs, 0, sizeof(_glyphs));
+    memset(_glyphX, 0, sizeof(_glyphX));
+    memset(_glyphWidth, 0, sizeof(_glyphWidth));
+}
+
+bool GlyphAtlas::begin(const lgfx::IFont* font, const char* glyphs,
+                       const uint16_t* colors, int colorCount,
+                       uint16_t background, int cellHeight) {
+    if (_ready) {
+        return true;
+    }
+
+    _glyphCount = 0;
+    _colorCount = std::min(colorCount, GLYPH_ATLAS_MAX_COLORS);
+    _cellHeight = cellHeight;
+
+    // Measure advances first so the sprite can be sized exactly
+    _sprite.setFont(font);
+    _sprite.setTextSize(1);
+
+    int atlasWidth = 0;
+    for (const char* p = glyphs; *p && _glyphCount < GLYPH_ATLAS_MAX_GLYPHS; p++) {
+        char glyphStr[2] = { *p, '\0' };
+        _glyphs[_glyphCount] = *p;
+        _glyphX[_glyphCount] = (int16_t)atlasWidth;
+        _glyphWidth[_glyphCount] = (int16_t)_sprite.textWidth(glyphStr);
+        atlasWidth += _glyphWidth[_glyphCount];
+        _glyphCount++;
+    }
+
+    if (_glyphCount == 0 || _colorCount <= 0 || atlasWidth <= 0) {
+        return false;
+    }
+
+    _sprite.setColorDepth(16);
+    _sprite.setPsram(true);
+    if (_sprite.createSprite(atlasWidth, _cellHeight * _colorCount) == nullptr) {
+        Serial.println("[GlyphAtlas] Sprite allocation failed");
+        return false;
+    }
+
+    _sprite.fillSprite(background);
+    _sprite.setFont(font);
+    _sprite.setTextSize(1);
+
+    // Rasterize every glyph once per color, clipped to its own cell
+    for (int row = 0; row < _colorCount; row++) {
+        _sprite.setTextColor(colors[row]);
+        for (int i = 0; i < _glyphCount; i++) {
+            char glyphStr[2] = { _glyphs[i], '\0' };
+            int cellY = row * _cellHeight;
+            _sprite.setClipRect(_glyphX[i], cellY, _glyphWidth[i], _cellHeight);
+            _sprite.setCursor(_glyphX[i], cellY);
+            _sprite.print(glyphStr);
+        }
+    }
+    _sprite.clearClipRect();
+
+    _ready = true;
+    Serial.printf("[GlyphAtlas] Rendered %d glyphs x %d colors (%dx%d, %u bytes)\n",
+                  _glyphCount, _colorCount, atlasWidth, _cellHeight * _colorCount,
+                  (unsigned)(atlasWidth * _cellHeight * _colorCount * 2));
+    return true;
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+bool GlyphAtlas::isReady() const {
+    return _ready;
+}
+
+bool GlyphAtlas::hasGlyph(char c) const {
+    return indexOf(c) >= 0;
+}
+
+int GlyphAtlas::glyphWidth(char c) const {
+    int i = indexOf(c);
+    return i >= 0 ? _glyphWidth[i] : 0;
+}
+
+int GlyphAtlas::cellHeight() const {
+    return _cellHeight;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+int GlyphAtlas::drawGlyph(lgfx::LovyanGFX& gfx, char c, int colorIndex, int x, int y) {
+    int i = indexOf(c);
+    if (!_ready || i < 0 || colorIndex < 0 || colorIndex >= _colorCount) {
+        return 0;
+    }
+
+    // Position the whole atlas so the wanted cell lands at (x, y),
+    // and clip the target to that cell - only the cell is transferred
+    gfx.setClipRect(x, y, _glyphWidth[i], _cellHeight);
+    _sprite.pushSprite(&gfx, x - _glyphX[i], y - colorIndex * _cellHeight);
+    gfx.clearClipRect();
+
+    return _glyphWidth[i];
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+int GlyphAtlas::indexOf(char c) const {
+    for (int i = 0; i < _glyphCount; i++) {
+        if (_glyphs[i] == c) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,244 @@
+/**
+ * header.cpp - Cached header strip implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "header.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <cstring>
+
+// Right-aligned indicators: battery at the right edge, Wi-Fi to its left
+static constexpr int WIFI_WIDTH = 24;
+static constexpr int WIFI_HEIGHT = 16;
+static constexpr int BATTERY_WIDTH = 12;
+static constexpr int BATTERY_HEIGHT = 16;
+static constexpr int BATTERY_X = SCREEN_WIDTH - HEADER_ITEM_GAP - BATTERY_WIDTH;
+static constexpr int WIFI_X = BATTERY_X - HEADER_ITEM_GAP - WIFI_WIDTH;
+// Offsets from the top of the strip (both indicators vertically centered)
+static constexpr int WIFI_Y = (HEADER_HEIGHT - WIFI_HEIGHT) / 2;
+static constexpr int BATTERY_Y = (HEADER_HEIGHT - BATTERY_HEIGHT) / 2;
+
+// ============================================================================
+// Constructor / Initialization
+// ============================================================================
+
+HeaderLayer::HeaderLayer()
+    : _ready(false)
+    , _composed(false)
+    , _composedWifi(Icon::WIFI_DISCONNECTED)
+    , _composedBattery(Icon::BATTERY_0)
+    , _wifiIcon(Icon::WIFI_DISCONNECTED)
+    , _batteryIcon(Icon::BATTERY_0)
+{
+    _title[0] = '\0';
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool HeaderLayer::begin() {
+    if (_ready) {
+        return true;
+    }
+
+    // 240x24 RGB565 = ~11KB
+    _canvas.setPsram(true);
+    _canvas.setColorDepth(16);
+
+    if (_canvas.createSprite(SCREEN_WIDTH, HEADER_HEIGHT) == nullptr) {
+        Serial.println("[Header] Layer allocation failed - drawing header directly");
+        _ready = false;
+        return false;
+    }
+
+    _ready = true;
+    _composed = false;
+    return true;
+}
+
+// ============================================================================
+// State
+// ============================================================================
+
+bool HeaderLayer::setNetworkStatus(NetworkStatus status) {
+    Icon icon = Icon::WIFI_DISCONNECTED;
+    if (status == NetworkStatus::CONNECTED) {
+        icon = Icon::WIFI_CONNECTED;
+    } else if (status == NetworkStatus::CONNECTING) {
+        icon = Icon::WIFI_CONNECTING;
+    } else if (status == NetworkStatus::ERROR) {
+        icon = Icon::WIFI_ERROR;
+    }
+
+    bool changed = (icon != _wifiIcon);
+    _wifiIcon = icon;
+    return changed;
+}
+
+bool HeaderLayer::setBatteryLevel(int level) {
+    // >80%: 4 bars, >60%: 3 bars, >40%: 2 bars, >20%: 1 bar, <20%: 0 bars
+    int barsLit = 0;
+    if (level > 80) {
+        barsLit = 4;
+    } else if (level > 60) {
+        barsLit = 3;
+    } else if (level > 40) {
+        barsLit = 2;
+    } else if (level > 20) {
+        barsLit = 1;
+    }
+
+    Icon icon = (Icon)((int)Icon::BATTERY_0 + barsLit);
+    bool changed = (icon != _batteryIcon);
+    _batteryIcon = icon;
+    return changed;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void HeaderLayer::draw(lgfx::LovyanGFX& gfx, const char* title) {
+    if (title == nullptr) {
+        title = "";
+    }
+
+    if (!_ready) {
+        renderStrip(gfx, HEADER_Y, title);
+        _stats.stripBlits++;
+        return;
+    }
+
+    compose(title);
+    _canvas.pushSprite(&gfx, 0, HEADER_Y);
+    _stats.stripBlits++;
+    RENDER_PROFILE_PIXELS((uint32_t)_canvas.width() * _canvas.height());
+    RENDER_PROFILE_PRIMITIVES(1);
+}
+
+void HeaderLayer::drawIndicators(lgfx::LovyanGFX& gfx) {
+    if (_ready) {
+        // Keep the layer in step so the next strip blit matches
+        compose(_title);
+    }
+    renderIndicators(gfx, HEADER_Y);
+    _stats.indicatorBlits++;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const HeaderLayerStats& HeaderLayer::getStats() const {
+    return _stats;
+}
+
+void HeaderLayer::printStats() const {
+    Serial.println("[Header] === LAYER STATS ===");
+    Serial.printf("  Composes: %lu, indicator updates: %lu\n",
+                  (unsigned long)_stats.composes, (unsigned long)_stats.indicatorUpdates);
+    Serial.printf("  Strip blits: %lu, indicator blits: %lu\n",
+                  (unsigned long)_stats.stripBlits, (unsigned long)_stats.indicatorBlits);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+void HeaderLayer::compose(const char* title) {
+    if (!_composed || strncmp(title, _title, HEADER_TITLE_MAX_LEN - 1) != 0) {
+        // New title (or first use): render the whole strip once
+        if (title != _title) {
+            strncpy(_title, title, HEADER_TITLE_MAX_LEN - 1);
+            _title[HEADER_TITLE_MAX_LEN - 1] = '\0';
+        }
+        renderStrip(_canvas, 0, _title);
+        _composed = true;
+        _stats.composes++;
+        return;
+    }
+
+    // Same title: only the indicators can have changed
+    if (_wifiIcon != _composedWifi || _batteryIcon != _composedBattery) {
+        renderIndicators(_canvas, 0);
+        _stats.indicatorUpdates++;
+    }
+}
+
+void HeaderLayer::renderStrip(lgfx::LovyanGFX& gfx, int y, const char* title) {
+    gfx.startWrite();
+
+    // Header background (full width, no border)
+    gfx.fillRect(0, y, SCREEN_WIDTH, HEADER_HEIGHT, COLOR_HEADER_BG);
+
+    // 1. Logo (22x14 rounded white rectangle with a face), pre-rendered
+    int currentX = HEADER_ITEM_GAP;
+    int logoY = y + (HEADER_HEIGHT - IconAtlas::height(Icon::LOGO)) / 2;
+    IconAtlas::getInstance().draw(gfx, Icon::LOGO, currentX, logoY);
+    currentX += IconAtlas::width(Icon::LOGO) + HEADER_ITEM_GAP;
+
+    // 2. Title with FreeSans9pt7b, 4px below top of header
+    gfx.setTextColor(COLOR_TEXT_PRIMARY);
+    gfx.setTextSize(1);
+    gfx.setFont(&fonts::FreeSans9pt7b);
+    gfx.setCursor(currentX, y + 4);
+    gfx.print(title);
+
+    // 3. Right-aligned Wi-Fi and battery indicators
+    renderIndicators(gfx, y);
+
+    gfx.endWrite();
+}
+
+void HeaderLayer::renderIndicators(lgfx::LovyanGFX& gfx, int y) {
+    IconAtlas& icons = IconAtlas::getInstance();
+
+    // Wi-Fi: triangle (point at bottom) in the status color with the status character
+    icons.draw(gfx, _wifiIcon, WIFI_X, y + WIFI_Y);
+
+    // Battery: 4 stacked bars, bottom bars lit white first, the rest 25% gray
+    icons.draw(gfx, _batteryIcon, BATTERY_X, y + BATTERY_Y);
+
+    // M5stickC plus2 does not support isCharging detection - see https://community.m5stack.com/topic/6006/m5stickcp2-ischarging-inf-power-class-does-not-function
+    bool isCharging = 0; // M5.Power.isCharging();
+    if (isCharging) {
+        drawChargingBolt(gfx, BATTERY_X, y + BATTERY_Y);
+    }
+
+    if (&gfx == &_canvas) {
+        _composedWifi = _wifiIcon;
+        _composedBattery = _batteryIcon;
+    }
+}
+
+void HeaderLayer::drawChargingBolt(lgfx::LovyanGFX& gfx, int batteryX, int batteryY) {
+    // Lightning bolt centered on battery indicator
+    int boltCenterX = batteryX + BATTERY_WIDTH / 2;
+    int boltCenterY = batteryY + BATTERY_HEIGHT / 2;
+
+    // Simple lightning bolt vertices (two triangles forming a zigzag)
+    int x1 = boltCenterX + 1; // Top right of upper triangle
+    int y1 = boltCenterY - 6;
+    int x2 = boltCenterX - 3; // Left side
+    int y2 = boltCenterY - 1;
+    int x3 = boltCenterX; // Inner left
+    int y3 = boltCenterY - 1;
+    int x4 = boltCenterX - 2; // Bottom left of lower part
+    int y4 = boltCenterY + 6;
+    int x5 = boltCenterX + 2; // Right side
+    int y5 = boltCenterY + 1;
+    int x6 = boltCenterX - 1; // Inner right
+    int y6 = boltCenterY + 1;
+
+    constexpr uint16_t COLOR_STROKE = 0x0000; // Black stroke
+    constexpr uint16_t COLOR_BOLT = 0xFFFF;   // White fill
+
+    // Draw stroke by drawing slightly larger shapes in black (2px offset)
+    gfx.fillTriangle(x1 - 2, y1 - 2, x2 - 2, y2, x6 + 2, y6, COLOR_STROKE);
+    gfx.fillTriangle(x3 - 2, y3, x4 - 2, y4 + 2, x5 + 2, y5, COLOR_STROKE);
+
+    // Draw white fill
+    gfx.fillTriangle(x1, y1, x2, y2, x6, y6, COLOR_BOLT);
+    gfx.fillTriangle(x3, y3, x4, y4, x5, y5, COLOR_BOLT);
+}
@@ -0,0 +1,270 @@
+/**
+ * http_message.cpp - HTTP/1.1 message framing implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "http_message.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// ============================================================================
+// Request
+// ============================================================================
+
+int formatHttpRequestHeader(char* buffer, size_t bufferSize, const char* method,
+                            const char* host, const char* basePath, const char* endpoint,
+                            const char* apiKey, long bodyLength) {
+    int length = snprintf(buffer, bufferSize,
+                          "%s %s%s HTTP/1.1\r\n"
+                          "Host: %s\r\n"
+                          "Content-Type: application/json\r\n"
+                          "Accept: application/json\r\n"
+                          "Connection: keep-alive\r\n",
+                          method, basePath, endpoint, host);
+
+    if (apiKey != nullptr && length < (int)bufferSize) {
+        length += snprintf(buffer + length, bufferSize - length, "X-API-Key: %s\r\n", apiKey);
+    }
+    if (bodyLength >= 0 && length < (int)bufferSize) {
+        length += snprintf(buffer + length, bufferSize - length,
+                           "Content-Length: %ld\r\n", bodyLength);
+    }
+    if (length < (int)bufferSize) {
+        length += snprintf(buffer + length, bufferSize - length, "\r\n");
+    }
+
+    return length < (int)bufferSize ? length : -1;
+}
+
+// ============================================================================
+// Response
+// ============================================================================
+
+HttpResponseReader::HttpResponseReader(HttpStream& stream, HttpIdleCallback idle, void* userData)
+    : _stream(stream)
+    , _idle(idle)
+    , _userData(userData)
+    , _started(false)
+    , _body(nullptr)
+    , _bodySize(0)
+    , _stored(0)
+    , _overflowed(false)
+{
+}
+
+bool HttpResponseReader::responseStarted() const {
+    return _started;
+}
+
+int HttpResponseReader::read(char* buffer, size_t bufferSize, bool& keepAlive, bool headRequest) {
+    char line[HTTP_LINE_SIZE];
+    _started = false;
+    keepAlive = false;
+    buffer[0] = '\0';
+
+    // Status line, after any interim 1xx responses (each with its own headers)
+    bool persistent = false;
+    int httpCode = readStatusLine(line, sizeof(line), persistent);
+    while (httpCode >= 100 && httpCode < 200 && httpCode != 101) {
+        int result;
+        while ((result = readLine(line, sizeof(line))) > 0) {
+        }
+        if (result < 0) {
+            return result;
+        }
+        httpCode = readStatusLine(line, sizeof(line), persistent);
+    }
+    if (httpCode < 0) {
+        return httpCode;
+    }
+
+    // Headers, up to the blank line
+    long contentLength = -1;
+    bool chunked = false;
+    int result;
+    for (;;) {
+        result = readLine(line, sizeof(line));
+        if (result < 0) {
+            return result;
+        }
+        if (result == 0) {
+            break;
+        }
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = strtol(line + 15, nullptr, 10);
+        } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+            chunked = strstr(line + 18, "chunked") != nullptr;
+        } else if (strncasecmp(line, "Connection:", 11) == 0) {
+            const char* value = line + 11;
+            while (*value == ' ') {
+                value++;
+            }
+            if (strncasecmp(value, "close", 5) == 0) {
+                persistent = false;
+            } else if (strncasecmp(value, "keep-alive", 10) == 0) {
+                persistent = true;
+            }
+        }
+    }
+
+    // No body, whatever the headers say: the next response (if any) starts
+    // right here, so waiting for a length or a close would only stall
+    if (headRequest || httpCode == 204 || httpCode == 304) {
+        keepAlive = persistent;
+        return httpCode;
+    }
+    if (httpCode == 101) {
+        // Switching protocols: whatever follows is not HTTP
+        return httpCode;
+    }
+
+    // A body that runs until the server closes ends the connection too
+    if (!chunked && contentLength < 0) {
+        persistent = false;
+    }
+
+    // Body: stored while it fits, otherwise read to its end and dropped
+    _body = buffer;
+    _bodySize = bufferSize;
+    _stored = 0;
+    _overflowed = false;
+
+    if (chunked) {
+        for (;;) {
+            result = readLine(line, sizeof(line));
+            if (result < 0) {
+                return result;
+            }
+            long chunkSize = strtol(line, nullptr, 16);
+            if (chunkSize <= 0) {
+                // Last chunk; skip any trailers
+                while ((result = readLine(line, sizeof(line))) > 0) {
+                }
+                break;
+            }
+            while (chunkSize > 0) {
+                result = readBodyBytes((size_t)chunkSize);
+                if (result <= 0) {
+                    return result < 0 ? result : API_ERROR_RESPONSE;
+                }
+                chunkSize -= result;
+            }
+            // CRLF after the chunk data
+            result = readLine(line, sizeof(line));
+            if (result < 0) {
+                return result;
+            }
+        }
+    } else {
+        // Content-Length, or everything until the server closes
+        size_t remaining = contentLength >= 0 ? (size_t)contentLength : SIZE_MAX;
+        while (remaining > 0) {
+            result = readBodyBytes(remaining);
+            if (result < 0) {
+                return result;
+            }
+            if (result == 0) {
+                if (contentLength >= 0) {
+                    return API_ERROR_RESPONSE;
+                }
+                break;
+            }
+            remaining -= result;
+        }
+    }
+
+    // The whole body was read, so the connection is still in step
+    keepAlive = persistent;
+    if (_overflowed) {
+        buffer[0] = '\0';
+        return API_ERROR_TOO_LARGE;
+    }
+    buffer[_stored] = '\0';
+    return httpCode;
+}
+
+int HttpResponseReader::readStatusLine(char* line, size_t lineSize, bool& persistent) {
+    // "HTTP/1.1 200 OK"
+    int result = readLine(line, lineSize);
+    if (result < 0) {
+        return result;
+    }
+    int versionMajor = 0;
+    int versionMinor = 0;
+    int httpCode = 0;
+    if (sscanf(line, "HTTP/%d.%d %d", &versionMajor, &versionMinor, &httpCode) != 3 || httpCode <= 0) {
+        return API_ERROR_RESPONSE;
+    }
+
+    // HTTP/1.1 connections stay open unless the server says otherwise
+    persistent = versionMajor > 1 || (versionMajor == 1 && versionMinor >= 1);
+    return httpCode;
+}
+
+int HttpResponseReader::readBodyBytes(size_t count) {
+    char scratch[128];
+    size_t want = count < sizeof(scratch) ? count : sizeof(scratch);
+    int result = readBytes(scratch, want);
+    if (result <= 0) {
+        return result;
+    }
+
+    // Keep room for the terminator; once a read misses, drop the rest too
+    // so the buffer never holds the head of the body spliced to its tail
+    if (!_overflowed && _stored + (size_t)result < _bodySize) {
+        memcpy(_body + _stored, scratch, result);
+        _stored += result;
+    } else {
+        _overflowed = true;
+    }
+    return result;
+}
+
+int HttpResponseReader::readLine(char* line, size_t lineSize) {
+    size_t length = 0;
+    for (;;) {
+        if (_stream.available() > 0) {
+            int c = _stream.read();
+            _started = true;
+            if (c == '\n') {
+                break;
+            }
+            if (c >= 0 && c != '\r' && length < lineSize - 1) {
+                line[length++] = (char)c;
+            }
+            continue;
+        }
+        if (!_stream.connected()) {
+            return API_ERROR_RESPONSE;
+        }
+        int error = _idle(_userData);
+        if (error != 0) {
+            return error;
+        }
+    }
+    line[length] = '\0';
+    return (int)length;
+}
+
+int HttpResponseReader::readBytes(char* out, size_t count) {
+    for (;;) {
+        int available = _stream.available();
+        if (available > 0) {
+            size_t want = (size_t)available < count ? (size_t)available : count;
+            int result = _stream.read((uint8_t*)out, want);
+            _started = true;
+            return result < 0 ? API_ERROR_RESPONSE : result;
+        }
+        if (!_stream.connected()) {
+            return 0;  // Closed
+        }
+        int error = _idle(_userData);
+        if (error != 0) {
+            return error;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * icon_atlas.cpp - Run-length encoded icon blitter implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "icon_atlas.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <algorithm>
+
+// ============================================================================
+// Singleton
+// ============================================================================
+
+IconAtlas& IconAtlas::getInstance() {
+    static IconAtlas instance;
+    return instance;
+}
+
+IconAtlas::IconAtlas() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void IconAtlas::draw(lgfx::LovyanGFX& gfx, Icon icon, int x, int y) {
+    if (icon >= Icon::COUNT) {
+        return;
+    }
+
+    uint32_t startUs = micros();
+    const IconAtlasEntry& entry = ICON_ATLAS_ENTRIES[(int)icon];
+
+    // setAddrWindow() shrinks the window to the clip rect, which would shift
+    // the runs; icons that don't fit entirely are drawn span by span instead
+    int32_t clipX, clipY, clipW, clipH;
+    gfx.getClipRect(&clipX, &clipY, &clipW, &clipH);
+    bool inside = x >= clipX && y >= clipY &&
+                  x + entry.width <= clipX + clipW && y + entry.height <= clipY + clipH;
+
+    gfx.startWrite();
+    if (inside) {
+        gfx.setAddrWindow(x, y, entry.width, entry.height);
+        const uint8_t* run = &ICON_ATLAS_RUNS[entry.firstRun];
+        const uint8_t* end = run + entry.runCount;
+        for (; run < end; run++) {
+            gfx.writeColor(ICON_ATLAS_PALETTE[*run >> 4], (uint32_t)(*run & 0x0F) + 1);
+        }
+    } else {
+        drawClipped(gfx, entry, x, y);
+        _stats.clippedBlits++;
+    }
+    gfx.endWrite();
+
+    _stats.blits++;
+    _stats.runs += entry.runCount;
+    _stats.pixels += (uint32_t)entry.width * entry.height;
+    _stats.lastBlitUs = micros() - startUs;
+    RENDER_PROFILE_PIXELS((uint32_t)entry.width * entry.height);
+    RENDER_PROFILE_PRIMITIVES(1);
+}
+
+int IconAtlas::width(Icon icon) {
+    return icon < Icon::COUNT ? ICON_ATLAS_ENTRIES[(int)icon].width : 0;
+}
+
+int IconAtlas::height(Icon icon) {
+    return icon < Icon::COUNT ? ICON_ATLAS_ENTRIES[(int)icon].height : 0;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const IconAtlasStats& IconAtlas::getStats() const {
+    return _stats;
+}
+
+void IconAtlas::printStats() const {
+    Serial.println("[IconAtlas] === BLIT STATS ===");
+    Serial.printf("  Blits: %lu (%lu clipped), last %lu us\n",
+                  (unsigned long)_stats.blits, (unsigned long)_stats.clippedBlits,
+                  (unsigned long)_stats.lastBlitUs);
+    Serial.printf("  Runs: %lu, pixels: %lu\n",
+                  (unsigned long)_stats.runs, (unsigned long)_stats.pixels);
+    Serial.printf("  Atlas: %d icons, %d runs, %d colors\n",
+                  (int)Icon::COUNT, ICON_ATLAS_RUN_COUNT, ICON_ATLAS_PALETTE_SIZE);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+void IconAtlas::drawClipped(lgfx::LovyanGFX& gfx, const IconAtlasEntry& entry, int x, int y) {
+    // Split runs at row ends; writeFastHLine() clips each span
+    int column = 0;
+    int row = 0;
+    const uint8_t* run = &ICON_ATLAS_RUNS[entry.firstRun];
+    const uint8_t* end = run + entry.runCount;
+
+    for (; run < end; run++) {
+        uint16_t color = ICON_ATLAS_PALETTE[*run >> 4];
+        int remaining = (*run & 0x0F) + 1;
+
+        while (remaining > 0) {
+            int span = std::min(remaining, entry.width - column);
+            gfx.writeFastHLine(x + column, y + row, span, color);
+            column += span;
+            remaining -= span;
+            if (column == entry.width) {
+                column = 0;
+                row++;
+            }
+        }
+    }
+}
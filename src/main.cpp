@@ -26,6 +26,8 @@
 // Application modules
 #include "config.h"
 #include "ui.h"
+#include "avatar_cache.h"
+#include "icon_atlas.h"
 #include "timer.h"
 #include "session_manager.h"
 #include "network.h"
@@ -34,6 +36,11 @@
 #include "persistence.h"
 #include "api_client.h"
 #include "polling_manager.h"
+#include "network_task.h"
+#include "render_profiler.h"
+#if RENDER_BENCHMARK
+#include "render_benchmark.h"
+#endif
 
 // New architecture modules
 #include "screen_manager.h"
@@ -64,6 +71,12 @@ RTC_DATA_ATTR int8_t rtcScreenType = -1;        // ScreenType at time of sleep (
 RTC_DATA_ATTR uint8_t rtcWeekday = 0xFF;        // Weekday at time of sleep (0-6, 0xFF = not set)
 RTC_DATA_ATTR bool rtcWasLoggedIn = false;      // Whether user was logged in when going to sleep
 
+// Last good WiFi AP and DHCP lease, for a no-scan reconnect after wake
+RTC_DATA_ATTR WifiLease rtcWifiLease = {};
+
+// API server address, so the first request after wake skips DNS
+RTC_DATA_ATTR ApiAddressCache rtcApiAddress = {};
+
 // ============================================================================
 // Global Objects
 // ============================================================================
@@ -108,35 +121,53 @@ bool tryGoToSleep(bool userInitiated = false);
 // ============================================================================
 
 /**
- * Perform initial time sync at startup
- * Connects to WiFi, syncs NTP time, sets RTC, then disconnects.
- * @return true if sync was successful
+ * Startup time sync completion (runs from NetworkTask::dispatch())
+ * Shows an error dialog if the sync failed.
  */
-bool performStartupTimeSync() {
-    Serial.println("[App] Starting initial time sync...");
-    
-    // Show connecting status
-    ui->updateNetworkStatus(NetworkStatus::CONNECTING);
-    
-    // Use the elegant withConnection pattern
-    bool success = networkManager.withConnection([]() {
-        // Update UI to show connected
-        ui->updateNetworkStatus(NetworkStatus::CONNECTED);
-        
-        // Sync time and set RTC
-        return networkManager.syncTimeAndSetRTC();
-    });
-    
-    // Update UI to show disconnected
-    ui->updateNetworkStatus(NetworkStatus::DISCONNECTED);
-    
-    if (success) {
+void onStartupTimeSynced(const NetJob& job, void* userData) {
+    if (job.timeSynced) {
         Serial.println("[App] Time sync completed successfully");
     } else {
         Serial.println("[App] Time sync failed");
     }
     
-    return success;
+    // Redraw after sync
+    screenManager->requestRedraw();
+    
+    // Show error dialog if sync failed
+    if (!job.timeSynced) {
+        screenManager->showInfoDialog("Something went wrong", 
+                          "Could not connect to WiFi or sync the time. "
+                          "The clock may not be accurate.",
+                          "OK");
+    }
+}
+
+/**
+ * WiFi status change (runs from NetworkTask::dispatch())
+ * Keeps the header's WiFi indicator in step with the connection.
+ */
+void onNetworkStatusChanged(NetworkStatus status, void* userData) {
+    if (ui != nullptr) {
+        ui->updateNetworkStatus(status);
+    }
+}
+
+/**
+ * Start the initial time sync at startup
+ * Connects to WiFi, syncs NTP time and sets the RTC on the network task;
+ * onStartupTimeSynced() reports the result.
+ * @return true if the sync was queued
+ */
+bool performStartupTimeSync() {
+    Serial.println("[App] Starting initial time sync...");
+    
+    // The WiFi indicator follows the connection (onNetworkStatusChanged)
+    if (NetworkTask::getInstance().submitSyncTime(onStartupTimeSynced) == 0) {
+        Serial.println("[App] Time sync not queued");
+        return false;
+    }
+    return true;
 }
 
 // ============================================================================
@@ -343,6 +374,11 @@ bool tryGoToSleep(bool userInitiated) {
     }
     M5.delay(1000);
     
+    // Let queued network jobs (e.g. the session just pushed) finish first
+    if (!NetworkTask::getInstance().waitIdle(NET_TASK_SLEEP_DRAIN_MS)) {
+        Serial.println("[Sleep] Network jobs still pending - sleeping anyway");
+    }
+    
     // Calculate wake-up time if timer was running
     uint64_t sleepDurationUs = 0;
     bool useTimerWake = false;
@@ -422,6 +458,11 @@ void checkAutoSleep() {
         return;
     }
     
+    // Don't auto-sleep while a network request is outstanding
+    if (NetworkTask::getInstance().isBusy()) {
+        return;
+    }
+    
     uint32_t inactiveMs = now - lastButtonPressMs;
     
     if (inactiveMs >= (AUTO_SLEEP_DURATION_SECS * 1000UL)) {
@@ -431,6 +472,45 @@ void checkAutoSleep() {
     }
 }
 
+#if RENDER_PROFILER
+/**
+ * Toggle the render profiler overlay on an A + B chord, and keep it fresh
+ * The chord has to be held past the click threshold, so neither button also
+ * clicks; it fires once per press.
+ */
+void checkRenderProfilerChord() {
+    static uint32_t chordStartMs = 0;
+    static bool chordFired = false;
+    static uint32_t lastOverlayRefreshMs = 0;
+    
+    uint32_t now = millis();
+    RenderProfiler& profiler = RenderProfiler::getInstance();
+    
+    if (M5.BtnA.isPressed() && M5.BtnB.isPressed()) {
+        if (chordStartMs == 0) {
+            chordStartMs = now;
+        } else if (!chordFired && now - chordStartMs >= RENDER_PROFILE_CHORD_MS) {
+            chordFired = true;
+            lastButtonPressMs = now;
+            profiler.setOverlayVisible(!profiler.isOverlayVisible());
+            Serial.printf("[RenderProfiler] Overlay %s\n", profiler.isOverlayVisible() ? "on" : "off");
+            profiler.printReport();
+            // A full frame draws the overlay, or paints over it when hidden
+            screenManager->requestRedraw();
+        }
+    } else {
+        chordStartMs = 0;
+        chordFired = false;
+    }
+    
+    if (profiler.isOverlayVisible() && now - lastOverlayRefreshMs >= RENDER_PROFILE_OVERLAY_REFRESH_MS) {
+        lastOverlayRefreshMs = now;
+        screenManager->requestRedraw(RENDER_PROFILE_OVERLAY_X, RENDER_PROFILE_OVERLAY_Y,
+                                     RENDER_PROFILE_OVERLAY_W, RENDER_PROFILE_OVERLAY_H);
+    }
+}
+#endif
+
 // ============================================================================
 // Main Setup
 // ============================================================================
@@ -512,7 +592,7 @@ void setup() {
         Serial.println("[App] Splash screen complete");
     }
     
-    // Create UI instance using M5.Display (which is M5GFX)
+    // Create UI instance drawing to the panel (M5.Display)
     ui = new UI(M5.Display);
     if (ui == nullptr) {
         Serial.println("[App] ERROR: Failed to create UI");
@@ -572,6 +652,7 @@ void setup() {
     
     // Initialize network
     networkManager.begin();
+    networkManager.setLeaseStore(&rtcWifiLease);
     syncManager = new SyncManager(networkManager);
     if (syncManager != nullptr) {
         syncManager->begin("https://api.screentime.example.com");
@@ -583,6 +664,7 @@ void setup() {
     // ========================================================================
     
     apiClient.begin(networkManager);
+    apiClient.setAddressCache(&rtcApiAddress);
     
     // Restore API client state from persisted session
     {
@@ -607,7 +689,11 @@ void setup() {
     pollingManager.setMoreTimePollInterval(MORE_TIME_POLL_INTERVAL_MS);
     pollingManager.setMoreTimeTimeout(MORE_TIME_POLL_TIMEOUT_MS);
     
-    Serial.println("[App] ApiClient and PollingManager initialized");
+    // Network requests run on core 0 from here on
+    NetworkTask::getInstance().begin(apiClient, networkManager);
+    networkManager.setStatusCallback(onNetworkStatusChanged);
+    
+    Serial.println("[App] ApiClient, PollingManager and NetworkTask initialized");
     
     // Initialize auto-sleep timer
     lastButtonPressMs = millis();
@@ -715,6 +801,15 @@ void setup() {
     } 
     Serial.println("[App] ScreenManager and all screens initialized");
     
+#if RENDER_BENCHMARK
+    // Render every screen off-screen and check golden frames (benchmark build only)
+    RenderBenchmark* renderBenchmark = new RenderBenchmark();
+    if (renderBenchmark != nullptr) {
+        renderBenchmark->run();
+        delete renderBenchmark;
+    }
+#endif
+    
     // ========================================================================
     // Initial Screen Selection (Phase 4 + Phase 7)
     // ========================================================================
@@ -751,21 +846,8 @@ void setup() {
         Serial.println("[App] Fresh boot with session - navigating to main screen");
         screenManager->navigateTo(ScreenType::MAIN);
         
-        // Perform startup time sync
-        bool timeSyncSuccess = performStartupTimeSync();
-        
-        // Redraw after sync
-        if (mainScreen != nullptr) {
-            mainScreen->draw();
-        }
-        
-        // Show error dialog if sync failed
-        if (!timeSyncSuccess) {
-            screenManager->showInfoDialog("Something went wrong", 
-                              "Could not connect to WiFi or sync the time. "
-                              "The clock may not be accurate.",
-                              "OK");
-        }
+        // Perform startup time sync (reported from loop() when it completes)
+        performStartupTimeSync();
     }
     
     // Play startup tone (quieter beep if woke from sleep)
@@ -784,6 +866,9 @@ void setup() {
     Serial.println("  Button B (side) click:  Open menu / cycle selection");
     Serial.println("  Power button click:     Close menu (back)");
     Serial.println("  Power button hold:      Power off (battery only)");
+#if RENDER_PROFILER
+    Serial.println("  Hold A + B:             Render profiler overlay");
+#endif
     Serial.printf("  Auto-sleep after %lu seconds of inactivity\n", 
                   (unsigned long)AUTO_SLEEP_DURATION_SECS);
     Serial.println("-----------------------------------------");
@@ -817,6 +902,9 @@ void loop() {
         lastButtonPressMs = millis();
         screenManager->handleButtonPowerHold();
     }
+#if RENDER_PROFILER
+    checkRenderProfilerChord();
+#endif
     
     // ========================================================================
     // Screen Updates - ScreenManager handles all screen updates
@@ -824,14 +912,15 @@ void loop() {
     screenManager->update();
     
     // ========================================================================
-    // Screen Drawing - ScreenManager handles dialog vs screen drawing
+    // Screen Drawing - ScreenManager renders at most one coalesced frame
+    // (dialog or screen) per FRAME_INTERVAL_MS
     // ========================================================================
     screenManager->draw();
     
     // ========================================================================
-    // Network Manager Update (Phase 6)
+    // Network Task Completions (keep-alive runs on the task itself)
     // ========================================================================
-    networkManager.update();
+    NetworkTask::getInstance().dispatch();
     
     // ========================================================================
     // Polling Manager Update (Phase 5)
@@ -846,7 +935,20 @@ void loop() {
         lastBatteryUpdateMs = now;
         if (ui != nullptr) {
             ui->updateBatteryIndicator();
+            ui->getCompositor().printStats();
+            ui->getActivationRing().printStats();
+            ui->getHeader().printStats();
+            ui->getMenuView().printStats("ui menu");
+            AvatarCache::getInstance().printStats();
+            IconAtlas::getInstance().printStats();
         }
+        screenManager->printFrameStats();
+        NetworkTask::getInstance().printStats();
+        networkManager.printConnectStats();
+        apiClient.printStats();
+#if RENDER_PROFILER
+        RenderProfiler::getInstance().printReport();
+#endif
     }
     
     // ========================================================================
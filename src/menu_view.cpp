@@ -0,0 +1,326 @@
+/**
+ * menu_view.cpp - Cached dropdown menu rendering implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "menu_view.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Rows far enough out to cover the item area at the largest scroll offset
+static constexpr int MAX_SCROLL_ROWS = 2;
+static constexpr int ROW_REACH = MAX_SCROLL_ROWS + 2;
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+MenuView::MenuView()
+    : _ready(false)
+    , _labelsKey(0)
+    , _itemCount(0)
+    , _shownIndex(-1)
+    , _scrolling(false)
+    , _scrollFrom(0)
+    , _drawnOffset(0)
+    , _scrollStartMs(0)
+    , _flashing(false)
+    , _flashStartMs(0)
+{
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void MenuView::draw(lgfx::LovyanGFX& gfx, const DropdownMenu& menu) {
+    if (!menu.isVisible()) {
+        return;
+    }
+    prepare(menu);
+
+    _scrolling = false;
+    _flashing = false;
+    _shownIndex = menu.getSelectedIndex();
+    _drawnOffset = 0;
+
+    RENDER_PROFILE_SCOPE(RenderSection::MENU);
+    uint32_t startUs = micros();
+    gfx.waitDisplay();
+    gfx.startWrite();
+
+    // Rows tile the item area; only the chevron area needs its own fill
+    drawRows(gfx, menu, 0, COLOR_TEXT_PRIMARY);
+    gfx.fillRect(0, MENU_ITEMS_BOTTOM, SCREEN_WIDTH, MENU_Y + MENU_HEIGHT - MENU_ITEMS_BOTTOM, COLOR_MENU_BG);
+    drawChevron(gfx);
+
+    gfx.endWrite();
+    gfx.display();
+
+    _stats.fullDraws++;
+    _stats.lastFrameUs = micros() - startUs;
+}
+
+void MenuView::scroll(lgfx::LovyanGFX& gfx, const DropdownMenu& menu) {
+    if (!menu.isVisible()) {
+        return;
+    }
+
+    int itemCount = menu.getItemCount();
+    int selectedIndex = menu.getSelectedIndex();
+    if (_shownIndex < 0 || _shownIndex >= itemCount || labelsKey(menu) != _labelsKey) {
+        draw(gfx, menu);
+        return;
+    }
+
+    // Shortest way round the wrapping list
+    int delta = (selectedIndex - _shownIndex + itemCount) % itemCount;
+    if (delta > itemCount / 2) {
+        delta -= itemCount;
+    }
+    if (delta == 0) {
+        return;
+    }
+    if (delta != 1 && delta != -1) {
+        draw(gfx, menu);
+        return;
+    }
+
+    // The old selection starts where it is (a running scroll continues from
+    // its current offset) and eases into its new slot
+    _scrollFrom = delta * MENU_ITEM_PITCH + (_scrolling ? _drawnOffset : 0);
+    _scrollFrom = std::max(-MAX_SCROLL_ROWS * MENU_ITEM_PITCH,
+                           std::min(_scrollFrom, MAX_SCROLL_ROWS * MENU_ITEM_PITCH));
+    _shownIndex = selectedIndex;
+    _scrolling = true;
+    _scrollStartMs = millis();
+
+    pushFrame(gfx, menu, _scrollFrom, COLOR_TEXT_PRIMARY);
+}
+
+void MenuView::flash(lgfx::LovyanGFX& gfx, const DropdownMenu& menu) {
+    if (!menu.isVisible() || menu.getItemCount() == 0) {
+        return;
+    }
+    if (_shownIndex != menu.getSelectedIndex()) {
+        draw(gfx, menu);
+    }
+
+    // Settle any scroll, with the selection in the flash color
+    _scrolling = false;
+    pushFrame(gfx, menu, 0, COLOR_MENU_FLASH);
+
+    _flashing = true;
+    _flashStartMs = millis();
+    _stats.flashes++;
+}
+
+bool MenuView::update(lgfx::LovyanGFX& gfx, const DropdownMenu& menu) {
+    if (!menu.isVisible()) {
+        // Hidden (or closed mid-animation) - the next draw() starts over
+        _scrolling = false;
+        _flashing = false;
+        _shownIndex = -1;
+        return false;
+    }
+
+    uint32_t now = millis();
+
+    if (_scrolling) {
+        uint32_t elapsed = now - _scrollStartMs;
+        int offset = 0;
+        if (elapsed < MENU_SCROLL_DURATION_MS) {
+            // Ease out: offset shrinks with the square of the remaining time
+            int32_t remaining = (int32_t)(MENU_SCROLL_DURATION_MS - elapsed);
+            offset = (int)((int64_t)_scrollFrom * remaining * remaining /
+                           ((int64_t)MENU_SCROLL_DURATION_MS * MENU_SCROLL_DURATION_MS));
+        } else {
+            _scrolling = false;
+        }
+        if (offset != _drawnOffset) {
+            pushFrame(gfx, menu, offset, COLOR_TEXT_PRIMARY);
+        }
+    }
+
+    if (_flashing && now - _flashStartMs >= MENU_FLASH_DURATION_MS) {
+        _flashing = false;
+        return true;
+    }
+    return false;
+}
+
+bool MenuView::isFlashing() const {
+    return _flashing;
+}
+
+bool MenuView::isScrolling() const {
+    return _scrolling;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const MenuViewStats& MenuView::getStats() const {
+    return _stats;
+}
+
+void MenuView::printStats(const char* name) const {
+    Serial.printf("[MenuView] %s: %lu strip builds, %lu full, %lu scroll frames, %lu flashes, last %lu us\n",
+                  name,
+                  (unsigned long)_stats.stripBuilds,
+                  (unsigned long)_stats.fullDraws,
+                  (unsigned long)_stats.scrollFrames,
+                  (unsigned long)_stats.flashes,
+                  (unsigned long)_stats.lastFrameUs);
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+uint32_t MenuView::labelsKey(const DropdownMenu& menu) {
+    // FNV-1a over the labels, separated so "AB","C" differs from "A","BC"
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < menu.getItemCount(); i++) {
+        for (const char* text = menu.getItemLabel(i); *text; text++) {
+            hash = (hash ^ (uint8_t)*text) * 16777619u;
+        }
+        hash = (hash ^ 0xFFu) * 16777619u;
+    }
+    return hash;
+}
+
+void MenuView::truncateLabel(const DropdownMenu& menu, int index, char* label) {
+    strncpy(label, menu.getItemLabel(index), MENU_LABEL_MAX_CHARS);
+    label[MENU_LABEL_MAX_CHARS] = '\0';
+}
+
+void MenuView::prepare(const DropdownMenu& menu) {
+    uint32_t key = labelsKey(menu);
+    if (key == _labelsKey && menu.getItemCount() == _itemCount) {
+        return;
+    }
+    _labelsKey = key;
+    _itemCount = menu.getItemCount();
+
+    if (_ready) {
+        _strip.deleteSprite();
+        _ready = false;
+    }
+    if (_itemCount == 0) {
+        return;
+    }
+
+    // One 1bpp row per item: 240 x 31 x 10 items = ~9KB
+    _strip.setPsram(true);
+    _strip.setColorDepth(1);
+    if (_strip.createSprite(SCREEN_WIDTH, _itemCount * MENU_ITEM_PITCH) == nullptr) {
+        Serial.println("[MenuView] Strip allocation failed - printing labels directly");
+        return;
+    }
+
+    // Index 0 is the menu background; index 1 gets each slot's color at blit time
+    _strip.setPaletteColor(0, (COLOR_MENU_BG >> 8) & 0xF8, (COLOR_MENU_BG >> 3) & 0xFC,
+                           (COLOR_MENU_BG << 3) & 0xF8);
+    _strip.fillSprite(0);
+    _strip.setFont(&fonts::FreeSansBold12pt7b);
+    _strip.setTextSize(1);
+    _strip.setTextColor(1);
+
+    for (int i = 0; i < _itemCount; i++) {
+        char label[MENU_LABEL_MAX_CHARS + 1];
+        truncateLabel(menu, i, label);
+        _strip.setCursor((SCREEN_WIDTH - _strip.textWidth(label)) / 2, i * MENU_ITEM_PITCH);
+        _strip.print(label);
+    }
+
+    _ready = true;
+    _stats.stripBuilds++;
+    Serial.printf("[MenuView] Rendered %d labels (%d bytes)\n",
+                  _itemCount, SCREEN_WIDTH * _itemCount * MENU_ITEM_PITCH / 8);
+}
+
+void MenuView::pushFrame(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int offset, uint16_t selectedColor) {
+    RENDER_PROFILE_SCOPE(RenderSection::MENU);
+    uint32_t startUs = micros();
+    gfx.startWrite();
+    drawRows(gfx, menu, offset, selectedColor);
+    gfx.endWrite();
+    gfx.display();
+
+    _drawnOffset = offset;
+    _stats.scrollFrames++;
+    _stats.lastFrameUs = micros() - startUs;
+}
+
+void MenuView::drawRows(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int offset, uint16_t selectedColor) {
+    int itemCount = menu.getItemCount();
+    if (itemCount == 0) {
+        gfx.fillRect(0, MENU_Y, SCREEN_WIDTH, MENU_ITEMS_BOTTOM - MENU_Y, COLOR_MENU_BG);
+        return;
+    }
+
+    // Row k shows item (selection + k); the one nearest the middle slot is
+    // drawn as the selection, the rest in gray
+    int selectedIndex = menu.getSelectedIndex();
+    for (int k = -ROW_REACH; k <= ROW_REACH; k++) {
+        int y = MENU_SELECTED_TEXT_Y + k * MENU_ITEM_PITCH + offset;
+        if (y + MENU_ITEM_PITCH <= MENU_Y || y >= MENU_ITEMS_BOTTOM) {
+            continue;
+        }
+        int index = ((selectedIndex + k) % itemCount + itemCount) % itemCount;
+        int distance = std::abs(k * MENU_ITEM_PITCH + offset);
+        drawRow(gfx, menu, index, y,
+                distance * 2 < MENU_ITEM_PITCH ? selectedColor : COLOR_MENU_ITEM_GRAY);
+    }
+}
+
+void MenuView::drawRow(lgfx::LovyanGFX& gfx, const DropdownMenu& menu, int index, int y, uint16_t color) {
+    // Clip the row to the item area, keeping any clip the caller had set
+    int32_t clipX, clipY, clipW, clipH;
+    gfx.getClipRect(&clipX, &clipY, &clipW, &clipH);
+
+    int top = std::max<int>(std::max(y, MENU_Y), clipY);
+    int bottom = std::min<int>(std::min(y + MENU_ITEM_PITCH, MENU_ITEMS_BOTTOM), clipY + clipH);
+    if (bottom <= top) {
+        return;
+    }
+    gfx.setClipRect(clipX, top, clipW, bottom - top);
+
+    if (_ready) {
+        _strip.setPaletteColor(1, (color >> 8) & 0xF8, (color >> 3) & 0xFC, (color << 3) & 0xF8);
+        _strip.pushSprite(&gfx, 0, y - index * MENU_ITEM_PITCH);
+    } else {
+        char label[MENU_LABEL_MAX_CHARS + 1];
+        truncateLabel(menu, index, label);
+        gfx.fillRect(0, top, SCREEN_WIDTH, bottom - top, COLOR_MENU_BG);
+        gfx.setFont(&fonts::FreeSansBold12pt7b);
+        gfx.setTextSize(1);
+        gfx.setTextColor(color);
+        gfx.setCursor((SCREEN_WIDTH - gfx.textWidth(label)) / 2, y);
+        gfx.print(label);
+    }
+    RENDER_PROFILE_PIXELS((uint32_t)SCREEN_WIDTH * (bottom - top));
+    RENDER_PROFILE_PRIMITIVES(1);
+
+    gfx.setClipRect(clipX, clipY, clipW, clipH);
+}
+
+void MenuView::drawChevron(lgfx::LovyanGFX& gfx) {
+    // Downward V at bottom center, two lines thick
+    int chevronY = MENU_ITEMS_BOTTOM + 2;
+    int chevronX = SCREEN_WIDTH / 2;
+    int chevronSize = 6;
+
+    gfx.drawLine(chevronX - chevronSize, chevronY, chevronX, chevronY + chevronSize, COLOR_TEXT_PRIMARY);
+    gfx.drawLine(chevronX, chevronY + chevronSize, chevronX + chevronSize, chevronY, COLOR_TEXT_PRIMARY);
+    gfx.drawLine(chevronX - chevronSize, chevronY + 1, chevronX, chevronY + chevronSize + 1, COLOR_TEXT_PRIMARY);
+    gfx.drawLine(chevronX, chevronY + chevronSize + 1, chevronX + chevronSize, chevronY + 1, COLOR_TEXT_PRIMARY);
+}
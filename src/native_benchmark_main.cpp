@@ -0,0 +1,36 @@
+/**
+ * native_benchmark_main.cpp - Host entry point of the render benchmark
+ *
+ * Only built by the native-benchmark environment:
+ *   pio run -e native-benchmark -t exec
+ * The firmware runs RenderBenchmark from main.cpp instead, so this file is
+ * empty in every ARDUINO build. It also stands in for the main.cpp symbols
+ * the screens link against.
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#ifndef ARDUINO
+
+#include "render_benchmark.h"
+#include <stdlib.h>
+#include <time.h>
+
+// Sleep requests from the screens (main.cpp on the device): never sleep
+bool tryGoToSleep(bool) {
+    return false;
+}
+
+int main() {
+    // UTC, so the pinned UI clock formats the same on every host
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    RenderBenchmark* benchmark = new RenderBenchmark();
+    bool passed = benchmark->run();
+    delete benchmark;
+    return passed ? 0 : 1;
+}
+
+#endif // ARDUINO
@@ -8,6 +8,22 @@
  * - Polling mode for login/more-time requests (R5.5)
  * - NTP sync frequency control (only sync if interval exceeded)
  * 
+ * WiFi events (scan done, associated, got IP, disconnected) arrive on the
+ * Arduino event task. The handler only stamps the time and sets a bit in an
+ * event group; advance() applies them on the network task, so the handler
+ * never blocks and the state is only written from one task.
+ * 
+ * A connect with a usable cached lease skips SCAN and DHCP: WiFi.config()
+ * sets the lease as a static IP and WiFi.begin() targets the cached BSSID
+ * and channel. Any failure drops the lease and restarts as a full connect.
+ * The static config is only a stand-in: the next time update() runs with
+ * the network task idle, lwIP's DHCP client is started directly on the
+ * connected link. Unlike WiFi.config(INADDR_NONE...), that leaves the
+ * borrowed address in place while it asks, so open sockets (the kept-alive
+ * API connection) survive unless the server hands out another address.
+ * The renewed lease, with the lease time the server granted, replaces the
+ * cached one.
+ * 
  * @author Screen Time Tracker
  * @version 2.0
  */
@@ -19,6 +35,10 @@
 #include <WiFi.h>
 #include <string.h>
 #include <time.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <lwip/tcpip.h>
 
 // SNTP header compatibility
 #if __has_include(<esp_sntp.h>)
@@ -31,46 +51,634 @@
   #define SNTP_ENABLED 0
 #endif
 
+// WiFi event bits (bit n's time is in _eventMs[n])
+constexpr int NET_EVENT_SCAN_DONE = 0;
+constexpr int NET_EVENT_ASSOCIATED = 1;
+constexpr int NET_EVENT_GOT_IP = 2;
+constexpr int NET_EVENT_DISCONNECTED = 3;
+constexpr EventBits_t NET_EVENT_ALL_BITS = 0x0F;
+
+// Phases timed in WifiConnectStats (SCAN, ASSOCIATE, DHCP)
+constexpr int NET_TIMED_PHASES = 3;
+
+// Histogram bucket for a connect time (see WIFI_CONNECT_BUCKETS)
+static int connectBucketFor(uint32_t ms) {
+    int bucket = 0;
+    uint32_t limit = 1u << WIFI_CONNECT_FIRST_BUCKET_SHIFT;
+    while (bucket < WIFI_CONNECT_BUCKETS - 1 && ms >= limit) {
+        bucket++;
+        limit <<= 1;
+    }
+    return bucket;
+}
+
+// lwIP interface behind the STA netif (nullptr before WiFi starts)
+static struct netif* staNetif() {
+    esp_netif_t* sta = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    return sta != nullptr ? (struct netif*)esp_netif_get_netif_impl(sta) : nullptr;
+}
+
+// Lease time the DHCP server granted on the STA interface (0 = unknown,
+// e.g. static config). Read on the network task once DHCP is bound.
+static uint32_t dhcpLeaseSecs() {
+    struct netif* lwipNetif = staNetif();
+    struct dhcp* dhcp = lwipNetif != nullptr ? netif_dhcp_data(lwipNetif) : nullptr;
+    return dhcp != nullptr ? dhcp->offered_t0_lease : 0;
+}
+
+// DHCP client on the live link, bypassing esp_netif (which would clear the
+// address first). Both run on the lwIP thread, queued in call order.
+static void startLinkDhcp(void* lwipNetif) {
+    dhcp_start(static_cast<struct netif*>(lwipNetif));
+}
+
+static void stopLinkDhcp(void* lwipNetif) {
+    dhcp_stop(static_cast<struct netif*>(lwipNetif));
+}
+
 // ============================================================================
 // NetworkManager Implementation
 // ============================================================================
 
 NetworkManager::NetworkManager()
     : _status(NetworkStatus::DISCONNECTED)
+    , _phase(WifiPhase::IDLE)
+    , _events(nullptr)
+    , _ssid(nullptr)
+    , _password(nullptr)
+    , _channel(0)
+    , _connectStartMs(0)
+    , _phaseStartMs(0)
+    , _associateRetries(0)
+    , _lease(nullptr)
+    , _fastPath(false)
+    , _staticIp(false)
+    , _leaseRenewDue(false)
+    , _leaseRenewing(false)
+    , _leaseRenewStartMs(0)
+    , _linkDhcp(false)
+    , _linkGeneration(0)
+    , _disconnectReason(0)
+    , _statusCallback(nullptr)
+    , _statusUserData(nullptr)
+    , _statusChanged(false)
     , _lastActivityMs(0)
     , _keepAliveDurationMs(WIFI_KEEPALIVE_MS)
     , _pollingMode(false)
 {
+    memset(_bssid, 0, sizeof(_bssid));
+    memset(&_connectStats, 0, sizeof(_connectStats));
+    for (int i = 0; i < 4; i++) {
+        _eventMs[i] = 0;
+    }
 }
 
 bool NetworkManager::begin() {
     Serial.println("[Network] Network subsystem initialized");
     WiFi.mode(WIFI_STA);
+    
+    // The state machine decides when to retry, not the driver
+    WiFi.setAutoReconnect(false);
+    
+    if (_events == nullptr) {
+        _events = xEventGroupCreate();
+        WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+            uint8_t reason = 0;
+            if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+                reason = info.wifi_sta_disconnected.reason;
+            }
+            handleWifiEvent((int)event, reason);
+        });
+    }
+    
     _lastActivityMs = 0;  // No activity yet
     _pollingMode = false;
     return true;
 }
 
+// ============================================================================
+// Connection State Machine
+// ============================================================================
+
+void NetworkManager::handleWifiEvent(int event, uint8_t reason) {
+    // Arduino event task: record and wake the network task, nothing else
+    int bit;
+    switch ((arduino_event_id_t)event) {
+        case ARDUINO_EVENT_WIFI_SCAN_DONE:          bit = NET_EVENT_SCAN_DONE; break;
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:      bit = NET_EVENT_ASSOCIATED; break;
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:         bit = NET_EVENT_GOT_IP; break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:   bit = NET_EVENT_DISCONNECTED; break;
+        default:
+            return;
+    }
+    
+    if (bit == NET_EVENT_DISCONNECTED) {
+        _disconnectReason = reason;
+    }
+    _eventMs[bit] = millis();
+    xEventGroupSetBits(_events, 1 << bit);
+}
+
+bool NetworkManager::requestConnection(const char* ssid, const char* password) {
+    // Check if WiFi is properly configured
+    if (!isWifiConfigured()) {
+        Serial.println("[Network] ERROR: WiFi not configured!");
+        Serial.println("[Network] Copy credentials.example.h to credentials.h and add your WiFi credentials");
+        setStatus(NetworkStatus::ERROR);
+        _wifiNotConfigured = true;
+        return false;
+    }
+    _wifiNotConfigured = false;
+    
+    advance();
+    WifiPhase phase = _phase.load();
+    if (phase == WifiPhase::SCAN || phase == WifiPhase::ASSOCIATE || phase == WifiPhase::DHCP) {
+        return true;  // Already on its way
+    }
+    if (phase == WifiPhase::CONNECTED && isConnected()) {
+        return true;
+    }
+    
+    Serial.printf("[Network] Connecting to WiFi '%s'...\n", ssid);
+    
+    _ssid = ssid;
+    _password = password;
+    _channel = 0;
+    memset(_bssid, 0, sizeof(_bssid));
+    _associateRetries = 0;
+    _connectStats.attempts++;
+    memset(_connectStats.lastPhaseMs, 0, sizeof(_connectStats.lastPhaseMs));
+    
+    xEventGroupClearBits(_events, NET_EVENT_ALL_BITS);
+    WiFi.mode(WIFI_STA);  // forceDisconnect() turns the radio off
+    setStatus(NetworkStatus::CONNECTING);
+    
+    _connectStartMs = millis();
+    _phaseStartMs = _connectStartMs;
+    _leaseRenewDue = false;
+    _leaseRenewing = false;
+    
+    if (isLeaseUsable(ssid)) {
+        startFastConnect();
+    } else {
+        startScan();
+    }
+    
+    return true;
+}
+
+void NetworkManager::startScan() {
+    _fastPath = false;
+    if (_staticIp) {
+        // Back to DHCP after a fast connect
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+        _staticIp = false;
+        _linkDhcp = false;  // esp_netif owns the DHCP client again
+    }
+    
+    _phase = WifiPhase::SCAN;
+    
+    // Scan for this SSID only, so we can go straight to the strongest AP
+    if (WiFi.scanNetworks(true, false, false, WIFI_SCAN_MS_PER_CHANNEL, 0, _ssid) == WIFI_SCAN_FAILED) {
+        Serial.println("[Network] Scan failed to start, connecting without it");
+        _phase = WifiPhase::ASSOCIATE;
+        startAssociation();
+    }
+}
+
+// ============================================================================
+// Fast Reconnect
+// ============================================================================
+
+void NetworkManager::setLeaseStore(WifiLease* lease) {
+    _lease = lease;
+}
+
+bool NetworkManager::isLeaseUsable(const char* ssid) const {
+    if (_lease == nullptr || !_lease->valid || strcmp(_lease->ssid, ssid) != 0) {
+        return false;
+    }
+    
+    // A DHCP client renews at half the lease (T1); past that the server
+    // may already be winding the address down
+    uint32_t maxAgeSecs = WIFI_LEASE_MAX_AGE_SECS;
+    if (_lease->leaseSecs != 0 && _lease->leaseSecs / 2 < maxAgeSecs) {
+        maxAgeSecs = _lease->leaseSecs / 2;
+    }
+    
+    // The system clock keeps running through deep sleep; a jump from the
+    // first NTP sync only makes the lease look too old, which is safe
+    time_t now = time(nullptr);
+    if (now < _lease->obtainedAt || (uint32_t)(now - _lease->obtainedAt) > maxAgeSecs) {
+        Serial.println("[Network] Cached lease too old, doing a full connect");
+        return false;
+    }
+    return true;
+}
+
+void NetworkManager::startFastConnect() {
+    Serial.printf("[Network] Fast reconnect to cached AP on channel %u\n", _lease->channel);
+    
+    _fastPath = true;
+    _connectStats.fastAttempts++;
+    _channel = _lease->channel;
+    memcpy(_bssid, _lease->bssid, sizeof(_bssid));
+    
+    // A renewal from an earlier fast connect may still own the DHCP client
+    if (_linkDhcp) {
+        struct netif* lwipNetif = staNetif();
+        if (lwipNetif != nullptr) {
+            tcpip_callback(stopLinkDhcp, lwipNetif);
+        }
+        _linkDhcp = false;
+    }
+    
+    WiFi.config(IPAddress(_lease->ip), IPAddress(_lease->gateway), IPAddress(_lease->subnet),
+                IPAddress(_lease->dns1), IPAddress(_lease->dns2));
+    _staticIp = true;
+    
+    _phase = WifiPhase::ASSOCIATE;
+    startAssociation();
+}
+
+void NetworkManager::fallBackToFullConnect(const char* why) {
+    Serial.printf("[Network] Fast reconnect failed (%s), doing a full connect\n", why);
+    _connectStats.fastFallbacks++;
+    
+    // The AP or the lease has changed; don't try it again
+    _lease->valid = false;
+    
+    WiFi.disconnect();
+    _channel = 0;
+    memset(_bssid, 0, sizeof(_bssid));
+    _associateRetries = 0;
+    memset(_connectStats.lastPhaseMs, 0, sizeof(_connectStats.lastPhaseMs));
+    _phaseStartMs = millis();
+    
+    startScan();
+}
+
+void NetworkManager::saveLease() {
+    if (_lease == nullptr) {
+        return;
+    }
+    
+    strncpy(_lease->ssid, _ssid, sizeof(_lease->ssid) - 1);
+    _lease->ssid[sizeof(_lease->ssid) - 1] = '\0';
+    memcpy(_lease->bssid, WiFi.BSSID(), sizeof(_lease->bssid));
+    _lease->channel = (uint8_t)WiFi.channel();
+    _lease->ip = (uint32_t)WiFi.localIP();
+    _lease->gateway = (uint32_t)WiFi.gatewayIP();
+    _lease->subnet = (uint32_t)WiFi.subnetMask();
+    _lease->dns1 = (uint32_t)WiFi.dnsIP(0);
+    _lease->dns2 = (uint32_t)WiFi.dnsIP(1);
+    _lease->obtainedAt = time(nullptr);
+    _lease->leaseSecs = dhcpLeaseSecs();
+    _lease->valid = true;
+}
+
+void NetworkManager::startLeaseRenewal() {
+    _leaseRenewDue = false;
+    struct netif* lwipNetif = staNetif();
+    if (lwipNetif == nullptr) {
+        return;
+    }
+    
+    Serial.println("[Network] Renewing DHCP lease after fast reconnect");
+    _leaseRenewing = true;
+    _leaseRenewStartMs = millis();
+    
+    // The static address stays on the interface until DHCP binds; esp_netif
+    // still sees a static config (_staticIp), so a full connect restarts
+    // DHCP through WiFi.config() as usual
+    _linkDhcp = true;
+    tcpip_callback(startLinkDhcp, lwipNetif);
+}
+
+void NetworkManager::checkLeaseRenewal() {
+    struct netif* lwipNetif = staNetif();
+    if (lwipNetif != nullptr && dhcp_supplied_address(lwipNetif)) {
+        _leaseRenewing = false;
+        _connectStats.leaseRenewals++;
+        uint32_t borrowedIp = _lease->ip;
+        saveLease();
+        if (_lease->ip != borrowedIp) {
+            // Sockets on the borrowed address are gone
+            _linkGeneration++;
+        }
+        Serial.printf("[Network] Lease renewed: IP %s%s, %lu s (%lu ms)\n",
+                      WiFi.localIP().toString().c_str(),
+                      _lease->ip != borrowedIp ? " (changed)" : "",
+                      (unsigned long)_lease->leaseSecs,
+                      (unsigned long)(millis() - _leaseRenewStartMs));
+        return;
+    }
+    
+    if (millis() - _leaseRenewStartMs > WIFI_LEASE_RENEW_TIMEOUT_MS) {
+        // Keep the borrowed address for this connection, but don't reuse
+        // the lease on the next connect; stopping DHCP now keeps it from
+        // binding another address under open sockets later
+        Serial.println("[Network] Lease renewal timed out");
+        _leaseRenewing = false;
+        _connectStats.leaseRenewFailures++;
+        _lease->valid = false;
+        if (lwipNetif != nullptr) {
+            tcpip_callback(stopLinkDhcp, lwipNetif);
+        }
+        _linkDhcp = false;
+    }
+}
+
+bool NetworkManager::waitForConnection(uint32_t timeoutMs) {
+    uint32_t startMs = millis();
+    
+    while (true) {
+        advance();
+        
+        WifiPhase phase = _phase.load();
+        if (phase == WifiPhase::CONNECTED) {
+            return true;
+        }
+        if (phase == WifiPhase::FAILED || phase == WifiPhase::IDLE) {
+            return false;
+        }
+        
+        uint32_t elapsed = millis() - startMs;
+        if (elapsed >= timeoutMs) {
+            failConnection("Connection timeout");
+            return false;
+        }
+        
+        // Sleep until the next WiFi event (advance() clears the bits), or
+        // until a fast reconnect runs out of time
+        uint32_t waitMs = timeoutMs - elapsed;
+        if (_fastPath && phase != WifiPhase::SCAN) {
+            uint32_t fastElapsed = millis() - _connectStartMs;
+            uint32_t fastLeft = fastElapsed < WIFI_FAST_CONNECT_TIMEOUT_MS
+                                    ? WIFI_FAST_CONNECT_TIMEOUT_MS - fastElapsed + 1 : 1;
+            if (fastLeft < waitMs) {
+                waitMs = fastLeft;
+            }
+        }
+        xEventGroupWaitBits(_events, NET_EVENT_ALL_BITS, pdFALSE, pdFALSE, pdMS_TO_TICKS(waitMs));
+    }
+}
+
+void NetworkManager::advance() {
+    if (_events == nullptr) {
+        return;
+    }
+    
+    EventBits_t bits = xEventGroupClearBits(_events, NET_EVENT_ALL_BITS);
+    
+    // A fast reconnect gets a short leash before the full connect
+    if (_fastPath && (_phase == WifiPhase::ASSOCIATE || _phase == WifiPhase::DHCP) &&
+        !(bits & (1 << NET_EVENT_GOT_IP)) && millis() - _connectStartMs > WIFI_FAST_CONNECT_TIMEOUT_MS) {
+        fallBackToFullConnect("timeout");
+        return;
+    }
+    
+    if (bits == 0) {
+        return;
+    }
+    
+    if ((bits & (1 << NET_EVENT_SCAN_DONE)) && _phase == WifiPhase::SCAN) {
+        // Strongest AP with our SSID (the scan was filtered to it)
+        int16_t found = WiFi.scanComplete();
+        int best = -1;
+        for (int i = 0; i < found; i++) {
+            if (WiFi.SSID(i) == _ssid && (best < 0 || WiFi.RSSI(i) > WiFi.RSSI(best))) {
+                best = i;
+            }
+        }
+        if (best >= 0) {
+            _channel = (uint8_t)WiFi.channel(best);
+            memcpy(_bssid, WiFi.BSSID(best), sizeof(_bssid));
+            Serial.printf("[Network] Found AP on channel %u (RSSI %d)\n",
+                          _channel, (int)WiFi.RSSI(best));
+        } else {
+            Serial.println("[Network] SSID not seen in scan, connecting anyway");
+        }
+        WiFi.scanDelete();
+        
+        enterPhase(WifiPhase::ASSOCIATE, _eventMs[NET_EVENT_SCAN_DONE]);
+        startAssociation();
+    }
+    
+    if ((bits & (1 << NET_EVENT_ASSOCIATED)) && _phase == WifiPhase::ASSOCIATE) {
+        enterPhase(WifiPhase::DHCP, _eventMs[NET_EVENT_ASSOCIATED]);
+    }
+    
+    if ((bits & (1 << NET_EVENT_GOT_IP)) &&
+        (_phase == WifiPhase::ASSOCIATE || _phase == WifiPhase::DHCP)) {
+        uint32_t gotIpMs = _eventMs[NET_EVENT_GOT_IP];
+        enterPhase(WifiPhase::CONNECTED, gotIpMs);
+        
+        uint32_t connectMs = gotIpMs - _connectStartMs;
+        _connectStats.connected++;
+        _connectStats.lastConnectMs = connectMs;
+        if (connectMs > _connectStats.maxConnectMs) {
+            _connectStats.maxConnectMs = connectMs;
+        }
+        for (int i = 0; i < NET_TIMED_PHASES; i++) {
+            _connectStats.totalPhaseMs[i] += _connectStats.lastPhaseMs[i];
+            if (_connectStats.lastPhaseMs[i] > _connectStats.maxPhaseMs[i]) {
+                _connectStats.maxPhaseMs[i] = _connectStats.lastPhaseMs[i];
+            }
+        }
+        
+        int bucket = connectBucketFor(connectMs);
+        if (_fastPath) {
+            _connectStats.fastConnected++;
+            _connectStats.fastBuckets[bucket]++;
+            _leaseRenewDue = _lease != nullptr;
+        } else {
+            _connectStats.fullBuckets[bucket]++;
+            saveLease();
+        }
+        
+        Serial.printf("[Network] Connected%s! IP: %s (%lu ms: scan %lu, associate %lu, DHCP %lu)\n",
+                      _fastPath ? " (fast)" : "",
+                      WiFi.localIP().toString().c_str(), (unsigned long)connectMs,
+                      (unsigned long)_connectStats.lastPhaseMs[0],
+                      (unsigned long)_connectStats.lastPhaseMs[1],
+                      (unsigned long)_connectStats.lastPhaseMs[2]);
+        
+        _linkGeneration++;
+        resetKeepAliveTimer();
+        setStatus(NetworkStatus::CONNECTED);
+    }
+    
+    if (bits & (1 << NET_EVENT_DISCONNECTED)) {
+        WifiPhase phase = _phase.load();
+        if (_fastPath && (phase == WifiPhase::ASSOCIATE || phase == WifiPhase::DHCP)) {
+            Serial.printf("[Network] Disconnected (reason %u)\n", (unsigned)_disconnectReason);
+            fallBackToFullConnect("association");
+        } else if (phase == WifiPhase::ASSOCIATE || phase == WifiPhase::DHCP) {
+            if (_associateRetries < WIFI_ASSOCIATE_RETRIES) {
+                _associateRetries++;
+                Serial.printf("[Network] Association failed (reason %u), retrying\n",
+                              (unsigned)_disconnectReason);
+                // Retry time counts towards the association phase
+                _phase = WifiPhase::ASSOCIATE;
+                startAssociation();
+            } else {
+                failConnection("Association failed");
+            }
+        } else if (phase == WifiPhase::CONNECTED) {
+            Serial.printf("[Network] Connection lost (reason %u)\n", (unsigned)_disconnectReason);
+            _connectStats.dropped++;
+            _leaseRenewDue = false;
+            _leaseRenewing = false;
+            _phase = WifiPhase::IDLE;
+            setStatus(NetworkStatus::DISCONNECTED);
+        }
+    }
+}
+
+void NetworkManager::startAssociation() {
+    if (_channel != 0) {
+        WiFi.begin(_ssid, _password, _channel, _bssid);
+    } else {
+        WiFi.begin(_ssid, _password);
+    }
+}
+
+void NetworkManager::enterPhase(WifiPhase phase, uint32_t atMs) {
+    // Charge the time spent in the phase being left
+    int index = (int)_phase.load() - (int)WifiPhase::SCAN;
+    if (index >= 0 && index < NET_TIMED_PHASES) {
+        _connectStats.lastPhaseMs[index] = atMs - _phaseStartMs;
+    }
+    _phase = phase;
+    _phaseStartMs = atMs;
+}
+
+void NetworkManager::failConnection(const char* why) {
+    Serial.printf("[Network] %s\n", why);
+    if (_phase == WifiPhase::SCAN) {
+        WiFi.scanDelete();
+    }
+    WiFi.disconnect();
+    _phase = WifiPhase::FAILED;
+    _connectStats.failed++;
+    setStatus(NetworkStatus::ERROR);
+}
+
+WifiPhase NetworkManager::getPhase() const {
+    return _phase.load();
+}
+
+// ============================================================================
+// Status Notification
+// ============================================================================
+
+void NetworkManager::setStatus(NetworkStatus status) {
+    if (_status.exchange(status) != status) {
+        _statusChanged = true;
+    }
+}
+
+void NetworkManager::setStatusCallback(NetworkStatusCallback callback, void* userData) {
+    _statusCallback = callback;
+    _statusUserData = userData;
+}
+
+void NetworkManager::dispatchEvents() {
+    if (_statusChanged.exchange(false) && _statusCallback != nullptr) {
+        _statusCallback(_status.load(), _statusUserData);
+    }
+}
+
+// ============================================================================
+// Connect Statistics
+// ============================================================================
+
+const WifiConnectStats& NetworkManager::getConnectStats() const {
+    return _connectStats;
+}
+
+void NetworkManager::printConnectStats() const {
+    const WifiConnectStats& s = _connectStats;
+    static const char* const names[NET_TIMED_PHASES] = { "scan", "associate", "DHCP" };
+    
+    Serial.printf("[Network] WiFi connects: %lu attempts, %lu connected, %lu failed, %lu dropped\n",
+                  (unsigned long)s.attempts, (unsigned long)s.connected,
+                  (unsigned long)s.failed, (unsigned long)s.dropped);
+    if (s.connected == 0) {
+        return;
+    }
+    for (int i = 0; i < NET_TIMED_PHASES; i++) {
+        Serial.printf("[Network]   %-9s last %lu ms, avg %lu ms, max %lu ms\n", names[i],
+                      (unsigned long)s.lastPhaseMs[i],
+                      (unsigned long)(s.totalPhaseMs[i] / s.connected),
+                      (unsigned long)s.maxPhaseMs[i]);
+    }
+    Serial.printf("[Network]   total     last %lu ms, max %lu ms\n",
+                  (unsigned long)s.lastConnectMs, (unsigned long)s.maxConnectMs);
+    
+    Serial.printf("[Network]   fast reconnects: %lu tried, %lu connected, %lu fell back\n",
+                  (unsigned long)s.fastAttempts, (unsigned long)s.fastConnected,
+                  (unsigned long)s.fastFallbacks);
+    Serial.printf("[Network]   lease renewals: %lu renewed, %lu timed out\n",
+                  (unsigned long)s.leaseRenewals, (unsigned long)s.leaseRenewFailures);
+    Serial.print("[Network]   connect ms  ");
+    for (int i = 0; i < WIFI_CONNECT_BUCKETS; i++) {
+        if (i < WIFI_CONNECT_BUCKETS - 1) {
+            Serial.printf(" <%-5lu", 1ul << (WIFI_CONNECT_FIRST_BUCKET_SHIFT + i));
+        } else {
+            Serial.print(" more");
+        }
+    }
+    Serial.println();
+    Serial.print("[Network]   fast        ");
+    for (int i = 0; i < WIFI_CONNECT_BUCKETS; i++) {
+        Serial.printf(" %-6lu", (unsigned long)s.fastBuckets[i]);
+    }
+    Serial.println();
+    Serial.print("[Network]   full        ");
+    for (int i = 0; i < WIFI_CONNECT_BUCKETS; i++) {
+        Serial.printf(" %-6lu", (unsigned long)s.fullBuckets[i]);
+    }
+    Serial.println();
+}
+
 // ============================================================================
 // Keep-Alive Management (R5.2-R5.4)
 // ============================================================================
 
 void NetworkManager::update() {
+    // Apply WiFi events and give up on a connect that has stalled
+    advance();
+    WifiPhase phase = _phase.load();
+    if ((phase == WifiPhase::SCAN || phase == WifiPhase::ASSOCIATE || phase == WifiPhase::DHCP) &&
+        millis() - _connectStartMs > WIFI_CONNECT_TIMEOUT_MS) {
+        failConnection("Connection timeout");
+    }
+    
+    // Renew the lease a fast connect borrowed, now that nothing is in flight
+    if (_leaseRenewing && phase == WifiPhase::CONNECTED) {
+        checkLeaseRenewal();
+    } else if (_leaseRenewDue && phase == WifiPhase::CONNECTED && isConnected()) {
+        startLeaseRenewal();
+    }
+    
     // Skip auto-disconnect if not connected or in polling mode
-    if (!isConnected() || _pollingMode) {
+    if (!isConnected() || _pollingMode.load()) {
         return;
     }
     
     // Check if keep-alive has expired
     uint32_t now = millis();
-    if (_lastActivityMs > 0 && (now - _lastActivityMs) > _keepAliveDurationMs) {
+    uint32_t lastActivityMs = _lastActivityMs.load();
+    if (lastActivityMs > 0 && (now - lastActivityMs) > _keepAliveDurationMs) {
         Serial.println("[Network] Keep-alive expired, auto-disconnecting");
         disconnect();
     }
 }
 
 void NetworkManager::resetKeepAliveTimer() {
-    _lastActivityMs = millis();
+    _lastActivityMs.store(millis());
 }
 
 void NetworkManager::extendKeepAlive() {
@@ -107,17 +715,14 @@ bool NetworkManager::ensureConnected() {
 // ============================================================================
 
 void NetworkManager::beginPollingMode() {
-    _pollingMode = true;
+    _pollingMode.store(true);
     Serial.println("[Network] Polling mode ENABLED - WiFi will stay connected");
     
-    // Ensure we're connected when entering polling mode
-    if (!isConnected()) {
-        ensureConnected();
-    }
+    // Called from the UI thread: the first poll connects on the network task
 }
 
 void NetworkManager::endPollingMode() {
-    _pollingMode = false;
+    _pollingMode.store(false);
     Serial.println("[Network] Polling mode DISABLED - normal keep-alive behavior");
     
     // Reset keep-alive timer so we don't immediately disconnect
@@ -125,51 +730,19 @@ void NetworkManager::endPollingMode() {
 }
 
 bool NetworkManager::isInPollingMode() const {
-    return _pollingMode;
+    return _pollingMode.load();
 }
 
 bool NetworkManager::connect(const char* ssid, const char* password, uint32_t timeoutMs) {
-    // Check if WiFi is properly configured
-    if (!isWifiConfigured()) {
-        Serial.println("[Network] ERROR: WiFi not configured!");
-        Serial.println("[Network] Copy credentials.example.h to credentials.h and add your WiFi credentials");
-        _status = NetworkStatus::ERROR;
-        _wifiNotConfigured = true;
+    if (!requestConnection(ssid, password)) {
         return false;
     }
-    _wifiNotConfigured = false;
-    
-    Serial.printf("[Network] Connecting to WiFi '%s'...\n", ssid);
-    
-    _status = NetworkStatus::CONNECTING;
-    
-    WiFi.begin(ssid, password);
-    
-    uint32_t startTime = millis();
-    while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - startTime > timeoutMs) {
-            Serial.println("[Network] Connection timeout");
-            _status = NetworkStatus::ERROR;
-            WiFi.disconnect();
-            return false;
-        }
-        M5.delay(100);
-        Serial.print(".");
-    }
-    
-    Serial.println();
-    Serial.printf("[Network] Connected! IP: %s\n", WiFi.localIP().toString().c_str());
-    _status = NetworkStatus::CONNECTED;
-    
-    // Reset keep-alive timer on successful connection
-    resetKeepAliveTimer();
-    
-    return true;
+    return waitForConnection(timeoutMs);
 }
 
 void NetworkManager::disconnect() {
     // Don't disconnect if in polling mode (R5.5)
-    if (_pollingMode) {
+    if (_pollingMode.load()) {
         Serial.println("[Network] Disconnect requested but in polling mode - ignoring");
         return;
     }
@@ -179,14 +752,17 @@ void NetworkManager::disconnect() {
 
 void NetworkManager::forceDisconnect() {
     Serial.println("[Network] Force disconnecting from WiFi");
+    _phase = WifiPhase::IDLE;  // The disconnect event is not a drop
     WiFi.disconnect(true);
     WiFi.mode(WIFI_OFF);
-    _status = NetworkStatus::DISCONNECTED;
-    _lastActivityMs = 0;  // Clear keep-alive timer
+    _leaseRenewDue = false;
+    _leaseRenewing = false;
+    setStatus(NetworkStatus::DISCONNECTED);
+    _lastActivityMs.store(0);  // Clear keep-alive timer
 }
 
 NetworkStatus NetworkManager::getStatus() const {
-    return _status;
+    return _status.load();
 }
 
 bool NetworkManager::isConnected() const {
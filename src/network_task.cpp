@@ -0,0 +1,442 @@
+/**
+ * network_task.cpp - Background network worker implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "network_task.h"
+#include "network.h"
+#include <new>
+#include <cstring>
+
+// ============================================================================
+// Singleton / Constructor
+// ============================================================================
+
+NetworkTask& NetworkTask::getInstance() {
+    static NetworkTask instance;
+    return instance;
+}
+
+NetworkTask::NetworkTask()
+    : _api(nullptr)
+    , _network(nullptr)
+    , _task(nullptr)
+    , _requests(nullptr)
+    , _completions(nullptr)
+    , _nextId(1)
+    , _outstanding(0)
+{
+    memset(_slotUsed, 0, sizeof(_slotUsed));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool NetworkTask::begin(ApiClient& api, NetworkManager& network) {
+    _api = &api;
+    _network = &network;
+
+    if (_task != nullptr) {
+        return true;
+    }
+
+    // One entry per slot, so posting an index never blocks
+    _requests = xQueueCreate(NET_TASK_MAX_JOBS, sizeof(uint8_t));
+    _completions = xQueueCreate(NET_TASK_MAX_JOBS, sizeof(uint8_t));
+    if (_requests == nullptr || _completions == nullptr) {
+        Serial.println("[NetworkTask] ERROR: Failed to create queues");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(taskMain, "network", NET_TASK_STACK_SIZE, this,
+                                NET_TASK_PRIORITY, &_task, NET_TASK_CORE) != pdPASS) {
+        Serial.println("[NetworkTask] ERROR: Failed to start task");
+        _task = nullptr;
+        return false;
+    }
+
+    Serial.printf("[NetworkTask] Started on core %d (%d job slots, %lu byte stack)\n",
+                  (int)NET_TASK_CORE, NET_TASK_MAX_JOBS, (unsigned long)NET_TASK_STACK_SIZE);
+    return true;
+}
+
+// ============================================================================
+// Completion (UI thread)
+// ============================================================================
+
+void NetworkTask::dispatch() {
+    if (_network != nullptr) {
+        if (_task == nullptr) {
+            // No task - keep-alive still has to run somewhere
+            _network->update();
+            _api->closeIdleConnection();
+        }
+        _network->dispatchEvents();
+    }
+    if (_task == nullptr) {
+        return;
+    }
+
+    uint8_t slot;
+    while (xQueueReceive(_completions, &slot, 0) == pdTRUE) {
+        NetJob& job = _jobs[slot];
+
+        uint32_t waitMs = job.startedMs - job.queuedMs;
+        uint32_t runMs = job.finishedMs - job.startedMs;
+        _stats.completed++;
+        _stats.lastWaitMs = waitMs;
+        _stats.lastRunMs = runMs;
+        if (waitMs > _stats.maxWaitMs) {
+            _stats.maxWaitMs = waitMs;
+        }
+        if (runMs > _stats.maxRunMs) {
+            _stats.maxRunMs = runMs;
+        }
+
+        if (job.status == NetJobStatus::TIMED_OUT) {
+            _stats.timedOut++;
+        }
+
+        static const char* const STATUS_NAMES[] = { "done", "cancelled", "timed out" };
+        Serial.printf("[NetworkTask] Job %lu (%s) %s: waited %lu ms, ran %lu ms\n",
+                      (unsigned long)job.id, typeName(job.type), STATUS_NAMES[(int)job.status],
+                      (unsigned long)waitMs, (unsigned long)runMs);
+
+        // The slot stays taken until the callback returns, so a job it
+        // submits lands in another slot
+        if (job.callback != nullptr) {
+            job.callback(job, job.userData);
+        }
+        _slotUsed[slot] = false;
+    }
+}
+
+// ============================================================================
+// Submission (UI thread)
+// ============================================================================
+
+uint32_t NetworkTask::submitInitiateLogin(NetJobCallback callback, void* userData) {
+    return enqueue(acquire(NetJobType::INITIATE_LOGIN, callback, userData));
+}
+
+uint32_t NetworkTask::submitPollLogin(const char* pairingCode, NetJobCallback callback, void* userData) {
+    NetJob* job = acquire(NetJobType::POLL_LOGIN, callback, userData);
+    if (job != nullptr) {
+        strncpy(job->arg, pairingCode, sizeof(job->arg) - 1);
+    }
+    return enqueue(job);
+}
+
+uint32_t NetworkTask::submitFamilyMembers(NetJobCallback callback, void* userData) {
+    return enqueue(acquire(NetJobType::FAMILY_MEMBERS, callback, userData));
+}
+
+uint32_t NetworkTask::submitTodayAllowance(const char* childId, NetJobCallback callback, void* userData) {
+    NetJob* job = acquire(NetJobType::TODAY_ALLOWANCE, callback, userData);
+    if (job != nullptr) {
+        strncpy(job->arg, childId, sizeof(job->arg) - 1);
+    }
+    return enqueue(job);
+}
+
+uint32_t NetworkTask::submitPushConsumedTime(const char* childId, uint32_t minutes, time_t startTime,
+                                             NetJobCallback callback, void* userData) {
+    NetJob* job = acquire(NetJobType::PUSH_CONSUMED_TIME, callback, userData);
+    if (job != nullptr) {
+        strncpy(job->arg, childId, sizeof(job->arg) - 1);
+        job->minutes = minutes;
+        job->startTime = startTime;
+    }
+    return enqueue(job);
+}
+
+uint32_t NetworkTask::submitRequestMoreTime(const char* childId, const char* childName,
+                                            NetJobCallback callback, void* userData) {
+    NetJob* job = acquire(NetJobType::REQUEST_MORE_TIME, callback, userData);
+    if (job != nullptr) {
+        strncpy(job->arg, childId, sizeof(job->arg) - 1);
+        if (childName != nullptr) {
+            strncpy(job->childName, childName, sizeof(job->childName) - 1);
+        }
+    }
+    return enqueue(job);
+}
+
+uint32_t NetworkTask::submitPollMoreTime(const char* grantId, NetJobCallback callback, void* userData) {
+    NetJob* job = acquire(NetJobType::POLL_MORE_TIME, callback, userData);
+    if (job != nullptr) {
+        strncpy(job->arg, grantId, sizeof(job->arg) - 1);
+    }
+    return enqueue(job);
+}
+
+uint32_t NetworkTask::submitSyncTime(NetJobCallback callback, void* userData) {
+    return enqueue(acquire(NetJobType::SYNC_TIME, callback, userData));
+}
+
+void NetworkTask::cancel(uint32_t jobId) {
+    if (jobId == 0) {
+        return;
+    }
+    for (int i = 0; i < NET_TASK_MAX_JOBS; i++) {
+        if (_slotUsed[i] && _jobs[i].id == jobId) {
+            // The task never reads the callback, so this needs no lock; the
+            // flag stops the job before it starts or at its next HTTP step
+            if (!_jobs[i].control.cancelled.exchange(true)) {
+                _stats.cancelled++;
+            }
+            _jobs[i].callback = nullptr;
+            return;
+        }
+    }
+}
+
+bool NetworkTask::isBusy() const {
+    for (int i = 0; i < NET_TASK_MAX_JOBS; i++) {
+        if (_slotUsed[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NetworkTask::waitIdle(uint32_t timeoutMs) {
+    uint32_t startMs = millis();
+    while (_outstanding.load() > 0) {
+        if (millis() - startMs >= timeoutMs) {
+            Serial.printf("[NetworkTask] %d job(s) still running after %lu ms\n",
+                          _outstanding.load(), (unsigned long)timeoutMs);
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const NetworkTaskStats& NetworkTask::getStats() const {
+    return _stats;
+}
+
+void NetworkTask::printStats() const {
+    Serial.printf("[NetworkTask] Jobs: %lu submitted, %lu rejected, %lu completed (%lu cancelled, %lu timed out)\n",
+                  (unsigned long)_stats.submitted, (unsigned long)_stats.rejected,
+                  (unsigned long)_stats.completed, (unsigned long)_stats.cancelled,
+                  (unsigned long)_stats.timedOut);
+    Serial.printf("[NetworkTask] Queue wait: last %lu ms, max %lu ms; run: last %lu ms, max %lu ms\n",
+                  (unsigned long)_stats.lastWaitMs, (unsigned long)_stats.maxWaitMs,
+                  (unsigned long)_stats.lastRunMs, (unsigned long)_stats.maxRunMs);
+    if (_task != nullptr) {
+        Serial.printf("[NetworkTask] Stack headroom: %lu bytes\n",
+                      (unsigned long)uxTaskGetStackHighWaterMark(_task));
+    }
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+NetJob* NetworkTask::acquire(NetJobType type, NetJobCallback callback, void* userData) {
+    if (_task == nullptr) {
+        Serial.printf("[NetworkTask] Not running - %s dropped\n", typeName(type));
+        _stats.rejected++;
+        return nullptr;
+    }
+
+    for (int i = 0; i < NET_TASK_MAX_JOBS; i++) {
+        if (!_slotUsed[i]) {
+            _slotUsed[i] = true;
+            NetJob& job = _jobs[i];
+            job.reset();
+            job.type = type;
+            job.id = _nextId++;
+            if (_nextId == 0) {
+                _nextId = 1;  // 0 means "not queued"
+            }
+            job.callback = callback;
+            job.userData = userData;
+
+            bool poll = type == NetJobType::POLL_LOGIN || type == NetJobType::POLL_MORE_TIME;
+            job.control.deadlineMs = millis() + (poll ? NET_POLL_TIMEOUT_MS : NET_JOB_TIMEOUT_MS);
+            return &job;
+        }
+    }
+
+    Serial.printf("[NetworkTask] All %d slots busy - %s dropped\n", NET_TASK_MAX_JOBS, typeName(type));
+    _stats.rejected++;
+    return nullptr;
+}
+
+uint32_t NetworkTask::enqueue(NetJob* job) {
+    if (job == nullptr) {
+        return 0;
+    }
+
+    uint8_t slot = (uint8_t)(job - _jobs);
+    job->queuedMs = millis();
+    _outstanding++;
+    // A free slot guarantees room in the queue
+    xQueueSend(_requests, &slot, 0);
+
+    _stats.submitted++;
+    Serial.printf("[NetworkTask] Queued job %lu (%s)\n", (unsigned long)job->id, typeName(job->type));
+    return job->id;
+}
+
+void NetworkTask::run(NetJob& job) {
+    switch (job.type) {
+        case NetJobType::INITIATE_LOGIN:
+            new (&job.deviceCode) DeviceCodeResponse(_api->initiateLogin());
+            break;
+
+        case NetJobType::POLL_LOGIN:
+            new (&job.loginPoll) LoginPollResult(_api->pollLoginStatus(job.arg));
+            break;
+
+        case NetJobType::FAMILY_MEMBERS: {
+            FamilyGroupResult* family = new (&job.family) FamilyGroupResult();
+            int maxCount = sizeof(family->members) / sizeof(family->members[0]);
+            family->success = _api->getFamilyMembers(family->members, maxCount, family->memberCount);
+            // Hand the family ID back with the result so the UI needn't read the client
+            strncpy(family->familyId, _api->getFamilyId(), sizeof(family->familyId) - 1);
+            break;
+        }
+
+        case NetJobType::TODAY_ALLOWANCE:
+            new (&job.allowance) AllowanceResult(_api->getTodayAllowance(job.arg));
+            break;
+
+        case NetJobType::PUSH_CONSUMED_TIME:
+            new (&job.consumed) ConsumedTimeResult(
+                _api->pushConsumedTime(job.arg, job.minutes, job.startTime));
+            break;
+
+        case NetJobType::REQUEST_MORE_TIME:
+            new (&job.moreTime) MoreTimeRequestResult(
+                _api->requestAdditionalTime(job.arg, job.childName[0] ? job.childName : nullptr));
+            break;
+
+        case NetJobType::POLL_MORE_TIME:
+            new (&job.moreTimePoll) MoreTimePollResult(_api->pollMoreTimeStatus(job.arg));
+            break;
+
+        case NetJobType::SYNC_TIME:
+            job.timeSynced = _network->ensureConnected() && _network->syncTimeAndSetRTC();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void NetworkTask::fail(NetJob& job, const char* message) {
+    // The failed result a skipped job hands to its callback
+    char* errorMessage = nullptr;
+    switch (job.type) {
+        case NetJobType::INITIATE_LOGIN:
+            errorMessage = (new (&job.deviceCode) DeviceCodeResponse())->errorMessage;
+            break;
+
+        case NetJobType::POLL_LOGIN: {
+            LoginPollResult* result = new (&job.loginPoll) LoginPollResult();
+            result->pending = false;
+            errorMessage = result->errorMessage;
+            break;
+        }
+
+        case NetJobType::FAMILY_MEMBERS:
+            errorMessage = (new (&job.family) FamilyGroupResult())->errorMessage;
+            break;
+
+        case NetJobType::TODAY_ALLOWANCE:
+            errorMessage = (new (&job.allowance) AllowanceResult())->errorMessage;
+            break;
+
+        case NetJobType::PUSH_CONSUMED_TIME:
+            errorMessage = (new (&job.consumed) ConsumedTimeResult())->errorMessage;
+            break;
+
+        case NetJobType::REQUEST_MORE_TIME:
+            errorMessage = (new (&job.moreTime) MoreTimeRequestResult())->errorMessage;
+            break;
+
+        case NetJobType::POLL_MORE_TIME: {
+            MoreTimePollResult* result = new (&job.moreTimePoll) MoreTimePollResult();
+            result->pending = false;
+            errorMessage = result->errorMessage;
+            break;
+        }
+
+        case NetJobType::SYNC_TIME:
+            job.timeSynced = false;
+            break;
+
+        default:
+            break;
+    }
+
+    // Every result type has the same 64-character message field
+    if (errorMessage != nullptr) {
+        snprintf(errorMessage, sizeof(ConsumedTimeResult::errorMessage), "%s", message);
+    }
+}
+
+void NetworkTask::taskMain(void* param) {
+    NetworkTask* self = static_cast<NetworkTask*>(param);
+
+    for (;;) {
+        uint8_t slot;
+        if (xQueueReceive(self->_requests, &slot, pdMS_TO_TICKS(NET_TASK_IDLE_MS)) != pdTRUE) {
+            // Idle - the keep-alive may drop WiFi now that nothing is using it
+            self->_network->update();
+            self->_api->closeIdleConnection();
+            continue;
+        }
+
+        NetJob& job = self->_jobs[slot];
+        job.startedMs = millis();
+
+        if (job.control.cancelled.load()) {
+            job.status = NetJobStatus::CANCELLED;
+            self->fail(job, "Cancelled");
+        } else if ((int32_t)(job.startedMs - job.control.deadlineMs) >= 0) {
+            job.status = NetJobStatus::TIMED_OUT;
+            self->fail(job, "Timed out");
+        } else {
+            // ApiClient checks the deadline and cancel flag between HTTP steps
+            self->_api->setRequestControl(&job.control);
+            self->run(job);
+            int error = self->_api->getLastError();
+            self->_api->setRequestControl(nullptr);
+
+            // Only when that is what stopped it; a result that made it
+            // through stays COMPLETED even if the deadline passed since
+            if (error == API_ERROR_CANCELLED) {
+                job.status = NetJobStatus::CANCELLED;
+            } else if (error == API_ERROR_TIMED_OUT) {
+                job.status = NetJobStatus::TIMED_OUT;
+            }
+        }
+        job.finishedMs = millis();
+
+        xQueueSend(self->_completions, &slot, portMAX_DELAY);
+        self->_outstanding--;
+    }
+}
+
+const char* NetworkTask::typeName(NetJobType type) {
+    switch (type) {
+        case NetJobType::INITIATE_LOGIN:     return "initiate login";
+        case NetJobType::POLL_LOGIN:         return "poll login";
+        case NetJobType::FAMILY_MEMBERS:     return "family members";
+        case NetJobType::TODAY_ALLOWANCE:    return "today allowance";
+        case NetJobType::PUSH_CONSUMED_TIME: return "push consumed time";
+        case NetJobType::REQUEST_MORE_TIME:  return "request more time";
+        case NetJobType::POLL_MORE_TIME:     return "poll more time";
+        case NetJobType::SYNC_TIME:          return "sync time";
+        default:                             return "unknown";
+    }
+}
@@ -2,6 +2,7 @@
  * polling_manager.cpp - Polling Manager implementation
  * 
  * Manages non-blocking polling for login and more-time requests.
+ * Each poll is a NetworkTask job; its result comes back through dispatch().
  * 
  * @author Screen Time Tracker
  * @version 1.0
@@ -10,6 +11,7 @@
 #include "polling_manager.h"
 #include "api_client.h"
 #include "network.h"
+#include "network_task.h"
 #include <Arduino.h>
 #include <cstring>
 
@@ -38,6 +40,7 @@ PollingManager::PollingManager()
     , _userData(nullptr)
     , _startTimeMs(0)
     , _lastPollMs(0)
+    , _jobId(0)
     , _loginPollIntervalMs(DEFAULT_LOGIN_POLL_INTERVAL_MS)
     , _loginTimeoutMs(DEFAULT_LOGIN_TIMEOUT_MS)
     , _moreTimePollIntervalMs(DEFAULT_MORE_TIME_POLL_INTERVAL_MS)
@@ -85,8 +88,8 @@ void PollingManager::update() {
         return;
     }
     
-    // Check if it's time to poll
-    if (now - _lastPollMs >= interval) {
+    // Check if it's time to poll (the previous poll has to have come back)
+    if (_jobId == 0 && now - _lastPollMs >= interval) {
         _lastPollMs = now;
         
         switch (_type) {
@@ -193,6 +196,10 @@ void PollingManager::stopPolling() {
         _network->endPollingMode();
     }
     
+    // A poll still in flight comes back to nobody
+    NetworkTask::getInstance().cancel(_jobId);
+    _jobId = 0;
+    
     _type = PollingType::NONE;
     _status = PollingStatus::IDLE;
     _pollId[0] = '\0';
@@ -269,8 +276,20 @@ void PollingManager::pollLogin() {
     Serial.printf("[PollingManager] Polling login status (%lu s elapsed)...\n",
                   getElapsedSeconds());
     
-    LoginPollResult apiResult = _api->pollLoginStatus(_pollId);
-    
+    // Runs on the network task; a full queue just retries next interval
+    _jobId = NetworkTask::getInstance().submitPollLogin(_pollId, onLoginPolled, this);
+}
+
+void PollingManager::onLoginPolled(const NetJob& job, void* userData) {
+    PollingManager* self = static_cast<PollingManager*>(userData);
+    if (self == nullptr || job.id != self->_jobId) {
+        return;
+    }
+    self->_jobId = 0;
+    self->handleLoginPoll(job.loginPoll);
+}
+
+void PollingManager::handleLoginPoll(const LoginPollResult& apiResult) {
     if (!apiResult.success) {
         // API call failed
         PollingResult result;
@@ -311,8 +330,20 @@ void PollingManager::pollMoreTime() {
     Serial.printf("[PollingManager] Polling more-time status (%lu s elapsed)...\n",
                   getElapsedSeconds());
     
-    MoreTimePollResult apiResult = _api->pollMoreTimeStatus(_pollId);
-    
+    // Runs on the network task; a full queue just retries next interval
+    _jobId = NetworkTask::getInstance().submitPollMoreTime(_pollId, onMoreTimePolled, this);
+}
+
+void PollingManager::onMoreTimePolled(const NetJob& job, void* userData) {
+    PollingManager* self = static_cast<PollingManager*>(userData);
+    if (self == nullptr || job.id != self->_jobId) {
+        return;
+    }
+    self->_jobId = 0;
+    self->handleMoreTimePoll(job.moreTimePoll);
+}
+
+void PollingManager::handleMoreTimePoll(const MoreTimePollResult& apiResult) {
     if (!apiResult.success) {
         // API call failed
         PollingResult result;
@@ -364,7 +395,9 @@ void PollingManager::completePolling(const PollingResult& result) {
     PollingCallback callback = _callback;
     void* userData = _userData;
     
-    // Clear polling state
+    // Clear polling state (a timeout may leave a poll in flight)
+    NetworkTask::getInstance().cancel(_jobId);
+    _jobId = 0;
     _type = PollingType::NONE;
     _pollId[0] = '\0';
     _callback = nullptr;
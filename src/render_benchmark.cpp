@@ -0,0 +1,565 @@
+/**
+ * render_benchmark.cpp - Golden-frame render benchmark implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "render_benchmark.h"
+#include "activation_ring.h"
+#include "avatar_cache.h"
+#include "avatar_manifest.h"
+#include "compositor.h"
+#include "dialog.h"
+#include "render_profiler.h"
+#include "ui.h"
+#include "timer.h"
+#include "session_manager.h"
+#include "screen_manager.h"
+#include "screens/main_screen.h"
+#include "screens/login_screen.h"
+#include "screens/select_child_screen.h"
+#include "screens/sync_screen.h"
+#include "screens/system_info_screen.h"
+#include "screens/settings_screen.h"
+#include "screens/brightness_screen.h"
+#include "screens/parent_screen.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef ARDUINO
+#include <sys/stat.h>
+#endif
+
+// Deterministic timer for the main screen frames: 1h allowance, 12:34 used
+static constexpr uint32_t BENCH_ALLOWANCE_SECONDS = 3600;
+static constexpr uint32_t BENCH_CONSUMED_SECONDS = 754;
+
+// Clock shown in the frames: Monday 9 Dec 2024, 10:00 UTC
+static constexpr time_t BENCH_TIME = 1733738400;
+
+// Region the compositor tick frames redraw (a countdown-sized box)
+static constexpr int BENCH_TICK_X = 70;
+static constexpr int BENCH_TICK_Y = 55;
+static constexpr int BENCH_TICK_W = 100;
+static constexpr int BENCH_TICK_H = 28;
+
+// Avatar frames: draws timed per path, centered on the screen
+static constexpr int BENCH_AVATAR_DRAWS = 20;
+static constexpr int BENCH_AVATAR_X = SCREEN_WIDTH / 2;
+static constexpr int BENCH_AVATAR_Y = SCREEN_HEIGHT / 2;
+
+// Activation ring frames: the ring UI draws outside the status ring
+static constexpr int BENCH_RING_RADIUS = AVATAR_RADIUS + STATUS_RING_THICKNESS + 1;
+
+/**
+ * Draw an avatar the way AvatarCache did before blobs: read the PNG from
+ * LittleFS and decode it onto the target on every draw
+ */
+static bool drawAvatarPng(lgfx::LovyanGFX& gfx, const char* avatarName,
+                          int centerX, int centerY, int radius) {
+    char path[64];
+    snprintf(path, sizeof(path), "/avatars/%s.png", avatarName);
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    size_t size = file.size();
+    uint8_t* png = (uint8_t*)malloc(size);
+    if (png == nullptr) {
+        file.close();
+        return false;
+    }
+    bool complete = file.read(png, size) == size;
+    file.close();
+
+    gfx.fillCircle(centerX, centerY, radius, COLOR_AVATAR_PRIMARY);
+    bool drawn = complete && gfx.drawPng(png, size, centerX - radius, centerY - radius);
+    gfx.clearClipRect();
+    free(png);
+    return drawn;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+RenderBenchmark::RenderBenchmark()
+    : _goldenCount(0)
+    , _goldensChanged(false)
+    , _frames(0)
+    , _mismatches(0)
+    , _missing(0)
+    , _frameStartUs(0)
+    , _frameStartPixels(0)
+    , _frameStartPrimitives(0)
+{
+    memset(_goldens, 0, sizeof(_goldens));
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+bool RenderBenchmark::run() {
+    Serial.println("[RenderBench] === RENDER BENCHMARK ===");
+
+    if (!_capture.begin()) {
+        Serial.println("[RenderBench] ERROR: No memory for the frame capture");
+        return false;
+    }
+    loadGoldens();
+
+    DisplayTarget& target = _capture.target();
+    uint32_t runStartMs = millis();
+
+    // Profiler sections cover only the benchmark frames
+    RenderProfiler& profiler = RenderProfiler::getInstance();
+    profiler.reset();
+
+    renderComponents(target);
+    renderAvatars(target);
+    renderActivationRing(target);
+    renderScreens(target);
+
+    if (_goldensChanged) {
+        saveGoldens();
+    }
+    profiler.printReport();
+
+    Serial.printf("[RenderBench] %lu frames, %lu mismatches, %lu missing, %lu ms\n",
+                  (unsigned long)_frames, (unsigned long)_mismatches,
+                  (unsigned long)_missing, (unsigned long)(millis() - runStartMs));
+    if (_missing > 0) {
+        Serial.println("[RenderBench] Missing goldens recorded - rerun to compare");
+    }
+    return _mismatches == 0 && _missing == 0;
+}
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+void RenderBenchmark::renderComponents(DisplayTarget& target) {
+    // ------------------------------------------------------------------------
+    // Dialog overlay
+    // ------------------------------------------------------------------------
+    Dialog* dialog = new Dialog(target);
+    if (dialog != nullptr) {
+        _capture.clear(COLOR_BACKGROUND);
+        beginFrame();
+        dialog->showInfo("Benchmark", "Rendering a dialog with a message long enough to wrap.", "OK");
+        dialog->draw();
+        endFrame("dialog", 0);
+        delete dialog;
+    }
+
+    // ------------------------------------------------------------------------
+    // Compositor: one full frame, then small dirty-region flushes
+    // ------------------------------------------------------------------------
+    Compositor* compositor = new Compositor(target);
+    if (compositor == nullptr || !compositor->begin()) {
+        Serial.println("[RenderBench] Skipping compositor frames (no framebuffer)");
+        delete compositor;
+        return;
+    }
+    lgfx::LovyanGFX& canvas = compositor->target();
+
+    _capture.clear(COLOR_BACKGROUND);
+    beginFrame();
+    canvas.fillScreen(COLOR_BACKGROUND);
+    canvas.drawRoundRect(2, 2, SCREEN_WIDTH - 4, SCREEN_HEIGHT - 4, 8, COLOR_ACCENT_SUCCESS);
+    canvas.setFont(&fonts::Font2);
+    canvas.setTextColor(COLOR_TEXT_PRIMARY, COLOR_BACKGROUND);
+    canvas.drawString("Compositor benchmark", 12, 10);
+    compositor->markAllDirty();
+    compositor->flush();
+    endFrame("compositor_full", compositor->getStats().lastFlushPixels * 2);
+
+    canvas.setFont(&fonts::Font4);
+    for (int tick = 0; tick < RENDER_BENCHMARK_TICKS; tick++) {
+        uint32_t remaining = BENCH_ALLOWANCE_SECONDS - BENCH_CONSUMED_SECONDS - tick - 1;
+        char text[8];
+        snprintf(text, sizeof(text), "%02lu:%02lu",
+                 (unsigned long)(remaining / 60), (unsigned long)(remaining % 60));
+
+        char name[RENDER_BENCHMARK_NAME_LEN];
+        snprintf(name, sizeof(name), "compositor_tick_%d", tick);
+
+        beginFrame();
+        canvas.fillRect(BENCH_TICK_X, BENCH_TICK_Y, BENCH_TICK_W, BENCH_TICK_H, COLOR_BACKGROUND);
+        canvas.drawString(text, BENCH_TICK_X, BENCH_TICK_Y);
+        compositor->markDirty(BENCH_TICK_X, BENCH_TICK_Y, BENCH_TICK_W, BENCH_TICK_H);
+        compositor->flush();
+        endFrame(name, compositor->getStats().lastFlushPixels * 2);
+    }
+
+    delete compositor;
+}
+
+void RenderBenchmark::renderAvatars(DisplayTarget& target) {
+    const char* name = AVATAR_BLOB_NAMES[0];
+    AvatarCache& cache = AvatarCache::getInstance();
+    cache.clear();
+
+    // ------------------------------------------------------------------------
+    // Before the blob cache: PNG read and decoded on every draw
+    // ------------------------------------------------------------------------
+    _capture.clear(COLOR_BACKGROUND);
+    if (!drawAvatarPng(target, name, BENCH_AVATAR_X, BENCH_AVATAR_Y, AVATAR_RADIUS)) {
+        Serial.printf("[RenderBench] Skipping avatar frames (no /avatars/%s.png)\n", name);
+        return;
+    }
+    _capture.clear(COLOR_BACKGROUND);
+    beginFrame();
+    uint32_t pngStartUs = micros();
+    for (int i = 0; i < BENCH_AVATAR_DRAWS; i++) {
+        drawAvatarPng(target, name, BENCH_AVATAR_X, BENCH_AVATAR_Y, AVATAR_RADIUS);
+    }
+    uint32_t pngUs = micros() - pngStartUs;
+    endFrame("avatar_png", 0);
+
+    // ------------------------------------------------------------------------
+    // AvatarCache: blob loaded on the first draw, span blit afterwards
+    // ------------------------------------------------------------------------
+    _capture.clear(COLOR_BACKGROUND);
+    beginFrame();
+    uint32_t loadStartUs = micros();
+    bool blobDrawn = cache.draw(target, name, BENCH_AVATAR_X, BENCH_AVATAR_Y, AVATAR_RADIUS);
+    uint32_t loadUs = micros() - loadStartUs;
+    uint32_t blitStartUs = micros();
+    for (int i = 1; i < BENCH_AVATAR_DRAWS; i++) {
+        cache.draw(target, name, BENCH_AVATAR_X, BENCH_AVATAR_Y, AVATAR_RADIUS);
+    }
+    uint32_t blitUs = micros() - blitStartUs;
+    endFrame("avatar_blob", 0);
+    cache.clear();
+
+    if (!blobDrawn) {
+        Serial.printf("[RenderBench] No blob for %s (run scripts/build_avatars.py)\n", name);
+        return;
+    }
+    Serial.printf("[RenderBench] Avatar %s: PNG %lu us/draw, blob %lu us/draw (first draw %lu us with load)\n",
+                  name, (unsigned long)(pngUs / BENCH_AVATAR_DRAWS),
+                  (unsigned long)(blitUs / (BENCH_AVATAR_DRAWS - 1)), (unsigned long)loadUs);
+}
+
+void RenderBenchmark::renderActivationRing(DisplayTarget& target) {
+    ActivationRing* ring = new ActivationRing();
+    if (ring == nullptr || !ring->begin(BENCH_RING_RADIUS, BENCH_RING_RADIUS + 2)) {
+        Serial.println("[RenderBench] Skipping activation ring frames (no span table)");
+        delete ring;
+        return;
+    }
+
+    // One tick per second of the minimum session countdown, down to the hidden ring
+    const uint32_t ticks = MINIMUM_SESSION_DURATION_SECONDS + 1;
+    const uint32_t captureTick = MINIMUM_SESSION_DURATION_SECONDS / 2;
+
+    // ------------------------------------------------------------------------
+    // Before the span table: 360-degree fillArc clear, then the arc, every tick
+    // ------------------------------------------------------------------------
+    uint64_t fillArcPixels = 0;
+    uint32_t fillArcUs = 0;
+    _capture.clear(COLOR_BACKGROUND);
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        int degrees = (int)((MINIMUM_SESSION_DURATION_SECONDS - tick) * 360 /
+                            MINIMUM_SESSION_DURATION_SECONDS);
+        if (tick == captureTick) {
+            beginFrame();
+        }
+
+        uint32_t startUs = micros();
+        target.fillArc(BENCH_AVATAR_X, BENCH_AVATAR_Y, BENCH_RING_RADIUS, BENCH_RING_RADIUS + 2,
+                       270, 270 + 360, COLOR_BACKGROUND);
+        if (degrees > 0) {
+            target.fillArc(BENCH_AVATAR_X, BENCH_AVATAR_Y, BENCH_RING_RADIUS, BENCH_RING_RADIUS + 2,
+                           270, 270 + degrees, COLOR_ACCENT_SUCCESS);
+        }
+        fillArcUs += micros() - startUs;
+        fillArcPixels += ring->getStats().ringPixels + ring->arcPixels(degrees);
+
+        if (tick == captureTick) {
+            endFrame("ring_fillarc_half", 0);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // ActivationRing: only the slice given up since the last tick
+    // ------------------------------------------------------------------------
+    uint64_t spanPixels = 0;
+    uint32_t spanUs = 0;
+    _capture.clear(COLOR_BACKGROUND);
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        int degrees = (int)((MINIMUM_SESSION_DURATION_SECONDS - tick) * 360 /
+                            MINIMUM_SESSION_DURATION_SECONDS);
+        if (tick == captureTick) {
+            beginFrame();
+        }
+
+        DirtyRect touched;
+        uint32_t startUs = micros();
+        bool drawn = ring->update(target, BENCH_AVATAR_X, BENCH_AVATAR_Y, degrees,
+                                  COLOR_ACCENT_SUCCESS, COLOR_BACKGROUND, touched);
+        spanUs += micros() - startUs;
+        if (drawn) {
+            spanPixels += ring->getStats().lastPixels;
+        }
+
+        if (tick == captureTick) {
+            endFrame("ring_spans_half", 0);
+        }
+    }
+
+    Serial.printf("[RenderBench] Activation ring, %lu ticks: fillArc %lu px/tick %lu us/tick, "
+                  "spans %lu px/tick %lu us/tick\n",
+                  (unsigned long)ticks,
+                  (unsigned long)(fillArcPixels / ticks), (unsigned long)(fillArcUs / ticks),
+                  (unsigned long)(spanPixels / ticks), (unsigned long)(spanUs / ticks));
+    delete ring;
+}
+
+void RenderBenchmark::renderScreens(DisplayTarget& target) {
+    ScreenTimer timer;
+    timer.begin(BENCH_ALLOWANCE_SECONDS, BENCH_CONSUMED_SECONDS);
+    SessionManager session(timer);
+
+    UI* ui = new UI(target);
+    ScreenManager* manager = new ScreenManager(target);
+    if (ui == nullptr || manager == nullptr) {
+        Serial.println("[RenderBench] ERROR: Failed to create UI");
+        delete ui;
+        delete manager;
+        return;
+    }
+    ui->begin();
+    ui->setFixedTime(BENCH_TIME);
+
+    // ------------------------------------------------------------------------
+    // Every ScreenType, drawn from a fresh instance (no onEnter side effects)
+    // ------------------------------------------------------------------------
+    for (int type = 0; type < static_cast<int>(ScreenType::COUNT); type++) {
+        Screen* screen = nullptr;
+        const char* name = nullptr;
+
+        switch (static_cast<ScreenType>(type)) {
+            case ScreenType::MAIN: {
+                MainScreen* s = new MainScreen(target, session, *ui);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "main";
+                break;
+            }
+            case ScreenType::LOGIN: {
+                LoginScreen* s = new LoginScreen(target);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "login";
+                break;
+            }
+            case ScreenType::SELECT_CHILD: {
+                SelectChildScreen* s = new SelectChildScreen(target);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "select_child";
+                break;
+            }
+            case ScreenType::SYNC_PROGRESS: {
+                SyncScreen* s = new SyncScreen(target);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "sync";
+                break;
+            }
+            case ScreenType::SYSTEM_INFO: {
+                SystemInfoScreen* s = new SystemInfoScreen(target);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "system_info";
+                break;
+            }
+            case ScreenType::SETTINGS: {
+                SettingsScreen* s = new SettingsScreen(target, *ui);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "settings";
+                break;
+            }
+            case ScreenType::BRIGHTNESS: {
+                BrightnessScreen* s = new BrightnessScreen(target);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "brightness";
+                break;
+            }
+            case ScreenType::PARENT: {
+                ParentScreen* s = new ParentScreen(target, *ui, timer);
+                if (s) s->setScreenManager(manager);
+                screen = s;
+                name = "parent";
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (screen == nullptr) {
+            Serial.printf("[RenderBench] Skipping screen type %d\n", type);
+            continue;
+        }
+
+        _capture.clear(COLOR_BACKGROUND);
+        beginFrame();
+        screen->draw();
+        endFrame(name, 0);
+        delete screen;
+    }
+
+    // ------------------------------------------------------------------------
+    // Main screen per-tick updates
+    // ------------------------------------------------------------------------
+    beginFrame();
+    ui->drawMainScreen(timer, DEFAULT_USER_NAME, DEFAULT_USER_INITIAL, "", false);
+    endFrame("main_full", ui->getCompositor().getStats().lastFlushPixels * 2);
+
+    for (int tick = 0; tick < RENDER_BENCHMARK_TICKS; tick++) {
+        // Let the UI rate limit pass, then consume one more second
+        delay(MIN_REFRESH_INTERVAL_MS);
+        timer.setConsumedTodaySeconds(BENCH_CONSUMED_SECONDS + tick + 1);
+
+        char name[RENDER_BENCHMARK_NAME_LEN];
+        snprintf(name, sizeof(name), "main_tick_%d", tick);
+
+        uint32_t flushesBefore = ui->getCompositor().getStats().flushCount;
+        beginFrame();
+        ui->updateDynamicElements(timer, false);
+        bool flushed = ui->getCompositor().getStats().flushCount != flushesBefore;
+        endFrame(name, flushed ? ui->getCompositor().getStats().lastFlushPixels * 2 : 0);
+    }
+
+    delete manager;
+    delete ui;
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+void RenderBenchmark::beginFrame() {
+    RenderProfiler& profiler = RenderProfiler::getInstance();
+    _frameStartPixels = profiler.totalPixels();
+    _frameStartPrimitives = profiler.totalPrimitives();
+    _frameStartUs = micros();
+}
+
+void RenderBenchmark::endFrame(const char* name, uint32_t bytesPushed) {
+    uint32_t renderUs = micros() - _frameStartUs;
+    RenderProfiler& profiler = RenderProfiler::getInstance();
+    uint32_t pixels = profiler.totalPixels() - _frameStartPixels;
+    uint32_t primitives = profiler.totalPrimitives() - _frameStartPrimitives;
+    FrameResult result = _capture.endFrame();
+    _frames++;
+
+    const char* status = "ok";
+    Golden* golden = findGolden(name);
+    if (golden == nullptr) {
+        if (_goldenCount < RENDER_BENCHMARK_MAX_FRAMES) {
+            golden = &_goldens[_goldenCount++];
+            strncpy(golden->name, name, sizeof(golden->name) - 1);
+            golden->checksum = result.checksum;
+            _goldensChanged = true;
+        }
+        _missing++;
+        status = "MISSING";
+    } else if (golden->checksum != result.checksum) {
+        _mismatches++;
+        status = "MISMATCH";
+    }
+
+    Serial.printf("[RenderBench] %-18s %7lu us %6lu px changed %6lu B pushed %6lu px %4lu prims  %08lX %s\n",
+                  name, (unsigned long)renderUs, (unsigned long)result.changedPixels,
+                  (unsigned long)bytesPushed, (unsigned long)pixels, (unsigned long)primitives,
+                  (unsigned long)result.checksum, status);
+}
+
+void RenderBenchmark::loadGoldens() {
+#ifdef ARDUINO
+    File file = LittleFS.open(RENDER_BENCHMARK_GOLDEN_PATH, "r");
+    if (!file) {
+        Serial.println("[RenderBench] No golden file - recording this run");
+        return;
+    }
+
+    while (file.available() && _goldenCount < RENDER_BENCHMARK_MAX_FRAMES) {
+        String line = file.readStringUntil('\n');
+        Golden& golden = _goldens[_goldenCount];
+        unsigned long checksum = 0;
+        if (sscanf(line.c_str(), "%23s %lx", golden.name, &checksum) == 2) {
+            golden.checksum = (uint32_t)checksum;
+            _goldenCount++;
+        }
+    }
+    file.close();
+#else
+    FILE* file = fopen(RENDER_BENCHMARK_NATIVE_GOLDEN_PATH, "r");
+    if (file == nullptr) {
+        Serial.println("[RenderBench] No golden file - recording this run");
+        return;
+    }
+
+    char line[64];
+    while (fgets(line, sizeof(line), file) != nullptr && _goldenCount < RENDER_BENCHMARK_MAX_FRAMES) {
+        Golden& golden = _goldens[_goldenCount];
+        unsigned long checksum = 0;
+        if (sscanf(line, "%23s %lx", golden.name, &checksum) == 2) {
+            golden.checksum = (uint32_t)checksum;
+            _goldenCount++;
+        }
+    }
+    fclose(file);
+#endif
+
+    Serial.printf("[RenderBench] Loaded %d golden frames\n", _goldenCount);
+}
+
+void RenderBenchmark::saveGoldens() {
+#ifdef ARDUINO
+    LittleFS.mkdir("/bench");
+    File file = LittleFS.open(RENDER_BENCHMARK_GOLDEN_PATH, "w");
+    if (!file) {
+        Serial.println("[RenderBench] ERROR: Could not write golden file");
+        return;
+    }
+
+    for (int i = 0; i < _goldenCount; i++) {
+        file.printf("%s %08lX\n", _goldens[i].name, (unsigned long)_goldens[i].checksum);
+    }
+    file.close();
+#else
+    mkdir(RENDER_BENCHMARK_NATIVE_GOLDEN_DIR, 0755);
+    FILE* file = fopen(RENDER_BENCHMARK_NATIVE_GOLDEN_PATH, "w");
+    if (file == nullptr) {
+        Serial.println("[RenderBench] ERROR: Could not write golden file");
+        return;
+    }
+
+    for (int i = 0; i < _goldenCount; i++) {
+        fprintf(file, "%s %08lX\n", _goldens[i].name, (unsigned long)_goldens[i].checksum);
+    }
+    fclose(file);
+#endif
+
+    Serial.printf("[RenderBench] Saved %d golden frames\n", _goldenCount);
+}
+
+RenderBenchmark::Golden* RenderBenchmark::findGolden(const char* name) {
+    for (int i = 0; i < _goldenCount; i++) {
+        if (strcmp(_goldens[i].name, name) == 0) {
+            return &_goldens[i];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,265 @@
+/**
+ * render_profiler.cpp - Scoped render-time profiler implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <cstring>
+
+// Section names, in RenderSection order
+static const char* const SECTION_NAMES[(int)RenderSection::COUNT] = {
+    "frame",
+    "dialog",
+    "main_full",
+    "main_dynamic",
+    "main_restore",
+    "compositor_flush",
+    "menu",
+    "screen_main",
+    "screen_login",
+    "screen_select_child",
+    "screen_sync",
+    "screen_system_info",
+    "screen_settings",
+    "screen_brightness",
+    "screen_parent",
+};
+
+// ============================================================================
+// Singleton / Constructor
+// ============================================================================
+
+RenderProfiler& RenderProfiler::getInstance() {
+    static RenderProfiler instance;
+    return instance;
+}
+
+RenderProfiler::RenderProfiler()
+    : _depth(0)
+    , _pixels(0)
+    , _primitives(0)
+    , _overlayVisible(false)
+{
+    memset(_stats, 0, sizeof(_stats));
+    memset(_open, 0, sizeof(_open));
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void RenderProfiler::begin(RenderSection section) {
+    // Deeper scopes than we track still balance end() through _depth
+    if (_depth < RENDER_PROFILE_MAX_DEPTH) {
+        OpenScope& scope = _open[_depth];
+        scope.section = section;
+        scope.startPixels = _pixels;
+        scope.startPrimitives = _primitives;
+        scope.startUs = micros();
+    }
+    _depth++;
+}
+
+void RenderProfiler::end() {
+    uint32_t nowUs = micros();
+    if (_depth == 0) {
+        return;
+    }
+    _depth--;
+    if (_depth >= RENDER_PROFILE_MAX_DEPTH) {
+        return;
+    }
+
+    const OpenScope& scope = _open[_depth];
+    RenderSectionStats& stats = _stats[(int)scope.section];
+    uint32_t elapsedUs = nowUs - scope.startUs;
+
+    stats.calls++;
+    stats.totalUs += elapsedUs;
+    stats.lastUs = elapsedUs;
+    if (elapsedUs > stats.maxUs) {
+        stats.maxUs = elapsedUs;
+    }
+    stats.pixels += _pixels - scope.startPixels;
+    stats.primitives += _primitives - scope.startPrimitives;
+    stats.buckets[bucketFor(elapsedUs)]++;
+}
+
+void RenderProfiler::countPixels(uint32_t pixels) {
+    _pixels += pixels;
+}
+
+void RenderProfiler::countPrimitives(uint32_t primitives) {
+    _primitives += primitives;
+}
+
+uint32_t RenderProfiler::totalPixels() const {
+    return _pixels;
+}
+
+uint32_t RenderProfiler::totalPrimitives() const {
+    return _primitives;
+}
+
+// ============================================================================
+// Overlay
+// ============================================================================
+
+void RenderProfiler::setOverlayVisible(bool visible) {
+    _overlayVisible = visible;
+}
+
+bool RenderProfiler::isOverlayVisible() const {
+    return _overlayVisible;
+}
+
+void RenderProfiler::drawOverlay(lgfx::LovyanGFX& gfx) {
+    if (!_overlayVisible) {
+        return;
+    }
+
+    // Sections with the most total time, the frame itself excluded
+    int top[RENDER_PROFILE_OVERLAY_TOP];
+    int topCount = 0;
+    for (int rank = 0; rank < RENDER_PROFILE_OVERLAY_TOP; rank++) {
+        int best = -1;
+        for (int i = (int)RenderSection::FRAME + 1; i < (int)RenderSection::COUNT; i++) {
+            bool taken = false;
+            for (int j = 0; j < topCount; j++) {
+                taken = taken || top[j] == i;
+            }
+            if (!taken && _stats[i].calls > 0 &&
+                (best < 0 || _stats[i].totalUs > _stats[best].totalUs)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        top[topCount++] = best;
+    }
+
+    const RenderSectionStats& frame = _stats[(int)RenderSection::FRAME];
+    char line[32];
+
+    gfx.startWrite();
+    gfx.fillRect(RENDER_PROFILE_OVERLAY_X, RENDER_PROFILE_OVERLAY_Y,
+                 RENDER_PROFILE_OVERLAY_W, RENDER_PROFILE_OVERLAY_H, COLOR_BACKGROUND);
+    gfx.drawRect(RENDER_PROFILE_OVERLAY_X, RENDER_PROFILE_OVERLAY_Y,
+                 RENDER_PROFILE_OVERLAY_W, RENDER_PROFILE_OVERLAY_H, COLOR_ACCENT_WARNING);
+    gfx.setFont(&fonts::Font0);
+    gfx.setTextSize(1);
+    gfx.setTextDatum(textdatum_t::top_left);
+
+    int x = RENDER_PROFILE_OVERLAY_X + 3;
+    int y = RENDER_PROFILE_OVERLAY_Y + 3;
+
+    gfx.setTextColor(COLOR_ACCENT_WARNING);
+    snprintf(line, sizeof(line), "frame %lu.%lums max %lu.%lu",
+             (unsigned long)(frame.lastUs / 1000), (unsigned long)(frame.lastUs / 100 % 10),
+             (unsigned long)(frame.maxUs / 1000), (unsigned long)(frame.maxUs / 100 % 10));
+    gfx.setCursor(x, y);
+    gfx.print(line);
+
+    gfx.setTextColor(COLOR_TEXT_PRIMARY);
+    for (int i = 0; i < topCount; i++) {
+        const RenderSectionStats& stats = _stats[top[i]];
+        uint32_t avgUs = stats.totalUs / stats.calls;
+        snprintf(line, sizeof(line), "%-13.13s%4lu.%lums", SECTION_NAMES[top[i]],
+                 (unsigned long)(avgUs / 1000), (unsigned long)(avgUs / 100 % 10));
+        gfx.setCursor(x, y + 10 * (i + 1));
+        gfx.print(line);
+    }
+
+    gfx.endWrite();
+    gfx.display();
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+const RenderSectionStats& RenderProfiler::getStats(RenderSection section) const {
+    return _stats[(int)section];
+}
+
+const char* RenderProfiler::sectionName(RenderSection section) {
+    return SECTION_NAMES[(int)section];
+}
+
+uint32_t RenderProfiler::percentileUs(RenderSection section, int percent) const {
+    const RenderSectionStats& stats = _stats[(int)section];
+    if (stats.calls == 0) {
+        return 0;
+    }
+
+    // First bucket at which the running count reaches the percentile
+    uint32_t target = (stats.calls * (uint32_t)percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < RENDER_PROFILE_BUCKETS; bucket++) {
+        seen += stats.buckets[bucket];
+        if (seen >= target) {
+            // The open-ended last bucket is bounded by the worst call
+            return bucket == RENDER_PROFILE_BUCKETS - 1 ? stats.maxUs : bucketLimitUs(bucket);
+        }
+    }
+    return stats.maxUs;
+}
+
+void RenderProfiler::printReport() const {
+    Serial.printf("[RenderProfiler] %-19s %6s %8s %8s %8s %8s %6s  histogram (<%luus, x2 per bucket)\n",
+                  "section", "calls", "avg us", "p95 us", "max us", "px/call", "prims",
+                  (unsigned long)bucketLimitUs(0));
+
+    for (int i = 0; i < (int)RenderSection::COUNT; i++) {
+        const RenderSectionStats& stats = _stats[i];
+        if (stats.calls == 0) {
+            continue;
+        }
+
+        char histogram[RENDER_PROFILE_BUCKETS * 11 + 1];
+        int length = 0;
+        for (int bucket = 0; bucket < RENDER_PROFILE_BUCKETS; bucket++) {
+            length += snprintf(histogram + length, sizeof(histogram) - length, " %lu",
+                               (unsigned long)stats.buckets[bucket]);
+            if (length >= (int)sizeof(histogram)) {
+                break;
+            }
+        }
+
+        Serial.printf("[RenderProfiler] %-19s %6lu %8lu %8lu %8lu %8lu %6lu  %s\n",
+                      SECTION_NAMES[i],
+                      (unsigned long)stats.calls,
+                      (unsigned long)(stats.totalUs / stats.calls),
+                      (unsigned long)percentileUs((RenderSection)i, 95),
+                      (unsigned long)stats.maxUs,
+                      (unsigned long)(stats.pixels / stats.calls),
+                      (unsigned long)(stats.primitives / stats.calls),
+                      histogram);
+    }
+}
+
+void RenderProfiler::reset() {
+    memset(_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+int RenderProfiler::bucketFor(uint32_t us) {
+    int bucket = 0;
+    uint32_t limit = bucketLimitUs(0);
+    while (us >= limit && bucket < RENDER_PROFILE_BUCKETS - 1) {
+        bucket++;
+        limit <<= 1;
+    }
+    return bucket;
+}
+
+uint32_t RenderProfiler::bucketLimitUs(int bucket) {
+    return 1u << (RENDER_PROFILE_FIRST_BUCKET_SHIFT + bucket);
+}
@@ -1,14 +1,34 @@
 /**
  * screen.cpp - Screen base class implementation
  * 
- * Currently empty as Screen is an abstract interface.
- * This file exists for future common utility implementations.
- * 
  * @author Screen Time Tracker
  * @version 1.0
  */
 
 #include "screen.h"
+#include "screen_manager.h"
+#include "config.h"
+
+// ============================================================================
+// Frame Scheduling
+// ============================================================================
+
+void Screen::requestRedraw() {
+    if (_scheduler == nullptr) {
+        drawFrame(true, { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT });
+        return;
+    }
+    if (_scheduler->getCurrentScreen() == this) {
+        _scheduler->requestRedraw();
+    }
+}
 
-// Screen is a pure abstract class - no implementation needed yet.
-// Future common utilities for all screens can be added here.
+void Screen::requestRedraw(int x, int y, int w, int h) {
+    if (_scheduler == nullptr) {
+        drawFrame(false, { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h });
+        return;
+    }
+    if (_scheduler->getCurrentScreen() == this) {
+        _scheduler->requestRedraw(x, y, w, h);
+    }
+}
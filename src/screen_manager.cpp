@@ -7,17 +7,30 @@
 
 #include "screen_manager.h"
 #include "dialog.h"
+#include "config.h"
+#include "render_profiler.h"
 #include <Arduino.h>
 
+// Frames are profiled per screen type
+static_assert((int)RenderSection::COUNT - (int)RenderSection::SCREEN_MAIN == (int)ScreenType::COUNT,
+              "RenderSection SCREEN_* entries must follow ScreenType");
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
 
-ScreenManager::ScreenManager(M5GFX& display)
+ScreenManager::ScreenManager(DisplayTarget& display)
     : _display(display)
     , _currentScreenType(ScreenType::NONE)
     , _historyIndex(-1)
     , _dialog(display)
+    , _framePending(false)
+    , _fullFramePending(false)
+    , _pendingRegion{0, 0, 0, 0}
+    , _frameDueMs(0)
+    , _nextFrameMs(0)
+    , _lastIdleUpdateMs(0)
+    , _frameStats{0, 0, 0, 0, 0, 0, 0}
 {
     // Initialize all screen pointers to nullptr
     for (int i = 0; i < static_cast<int>(ScreenType::COUNT); i++) {
@@ -59,6 +72,9 @@ void ScreenManager::registerScreen(ScreenType type, Screen* screen) {
     int index = static_cast<int>(type);
     if (index >= 0 && index < static_cast<int>(ScreenType::COUNT)) {
         _screens[index] = screen;
+        if (screen != nullptr) {
+            screen->attachScheduler(this);
+        }
         Serial.printf("[ScreenMgr] Registered screen type %d\n", index);
     }
 }
@@ -103,8 +119,10 @@ void ScreenManager::navigateTo(ScreenType type) {
     // Enter new screen
     newScreen->onEnter();
     
-    // Draw the new screen
-    newScreen->draw();
+    // Render the new screen right away, so it is visible before any
+    // blocking work the caller does after navigating
+    requestRedraw();
+    flushFrame();
 }
 
 bool ScreenManager::navigateBack() {
@@ -136,7 +154,8 @@ bool ScreenManager::navigateBack() {
     previousScreen->onResume();
     
     // Draw the screen
-    previousScreen->draw();
+    requestRedraw();
+    flushFrame();
     
     return true;
 }
@@ -170,17 +189,158 @@ void ScreenManager::update() {
     }
     
     Screen* screen = getCurrentScreen();
-    if (screen != nullptr) {
-        screen->update();
+    if (screen == nullptr) {
+        return;
+    }
+    
+    // Static screens only poll for changes every SCREEN_IDLE_UPDATE_MS
+    if (!screen->needsFrequentUpdates()) {
+        uint32_t now = millis();
+        if (now - _lastIdleUpdateMs < SCREEN_IDLE_UPDATE_MS) {
+            return;
+        }
+        _lastIdleUpdateMs = now;
     }
+    
+    screen->update();
 }
 
 void ScreenManager::draw() {
-    // Only draw if there's a dialog visible that needs redraw
-    if (_dialog.isVisible() && _dialog.needsRedraw()) {
-        _dialog.draw();
+    // Dialog content or spinner changed. Not a full request, so a spinner
+    // frame repaints only the spinner.
+    if (_dialog.isVisible() && _dialog.needsRedraw() && !_framePending) {
+        requestRedraw(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    
+    if (!_framePending) {
+        return;
+    }
+    
+    // At most one frame per FRAME_INTERVAL_MS
+    if ((int32_t)(millis() - _nextFrameMs) < 0) {
+        return;
+    }
+    
+    renderFrame();
+}
+
+// ============================================================================
+// Frame Scheduling
+// ============================================================================
+
+void ScreenManager::requestRedraw() {
+    requestRedraw(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    _fullFramePending = true;
+}
+
+void ScreenManager::requestRedraw(int x, int y, int w, int h) {
+    // Clip to the screen
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
+    if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    
+    _frameStats.requests++;
+    
+    if (!_framePending) {
+        _framePending = true;
+        _pendingRegion = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+        
+        // Due now, or when the frame interval allows the next frame
+        uint32_t now = millis();
+        _frameDueMs = ((int32_t)(now - _nextFrameMs) >= 0) ? now : _nextFrameMs;
+        return;
+    }
+    
+    // Merge into the pending frame
+    _frameStats.coalesced++;
+    int left = min(x, (int)_pendingRegion.x);
+    int top = min(y, (int)_pendingRegion.y);
+    int right = max(x + w, _pendingRegion.x + _pendingRegion.w);
+    int bottom = max(y + h, _pendingRegion.y + _pendingRegion.h);
+    _pendingRegion = { (int16_t)left, (int16_t)top,
+                       (int16_t)(right - left), (int16_t)(bottom - top) };
+}
+
+void ScreenManager::flushFrame() {
+    if (_framePending) {
+        renderFrame();
+    }
+}
+
+bool ScreenManager::hasPendingFrame() const {
+    return _framePending;
+}
+
+const FrameStats& ScreenManager::getFrameStats() const {
+    return _frameStats;
+}
+
+void ScreenManager::printFrameStats() const {
+    uint32_t avgUs = _frameStats.frames > 0
+        ? (uint32_t)(_frameStats.totalFrameUs / _frameStats.frames) : 0;
+    Serial.printf("[ScreenMgr] Frames: %lu, requests: %lu (%lu coalesced), missed: %lu, "
+                  "last: %lu us, avg: %lu us, max: %lu us\n",
+                  (unsigned long)_frameStats.frames,
+                  (unsigned long)_frameStats.requests,
+                  (unsigned long)_frameStats.coalesced,
+                  (unsigned long)_frameStats.missedDeadlines,
+                  (unsigned long)_frameStats.lastFrameUs,
+                  (unsigned long)avgUs,
+                  (unsigned long)_frameStats.maxFrameUs);
+}
+
+void ScreenManager::renderFrame() {
+    // Take the pending request first so anything requested while
+    // rendering lands in the next frame
+    bool full = _fullFramePending;
+    DirtyRect region = _pendingRegion;
+    uint32_t dueMs = _frameDueMs;
+    _framePending = false;
+    _fullFramePending = false;
+    
+    uint32_t startUs = micros();
+    
+    {
+        RENDER_PROFILE_SCOPE(RenderSection::FRAME);
+        if (_dialog.isVisible()) {
+            // The dialog covers the whole screen; a full request means something
+            // else may have drawn over it
+            if (full) {
+                _dialog.invalidate();
+            }
+            _dialog.draw();
+        } else {
+            Screen* screen = getCurrentScreen();
+            if (screen != nullptr) {
+                RENDER_PROFILE_SCOPE((RenderSection)((int)RenderSection::SCREEN_MAIN + (int)_currentScreenType));
+                screen->drawFrame(full, region);
+            }
+        }
+    }
+    
+    uint32_t frameUs = micros() - startUs;
+    uint32_t now = millis();
+    
+    _frameStats.frames++;
+    _frameStats.lastFrameUs = frameUs;
+    _frameStats.totalFrameUs += frameUs;
+    if (frameUs > _frameStats.maxFrameUs) {
+        _frameStats.maxFrameUs = frameUs;
     }
-    // Note: When no dialog, screens draw themselves incrementally via update()
+    if (now - dueMs > FRAME_INTERVAL_MS) {
+        _frameStats.missedDeadlines++;
+    }
+    
+#if RENDER_PROFILER
+    // Drawn after the frame is timed so the overlay doesn't count itself
+    RenderProfiler::getInstance().drawOverlay(_display);
+#endif
+    
+    _nextFrameMs = now + FRAME_INTERVAL_MS;
 }
 
 // ============================================================================
@@ -192,13 +352,14 @@ void ScreenManager::handleButtonA() {
     if (_dialog.isVisible()) {
         _dialog.handleButtonA();
         
-        // If dialog was dismissed, trigger onResume for current screen
+        // If dialog was dismissed, let the current screen restore itself
         // and redraw BEFORE invoking callback (deferred callback pattern)
         if (_dialog.isDismissed()) {
             Screen* screen = getCurrentScreen();
             if (screen != nullptr) {
-                screen->onResume();
-                screen->draw();
+                screen->onOverlayClosed();
+                requestRedraw();
+                flushFrame();
             }
             
             // Now invoke the callback after screen has been redrawn
@@ -277,11 +438,11 @@ void ScreenManager::dismissDialog() {
     if (_dialog.isVisible()) {
         _dialog.dismiss();
         
-        // Trigger onResume for current screen
+        // Let the current screen restore what the dialog covered
         Screen* screen = getCurrentScreen();
         if (screen != nullptr) {
-            screen->onResume();
-            screen->draw();
+            screen->onOverlayClosed();
+            requestRedraw();
         }
         
         Serial.println("[ScreenMgr] Dialog dismissed");
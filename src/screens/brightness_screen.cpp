@@ -11,17 +11,19 @@
 #include "persistence.h"
 #include "config.h"
 #include "sound.h"
+#include "icon_atlas.h"
 #include <Arduino.h>
 
 // ============================================================================
 // Constructor
 // ============================================================================
 
-BrightnessScreen::BrightnessScreen(M5GFX& display)
+BrightnessScreen::BrightnessScreen(DisplayTarget& display)
     : _display(display)
     , _screenManager(nullptr)
     , _currentLevel(DEFAULT_BRIGHTNESS_LEVEL - 1)  // Convert to 0-indexed
 {
+    setupWidgets();
 }
 
 void BrightnessScreen::setScreenManager(ScreenManager* manager) {
@@ -45,12 +47,14 @@ void BrightnessScreen::onEnter() {
     
     Serial.printf("[BrightnessScreen] Current level: %d (0-indexed)\n", _currentLevel);
     
-    // Draw the screen
-    draw();
+    // Reset widgets; ScreenManager renders the first frame
+    updateWidgets();
+    _widgets.invalidateAll();
 }
 
 void BrightnessScreen::onExit() {
     Serial.println("[BrightnessScreen] onExit");
+    _widgets.printStats("brightness");
     
     // Ensure brightness is saved when exiting
     saveBrightnessLevel();
@@ -58,7 +62,7 @@ void BrightnessScreen::onExit() {
 
 void BrightnessScreen::onResume() {
     Serial.println("[BrightnessScreen] onResume");
-    draw();
+    _widgets.invalidateAll();
 }
 
 void BrightnessScreen::update() {
@@ -66,14 +70,19 @@ void BrightnessScreen::update() {
 }
 
 void BrightnessScreen::draw() {
+    // Nothing changed since the last draw (e.g. onEnter already drew)
+    if (!_widgets.hasDirtyWidgets()) {
+        return;
+    }
+    
     _display.waitDisplay();
     _display.startWrite();
     
-    drawBackground();
-    drawTitle();
-    drawChevrons();
-    drawBrightnessIndicator();
-    drawInstructions();
+    if (_widgets.needsFullRepaint()) {
+        drawBackground();
+        drawChevrons();
+    }
+    _widgets.render(_display);
     
     _display.endWrite();
     _display.display();
@@ -108,98 +117,65 @@ void BrightnessScreen::onButtonPowerHold() {
 // Drawing Helpers
 // ============================================================================
 
-void BrightnessScreen::drawBackground() {
-    _display.fillScreen(COLOR_BACKGROUND);
-}
-
-void BrightnessScreen::drawTitle() {
-    // Draw title centered at top using FreeSansBold12pt7b
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::FreeSansBold12pt7b);
-    
-    const char* title = "Brightness";
-    int textWidth = _display.textWidth(title);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    int textY = 10;  // Padding from top
-    
-    _display.setCursor(textX, textY + 18);  // FreeSansBold12pt7b has baseline offset
-    _display.print(title);
-}
-
-void BrightnessScreen::drawChevrons() {
-    // Draw left and right chevron-style arrows
-    // Position: vertically centered, at left and right edges of screen
-    
-    int centerY = SCREEN_HEIGHT / 2;
-    int chevronHeight = 24;
-    int chevronWidth = 12;
-    int strokeWidth = 2;
-    
-    uint16_t chevronColor = COLOR_ACCENT_PRIMARY;
-    
-    // Left chevron - pointing left (at left side of screen)
-    int leftX = UI_PADDING + 8;
-    // Draw two lines forming a < shape
-    for (int i = 0; i < strokeWidth; i++) {
-        _display.drawLine(leftX + chevronWidth + i, centerY - chevronHeight/2, 
-                          leftX + i, centerY, chevronColor);
-        _display.drawLine(leftX + i, centerY, 
-                          leftX + chevronWidth + i, centerY + chevronHeight/2, chevronColor);
-    }
-    
-    // Right chevron - pointing right (at right side of screen)
-    int rightX = SCREEN_WIDTH - UI_PADDING - 8 - chevronWidth;
-    // Draw two lines forming a > shape
-    for (int i = 0; i < strokeWidth; i++) {
-        _display.drawLine(rightX + i, centerY - chevronHeight/2, 
-                          rightX + chevronWidth + i, centerY, chevronColor);
-        _display.drawLine(rightX + chevronWidth + i, centerY, 
-                          rightX + i, centerY + chevronHeight/2, chevronColor);
-    }
-}
-
-void BrightnessScreen::drawBrightnessIndicator() {
-    // Draw 4 horizontally stacked rectangles in the center
-    // "On" levels are white, "Off" levels are dark gray
+void BrightnessScreen::setupWidgets() {
+    // Title centered at top using FreeSansBold12pt7b (baseline offset 18)
+    _title.setStyle(&fonts::FreeSansBold12pt7b, COLOR_TEXT_PRIMARY, WidgetAlign::CENTER);
+    _title.setBounds(0, 10, SCREEN_WIDTH, 24);
+    _title.setAnchor(SCREEN_WIDTH / 2, 10 + 18);
+    _title.setText("Brightness");
+    _widgets.add(_title);
     
+    // 4 horizontally stacked level rectangles in the center
     int rectWidth = 28;
     int rectHeight = 28;
     int rectGap = 8;
     int totalWidth = (BRIGHTNESS_LEVEL_COUNT * rectWidth) + ((BRIGHTNESS_LEVEL_COUNT - 1) * rectGap);
-    
     int startX = (SCREEN_WIDTH - totalWidth) / 2;
-    int centerY = SCREEN_HEIGHT / 2;
-    int rectY = centerY - rectHeight / 2;
+    int rectY = SCREEN_HEIGHT / 2 - rectHeight / 2;
+    
+    for (int i = 0; i < BRIGHTNESS_LEVEL_COUNT; i++) {
+        _levels[i].setBounds(startX + i * (rectWidth + rectGap), rectY, rectWidth, rectHeight);
+        _levels[i].setRadius(4);
+        _widgets.add(_levels[i]);
+    }
+    
+    // Instruction text at bottom of screen
+    int hintY = SCREEN_HEIGHT - UI_PADDING - 14;
+    _hint.setStyle(&fonts::Font2, COLOR_TEXT_MUTED, WidgetAlign::CENTER);
+    _hint.setBounds(0, hintY, SCREEN_WIDTH, 16);
+    _hint.setAnchor(SCREEN_WIDTH / 2, hintY);
+    _hint.setText("Press B to change brightness");
+    _widgets.add(_hint);
     
+    updateWidgets();
+}
+
+void BrightnessScreen::updateWidgets() {
+    // "On" levels are white, "Off" levels are dark gray
     uint16_t colorOn = COLOR_TEXT_PRIMARY;  // White
     uint16_t colorOff = 0x3186;  // Dark gray (RGB: 48, 48, 48)
     
+    // Only the rectangles whose state flips are repainted
     for (int i = 0; i < BRIGHTNESS_LEVEL_COUNT; i++) {
-        int rectX = startX + i * (rectWidth + rectGap);
-        
-        // Determine if this level is "on" (i.e., <= current level)
-        bool isOn = (i <= _currentLevel);
-        uint16_t fillColor = isOn ? colorOn : colorOff;
-        
-        _display.fillRoundRect(rectX, rectY, rectWidth, rectHeight, 4, fillColor);
+        _levels[i].setColor(i <= _currentLevel ? colorOn : colorOff);
     }
 }
 
-void BrightnessScreen::drawInstructions() {
-    // Draw instruction text at bottom of screen
-    int hintY = SCREEN_HEIGHT - UI_PADDING - 14;
-    
-    _display.setTextColor(COLOR_TEXT_MUTED);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font2);
+void BrightnessScreen::drawBackground() {
+    _display.fillScreen(COLOR_BACKGROUND);
+}
+
+void BrightnessScreen::drawChevrons() {
+    // Pre-rendered left and right arrows, vertically centered at the screen edges
+    IconAtlas& icons = IconAtlas::getInstance();
+    constexpr int chevronWidth = 12;  // Arrow depth (the 2px stroke adds a column)
+    int chevronY = SCREEN_HEIGHT / 2 - IconAtlas::height(Icon::CHEVRON_LARGE_LEFT) / 2;
     
-    const char* hint = "Press B to change brightness";
-    int textWidth = _display.textWidth(hint);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
+    int leftX = UI_PADDING + 8;
+    icons.draw(_display, Icon::CHEVRON_LARGE_LEFT, leftX, chevronY);
     
-    _display.setCursor(textX, hintY);
-    _display.print(hint);
+    int rightX = SCREEN_WIDTH - UI_PADDING - 8 - chevronWidth;
+    icons.draw(_display, Icon::CHEVRON_LARGE_RIGHT, rightX, chevronY);
 }
 
 // ============================================================================
@@ -219,7 +195,8 @@ void BrightnessScreen::cycleBrightness() {
     saveBrightnessLevel();
     
     // Redraw indicator
-    draw();
+    updateWidgets();
+    requestRedraw();
 }
 
 void BrightnessScreen::applyBrightness() {
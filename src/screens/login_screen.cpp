@@ -13,6 +13,7 @@
 #include "screen_manager.h"
 #include "api_client.h"
 #include "polling_manager.h"
+#include "network_task.h"
 #include "app_state.h"
 #include "sound.h"
 #include "config.h"
@@ -28,16 +29,19 @@ extern bool tryGoToSleep(bool userInitiated);
 // Constructor
 // ============================================================================
 
-LoginScreen::LoginScreen(M5GFX& display)
+LoginScreen::LoginScreen(DisplayTarget& display)
     : _display(display)
     , _screenManager(nullptr)
     , _apiClient(nullptr)
     , _pollingManager(nullptr)
     , _state(LoginState::INITIALIZING)
+    , _initiateJobId(0)
     , _qrSize(0)
     , _qrGenerated(false)
-    , _lastAnimationMs(0)
+    , _qrSprite(&display)
+    , _qrModuleSize(1)
     , _animationFrame(0)
+    , _drawnAnimationFrame(0)
 {
     _pairingCode[0] = '\0';
     _deviceCode[0] = '\0';
@@ -70,8 +74,7 @@ void LoginScreen::onEnter() {
     _deviceCode[0] = '\0';
     _errorMessage[0] = '\0';
     _qrGenerated = false;
-    _animationFrame = 0;
-    _lastAnimationMs = millis();
+    _animationFrame = AnimatedSprite::frameAt(ANIMATION_TICKS_PER_FRAME, ANIMATION_FRAMES);
     
     // Clear the display first to ensure clean slate
     _display.fillScreen(COLOR_BACKGROUND);
@@ -80,8 +83,7 @@ void LoginScreen::onEnter() {
     // Initiate login via API (or mock if API not available)
     initiateLogin();
     
-    // Draw initial screen
-    draw();
+    // ScreenManager renders the initial screen once onEnter returns
 }
 
 void LoginScreen::onExit() {
@@ -97,27 +99,36 @@ void LoginScreen::onExit() {
     if (_pollingManager && _pollingManager->isPolling()) {
         _pollingManager->stopPolling();
     }
+    
+    // Drop a login request still in flight
+    NetworkTask::getInstance().cancel(_initiateJobId);
+    _initiateJobId = 0;
+    
+    // Free the QR bitmap; the next login renders a new code anyway
+    _qrSprite.deleteSprite();
+    _dots.printStats("login dots");
+    _menuView.printStats("login menu");
 }
 
 void LoginScreen::onResume() {
     Serial.println("[LoginScreen] onResume");
-    draw();
+    requestRedraw();
 }
 
 void LoginScreen::update() {
-    uint32_t now = millis();
+    // Menu scroll frames
+    if (_menu.isVisible()) {
+        _menuView.update(_display, _menu);
+    }
     
     // Update animation
-    if (now - _lastAnimationMs >= ANIMATION_INTERVAL_MS) {
-        _lastAnimationMs = now;
-        _animationFrame = (_animationFrame + 1) % 4;
+    uint8_t frame = AnimatedSprite::frameAt(ANIMATION_TICKS_PER_FRAME, ANIMATION_FRAMES);
+    if (frame != _animationFrame) {
+        _animationFrame = frame;
         
         // Only redraw the polling indicator, not the whole screen
         if (_state == LoginState::DISPLAYING_CODE) {
-            _display.startWrite();
-            drawPollingIndicator();
-            _display.endWrite();
-            _display.display();
+            requestRedraw(DOTS_AREA_X, DOTS_AREA_Y, DOTS_AREA_W, DOTS_AREA_H);
         }
     }
     
@@ -135,13 +146,13 @@ void LoginScreen::draw() {
     switch (_state) {
         case LoginState::INITIALIZING:
             // Show loading indicator
-            drawPollingIndicator();
+            drawPollingIndicator(false);
             break;
             
         case LoginState::DISPLAYING_CODE:
             drawQRCode();
             drawPairingCode();
-            drawPollingIndicator();
+            drawPollingIndicator(false);
             drawInstructions();
             break;
             
@@ -163,6 +174,27 @@ void LoginScreen::draw() {
     _display.display();
 }
 
+void LoginScreen::drawFrame(bool full, const DirtyRect& region) {
+    // Animation frames only touch the polling indicator
+    if (!full && _state == LoginState::DISPLAYING_CODE && !_menu.isVisible()) {
+        _display.startWrite();
+        drawPollingIndicator(true);
+        _display.endWrite();
+        _display.display();
+        return;
+    }
+    
+    // The menu covers everything the animation touches
+    if (!full && _menu.isVisible()) {
+        return;
+    }
+    
+    draw();
+    if (_menu.isVisible()) {
+        drawMenu();
+    }
+}
+
 // ============================================================================
 // Input Handling
 // ============================================================================
@@ -174,7 +206,7 @@ void LoginScreen::onButtonA() {
         Serial.println("[LoginScreen] Button A - activating menu item");
         _menu.activateSelected();
         _menu.hide();
-        draw();
+        requestRedraw();
         return;
     }
     
@@ -183,7 +215,7 @@ void LoginScreen::onButtonA() {
         Serial.println("[LoginScreen] Retrying login...");
         playButtonBeep();
         initiateLogin();
-        draw();
+        requestRedraw();
     } else if (_state == LoginState::DISPLAYING_CODE) {
         // For testing: skip wait and simulate immediate success
         Serial.println("[LoginScreen] Button A - skipping to success (test mode)");
@@ -200,9 +232,9 @@ void LoginScreen::onButtonA() {
 void LoginScreen::onButtonB() {
     // Check if menu is visible first
     if (_menu.isVisible()) {
-        // Menu visible - cycle to next item
+        // Menu visible - scroll to next item
         _menu.selectNext();
-        drawMenu();
+        _menuView.scroll(_display, _menu);
         return;
     }
     
@@ -218,7 +250,7 @@ void LoginScreen::onButtonPower() {
         // Menu visible - close it
         Serial.println("[LoginScreen] Power - closing menu");
         _menu.hide();
-        draw();
+        requestRedraw();
         return;
     }
     
@@ -241,39 +273,57 @@ void LoginScreen::initiateLogin() {
     
     // Use ApiClient if available
     if (_apiClient != nullptr) {
-        DeviceCodeResponse response = _apiClient->initiateLogin();
+        // A request already in flight will show its code
+        if (_initiateJobId != 0) {
+            return;
+        }
+        _initiateJobId = NetworkTask::getInstance().submitInitiateLogin(onLoginInitiated, this);
+        if (_initiateJobId == 0) {
+            setError("Network busy");
+        }
+    } else {
+        // Fallback to mock login if no API client
+        Serial.println("[LoginScreen] No ApiClient, using mock login");
+        simulateMockLogin();
+    }
+}
+
+void LoginScreen::onLoginInitiated(const NetJob& job, void* userData) {
+    LoginScreen* self = static_cast<LoginScreen*>(userData);
+    if (self != nullptr && job.id == self->_initiateJobId) {
+        self->_initiateJobId = 0;
+        self->handleLoginInitiated(job.deviceCode);
+    }
+}
+
+void LoginScreen::handleLoginInitiated(const DeviceCodeResponse& response) {
+    if (response.success) {
+        // Store codes
+        strncpy(_pairingCode, response.userCode, sizeof(_pairingCode) - 1);
+        _pairingCode[sizeof(_pairingCode) - 1] = '\0';
+        strncpy(_deviceCode, response.deviceCode, sizeof(_deviceCode) - 1);
+        _deviceCode[sizeof(_deviceCode) - 1] = '\0';
         
-        if (response.success) {
-            // Store codes
-            strncpy(_pairingCode, response.userCode, sizeof(_pairingCode) - 1);
-            _pairingCode[sizeof(_pairingCode) - 1] = '\0';
-            strncpy(_deviceCode, response.deviceCode, sizeof(_deviceCode) - 1);
-            _deviceCode[sizeof(_deviceCode) - 1] = '\0';
+        // Generate QR code
+        if (generateQRCode(response.qrCodeUrl)) {
+            _state = LoginState::DISPLAYING_CODE;
             
-            // Generate QR code
-            if (generateQRCode(response.qrCodeUrl)) {
-                _state = LoginState::DISPLAYING_CODE;
-                
-                // Start polling for login completion
-                if (_pollingManager != nullptr) {
-                    _pollingManager->startLoginPolling(
-                        _deviceCode,
-                        LoginScreen::onLoginPollResult,
-                        this  // Pass this pointer for callback
-                    );
-                }
-                
-                Serial.printf("[LoginScreen] Login initiated, code: %s\n", _pairingCode);
-            } else {
-                setError("QR code generation failed");
+            // Start polling for login completion
+            if (_pollingManager != nullptr) {
+                _pollingManager->startLoginPolling(
+                    _deviceCode,
+                    LoginScreen::onLoginPollResult,
+                    this  // Pass this pointer for callback
+                );
             }
+            
+            Serial.printf("[LoginScreen] Login initiated, code: %s\n", _pairingCode);
+            requestRedraw();
         } else {
-            setError(response.errorMessage);
+            setError("QR code generation failed");
         }
     } else {
-        // Fallback to mock login if no API client
-        Serial.println("[LoginScreen] No ApiClient, using mock login");
-        simulateMockLogin();
+        setError(response.errorMessage);
     }
 }
 
@@ -304,6 +354,7 @@ void LoginScreen::setError(const char* errorMessage) {
     }
     
     Serial.printf("[LoginScreen] Error: %s\n", errorMessage);
+    requestRedraw();
 }
 
 void LoginScreen::setLoginSuccess() {
@@ -438,30 +489,15 @@ void LoginScreen::drawQRCode() {
         return;
     }
     
-    // Calculate QR code display size
-    // QR should fit in left portion of screen
-    int maxSize = 70;  // Max pixel size for QR
-    int moduleSize = maxSize / _qrSize;
-    if (moduleSize < 1) moduleSize = 1;
-    
-    int qrPixelSize = moduleSize * _qrSize;
-    int qrX = 15;  // Left aligned with some margin
-    int qrY = 30;  // Below title
-    
-    // Draw white background for QR code (with quiet zone)
-    int quietZone = moduleSize * 2;
-    _display.fillRect(qrX - quietZone, qrY - quietZone, 
-                      qrPixelSize + quietZone * 2, qrPixelSize + quietZone * 2, 
-                      TFT_WHITE);
-    
-    // Draw QR code modules
-    for (int y = 0; y < _qrSize; y++) {
-        for (int x = 0; x < _qrSize; x++) {
-            if (getQRModule(x, y)) {
-                _display.fillRect(qrX + x * moduleSize, qrY + y * moduleSize,
-                                  moduleSize, moduleSize, TFT_BLACK);
-            }
-        }
+    int size = (_qrSize + QR_QUIET_ZONE_MODULES * 2) * _qrModuleSize;
+    int qrX = QR_AREA_X + (QR_AREA_SIZE - size) / 2;
+    int qrY = QR_AREA_Y + (QR_AREA_SIZE - size) / 2;
+    
+    // Rendered once in generateQRCode(); falls back to spans if there was no memory
+    if (_qrSprite.getBuffer() != nullptr) {
+        _qrSprite.pushSprite(&_display, qrX, qrY);
+    } else {
+        drawQRSpans(_display, qrX, qrY);
     }
 }
 
@@ -485,20 +521,23 @@ void LoginScreen::drawPairingCode() {
     _display.print(_pairingCode);
 }
 
-void LoginScreen::drawPollingIndicator() {
-    // Animated dots at bottom of screen
-    int dotY = 118;
-    int dotStartX = SCREEN_WIDTH / 2 - 20;
+void LoginScreen::drawPollingIndicator(bool frameOnly) {
+    // Animated dots at bottom of screen, rendered once per frame
+    _dots.begin(DOTS_AREA_W, DOTS_AREA_H, ANIMATION_FRAMES, COLOR_BACKGROUND, renderDotsFrame, nullptr);
+    _dots.draw(_display, DOTS_AREA_X, DOTS_AREA_Y, _animationFrame,
+               frameOnly ? _drawnAnimationFrame : -1);
+    _drawnAnimationFrame = _animationFrame;
+}
+
+void LoginScreen::renderDotsFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData) {
     int dotSpacing = 12;
     int dotRadius = 3;
     
-    // Clear the dot area first
-    _display.fillRect(dotStartX - 5, dotY - 5, 50, 15, COLOR_BACKGROUND);
-    
-    // Draw dots with animation
-    for (int i = 0; i < 4; i++) {
-        uint16_t color = (i == _animationFrame) ? COLOR_ACCENT_PRIMARY : COLOR_TEXT_MUTED;
-        _display.fillCircle(dotStartX + i * dotSpacing, dotY, dotRadius, color);
+    // Highlight one dot per frame
+    for (int i = 0; i < ANIMATION_FRAMES; i++) {
+        uint16_t color = (i == frame) ? COLOR_ACCENT_PRIMARY : COLOR_TEXT_MUTED;
+        gfx.fillCircle(x + (DOTS_START_X - DOTS_AREA_X) + i * dotSpacing,
+                       y + (DOTS_Y - DOTS_AREA_Y), dotRadius, color);
     }
 }
 
@@ -547,15 +586,69 @@ void LoginScreen::drawInstructions() {
 // QR Code Generation
 // ============================================================================
 
+// Data codewords per QR version (1 .. QR_MAX_VERSION) at error correction level M
+static const uint16_t QR_DATA_CODEWORDS_M[] = { 16, 28, 44, 64 };
+
+/**
+ * Bits needed to encode text in the densest mode the qrcode library picks
+ * for it (numeric, alphanumeric or byte); count field sizes for versions 1-9
+ */
+static int qrDataBits(const char* text) {
+    int length = strlen(text);
+    bool numeric = true;
+    bool alphanumeric = true;
+    
+    for (int i = 0; i < length; i++) {
+        char c = text[i];
+        if (c < '0' || c > '9') {
+            numeric = false;
+        }
+        if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || strchr(" $%*+-./:", c) != nullptr)) {
+            alphanumeric = false;
+        }
+    }
+    
+    if (numeric) {
+        int remainder = length % 3;
+        return 4 + 10 + (length / 3) * 10 + (remainder == 2 ? 7 : remainder == 1 ? 4 : 0);
+    }
+    if (alphanumeric) {
+        return 4 + 9 + (length / 2) * 11 + (length % 2) * 6;
+    }
+    return 4 + 8 + length * 8;
+}
+
 bool LoginScreen::generateQRCode(const char* url) {
+    static_assert(sizeof(QR_DATA_CODEWORDS_M) / sizeof(QR_DATA_CODEWORDS_M[0]) == QR_MAX_VERSION,
+                  "QR capacity table must cover every version up to QR_MAX_VERSION");
+    
+    char text[128];
+    strncpy(text, url, sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    if (QR_UPPERCASE_URL) {
+        for (char* c = text; *c; c++) {
+            *c = toupper((unsigned char)*c);
+        }
+    }
+    
+    // Smallest version that holds the text - fewer modules means larger ones
+    int bits = qrDataBits(text);
+    int version = 1;
+    while (version <= QR_MAX_VERSION && bits > QR_DATA_CODEWORDS_M[version - 1] * 8) {
+        version++;
+    }
+    if (version > QR_MAX_VERSION) {
+        Serial.printf("[LoginScreen] QR text too long (%d bits)\n", bits);
+        _qrGenerated = false;
+        return false;
+    }
+    
     // Use the qrcode library to generate QR code
     QRCode qrcode;
-    
-    // Calculate buffer size for version 4 (33x33)
     uint8_t qrcodeData[qrcode_getBufferSize(QR_MAX_VERSION)];
     
     // Generate QR code with error correction level M (medium, 15% recovery)
-    int result = qrcode_initText(&qrcode, qrcodeData, QR_MAX_VERSION, ECC_MEDIUM, url);
+    int result = qrcode_initText(&qrcode, qrcodeData, version, ECC_MEDIUM, text);
     
     if (result != 0) {
         Serial.printf("[LoginScreen] QR code generation failed: %d\n", result);
@@ -568,21 +661,69 @@ bool LoginScreen::generateQRCode(const char* url) {
     // Copy QR data to our buffer
     // The qrcode library uses qrcode_getModule(qrcode, x, y) to read modules
     // We store the qrcode struct data for later use
-    memcpy(_qrData, qrcodeData, sizeof(_qrData));
+    memcpy(_qrData, qrcodeData, qrcode_getBufferSize(version));
     
     _qrGenerated = true;
-    Serial.printf("[LoginScreen] QR code generated, size: %dx%d\n", _qrSize, _qrSize);
+    renderQRCode();
+    Serial.printf("[LoginScreen] QR code generated: version %d, %dx%d, %dpx modules\n",
+                  version, _qrSize, _qrSize, _qrModuleSize);
     
     return true;
 }
 
+void LoginScreen::renderQRCode() {
+    // Largest whole-pixel module that fits the area with the quiet zone
+    int modules = _qrSize + QR_QUIET_ZONE_MODULES * 2;
+    _qrModuleSize = QR_AREA_SIZE / modules;
+    if (_qrModuleSize < 1) _qrModuleSize = 1;
+    int size = modules * _qrModuleSize;
+    
+    if (_qrSprite.width() != size) {
+        _qrSprite.deleteSprite();
+        _qrSprite.setPsram(true);
+        _qrSprite.setColorDepth(16);
+        if (_qrSprite.createSprite(size, size) == nullptr) {
+            Serial.println("[LoginScreen] QR sprite allocation failed - drawing spans directly");
+            return;
+        }
+    }
+    
+    drawQRSpans(_qrSprite, 0, 0);
+}
+
+void LoginScreen::drawQRSpans(lgfx::LovyanGFX& gfx, int x, int y) const {
+    int size = (_qrSize + QR_QUIET_ZONE_MODULES * 2) * _qrModuleSize;
+    int originX = x + QR_QUIET_ZONE_MODULES * _qrModuleSize;
+    int originY = y + QR_QUIET_ZONE_MODULES * _qrModuleSize;
+    
+    // White background including the quiet zone
+    gfx.fillRect(x, y, size, size, TFT_WHITE);
+    
+    // One fillRect per horizontal run of dark modules
+    for (int row = 0; row < _qrSize; row++) {
+        int col = 0;
+        while (col < _qrSize) {
+            if (!getQRModule(col, row)) {
+                col++;
+                continue;
+            }
+            int runStart = col;
+            while (col < _qrSize && getQRModule(col, row)) {
+                col++;
+            }
+            gfx.fillRect(originX + runStart * _qrModuleSize, originY + row * _qrModuleSize,
+                         (col - runStart) * _qrModuleSize, _qrModuleSize, TFT_BLACK);
+        }
+    }
+}
+
 bool LoginScreen::getQRModule(int x, int y) const {
     if (!_qrGenerated || x < 0 || y < 0 || x >= _qrSize || y >= _qrSize) {
         return false;
     }
     
     // Recreate QRCode struct to use qrcode_getModule
-    // This is a bit inefficient but the qrcode library doesn't expose internals
+    // Only used while rendering the QR bitmap, not on every draw
     QRCode qrcode;
     qrcode.size = _qrSize;
     qrcode.modules = (uint8_t*)_qrData;
@@ -625,85 +766,8 @@ void LoginScreen::destroyMenu() {
 }
 
 void LoginScreen::drawMenu() {
-    // Draw menu overlay on the login screen using the new full-screen design
-    
-    if (!_menu.isVisible()) return;
-    
-    _display.waitDisplay();
-    _display.startWrite();
-    
-    int itemCount = _menu.getItemCount();
-    int selectedIndex = _menu.getSelectedIndex();
-    
-    // Fill entire area below header with dark gray background
-    _display.fillRect(0, MENU_Y, SCREEN_WIDTH, MENU_HEIGHT, COLOR_MENU_BG);
-    
-    // Calculate content area (with padding, leaving space for chevron)
-    // Move content up by 24px from original position
-    int contentY = MENU_Y + MENU_PADDING - 24;
-    int contentHeight = MENU_HEIGHT - (2 * MENU_PADDING) - MENU_CHEVRON_AREA_HEIGHT;
-    int itemAreaHeight = contentHeight / MENU_VISIBLE_ITEMS;
-    int itemGap = 8;  // 8px gap between items
-    
-    // Draw the 3 visible items: previous, selected, next (with wrapping)
-    for (int slot = 0; slot < MENU_VISIBLE_ITEMS && itemCount > 0; slot++) {
-        // Calculate which item index to show in this slot
-        int displayIndex;
-        if (slot == 0) {
-            // Previous item (wraps to end if at start)
-            displayIndex = (selectedIndex - 1 + itemCount) % itemCount;
-        } else if (slot == 1) {
-            // Current selected item
-            displayIndex = selectedIndex;
-        } else {
-            // Next item (wraps to start if at end)
-            displayIndex = (selectedIndex + 1) % itemCount;
-        }
-        
-        // Add gap spacing: slot 0 at base, slot 1 adds gap, slot 2 adds 2*gap
-        int itemY = contentY + (slot * itemAreaHeight) + (slot * itemGap);
-        
-        // Set color based on slot (middle slot = selected = white, others = gray)
-        if (slot == 1) {
-            _display.setTextColor(COLOR_TEXT_PRIMARY);  // White for selected
-        } else {
-            _display.setTextColor(COLOR_MENU_ITEM_GRAY);  // Gray for prev/next
-        }
-        
-        // Use FreeSansBold12pt7b for ~16px bold look
-        _display.setFont(&fonts::FreeSansBold12pt7b);
-        _display.setTextSize(1);
-        
-        // Get label and truncate to 18 characters max
-        const char* rawLabel = _menu.getItemLabel(displayIndex);
-        char label[19];  // 18 chars + null terminator
-        strncpy(label, rawLabel, 18);
-        label[18] = '\0';
-        
-        // Center the text horizontally
-        int textWidth = _display.textWidth(label);
-        int textX = (SCREEN_WIDTH - textWidth) / 2;
-        int textY = itemY + (itemAreaHeight + 12) / 2;  // Center vertically (baseline adjustment for GFX font)
-        
-        _display.setCursor(textX, textY);
-        _display.print(label);
-    }
-    
-    // Draw downward chevron at bottom center
-    int chevronY = MENU_Y + MENU_HEIGHT - MENU_CHEVRON_AREA_HEIGHT + 2;
-    int chevronX = SCREEN_WIDTH / 2;
-    int chevronSize = 6;
-    
-    _display.setColor(COLOR_TEXT_PRIMARY);
-    // Draw simple V chevron
-    _display.drawLine(chevronX - chevronSize, chevronY, chevronX, chevronY + chevronSize, COLOR_TEXT_PRIMARY);
-    _display.drawLine(chevronX, chevronY + chevronSize, chevronX + chevronSize, chevronY, COLOR_TEXT_PRIMARY);
-    // Make it slightly thicker
-    _display.drawLine(chevronX - chevronSize, chevronY + 1, chevronX, chevronY + chevronSize + 1, COLOR_TEXT_PRIMARY);
-    _display.drawLine(chevronX, chevronY + chevronSize + 1, chevronX + chevronSize, chevronY + 1, COLOR_TEXT_PRIMARY);
-    
-    _display.endWrite();
-    _display.display();
+    // Draw menu overlay on the login screen from the cached label strip
+    _menuView.draw(_display, _menu);
 }
 
 void LoginScreen::onMenuSleepNow(int itemIndex, void* userData) {
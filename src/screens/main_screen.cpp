@@ -12,6 +12,7 @@
 #include "api_client.h"
 #include "polling_manager.h"
 #include "network.h"
+#include "network_task.h"
 #include "app_state.h"
 #include "persistence.h"
 #include "sound.h"
@@ -26,7 +27,7 @@ extern bool tryGoToSleep(bool userInitiated);
 // Constructor
 // ============================================================================
 
-MainScreen::MainScreen(M5GFX& display, SessionManager& sessionManager, UI& ui)
+MainScreen::MainScreen(DisplayTarget& display, SessionManager& sessionManager, UI& ui)
     : _display(display)
     , _sessionManager(sessionManager)
     , _timer(sessionManager.getTimer())
@@ -37,6 +38,13 @@ MainScreen::MainScreen(M5GFX& display, SessionManager& sessionManager, UI& ui)
     , _networkManager(nullptr)
     , _isPollingForMoreTime(false)
     , _lastDisplayUpdateMs(0)
+    , _restorePending(false)
+    , _allowanceJobId(0)
+    , _allowanceFetch(AllowanceFetch::ENTER)
+    , _grantMinutes(0)
+    , _moreTimeJobId(0)
+    , _syncJobId(0)
+    , _refreshTimeSynced(false)
 {
 }
 
@@ -73,20 +81,13 @@ void MainScreen::onEnter() {
         
         drawFullScreen();
         
-        // Fetch new daily allowance from API
-        bool success = fetchAllowanceFromApi();
+        // Fetch new daily allowance from API (result handled in
+        // finishAllowanceFetch: "New day!" or the retry dialog)
+        fetchAllowanceFromApi(AllowanceFetch::NEW_DAY);
         
         // Update weekday tracking
         state.updateLastActiveWeekday();
         state.saveWeekdayToPersistence();
-        
-        if (!success) {
-            // Show retry dialog for new day sync failure
-            showAllowanceFetchFailedDialog();
-        } else {
-            // Show brief notification that it's a new day
-            _ui.showNotification("New day!", 1000);
-        }
     } else {
         // Not a new day - load consumed time from persistence (crash recovery)
         uint8_t currentWeekday = state.getCurrentWeekday();
@@ -113,12 +114,8 @@ void MainScreen::onEnter() {
                 "[MainScreen] No cached allowance - fetching from API");
             drawFullScreen();
             
-            bool success = fetchAllowanceFromApi();
-            
-            if (!success) {
-                // Show retry dialog for first boot / no cached allowance
-                showAllowanceFetchFailedDialog();
-            }
+            // Shows the retry dialog for first boot / no cached allowance on failure
+            fetchAllowanceFromApi(AllowanceFetch::ENTER);
         } else {
             // Have valid cached allowance - use it
             Serial.printf("[MainScreen] Using cached allowance: %lu seconds\n",
@@ -134,8 +131,9 @@ void MainScreen::onEnter() {
     // Ensure menu is hidden initially
     _menu.hide();
     
-    // Draw the full screen
-    drawFullScreen();
+    // Full screen on the next frame
+    _restorePending = false;
+    requestRedraw();
 }
 
 void MainScreen::onExit() {
@@ -157,11 +155,26 @@ void MainScreen::onResume() {
     // Ensure menu is hidden initially
     _menu.hide();
     
-    // Returning from a dialog or overlay - redraw everything
-    drawFullScreen();
+    // Returning from another screen - redraw everything
+    _restorePending = false;
+    requestRedraw();
+}
+
+void MainScreen::onOverlayClosed() {
+    Serial.println("[MainScreen] onOverlayClosed");
+    
+    // The dialog only covered the panel; restore the retained frame
+    _menu.hide();
+    _restorePending = true;
+    requestRedraw();
 }
 
 void MainScreen::update() {
+    // Menu scroll frames; activate the item once its flash has played
+    if (_menu.isVisible() && _ui.updateMenu(_menu)) {
+        activateMenuItem();
+    }
+    
     // Update timer if running
     if (_sessionManager.isSessionRunning()) {
         // Capture session info BEFORE update (in case timer expires during update)
@@ -179,15 +192,10 @@ void MainScreen::update() {
         }
     }
     
-    // Update display periodically
+    // Update display periodically (timer, progress bar and status below the header)
     uint32_t now = millis();
     if (!_menu.isVisible() && (now - _lastDisplayUpdateMs >= TIMER_UPDATE_INTERVAL_MS)) {
-        // Check if a full redraw is needed (e.g., after notification cleared)
-        if (_ui.needsFullRedraw()) {
-            drawFullScreen();
-        } else {
-            updateDynamicElements();
-        }
+        requestRedraw(0, HEADER_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT - HEADER_HEIGHT);
         _lastDisplayUpdateMs = now;
     }
     
@@ -199,7 +207,7 @@ void MainScreen::update() {
         // Redraw if state changed
         if (wasPolling != _isPollingForMoreTime) {
             if (!_menu.isVisible()) {
-                drawFullScreen();
+                requestRedraw();
             }
         }
     }
@@ -209,6 +217,33 @@ void MainScreen::draw() {
     drawFullScreen();
 }
 
+void MainScreen::drawFrame(bool full, const DirtyRect& region) {
+    // Overlay just closed: put the retained frame back instead of redrawing
+    if (_restorePending && !_menu.isVisible()) {
+        _restorePending = false;
+        if (restoreScreen()) {
+            return;
+        }
+        full = true;
+    }
+    
+    if (_menu.isVisible()) {
+        // The menu covers the content area; only a full frame redraws under it
+        if (full) {
+            drawFullScreen();
+            _ui.drawMenu(_menu);
+        }
+        return;
+    }
+    
+    // A full redraw is also needed after a notification cleared
+    if (full || _ui.needsFullRedraw()) {
+        drawFullScreen();
+    } else {
+        updateDynamicElements();
+    }
+}
+
 // ============================================================================
 // Input Handling
 // ============================================================================
@@ -218,44 +253,31 @@ void MainScreen::onButtonA() {
     // So if we get here, there's no dialog visible
     
     if (_menu.isVisible()) {
-        // Menu visible - activate selected item
-        Serial.println("[MainScreen] Button A - activating menu item");
-        
-        // Flash the selected item
-        _ui.flashMenuItem(_menu, _menu.getSelectedIndex());
-        M5.delay(MENU_FLASH_DURATION_MS);
-        
-        // Activate the item - note this may trigger a screen transition
-        // via navigateTo(), so we must check if we're still the active screen
-        _menu.activateSelected();
-        
-        // Check if we're still the active screen - menu activation may have
-        // navigated away, in which case we should NOT redraw this screen
-        if (_screenManager && 
-            _screenManager->getCurrentScreenType() != ScreenType::MAIN) {
-            // Screen changed - don't redraw, just return
+        // Already activating - wait for the flash to finish
+        if (_ui.isMenuFlashing()) {
             return;
         }
         
-        // Still on this screen - hide menu and redraw
-        _menu.hide();
-        
-        // Redraw without menu
-        drawFullScreen();
+        // Menu visible - flash the selected item; update() activates it
+        Serial.println("[MainScreen] Button A - activating menu item");
+        _ui.flashMenuItem(_menu, _menu.getSelectedIndex());
     } else {
         // Menu hidden - toggle timer
         Serial.println("[MainScreen] Button A - toggling timer");
         playButtonBeep();
         toggleTimer();
-        updateDynamicElements();
+        requestRedraw(0, HEADER_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT - HEADER_HEIGHT);
     }
 }
 
 void MainScreen::onButtonB() {
     if (_menu.isVisible()) {
-        // Menu visible - cycle to next item
+        // Menu visible - scroll to next item
+        if (_ui.isMenuFlashing()) {
+            return;
+        }
         _menu.selectNext();
-        _ui.drawMenu(_menu);
+        _ui.scrollMenu(_menu);
         Serial.printf("[MainScreen] Button B - selected item %d\n", 
                       _menu.getSelectedIndex());
     } else {
@@ -272,8 +294,9 @@ void MainScreen::onButtonPower() {
         Serial.println("[MainScreen] Power - closing menu");
         _menu.hide();
         
-        // Redraw without menu
-        drawFullScreen();
+        // Restore what the menu covered
+        _restorePending = true;
+        requestRedraw();
     }
     // Menu hidden - no action on main screen
 }
@@ -412,6 +435,29 @@ void MainScreen::drawFullScreen() {
     }
 }
 
+bool MainScreen::restoreScreen() {
+    AppState& state = AppState::getInstance();
+    const UserSession& session = state.getSession();
+    
+    bool restored = _ui.restoreMainScreen(
+        _timer,
+        state.getDisplayName(),
+        state.getAvatarInitial(),
+        session.selectedChildAvatarName,
+        _timer.isRunning(),
+        state.getNetworkStatus()
+    );
+    if (!restored) {
+        return false;
+    }
+    
+    // The banner is drawn on the panel, not into the retained frame
+    if (_networkManager && _networkManager->isWifiNotConfigured()) {
+        drawWifiWarning();
+    }
+    return true;
+}
+
 void MainScreen::drawWifiWarning() {
     // Draw a warning banner at the bottom of the screen
     _display.startWrite();
@@ -538,8 +584,8 @@ void MainScreen::requestMoreTime() {
         return;
     }
     
-    // Check if already polling
-    if (_pollingManager->isPolling()) {
+    // Check if already polling (or still submitting the request)
+    if (_pollingManager->isPolling() || _moreTimeJobId != 0) {
         Serial.println("[MainScreen] Already polling for more time");
         _ui.showNotification("Request pending...", 1500);
         return;
@@ -555,12 +601,30 @@ void MainScreen::requestMoreTime() {
         return;
     }
     
-    // Submit the request via API (with child name for notification message)
-    MoreTimeRequestResult result = _apiClient->requestAdditionalTime(childId, childName);
+    // Submit the request on the network task (with child name for notification message)
+    _moreTimeJobId = NetworkTask::getInstance().submitRequestMoreTime(
+        childId, childName, onMoreTimeRequested, this);
     
+    if (_moreTimeJobId == 0) {
+        _ui.showNotification("Request failed", 1500);
+    }
+}
+
+void MainScreen::onMoreTimeRequested(const NetJob& job, void* userData) {
+    MainScreen* self = static_cast<MainScreen*>(userData);
+    if (self != nullptr && job.id == self->_moreTimeJobId) {
+        self->_moreTimeJobId = 0;
+        self->handleMoreTimeRequest(job.moreTime);
+    }
+}
+
+void MainScreen::handleMoreTimeRequest(const MoreTimeRequestResult& result) {
     if (!result.success) {
         Serial.printf("[MainScreen] More time request failed: %s\n", result.errorMessage);
-        _ui.showNotification("Request failed", 1500);
+        if (isCurrentScreen()) {
+            _ui.showNotification("Request failed", 1500);
+            drawFullScreen();
+        }
         return;
     }
     
@@ -574,8 +638,10 @@ void MainScreen::requestMoreTime() {
     // Update UI to show polling
     _isPollingForMoreTime = true;
     
-    _ui.showNotification("Request sent!", 1000);
-    drawFullScreen();
+    if (isCurrentScreen()) {
+        _ui.showNotification("Request sent!", 1000);
+        drawFullScreen();
+    }
 }
 
 bool MainScreen::isPollingForMoreTime() const {
@@ -609,21 +675,9 @@ void MainScreen::handleMoreTimeResult(const PollingResult& result) {
         // Fetch the updated allowance from the API to get the authoritative value.
         // This avoids issues where the server's bonusMinutes field may contain
         // cumulative bonus rather than just the delta from this specific grant.
-        bool fetchSuccess = fetchAllowanceFromApi();
-        
-        if (!fetchSuccess) {
-            // Fallback: add locally if API fetch fails (better than nothing)
-            Serial.println("[MainScreen] API fetch failed, falling back to local add");
-            uint32_t additionalSeconds = result.additionalMinutes * 60;
-            _timer.addAllowance(additionalSeconds);
-            
-            AppState& appState = AppState::getInstance();
-            appState.getScreenTime().dailyAllowanceSeconds += additionalSeconds;
-            appState.saveAllowanceToPersistence();
-        }
-        
-        // Force redraw to update timer display
-        _ui.forceFullRedraw();
+        // finishAllowanceFetch() adds the minutes locally if the fetch fails.
+        _grantMinutes = result.additionalMinutes;
+        fetchAllowanceFromApi(AllowanceFetch::GRANT);
     } else if (result.denied) {
         _ui.showNotification("Request denied", 2000);
     } else {
@@ -651,6 +705,25 @@ void MainScreen::setupMenu() {
     Serial.printf("[MainScreen] Menu initialized with %d items\n", _menu.getItemCount());
 }
 
+void MainScreen::activateMenuItem() {
+    // Activate the item - note this may trigger a screen transition
+    // via navigateTo(), so we must check if we're still the active screen
+    _menu.activateSelected();
+    
+    // Check if we're still the active screen - menu activation may have
+    // navigated away, in which case we should NOT redraw this screen
+    if (_screenManager && 
+        _screenManager->getCurrentScreenType() != ScreenType::MAIN) {
+        // Screen changed - don't redraw, just return
+        return;
+    }
+    
+    // Still on this screen - hide menu and restore what it covered
+    _menu.hide();
+    _restorePending = true;
+    requestRedraw();
+}
+
 void MainScreen::destroyMenu() {
     _menu.clear();
     Serial.println("[MainScreen] Menu cleared");
@@ -703,10 +776,19 @@ void MainScreen::doParent() {
 // API Integration
 // ============================================================================
 
-bool MainScreen::fetchAllowanceFromApi() {
+void MainScreen::fetchAllowanceFromApi(AllowanceFetch reason) {
+    _allowanceFetch = reason;
+    
+    // A fetch already in flight answers this one too
+    if (_allowanceJobId != 0) {
+        Serial.println("[MainScreen] Allowance fetch already in flight");
+        return;
+    }
+    
     if (_apiClient == nullptr) {
         Serial.println("[MainScreen] No API client - skipping allowance fetch");
-        return false;
+        finishAllowanceFetch(false);
+        return;
     }
     
     AppState& appState = AppState::getInstance();
@@ -714,12 +796,28 @@ bool MainScreen::fetchAllowanceFromApi() {
     
     if (childId[0] == '\0') {
         Serial.println("[MainScreen] No child selected - skipping allowance fetch");
-        return false;
+        finishAllowanceFetch(false);
+        return;
     }
     
     Serial.println("[MainScreen] Fetching allowance from API...");
     
-    AllowanceResult result = _apiClient->getTodayAllowance(childId);
+    _allowanceJobId = NetworkTask::getInstance().submitTodayAllowance(childId, onAllowanceFetched, this);
+    if (_allowanceJobId == 0) {
+        finishAllowanceFetch(false);
+    }
+}
+
+void MainScreen::onAllowanceFetched(const NetJob& job, void* userData) {
+    MainScreen* self = static_cast<MainScreen*>(userData);
+    if (self != nullptr && job.id == self->_allowanceJobId) {
+        self->_allowanceJobId = 0;
+        self->finishAllowanceFetch(self->applyAllowance(job.allowance));
+    }
+}
+
+bool MainScreen::applyAllowance(const AllowanceResult& result) {
+    AppState& appState = AppState::getInstance();
     
     if (result.success) {
         uint32_t allowanceSeconds = result.dailyAllowanceMinutes * 60;
@@ -755,11 +853,64 @@ bool MainScreen::fetchAllowanceFromApi() {
     }
 }
 
+void MainScreen::finishAllowanceFetch(bool success) {
+    switch (_allowanceFetch) {
+        case AllowanceFetch::NEW_DAY:
+            if (success && isCurrentScreen()) {
+                // Show brief notification that it's a new day
+                _ui.showNotification("New day!", 1000);
+            }
+            break;
+            
+        case AllowanceFetch::GRANT:
+            if (!success) {
+                // Fallback: add locally if API fetch fails (better than nothing)
+                Serial.println("[MainScreen] API fetch failed, falling back to local add");
+                uint32_t additionalSeconds = _grantMinutes * 60;
+                _timer.addAllowance(additionalSeconds);
+                
+                AppState& appState = AppState::getInstance();
+                appState.getScreenTime().dailyAllowanceSeconds += additionalSeconds;
+                appState.saveAllowanceToPersistence();
+            }
+            _grantMinutes = 0;
+            
+            // Force redraw to update timer display
+            _ui.forceFullRedraw();
+            requestRedraw();
+            return;
+            
+        case AllowanceFetch::REFRESH:
+            finishRefreshSync(success);
+            return;
+            
+        default:
+            break;
+    }
+    
+    if (!success) {
+        // The allowance is required (first boot, new day) - offer a retry
+        showAllowanceFetchFailedDialog();
+    } else {
+        requestRedraw();
+    }
+}
+
+bool MainScreen::isCurrentScreen() const {
+    return _screenManager != nullptr &&
+           _screenManager->getCurrentScreenType() == ScreenType::MAIN;
+}
+
 void MainScreen::showAllowanceFetchFailedDialog() {
     if (_screenManager == nullptr) {
         Serial.println("[MainScreen] No screen manager - cannot show dialog");
         return;
     }
+    if (!isCurrentScreen()) {
+        // Left the main screen meanwhile; Refresh can fetch it later
+        Serial.println("[MainScreen] Allowance fetch failed off-screen - no dialog");
+        return;
+    }
     
     Dialog& dialog = _screenManager->getDialog();
     dialog.showInfo(
@@ -777,18 +928,9 @@ void MainScreen::onAllowanceFetchFailedDialogResult(DialogResult result, void* u
     
     Serial.println("[MainScreen] Allowance fetch failed dialog result - retrying");
     
-    // Try again
+    // Try again (failing again shows the dialog again)
     self->drawFullScreen();
-    
-    bool success = self->fetchAllowanceFromApi();
-    
-    if (!success) {
-        // Still failed - show the dialog again
-        self->showAllowanceFetchFailedDialog();
-    } else {
-        // Success - redraw the screen
-        self->drawFullScreen();
-    }
+    self->fetchAllowanceFromApi(AllowanceFetch::RETRY);
 }
 
 // Menu action implementations
@@ -796,6 +938,12 @@ void MainScreen::onAllowanceFetchFailedDialogResult(DialogResult result, void* u
 void MainScreen::doRefreshSync() {
     Serial.println("[MainScreen] Refresh/Sync activated");
     
+    if (_syncJobId != 0 || _allowanceJobId != 0) {
+        _ui.showNotification("Syncing...", 500);
+        drawFullScreen();
+        return;
+    }
+    
     _ui.showNotification("Syncing...", 500);
     
     if (_networkManager == nullptr) {
@@ -804,31 +952,43 @@ void MainScreen::doRefreshSync() {
         return;
     }
     
-    // Perform time sync
-    bool timeSuccess = _networkManager->withConnection([this]() {
-        _ui.updateNetworkStatus(NetworkStatus::CONNECTED);
-        return _networkManager->syncTimeAndSetRTC();
-    });
-    
-    // Also fetch updated screen time allowance - reuse fetchAllowanceFromApi()
-    // to avoid code duplication and ensure consistent behavior
-    bool allowanceSuccess = fetchAllowanceFromApi();
-    
-    _ui.updateNetworkStatus(NetworkStatus::DISCONNECTED);
+    // Time sync first, then the allowance (chained from onRefreshTimeSynced)
+    _refreshTimeSynced = false;
+    _syncJobId = NetworkTask::getInstance().submitSyncTime(onRefreshTimeSynced, this);
+    if (_syncJobId == 0) {
+        fetchAllowanceFromApi(AllowanceFetch::REFRESH);
+    }
     
-    if (timeSuccess || allowanceSuccess) {
+    drawFullScreen();
+}
+
+void MainScreen::onRefreshTimeSynced(const NetJob& job, void* userData) {
+    MainScreen* self = static_cast<MainScreen*>(userData);
+    if (self != nullptr && job.id == self->_syncJobId) {
+        self->_syncJobId = 0;
+        self->_refreshTimeSynced = job.timeSynced;
+        
+        // Also fetch updated screen time allowance - reuse fetchAllowanceFromApi()
+        // to avoid code duplication and ensure consistent behavior
+        self->fetchAllowanceFromApi(AllowanceFetch::REFRESH);
+    }
+}
+
+void MainScreen::finishRefreshSync(bool allowanceSuccess) {
+    bool synced = _refreshTimeSynced || allowanceSuccess;
+    if (synced) {
         // Update weekday tracking after sync
         AppState::getInstance().updateLastActiveWeekday();
         AppState::getInstance().saveWeekdayToPersistence();
         
         // Note: We no longer push consumed time on refresh sync.
         // Sessions are pushed when they end (via pushSessionToApi).
-        
-        _ui.showNotification("Synced", 1000);
-    } else {
-        _ui.showNotification("Sync failed", 1500);
     }
     
+    if (!isCurrentScreen()) {
+        return;
+    }
+    _ui.showNotification(synced ? "Synced" : "Sync failed", synced ? 1000 : 1500);
     drawFullScreen();
 }
 
@@ -22,14 +22,16 @@ constexpr uint8_t ParentScreen::EXPECTED_SEQUENCE[SEQUENCE_LENGTH];
 // Constructor
 // ============================================================================
 
-ParentScreen::ParentScreen(M5GFX& display, UI& ui, ScreenTimer& timer)
+ParentScreen::ParentScreen(DisplayTarget& display, UI& ui, ScreenTimer& timer)
     : _display(display)
     , _ui(ui)
     , _timer(timer)
     , _screenManager(nullptr)
     , _isUnlocked(false)
     , _sequenceIndex(0)
+    , _header(ui)
 {
+    setupWidgets();
 }
 
 void ParentScreen::setScreenManager(ScreenManager* manager) {
@@ -50,12 +52,14 @@ void ParentScreen::onEnter() {
     // Clear any existing menu
     destroyMenu();
     
-    // Draw the screen
-    draw();
+    // Reset widgets; ScreenManager renders the first frame
+    updateInstruction();
+    _widgets.invalidateAll();
 }
 
 void ParentScreen::onExit() {
     Serial.println("[ParentScreen] onExit");
+    _widgets.printStats("parent");
     
     // Clean up menu
     _menu.hide();
@@ -65,29 +69,40 @@ void ParentScreen::onExit() {
 void ParentScreen::onResume() {
     Serial.println("[ParentScreen] onResume");
     
-    // Redraw the screen
-    draw();
+    // Full repaint on the next frame
+    _widgets.invalidateAll();
 }
 
 void ParentScreen::update() {
-    // No animation or updates needed
+    // Menu scroll frames; activate the item once its flash has played
+    if (_menu.isVisible() && _ui.updateMenu(_menu)) {
+        activateMenuItem();
+    }
 }
 
 void ParentScreen::draw() {
+    _header.setNetworkStatus(AppState::getInstance().getNetworkStatus());
+    
+    // Nothing changed since the last draw (e.g. onEnter already drew)
+    if (!_widgets.hasDirtyWidgets()) {
+        return;
+    }
+    
+    bool full = _widgets.needsFullRepaint();
+    
     _display.waitDisplay();
     _display.startWrite();
     
-    drawBackground();
-    drawHeader();
-    drawTitle();
-    drawInstruction();
-    drawHint();
+    if (full) {
+        drawBackground();
+    }
+    _widgets.render(_display);
     
     _display.endWrite();
     _display.display();
     
-    // Draw menu on top if visible
-    if (_menu.isVisible()) {
+    // Draw menu on top if visible (it covers everything below the header)
+    if (full && _menu.isVisible()) {
         drawMenu();
     }
 }
@@ -98,18 +113,11 @@ void ParentScreen::draw() {
 
 void ParentScreen::onButtonA() {
     if (_menu.isVisible()) {
-        // Menu visible - activate selected item
-        Serial.println("[ParentScreen] Button A - activating menu item");
-        
-        // Flash the selected item
-        _ui.flashMenuItem(_menu, _menu.getSelectedIndex());
-        M5.delay(MENU_FLASH_DURATION_MS);
-        
-        // Activate the item
-        _menu.activateSelected();
-        
-        // Redraw menu
-        drawMenu();
+        // Menu visible - flash the selected item; update() activates it
+        if (!_ui.isMenuFlashing()) {
+            Serial.println("[ParentScreen] Button A - activating menu item");
+            _ui.flashMenuItem(_menu, _menu.getSelectedIndex());
+        }
     } else if (!_isUnlocked) {
         // Not unlocked - process as sequence input
         processSequenceButton(0);  // 0 = A
@@ -118,9 +126,12 @@ void ParentScreen::onButtonA() {
 
 void ParentScreen::onButtonB() {
     if (_menu.isVisible()) {
-        // Menu visible - cycle to next item
+        // Menu visible - scroll to next item
+        if (_ui.isMenuFlashing()) {
+            return;
+        }
         _menu.selectNext();
-        drawMenu();
+        _ui.scrollMenu(_menu);
         Serial.printf("[ParentScreen] Button B - selected item %d\n", 
                       _menu.getSelectedIndex());
     } else if (_isUnlocked) {
@@ -140,7 +151,8 @@ void ParentScreen::onButtonPower() {
     // Close menu if open
     if (_menu.isVisible()) {
         _menu.hide();
-        draw();
+        _widgets.invalidateAll();
+        requestRedraw();
         return;
     }
     
@@ -197,8 +209,9 @@ void ParentScreen::onUnlocked() {
     // Set up the parent menu
     setupMenu();
     
-    // Redraw screen with new state
-    draw();
+    // Redraw screen with new state (only the instruction changes)
+    updateInstruction();
+    requestRedraw();
 }
 
 // ============================================================================
@@ -221,6 +234,14 @@ void ParentScreen::setupMenu() {
     Serial.printf("[ParentScreen] Menu initialized with %d items\n", _menu.getItemCount());
 }
 
+void ParentScreen::activateMenuItem() {
+    // Activate the item
+    _menu.activateSelected();
+    
+    // Redraw menu
+    drawMenu();
+}
+
 void ParentScreen::destroyMenu() {
     _menu.clear();
     Serial.println("[ParentScreen] Menu cleared");
@@ -230,65 +251,43 @@ void ParentScreen::destroyMenu() {
 // Drawing Helpers
 // ============================================================================
 
-void ParentScreen::drawBackground() {
-    _display.fillScreen(COLOR_BACKGROUND);
-}
-
-void ParentScreen::drawHeader() {
-    // Use the shared header drawing from UI
-    NetworkStatus networkStatus = AppState::getInstance().getNetworkStatus();
-    _ui.drawStandardHeader("Parent", networkStatus);
-}
-
-void ParentScreen::drawTitle() {
+void ParentScreen::setupWidgets() {
+    // Shared header from UI
+    _header.setTitle("Parent");
+    _widgets.add(_header);
+    
     // Title text centered below header
     int titleY = HEADER_HEIGHT + 20;
+    _title.setStyle(&fonts::Font2, COLOR_TEXT_PRIMARY, WidgetAlign::CENTER);
+    _title.setBounds(0, titleY, SCREEN_WIDTH, 16);
+    _title.setAnchor(SCREEN_WIDTH / 2, titleY);
+    _title.setText("Parent screen");
+    _widgets.add(_title);
     
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font2);
+    // Instruction centered in middle of content area (changes on unlock)
+    int instructionY = HEADER_HEIGHT + 50;
+    _instruction.setStyle(&fonts::Font2, COLOR_TEXT_SECONDARY, WidgetAlign::CENTER);
+    _instruction.setBounds(0, instructionY - 2, SCREEN_WIDTH, 20);
+    _instruction.setAnchor(SCREEN_WIDTH / 2, instructionY);
+    _widgets.add(_instruction);
     
-    const char* title = "Parent screen";
-    int textWidth = _display.textWidth(title);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
+    // Hint at bottom of screen (smaller font)
+    int hintY = SCREEN_HEIGHT - UI_PADDING - 12;
+    _hint.setStyle(&fonts::Font0, COLOR_TEXT_MUTED, WidgetAlign::CENTER);
+    _hint.setBounds(0, hintY, SCREEN_WIDTH, 8);
+    _hint.setAnchor(SCREEN_WIDTH / 2, hintY);
+    _hint.setText("Button C to go back.");
+    _widgets.add(_hint);
     
-    _display.setCursor(textX, titleY);
-    _display.print(title);
+    updateInstruction();
 }
 
-void ParentScreen::drawInstruction() {
-    // Instruction centered in middle of content area
-    int instructionY = HEADER_HEIGHT + 50;
-    
-    // Clear the instruction area first (for updates after unlock)
-    _display.fillRect(0, instructionY - 2, SCREEN_WIDTH, 20, COLOR_BACKGROUND);
-    
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font2);
-    
-    const char* instruction = _isUnlocked ? "Menu Unlocked" : "Password to unlock.";
-    int textWidth = _display.textWidth(instruction);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    
-    _display.setCursor(textX, instructionY);
-    _display.print(instruction);
+void ParentScreen::updateInstruction() {
+    _instruction.setText(_isUnlocked ? "Menu Unlocked" : "Password to unlock.");
 }
 
-void ParentScreen::drawHint() {
-    // Hint at bottom of screen (smaller font)
-    int hintY = SCREEN_HEIGHT - UI_PADDING - 12;
-    
-    _display.setTextColor(COLOR_TEXT_MUTED);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font0);
-    
-    const char* hint = "Button C to go back.";
-    int textWidth = _display.textWidth(hint);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    
-    _display.setCursor(textX, hintY);
-    _display.print(hint);
+void ParentScreen::drawBackground() {
+    _display.fillScreen(COLOR_BACKGROUND);
 }
 
 void ParentScreen::drawMenu() {
@@ -338,7 +337,8 @@ void ParentScreen::handleResetTime() {
     
     // Wait for notification and redraw
     M5.delay(1500);
-    draw();
+    _widgets.invalidateAll();
+    requestRedraw();
 }
 
 void ParentScreen::navigateToChangeChild() {
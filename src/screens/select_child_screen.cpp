@@ -6,30 +6,43 @@
  */
 
 #include <M5Unified.h>
-#include <LittleFS.h>
 #include "screens/select_child_screen.h"
 #include "screen_manager.h"
 #include "app_state.h"
+#include "network_task.h"
 #include "sound.h"
+#include "icon_atlas.h"
 #include "config.h"
 #include <Arduino.h>
+#include <algorithm>
 
 // ============================================================================
 // Constructor
 // ============================================================================
 
-SelectChildScreen::SelectChildScreen(M5GFX& display)
+SelectChildScreen::SelectChildScreen(DisplayTarget& display)
     : _display(display)
     , _screenManager(nullptr)
     , _apiClient(nullptr)
     , _memberCount(0)
     , _currentIndex(0)
     , _loading(false)
+    , _membersJobId(0)
+    , _shownCard(-1)
+    , _pageStartUs(0)
+    , _cardsUnavailable(false)
 {
     // Clear members array
     for (int i = 0; i < MAX_MEMBERS; i++) {
         _members[i] = FamilyMember();
     }
+    
+    for (int i = 0; i < CARD_CACHE_SIZE; i++) {
+        _cardMember[i] = -1;
+    }
+    memset(&_cardStats, 0, sizeof(_cardStats));
+    
+    setupWidgets();
 }
 
 void SelectChildScreen::setScreenManager(ScreenManager* manager) {
@@ -47,66 +60,107 @@ void SelectChildScreen::setApiClient(ApiClient* api) {
 void SelectChildScreen::onEnter() {
     Serial.println("[SelectChildScreen] onEnter");
     
-    // Reset state
+    // Reset state (cards of a previous member list are stale)
     _currentIndex = 0;
+    _memberCount = 0;
     _loading = true;
+    releaseCards();
     
     // Draw loading state
+    updateWidgets();
+    _widgets.invalidateAll();
     draw();
     
-    // Try to load members from API, fall back to mock if not available
+    // Try to load members from API (finishLoading() runs on completion),
+    // fall back to mock if not available
     if (_apiClient != nullptr) {
         if (!loadMembersFromApi()) {
             Serial.println("[SelectChildScreen] API load failed, using mock data");
             loadMockMembers();
+            finishLoading();
         }
     } else {
         Serial.println("[SelectChildScreen] No API client, using mock data");
         loadMockMembers();
+        finishLoading();
     }
+}
+
+void SelectChildScreen::finishLoading() {
     _loading = false;
     
-    // Redraw with members
-    draw();
+    // Full repaint with members (so the chevrons appear)
+    updateWidgets();
+    _widgets.invalidateAll();
+    requestRedraw();
 }
 
 void SelectChildScreen::onExit() {
     Serial.println("[SelectChildScreen] onExit");
+    
+    // Drop a member list still in flight
+    NetworkTask::getInstance().cancel(_membersJobId);
+    _membersJobId = 0;
+    _loading = false;
+    _widgets.printStats("select_child");
+    printCardStats();
+    
+    // Free the card sprites; onEnter loads the members again anyway
+    releaseCards();
 }
 
 void SelectChildScreen::onResume() {
     Serial.println("[SelectChildScreen] onResume");
-    draw();
+    _widgets.invalidateAll();
 }
 
 void SelectChildScreen::update() {
-    // No animation needed for this screen
+    // Idle with the current card on screen: render the neighbors ahead
+    if (!_loading && _pageStartUs == 0 && _shownCard == _currentIndex) {
+        prerenderNeighbors();
+    }
 }
 
 void SelectChildScreen::draw() {
+    bool hasMember = !_loading && _currentIndex >= 0 && _currentIndex < _memberCount;
+    
+    // Nothing changed since the last draw (e.g. onEnter already drew)
+    if (!_widgets.hasDirtyWidgets() && (!hasMember || _shownCard == _currentIndex)) {
+        return;
+    }
+    
     _display.waitDisplay();
     _display.startWrite();
     
-    drawBackground();
-    drawTitle();
-    
-    if (_loading) {
-        drawLoadingState();
-    } else if (_memberCount > 0) {
-        drawCurrentChild();
-        if (_memberCount > 1) {
-            drawChevrons();
-        }
-    } else {
-        // No members - show error
-        _display.setTextColor(COLOR_TEXT_SECONDARY);
-        _display.setFont(&fonts::Font2);
-        _display.setCursor(SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2);
-        _display.print("No children found");
+    if (_widgets.needsFullRepaint()) {
+        drawBackground();
+        _shownCard = -1;
+    }
+    _widgets.render(_display);
+    bool cardWasReady = true;
+    if (hasMember && _shownCard != _currentIndex) {
+        cardWasReady = drawCard(_currentIndex);
     }
     
     _display.endWrite();
     _display.display();
+    
+    // Button press to completed frame
+    if (_pageStartUs != 0) {
+        uint32_t latencyUs = micros() - _pageStartUs;
+        _pageStartUs = 0;
+        if (cardWasReady) {
+            _cardStats.hits++;
+            _cardStats.lastHitUs = latencyUs;
+            _cardStats.maxHitUs = std::max(_cardStats.maxHitUs, latencyUs);
+        } else {
+            _cardStats.misses++;
+            _cardStats.lastMissUs = latencyUs;
+            _cardStats.maxMissUs = std::max(_cardStats.maxMissUs, latencyUs);
+        }
+        Serial.printf("[SelectChildScreen] Page %d: %lu us (%s)\n", _currentIndex,
+                      (unsigned long)latencyUs, cardWasReady ? "pre-rendered" : "rendered on demand");
+    }
 }
 
 // ============================================================================
@@ -125,16 +179,20 @@ void SelectChildScreen::onButtonA() {
 void SelectChildScreen::onButtonB() {
     if (_memberCount > 1 && !_loading) {
         // Next child
+        _pageStartUs = micros();
         selectNext();
-        draw();
+        updateWidgets();
+        requestRedraw();
     }
 }
 
 void SelectChildScreen::onButtonPower() {
     if (_memberCount > 1 && !_loading) {
         // Previous child
+        _pageStartUs = micros();
         selectPrevious();
-        draw();
+        updateWidgets();
+        requestRedraw();
     }
 }
 
@@ -180,20 +238,40 @@ bool SelectChildScreen::loadMembersFromApi() {
         return false;
     }
     
-    // Fetch family members (children only) from API
-    bool success = _apiClient->getFamilyMembers(_members, MAX_MEMBERS, _memberCount);
-    
-    if (!success || _memberCount == 0) {
+    // Fetch family members (children only) on the NetworkTask
+    _membersJobId = NetworkTask::getInstance().submitFamilyMembers(onMembersLoaded, this);
+    return _membersJobId != 0;
+}
+
+void SelectChildScreen::onMembersLoaded(const NetJob& job, void* userData) {
+    SelectChildScreen* self = static_cast<SelectChildScreen*>(userData);
+    if (self != nullptr && job.id == self->_membersJobId) {
+        self->_membersJobId = 0;
+        if (!self->applyMembers(job.family)) {
+            Serial.println("[SelectChildScreen] API load failed, using mock data");
+            self->loadMockMembers();
+        }
+        self->finishLoading();
+    }
+}
+
+bool SelectChildScreen::applyMembers(const FamilyGroupResult& result) {
+    if (!result.success || result.memberCount == 0) {
         Serial.println("[SelectChildScreen] Failed to load members from API");
         _memberCount = 0;
         return false;
     }
     
-    // Copy family ID from ApiClient to session so it gets persisted
-    if (_apiClient->hasFamilyId()) {
+    _memberCount = std::min(result.memberCount, MAX_MEMBERS);
+    for (int i = 0; i < _memberCount; i++) {
+        _members[i] = result.members[i];
+    }
+    
+    // Copy family ID to session so it gets persisted
+    if (result.familyId[0] != '\0') {
         AppState& appState = AppState::getInstance();
         UserSession& session = appState.getSession();
-        strncpy(session.familyId, _apiClient->getFamilyId(), sizeof(session.familyId) - 1);
+        strncpy(session.familyId, result.familyId, sizeof(session.familyId) - 1);
         session.familyId[sizeof(session.familyId) - 1] = '\0';
         Serial.printf("[SelectChildScreen] Family ID copied to session: %s\n", session.familyId);
     }
@@ -206,178 +284,189 @@ bool SelectChildScreen::loadMembersFromApi() {
 // Drawing Methods
 // ============================================================================
 
+void SelectChildScreen::setupWidgets() {
+    // Title
+    _title.setStyle(&fonts::Font2, COLOR_TEXT_PRIMARY, WidgetAlign::CENTER);
+    _title.setBounds(0, TITLE_Y, SCREEN_WIDTH, 16);
+    _title.setAnchor(SCREEN_WIDTH / 2, TITLE_Y);
+    _title.setText(getTitle());
+    _widgets.add(_title);
+    
+    // Loading / empty state message
+    _status.setBounds(0, SCREEN_HEIGHT / 2 - 8, SCREEN_WIDTH, 24);
+    _widgets.add(_status);
+    
+    // Name, page dots and avatar make up the card (see paintCard())
+    _name.setStyle(&fonts::Font2, COLOR_TEXT_PRIMARY, WidgetAlign::CENTER);
+    layoutCard(0);
+    
+    updateWidgets();
+}
+
+void SelectChildScreen::updateWidgets() {
+    bool hasMember = !_loading && _currentIndex >= 0 && _currentIndex < _memberCount;
+    
+    // The member itself is shown by its card (draw() blits it)
+    _status.setVisible(!hasMember);
+    
+    if (_loading) {
+        _status.setStyle(&fonts::Font2, COLOR_TEXT_SECONDARY, WidgetAlign::CENTER);
+        _status.setAnchor(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 8);
+        _status.setText("Loading...");
+    } else if (!hasMember) {
+        // No members - show error
+        _status.setStyle(&fonts::Font2, COLOR_TEXT_SECONDARY, WidgetAlign::LEFT);
+        _status.setAnchor(SCREEN_WIDTH / 2 - 50, SCREEN_HEIGHT / 2);
+        _status.setText("No children found");
+    }
+}
+
 void SelectChildScreen::drawBackground() {
     _display.fillScreen(COLOR_BACKGROUND);
 }
 
-void SelectChildScreen::drawTitle() {
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setFont(&fonts::Font2);
-    _display.setTextSize(1);
-    
-    const char* title = getTitle();
-    int textWidth = _display.textWidth(title);
-    _display.setCursor((SCREEN_WIDTH - textWidth) / 2, TITLE_Y);
-    _display.print(title);
+void SelectChildScreen::drawChevrons(lgfx::LovyanGFX& gfx, int top) {
+    // Pre-rendered < and > (tips at CHEVRON_*_X, CHEVRON_Y; 2px strokes reach 10px out)
+    IconAtlas& icons = IconAtlas::getInstance();
+    icons.draw(gfx, Icon::CHEVRON_LEFT, CHEVRON_LEFT_X, CHEVRON_Y - 10 - top);
+    icons.draw(gfx, Icon::CHEVRON_RIGHT,
+               CHEVRON_RIGHT_X - IconAtlas::width(Icon::CHEVRON_RIGHT) + 1, CHEVRON_Y - 10 - top);
 }
 
-void SelectChildScreen::drawCurrentChild() {
-    if (_currentIndex < 0 || _currentIndex >= _memberCount) {
-        return;
-    }
+// ============================================================================
+// Card Cache
+// ============================================================================
+
+void SelectChildScreen::layoutCard(int top) {
+    // Card painters at their screen positions, shifted up by top
+    // (0 = on the panel, CARD_Y = in a card sprite)
+    _name.setBounds(0, NAME_Y - top, SCREEN_WIDTH, 16);
+    _name.setAnchor(SCREEN_WIDTH / 2, NAME_Y - top);
     
-    const FamilyMember& member = _members[_currentIndex];
+    // Page indicator (drawn only with multiple members)
+    int dotY = SCREEN_HEIGHT - 12 - top;
+    _dots.setBounds(0, dotY - 4, SCREEN_WIDTH, 9);
+    _dots.setCenter(SCREEN_WIDTH / 2, dotY);
     
-    // NOTE: Draw name and dots BEFORE avatar because drawPng() affects
-    // subsequent drawing operations. This order ensures all elements render.
+    // Large avatar in center
+    _avatar.setGeometry(SCREEN_WIDTH / 2, AVATAR_CENTER_Y - top, AVATAR_LARGE_RADIUS);
+}
+
+void SelectChildScreen::paintCard(lgfx::LovyanGFX& gfx, int index, int top) {
+    const FamilyMember& member = _members[index];
     
-    // Draw name below avatar area
-    drawName(member.name);
+    layoutCard(top);
+    _name.setText(member.name);
+    _dots.setPages(_memberCount, index);
+    _avatar.setAvatar(member.avatarName, member.initial);
     
-    // Draw page indicator if multiple members
+    gfx.fillRect(0, CARD_Y - top, SCREEN_WIDTH, CARD_HEIGHT, COLOR_BACKGROUND);
     if (_memberCount > 1) {
-        int dotY = SCREEN_HEIGHT - 12;
-        int totalWidth = _memberCount * 10 - 4;  // 6px dot + 4px spacing
-        int startX = (SCREEN_WIDTH - totalWidth) / 2;
-        
-        for (int i = 0; i < _memberCount; i++) {
-            uint16_t color = (i == _currentIndex) ? COLOR_ACCENT_PRIMARY : COLOR_TEXT_MUTED;
-            int dotX = startX + i * 10;
-            _display.fillCircle(dotX, dotY, 3, color);
-        }
+        drawChevrons(gfx, top);
     }
-    
-    // Draw large avatar in center (last due to PNG rendering side effects)
-    drawAvatar(member.initial, member.avatarName, SCREEN_WIDTH / 2, AVATAR_CENTER_Y, AVATAR_LARGE_RADIUS);
-}
-
-void SelectChildScreen::drawAvatar(char initial, const char* avatarName, int centerX, int centerY, int radius) {
-    // Try to load and draw PNG avatar if avatarName is provided
-    bool pngDrawn = false;
-    
-    if (avatarName != nullptr && avatarName[0] != '\0') {
-        // Construct full path: /avatars/[avatarName]
-        // Handle both cases: avatarName with or without .png extension
-        char avatarPath[64];
-        
-        // Check if avatarName already ends with .png
-        size_t len = strlen(avatarName);
-        bool hasPngExtension = (len > 4 && strcmp(&avatarName[len - 4], ".png") == 0);
-        
-        if (hasPngExtension) {
-            // Already has extension, use as-is
-            snprintf(avatarPath, sizeof(avatarPath), "/avatars/%s", avatarName);
-        } else {
-            // No extension, append .png
-            snprintf(avatarPath, sizeof(avatarPath), "/avatars/%s.png", avatarName);
+    _name.render(gfx, true);
+    _dots.render(gfx, true);
+    _avatar.render(gfx, true);
+}
+
+int SelectChildScreen::findCard(int index) const {
+    for (int i = 0; i < CARD_CACHE_SIZE; i++) {
+        if (_cardMember[i] == index) {
+            return i;
         }
-        
-        // Try to load PNG from LittleFS
-        if (LittleFS.exists(avatarPath)) {
-            // Draw background circle first (in case PNG has transparency)
-            _display.fillCircle(centerX, centerY, radius, COLOR_AVATAR_PRIMARY);
-            
-            // Load and draw PNG centered in the circle
-            File avatarFile = LittleFS.open(avatarPath, "r");
-            if (avatarFile) {
-                // Calculate top-left position to center the image in the circle
-                // PNG is 50x50, avatar diameter is 50 (radius 25), so no scaling needed
-                int imgX = centerX - radius;
-                int imgY = centerY - radius;
-                
-                // Draw PNG at position
-                _display.drawPng(&avatarFile, imgX, imgY);
-                
-                avatarFile.close();
-                pngDrawn = true;
-                
-                // Draw border after PNG
-                _display.drawCircle(centerX, centerY, radius, COLOR_AVATAR_BORDER);
-                _display.drawCircle(centerX, centerY, radius + 1, COLOR_AVATAR_BORDER);
-            }
+    }
+    return -1;
+}
+
+int SelectChildScreen::renderCard(int index) {
+    // Reuse a slot holding none of the current, next and previous members
+    int slot = -1;
+    for (int i = 0; i < CARD_CACHE_SIZE && slot < 0; i++) {
+        int member = _cardMember[i];
+        if (member < 0 || member >= _memberCount) {
+            slot = i;
+        } else if (member != _currentIndex &&
+                   member != (_currentIndex + 1) % _memberCount &&
+                   member != (_currentIndex - 1 + _memberCount) % _memberCount) {
+            slot = i;
         }
     }
+    if (slot < 0 || _cardsUnavailable) {
+        return -1;
+    }
     
-    // Fallback: Draw initial letter if PNG not available
-    if (!pngDrawn) {
-        // Draw circular avatar with primary color
-        _display.fillCircle(centerX, centerY, radius, COLOR_AVATAR_PRIMARY);
-        
-        // Draw border
-        _display.drawCircle(centerX, centerY, radius, COLOR_AVATAR_BORDER);
-        _display.drawCircle(centerX, centerY, radius + 1, COLOR_AVATAR_BORDER);
-        
-        // Draw initial centered in circle
-        _display.setTextColor(COLOR_TEXT_PRIMARY);
-        _display.setFont(&fonts::Font4);  // Larger font for bigger avatar
-        _display.setTextSize(1);
-        
-        char initialStr[2] = {initial, '\0'};
-        int textWidth = _display.textWidth(initialStr);
-        int textX = centerX - textWidth / 2;
-        int textY = centerY - 12;  // Approximate vertical center for Font4
-        
-        _display.setCursor(textX, textY);
-        _display.print(initialStr);
+    M5Canvas& card = _cards[slot];
+    if (card.getBuffer() == nullptr) {
+        card.setPsram(true);
+        card.setColorDepth(16);
+        if (card.createSprite(SCREEN_WIDTH, CARD_HEIGHT) == nullptr) {
+            Serial.println("[SelectChildScreen] Card allocation failed - painting in place");
+            _cardsUnavailable = true;
+            return -1;
+        }
     }
-}
-
-void SelectChildScreen::drawName(const char* name) {
-    // Set text properties
-    _display.setTextDatum(textdatum_t::top_center);
-    _display.setTextColor(COLOR_TEXT_PRIMARY, COLOR_BACKGROUND);
-    _display.setFont(&fonts::Font2);
-    _display.setTextSize(1);
     
-    // Draw name centered
-    _display.drawString(name, SCREEN_WIDTH / 2, NAME_Y);
+    paintCard(card, index, CARD_Y);
+    _cardMember[slot] = index;
+    return slot;
 }
 
-void SelectChildScreen::drawChevrons() {
-    // Left chevron (previous)
-    drawChevronLeft(CHEVRON_LEFT_X, CHEVRON_Y);
+bool SelectChildScreen::drawCard(int index) {
+    int slot = findCard(index);
+    bool wasReady = slot >= 0;
+    if (slot < 0) {
+        slot = renderCard(index);
+    }
     
-    // Right chevron (next)
-    drawChevronRight(CHEVRON_RIGHT_X, CHEVRON_Y);
+    if (slot >= 0) {
+        _cards[slot].pushSprite(&_display, 0, CARD_Y);
+    } else {
+        // No sprite memory - paint straight onto the panel
+        paintCard(_display, index, 0);
+    }
+    _shownCard = index;
+    return wasReady;
 }
 
-void SelectChildScreen::drawChevronLeft(int x, int y) {
-    // Draw < shape
-    int size = 10;
-    uint16_t color = COLOR_TEXT_SECONDARY;
-    
-    // Draw lines for chevron
-    _display.drawLine(x + size, y - size, x, y, color);
-    _display.drawLine(x, y, x + size, y + size, color);
+void SelectChildScreen::prerenderNeighbors() {
+    if (_memberCount <= 1) {
+        return;
+    }
     
-    // Make it thicker
-    _display.drawLine(x + size, y - size + 1, x, y + 1, color);
-    _display.drawLine(x, y + 1, x + size, y + size + 1, color);
+    // One card per update() so the loop stays responsive; next first (button B)
+    int neighbors[2] = {
+        (_currentIndex + 1) % _memberCount,
+        (_currentIndex - 1 + _memberCount) % _memberCount
+    };
+    for (int index : neighbors) {
+        if (findCard(index) < 0) {
+            if (renderCard(index) >= 0) {
+                _cardStats.prerenders++;
+            }
+            return;
+        }
+    }
 }
 
-void SelectChildScreen::drawChevronRight(int x, int y) {
-    // Draw > shape
-    int size = 10;
-    uint16_t color = COLOR_TEXT_SECONDARY;
-    
-    // Draw lines for chevron
-    _display.drawLine(x - size, y - size, x, y, color);
-    _display.drawLine(x, y, x - size, y + size, color);
-    
-    // Make it thicker
-    _display.drawLine(x - size, y - size + 1, x, y + 1, color);
-    _display.drawLine(x, y + 1, x - size, y + size + 1, color);
+void SelectChildScreen::releaseCards() {
+    for (int i = 0; i < CARD_CACHE_SIZE; i++) {
+        _cards[i].deleteSprite();
+        _cardMember[i] = -1;
+    }
+    _shownCard = -1;
+    _cardsUnavailable = false;
 }
 
-void SelectChildScreen::drawLoadingState() {
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setFont(&fonts::Font2);
-    _display.setTextSize(1);
-    
-    const char* msg = "Loading...";
-    int textWidth = _display.textWidth(msg);
-    _display.setCursor((SCREEN_WIDTH - textWidth) / 2, SCREEN_HEIGHT / 2 - 8);
-    _display.print(msg);
+void SelectChildScreen::printCardStats() const {
+    Serial.printf("[SelectChildScreen] Cards: %lu pre-rendered, %lu pages ready (last %lu us, max %lu us), "
+                  "%lu on demand (last %lu us, max %lu us)\n",
+                  (unsigned long)_cardStats.prerenders,
+                  (unsigned long)_cardStats.hits,
+                  (unsigned long)_cardStats.lastHitUs,
+                  (unsigned long)_cardStats.maxHitUs,
+                  (unsigned long)_cardStats.misses,
+                  (unsigned long)_cardStats.lastMissUs,
+                  (unsigned long)_cardStats.maxMissUs);
 }
 
 // ============================================================================
@@ -18,11 +18,13 @@
 // Constructor
 // ============================================================================
 
-SettingsScreen::SettingsScreen(M5GFX& display, UI& ui)
+SettingsScreen::SettingsScreen(DisplayTarget& display, UI& ui)
     : _display(display)
     , _ui(ui)
     , _screenManager(nullptr)
+    , _header(ui)
 {
+    setupWidgets();
 }
 
 void SettingsScreen::setScreenManager(ScreenManager* manager) {
@@ -39,18 +41,14 @@ void SettingsScreen::onEnter() {
     // Set up the menu
     setupMenu();
     
-    // Draw full screen with header
-    drawBackground();
-    drawHeader();
-    drawPlaceholderText();
-    
-    // Show the menu immediately
+    // Full screen with header, showing the menu immediately
     _menu.show();
-    drawMenu();
+    _widgets.invalidateAll();
 }
 
 void SettingsScreen::onExit() {
     Serial.println("[SettingsScreen] onExit");
+    _widgets.printStats("settings");
     
     // Ensure menu is hidden
     _menu.hide();
@@ -67,24 +65,39 @@ void SettingsScreen::onResume() {
         setupMenu();
     }
     
-    // Show full screen with header and menu again
-    drawBackground();
-    drawHeader();
-    drawPlaceholderText();
+    // Full screen with header and menu again
     _menu.show();
-    drawMenu();
+    _widgets.invalidateAll();
 }
 
 void SettingsScreen::update() {
-    // No animation or updates needed
+    // Menu scroll frames; activate the item once its flash has played
+    if (_menu.isVisible() && _ui.updateMenu(_menu)) {
+        activateMenuItem();
+    }
 }
 
 void SettingsScreen::draw() {
-    drawBackground();
-    drawHeader();
-    drawPlaceholderText();
+    _header.setNetworkStatus(AppState::getInstance().getNetworkStatus());
     
-    if (_menu.isVisible()) {
+    // Nothing changed since the last draw (e.g. onEnter already drew)
+    if (!_widgets.hasDirtyWidgets()) {
+        return;
+    }
+    
+    bool full = _widgets.needsFullRepaint();
+    if (full) {
+        drawBackground();
+    }
+    
+    _display.startWrite();
+    _widgets.render(_display);
+    _display.endWrite();
+    _display.display();
+    
+    // The menu covers everything below the header, so it only needs
+    // redrawing after the screen underneath was repainted
+    if (full && _menu.isVisible()) {
         drawMenu();
     }
 }
@@ -94,34 +107,21 @@ void SettingsScreen::draw() {
 // ============================================================================
 
 void SettingsScreen::onButtonA() {
-    if (_menu.isVisible()) {
-        // Menu visible - activate selected item
+    if (_menu.isVisible() && !_ui.isMenuFlashing()) {
+        // Menu visible - flash the selected item; update() activates it
         Serial.println("[SettingsScreen] Button A - activating menu item");
-        
-        // Flash the selected item
         _ui.flashMenuItem(_menu, _menu.getSelectedIndex());
-        M5.delay(MENU_FLASH_DURATION_MS);
-        
-        // Activate the item - this may navigate away
-        _menu.activateSelected();
-        
-        // Check if we're still the active screen
-        if (_screenManager && 
-            _screenManager->getCurrentScreenType() != ScreenType::SETTINGS) {
-            // Screen changed - don't redraw
-            return;
-        }
-        
-        // Still on this screen - redraw menu
-        drawMenu();
     }
 }
 
 void SettingsScreen::onButtonB() {
     if (_menu.isVisible()) {
-        // Menu visible - cycle to next item
+        // Menu visible - scroll to next item
+        if (_ui.isMenuFlashing()) {
+            return;
+        }
         _menu.selectNext();
-        drawMenu();
+        _ui.scrollMenu(_menu);
         Serial.printf("[SettingsScreen] Button B - selected item %d\n", 
                       _menu.getSelectedIndex());
     } else {
@@ -158,6 +158,21 @@ void SettingsScreen::setupMenu() {
     Serial.printf("[SettingsScreen] Menu initialized with %d items\n", _menu.getItemCount());
 }
 
+void SettingsScreen::activateMenuItem() {
+    // Activate the item - this may navigate away
+    _menu.activateSelected();
+    
+    // Check if we're still the active screen
+    if (_screenManager && 
+        _screenManager->getCurrentScreenType() != ScreenType::SETTINGS) {
+        // Screen changed - don't redraw
+        return;
+    }
+    
+    // Still on this screen - redraw menu
+    drawMenu();
+}
+
 void SettingsScreen::destroyMenu() {
     _menu.clear();
     Serial.println("[SettingsScreen] Menu cleared");
@@ -167,6 +182,21 @@ void SettingsScreen::destroyMenu() {
 // Drawing Helpers
 // ============================================================================
 
+void SettingsScreen::setupWidgets() {
+    // Shared header from UI
+    _header.setTitle("Settings");
+    _widgets.add(_header);
+    
+    // Very dim placeholder text in center
+    // This should never be visible in normal use
+    int textY = (SCREEN_HEIGHT - 12) / 2;
+    _placeholder.setStyle(&fonts::Font2, 0x2104, WidgetAlign::CENTER);  // Very dark gray, barely visible
+    _placeholder.setBounds(0, textY, SCREEN_WIDTH, 16);
+    _placeholder.setAnchor(SCREEN_WIDTH / 2, textY);
+    _placeholder.setText("SETTINGS");
+    _widgets.add(_placeholder);
+}
+
 void SettingsScreen::drawBackground() {
     _display.waitDisplay();
     _display.startWrite();
@@ -174,33 +204,6 @@ void SettingsScreen::drawBackground() {
     _display.endWrite();
 }
 
-void SettingsScreen::drawHeader() {
-    // Use the shared header drawing from UI
-    NetworkStatus networkStatus = AppState::getInstance().getNetworkStatus();
-    _ui.drawStandardHeader("Settings", networkStatus);
-}
-
-void SettingsScreen::drawPlaceholderText() {
-    // Draw very dim placeholder text in center
-    // This should never be visible in normal use
-    _display.startWrite();
-    
-    _display.setTextColor(0x2104);  // Very dark gray, barely visible
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font2);
-    
-    const char* text = "SETTINGS";
-    int textWidth = _display.textWidth(text);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    int textY = (SCREEN_HEIGHT - 12) / 2;
-    
-    _display.setCursor(textX, textY);
-    _display.print(text);
-    
-    _display.endWrite();
-    _display.display();
-}
-
 void SettingsScreen::drawMenu() {
     _ui.drawMenu(_menu);
 }
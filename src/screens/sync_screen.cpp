@@ -10,22 +10,19 @@
 #include "screen_manager.h"
 #include "config.h"
 #include <Arduino.h>
-#include <cmath>
 
 // ============================================================================
 // Constructor
 // ============================================================================
 
-SyncScreen::SyncScreen(M5GFX& display)
+SyncScreen::SyncScreen(DisplayTarget& display)
     : _display(display)
     , _screenManager(nullptr)
-    , _progress(0.0f)
     , _showSpinner(true)
     , _showProgress(false)
-    , _lastAnimationMs(0)
     , _spinnerFrame(0)
 {
-    strncpy(_message, "Loading...", sizeof(_message));
+    setupWidgets();
 }
 
 void SyncScreen::setScreenManager(ScreenManager* manager) {
@@ -42,49 +39,45 @@ void SyncScreen::onEnter() {
     // Reset to default state
     reset();
     
-    draw();
+    _widgets.invalidateAll();
 }
 
 void SyncScreen::onExit() {
     Serial.println("[SyncScreen] onExit");
+    _widgets.printStats("sync");
+    _spinner.printStats("sync spinner");
 }
 
 void SyncScreen::onResume() {
     Serial.println("[SyncScreen] onResume");
-    draw();
+    _widgets.invalidateAll();
 }
 
 void SyncScreen::update() {
-    uint32_t now = millis();
-    
     // Update spinner animation
-    if (_showSpinner && (now - _lastAnimationMs >= SPINNER_INTERVAL_MS)) {
-        _lastAnimationMs = now;
-        _spinnerFrame = (_spinnerFrame + 1) % SPINNER_FRAMES;
+    uint8_t frame = AnimatedSprite::frameAt(SPINNER_TICKS_PER_FRAME, SPINNER_FRAMES);
+    if (_showSpinner && frame != _spinnerFrame) {
+        _spinnerFrame = frame;
         
-        // Redraw just the spinner area
-        _display.startWrite();
-        drawSpinner();
-        _display.endWrite();
-        _display.display();
+        // Only the spinner is invalidated; only its changed pixels are pushed
+        _spinner.setFrame(_spinnerFrame);
+        const DirtyRect& bounds = _spinner.getBounds();
+        requestRedraw(bounds.x, bounds.y, bounds.w, bounds.h);
     }
 }
 
 void SyncScreen::draw() {
+    if (!_widgets.hasDirtyWidgets()) {
+        return;
+    }
+    
     _display.waitDisplay();
     _display.startWrite();
     
-    drawBackground();
-    
-    if (_showSpinner && !_showProgress) {
-        drawSpinner();
+    if (_widgets.needsFullRepaint()) {
+        drawBackground();
     }
-    
-    if (_showProgress) {
-        drawProgressBar();
-    }
-    
-    drawMessage();
+    _widgets.render(_display);
     
     _display.endWrite();
     _display.display();
@@ -117,31 +110,19 @@ void SyncScreen::onButtonPowerHold() {
 // ============================================================================
 
 void SyncScreen::setMessage(const char* message) {
-    strncpy(_message, message, sizeof(_message) - 1);
-    _message[sizeof(_message) - 1] = '\0';
-    
-    // Redraw message area
-    _display.startWrite();
-    // Clear message area
-    _display.fillRect(0, MESSAGE_Y - 5, SCREEN_WIDTH, 30, COLOR_BACKGROUND);
-    drawMessage();
-    _display.endWrite();
-    _display.display();
+    // Redraws only the message area, and only if the text changed
+    _message.setText(message);
+    requestRedraw();
 }
 
 void SyncScreen::setProgress(float progress) {
-    _progress = progress;
-    if (_progress < 0.0f) _progress = 0.0f;
-    if (_progress > 1.0f) _progress = 1.0f;
-    
     _showProgress = true;
     _showSpinner = false;
+    updateVisibility();
     
-    // Redraw progress bar
-    _display.startWrite();
-    drawProgressBar();
-    _display.endWrite();
-    _display.display();
+    // Redraws only if the fill width changed
+    _progressBar.setProgress(progress);
+    requestRedraw();
 }
 
 void SyncScreen::showSpinner(bool show) {
@@ -149,84 +130,51 @@ void SyncScreen::showSpinner(bool show) {
     if (show) {
         _showProgress = false;
     }
-    draw();
+    updateVisibility();
+    requestRedraw();
 }
 
 void SyncScreen::reset() {
-    strncpy(_message, "Loading...", sizeof(_message));
-    _progress = 0.0f;
+    _message.setText("Loading...");
+    _progressBar.setProgress(0.0f);
     _showSpinner = true;
     _showProgress = false;
-    _spinnerFrame = 0;
-    _lastAnimationMs = millis();
+    _spinnerFrame = AnimatedSprite::frameAt(SPINNER_TICKS_PER_FRAME, SPINNER_FRAMES);
+    _spinner.setFrame(_spinnerFrame);
+    updateVisibility();
 }
 
 // ============================================================================
 // Drawing Methods
 // ============================================================================
 
-void SyncScreen::drawBackground() {
-    _display.fillScreen(COLOR_BACKGROUND);
-}
-
-void SyncScreen::drawSpinner() {
-    // Draw a rotating arc spinner
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SPINNER_CENTER_Y;
-    
-    // Clear spinner area
-    _display.fillCircle(centerX, centerY, SPINNER_RADIUS + 5, COLOR_BACKGROUND);
-    
-    // Draw spinner track (faint circle)
-    _display.drawCircle(centerX, centerY, SPINNER_RADIUS, COLOR_BORDER);
-    
-    // Draw active arc segment
-    // Calculate arc position based on frame
-    float startAngle = (_spinnerFrame * 360.0f / SPINNER_FRAMES) * DEG_TO_RAD;
-    float arcLength = 90.0f * DEG_TO_RAD;  // 90 degree arc
+void SyncScreen::setupWidgets() {
+    // Rotating arc spinner
+    _spinner.setGeometry(SCREEN_WIDTH / 2, SPINNER_CENTER_Y, SPINNER_RADIUS);
+    _spinner.setColors(COLOR_BORDER, COLOR_ACCENT_PRIMARY);
+    _spinner.setFrameCount(SPINNER_FRAMES);
+    _widgets.add(_spinner);
+    
+    // Progress bar (replaces the spinner once progress is reported)
+    _progressBar.setBounds((SCREEN_WIDTH - PROGRESS_WIDTH) / 2, PROGRESS_Y,
+                           PROGRESS_WIDTH, PROGRESS_HEIGHT);
+    _progressBar.setColors(COLOR_PROGRESS_BG, COLOR_PROGRESS_FILL, COLOR_BORDER);
+    _widgets.add(_progressBar);
+    
+    // Status message, below the progress bar
+    _message.setStyle(&fonts::Font2, COLOR_TEXT_PRIMARY, WidgetAlign::CENTER);
+    _message.setBounds(0, MESSAGE_Y, SCREEN_WIDTH, 16);
+    _message.setAnchor(SCREEN_WIDTH / 2, MESSAGE_Y);
+    _widgets.add(_message);
     
-    // Draw thick arc by drawing multiple circles at different positions
-    for (int i = 0; i < 6; i++) {
-        float angle = startAngle + (arcLength * i / 5);
-        int x = centerX + (int)(SPINNER_RADIUS * cos(angle));
-        int y = centerY + (int)(SPINNER_RADIUS * sin(angle));
-        
-        // Gradient from bright to dim
-        uint16_t color = (i < 3) ? COLOR_ACCENT_PRIMARY : COLOR_ACCENT_PRIMARY;
-        int radius = (i == 0 || i == 1) ? 4 : 3;
-        
-        _display.fillCircle(x, y, radius, color);
-    }
+    reset();
 }
 
-void SyncScreen::drawProgressBar() {
-    int barX = (SCREEN_WIDTH - PROGRESS_WIDTH) / 2;
-    int barY = PROGRESS_Y;
-    
-    // Draw background
-    _display.fillRoundRect(barX, barY, PROGRESS_WIDTH, PROGRESS_HEIGHT, 
-                           PROGRESS_HEIGHT / 2, COLOR_PROGRESS_BG);
-    
-    // Draw fill
-    int fillWidth = (int)(PROGRESS_WIDTH * _progress);
-    if (fillWidth > 0) {
-        _display.fillRoundRect(barX, barY, fillWidth, PROGRESS_HEIGHT,
-                               PROGRESS_HEIGHT / 2, COLOR_PROGRESS_FILL);
-    }
-    
-    // Draw border
-    _display.drawRoundRect(barX, barY, PROGRESS_WIDTH, PROGRESS_HEIGHT,
-                           PROGRESS_HEIGHT / 2, COLOR_BORDER);
+void SyncScreen::updateVisibility() {
+    _spinner.setVisible(_showSpinner && !_showProgress);
+    _progressBar.setVisible(_showProgress);
 }
 
-void SyncScreen::drawMessage() {
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setFont(&fonts::Font2);
-    _display.setTextSize(1);
-    
-    int textWidth = _display.textWidth(_message);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    
-    _display.setCursor(textX, MESSAGE_Y);
-    _display.print(_message);
+void SyncScreen::drawBackground() {
+    _display.fillScreen(COLOR_BACKGROUND);
 }
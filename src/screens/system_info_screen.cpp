@@ -8,6 +8,7 @@
 #include <M5Unified.h>
 #include "screens/system_info_screen.h"
 #include "screen_manager.h"
+#include "avatar_cache.h"
 #include "config.h"
 #include <Arduino.h>
 
@@ -15,12 +16,13 @@
 // Constructor
 // ============================================================================
 
-SystemInfoScreen::SystemInfoScreen(M5GFX& display)
+SystemInfoScreen::SystemInfoScreen(DisplayTarget& display)
     : _display(display)
     , _screenManager(nullptr)
     , _batteryLevel(0)
     , _batteryVoltage(0)
 {
+    setupWidgets();
 }
 
 void SystemInfoScreen::setScreenManager(ScreenManager* manager) {
@@ -41,17 +43,21 @@ void SystemInfoScreen::onEnter() {
     Serial.printf("[SystemInfoScreen] Battery: %d%%, %dmV\n", 
                   _batteryLevel, _batteryVoltage);
     
-    // Draw the screen
-    draw();
+    AvatarCache::getInstance().printStats();
+    
+    // Reset widgets; ScreenManager renders the first frame
+    updateWidgets();
+    _widgets.invalidateAll();
 }
 
 void SystemInfoScreen::onExit() {
     Serial.println("[SystemInfoScreen] onExit");
+    _widgets.printStats("system_info");
 }
 
 void SystemInfoScreen::onResume() {
     Serial.println("[SystemInfoScreen] onResume");
-    draw();
+    _widgets.invalidateAll();
 }
 
 void SystemInfoScreen::update() {
@@ -59,14 +65,19 @@ void SystemInfoScreen::update() {
 }
 
 void SystemInfoScreen::draw() {
+    // Nothing changed since the last draw (e.g. onEnter already drew)
+    if (!_widgets.hasDirtyWidgets()) {
+        return;
+    }
+    
     _display.waitDisplay();
     _display.startWrite();
     
-    drawBackground();
-    drawTitle();
-    drawBatteryInfo();
-    drawVersionInfo();
-    drawExitHint();
+    if (_widgets.needsFullRepaint()) {
+        drawBackground();
+        drawTitle();
+    }
+    _widgets.render(_display);
     
     _display.endWrite();
     _display.display();
@@ -100,6 +111,67 @@ void SystemInfoScreen::onButtonPowerHold() {
 // Drawing Helpers
 // ============================================================================
 
+void SystemInfoScreen::setupWidgets() {
+    // Content area starts below header, one row every 20px
+    static const char* const ROW_NAMES[ROW_COUNT] = {
+        "Battery Voltage:", "Battery Level:", "App Version:", "Avatar Cache:"
+    };
+    int contentY = HEADER_HEIGHT + 12;
+    int leftMargin = UI_PADDING + 4;
+    int valueX = 140;  // Right-align values
+    
+    for (int i = 0; i < ROW_COUNT; i++) {
+        int rowY = contentY + i * 20;
+        
+        _rowLabels[i].setStyle(&fonts::Font2, COLOR_TEXT_SECONDARY, WidgetAlign::LEFT);
+        _rowLabels[i].setBounds(leftMargin, rowY, valueX - leftMargin, 16);
+        _rowLabels[i].setAnchor(leftMargin, rowY);
+        _rowLabels[i].setText(ROW_NAMES[i]);
+        _widgets.add(_rowLabels[i]);
+        
+        _rowValues[i].setStyle(&fonts::Font2, COLOR_TEXT_PRIMARY, WidgetAlign::LEFT);
+        _rowValues[i].setBounds(valueX, rowY, SCREEN_WIDTH - valueX, 16);
+        _rowValues[i].setAnchor(valueX, rowY);
+        _widgets.add(_rowValues[i]);
+    }
+    
+    // Hint at bottom of screen
+    int hintY = SCREEN_HEIGHT - UI_PADDING - 12;
+    _hint.setStyle(&fonts::Font0, COLOR_TEXT_MUTED, WidgetAlign::CENTER);
+    _hint.setBounds(0, hintY, SCREEN_WIDTH, 8);
+    _hint.setAnchor(SCREEN_WIDTH / 2, hintY);
+    _hint.setText("Press any button to exit");
+    _widgets.add(_hint);
+    
+    updateWidgets();
+}
+
+void SystemInfoScreen::updateWidgets() {
+    char value[24];
+    
+    // Battery voltage
+    snprintf(value, sizeof(value), "%.2f V", _batteryVoltage / 1000.0f);
+    _rowValues[0].setText(value);
+    
+    // Battery percentage
+    if (_batteryLevel >= 0) {
+        snprintf(value, sizeof(value), "%d%%", _batteryLevel);
+    } else {
+        snprintf(value, sizeof(value), "N/A");
+    }
+    _rowValues[1].setText(value);
+    
+    // App version
+    _rowValues[2].setText(APP_VERSION);
+    
+    // Avatar cache hits / misses / last blit time
+    const AvatarCacheStats& stats = AvatarCache::getInstance().getStats();
+    snprintf(value, sizeof(value), "%lu/%lu %luus",
+             (unsigned long)stats.hits, (unsigned long)stats.misses,
+             (unsigned long)stats.lastBlitUs);
+    _rowValues[3].setText(value);
+}
+
 void SystemInfoScreen::drawBackground() {
     _display.fillScreen(COLOR_BACKGROUND);
 }
@@ -123,80 +195,6 @@ void SystemInfoScreen::drawTitle() {
     _display.print(title);
 }
 
-void SystemInfoScreen::drawBatteryInfo() {
-    // Content area starts below header
-    int contentY = HEADER_HEIGHT + 12;
-    int leftMargin = UI_PADDING + 4;
-    int valueX = 140;  // Right-align values
-    
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font2);
-    
-    // Battery Voltage label
-    _display.setCursor(leftMargin, contentY);
-    _display.print("Battery Voltage:");
-    
-    // Battery Voltage value
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    char voltageStr[16];
-    float voltageV = _batteryVoltage / 1000.0f;
-    snprintf(voltageStr, sizeof(voltageStr), "%.2f V", voltageV);
-    _display.setCursor(valueX, contentY);
-    _display.print(voltageStr);
-    
-    // Battery Percentage label
-    contentY += 20;
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setCursor(leftMargin, contentY);
-    _display.print("Battery Level:");
-    
-    // Battery Percentage value
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    char levelStr[16];
-    if (_batteryLevel >= 0) {
-        snprintf(levelStr, sizeof(levelStr), "%d%%", _batteryLevel);
-    } else {
-        snprintf(levelStr, sizeof(levelStr), "N/A");
-    }
-    _display.setCursor(valueX, contentY);
-    _display.print(levelStr);
-}
-
-void SystemInfoScreen::drawVersionInfo() {
-    // Position below battery info
-    int contentY = HEADER_HEIGHT + 12 + 20 + 20;
-    int leftMargin = UI_PADDING + 4;
-    int valueX = 140;
-    
-    // App Version label
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setFont(&fonts::Font2);
-    _display.setCursor(leftMargin, contentY);
-    _display.print("App Version:");
-    
-    // App Version value
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setCursor(valueX, contentY);
-    _display.print(APP_VERSION);
-}
-
-void SystemInfoScreen::drawExitHint() {
-    // Draw hint at bottom of screen
-    int hintY = SCREEN_HEIGHT - UI_PADDING - 12;
-    
-    _display.setTextColor(COLOR_TEXT_MUTED);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font0);
-    
-    const char* hint = "Press any button to exit";
-    int textWidth = _display.textWidth(hint);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    
-    _display.setCursor(textX, hintY);
-    _display.print(hint);
-}
-
 // ============================================================================
 // Navigation
 // ============================================================================
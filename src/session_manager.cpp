@@ -10,6 +10,7 @@
 #include "session_manager.h"
 #include "timer.h"
 #include "api_client.h"
+#include "network_task.h"
 #include "persistence.h"
 #include "app_state.h"
 #include "config.h"
@@ -264,13 +265,21 @@ void SessionManager::pushSessionToApi(uint32_t durationSeconds, time_t startTime
     Serial.printf("[SessionManager] Pushing session to API: %lu minutes, started at %ld\n",
                   (unsigned long)durationMinutes, (long)startTime);
     
-    // This is a non-critical operation - we log but don't block on failure
-    ConsumedTimeResult result = _apiClient->pushConsumedTime(childId, durationMinutes, startTime);
+    // This is a non-critical operation - queue it on the network task and
+    // only log the outcome
+    uint32_t jobId = NetworkTask::getInstance().submitPushConsumedTime(
+        childId, durationMinutes, startTime, onSessionPushed, this);
     
-    if (result.success) {
+    if (jobId == 0) {
+        Serial.println("[SessionManager] Network queue full - session not pushed");
+    }
+}
+
+void SessionManager::onSessionPushed(const NetJob& job, void* userData) {
+    if (job.consumed.success) {
         Serial.println("[SessionManager] Session pushed successfully");
     } else {
         Serial.printf("[SessionManager] Failed to push session: %s\n",
-                      result.errorMessage);
+                      job.consumed.errorMessage);
     }
 }
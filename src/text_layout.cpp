@@ -0,0 +1,169 @@
+/**
+ * text_layout.cpp - Cached word-wrap layout implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "text_layout.h"
+#include <cstring>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+TextLayout::TextLayout()
+    : _font(nullptr)
+    , _maxWidth(0)
+    , _maxLines(0)
+    , _valid(false)
+    , _lineCount(0)
+    , _used(0)
+{
+    _source[0] = '\0';
+    _lines[0] = '\0';
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+bool TextLayout::layout(lgfx::LovyanGFX& gfx, const char* text, const lgfx::IFont* font,
+                        int maxWidth, int maxLines) {
+    if (text == nullptr) {
+        text = "";
+    }
+    if (maxLines > TEXT_LAYOUT_MAX_LINES) {
+        maxLines = TEXT_LAYOUT_MAX_LINES;
+    }
+
+    // Same text (up to the truncation limit), font and width - keep the lines
+    if (_valid && font == _font && maxWidth == _maxWidth && maxLines == _maxLines &&
+        strncmp(text, _source, TEXT_LAYOUT_MAX_LEN - 1) == 0) {
+        return false;
+    }
+
+    strncpy(_source, text, TEXT_LAYOUT_MAX_LEN - 1);
+    _source[TEXT_LAYOUT_MAX_LEN - 1] = '\0';
+    _font = font;
+    _maxWidth = (int16_t)maxWidth;
+    _maxLines = (int8_t)maxLines;
+    _valid = true;
+    _lineCount = 0;
+    _used = 0;
+
+    gfx.setFont(font);
+    gfx.setTextSize(1);
+
+    int lineStart = 0;  // First character of the current line
+    int lineEnd = 0;    // End of the last word that fits on it
+    int pos = 0;
+
+    while (_lineCount < maxLines) {
+        char c = _source[pos];
+
+        if (c == '\0' || c == '\n') {
+            if (c == '\n' || lineEnd > lineStart) {
+                addLine(lineStart, lineEnd);
+            }
+            if (c == '\0') {
+                break;
+            }
+            pos++;
+            lineStart = lineEnd = pos;
+            continue;
+        }
+
+        // Next word, together with the spaces before it
+        int wordStart = pos;
+        while (_source[wordStart] == ' ') {
+            wordStart++;
+        }
+        int wordEnd = wordStart;
+        while (_source[wordEnd] != '\0' && _source[wordEnd] != ' ' && _source[wordEnd] != '\n') {
+            wordEnd++;
+        }
+        if (wordEnd == wordStart) {
+            // Only trailing spaces before a line break or the end
+            pos = wordEnd;
+            continue;
+        }
+
+        if (measure(gfx, lineStart, wordEnd) <= maxWidth) {
+            lineEnd = wordEnd;
+            pos = wordEnd;
+            continue;
+        }
+
+        if (lineEnd > lineStart) {
+            // Wrap before this word
+            addLine(lineStart, lineEnd);
+            pos = lineEnd;
+            while (_source[pos] == ' ') {
+                pos++;
+            }
+            lineStart = lineEnd = pos;
+            continue;
+        }
+
+        // A single word wider than the line - break it between characters
+        int breakAt = lineStart + 1;
+        while (breakAt < wordEnd && measure(gfx, lineStart, breakAt + 1) <= maxWidth) {
+            breakAt++;
+        }
+        addLine(lineStart, breakAt);
+        lineStart = lineEnd = pos = breakAt;
+    }
+
+    return true;
+}
+
+int TextLayout::getLineCount() const {
+    return _lineCount;
+}
+
+const char* TextLayout::getLine(int index) const {
+    if (index < 0 || index >= _lineCount) {
+        return "";
+    }
+    return &_lines[_lineOffsets[index]];
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void TextLayout::draw(lgfx::LovyanGFX& gfx, int x, int y, int lineHeight) const {
+    if (_lineCount == 0) {
+        return;
+    }
+
+    gfx.setFont(_font);
+    gfx.setTextSize(1);
+
+    for (int i = 0; i < _lineCount; i++) {
+        gfx.setCursor(x, y + i * lineHeight);
+        gfx.print(getLine(i));
+    }
+}
+
+// ============================================================================
+// Internal Methods
+// ============================================================================
+
+int TextLayout::measure(lgfx::LovyanGFX& gfx, int start, int end) {
+    // Terminate the source in place instead of copying the substring
+    char saved = _source[end];
+    _source[end] = '\0';
+    int width = gfx.textWidth(&_source[start]);
+    _source[end] = saved;
+    return width;
+}
+
+void TextLayout::addLine(int start, int end) {
+    int length = end - start;
+    _lineOffsets[_lineCount++] = (uint16_t)_used;
+    memcpy(&_lines[_used], &_source[start], length);
+    _used += length;
+    _lines[_used++] = '\0';
+}
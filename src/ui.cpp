@@ -1,7 +1,7 @@
 /**
  * ui.cpp - User Interface implementation for Screen Time Tracker
  *
- * Implements all display rendering using M5GFX.
+ * Implements all display rendering through a DisplayTarget.
  *
  * @author Screen Time Tracker
  * @version 1.0
@@ -11,8 +11,10 @@
 #include "timer.h"
 #include "menu.h"
 #include "app_state.h"
+#include "avatar_cache.h"
+#include "font_subsets.h"
+#include "render_profiler.h"
 #include <M5Unified.h>
-#include <LittleFS.h>
 #include <time.h>
 
 // Calculate avatar Y position to center the avatar+ring unit vertically
@@ -24,25 +26,82 @@ static constexpr int AVAILABLE_HEIGHT = SCREEN_HEIGHT - HEADER_Y - HEADER_HEIGHT
 // Avatar center Y = header bottom + offset to center the unit
 static constexpr int AVATAR_Y = HEADER_Y + HEADER_HEIGHT + (AVAILABLE_HEIGHT / 2) - (UI_PADDING * 2);
 
+// Timer area cleared before each text redraw (timer text starts at Y=61)
+static constexpr int TIMER_CLEAR_X = UI_PADDING * 2;
+static constexpr int TIMER_CLEAR_Y = 63;
+static constexpr int TIMER_CLEAR_WIDTH = 152;
+static constexpr int TIMER_CLEAR_HEIGHT = 42;
+
+// Dirty regions pushed by updateDynamicElements()
+// Timer: text top (Y=61) down to the cleared area bottom
+static constexpr int TIMER_DIRTY_X = TIMER_CLEAR_X;
+static constexpr int TIMER_DIRTY_Y = 61;
+static constexpr int TIMER_DIRTY_WIDTH = TIMER_CLEAR_WIDTH;
+static constexpr int TIMER_DIRTY_HEIGHT = TIMER_CLEAR_Y + TIMER_CLEAR_HEIGHT - TIMER_DIRTY_Y;
+// Countdown glyph atlas: one cell per character, covering the whole timer area
+// (scripts/build_fonts.py subsets FONT_TIMER to these plus formatTime()'s text)
+static constexpr const char* TIMER_ATLAS_GLYPHS = "0123456789:";
+static constexpr uint16_t TIMER_ATLAS_COLORS[] = {COLOR_TEXT_PRIMARY, COLOR_ACCENT_WARNING, COLOR_ACCENT_DANGER};
+static constexpr int TIMER_ATLAS_COLOR_COUNT = sizeof(TIMER_ATLAS_COLORS) / sizeof(TIMER_ATLAS_COLORS[0]);
+// Activation ring: just outside the status ring
+static constexpr int ACTIVATION_RING_RADIUS = AVATAR_RADIUS + STATUS_RING_THICKNESS + 1;
+// Status + activation rings: bounding square of the outer activation ring
+static constexpr int RING_DIRTY_RADIUS = AVATAR_RADIUS + STATUS_RING_THICKNESS + 1 + 2;
+static constexpr int RING_DIRTY_X = AVATAR_X - RING_DIRTY_RADIUS - 1;
+static constexpr int RING_DIRTY_Y = AVATAR_Y - RING_DIRTY_RADIUS - 1;
+static constexpr int RING_DIRTY_SIZE = RING_DIRTY_RADIUS * 2 + 3;
+// Progress bar, and the right-aligned status label below it (wide enough for
+// "Today's allowance: Unlimited")
+static constexpr int PROGRESS_DIRTY_X = UI_PADDING * 2;
+static constexpr int PROGRESS_DIRTY_Y = 108;
+static constexpr int LABEL_DIRTY_WIDTH = 180;
+static constexpr int LABEL_DIRTY_X = SCREEN_WIDTH - LABEL_DIRTY_WIDTH;
+static constexpr int LABEL_DIRTY_Y = SCREEN_HEIGHT - 8 - UI_PADDING - 2;
+static constexpr int LABEL_DIRTY_HEIGHT = 10;
+
 // ============================================================================
 // Constructor and Initialization
 // ============================================================================
 
-UI::UI(M5GFX &display)
-    : _display(display), _canvas(&display), _needsFullRedraw(true), _lastUpdateMs(0), _infoDialogVisible(false), _currentNetworkStatus(NetworkStatus::DISCONNECTED), _lastDrawnSeconds(UINT32_MAX), _lastDrawnProgress(-1.0f), _lastDrawnRunning(false)
+UI::UI(DisplayTarget& display)
+    : _display(display), _gfx(&display), _compositor(display), _needsFullRedraw(true), _lastUpdateMs(0), _fixedTime(0), _infoDialogVisible(false), _currentNetworkStatus(NetworkStatus::DISCONNECTED), _lastDrawnSeconds(UINT32_MAX), _lastDrawnProgress(-1.0f), _lastDrawnRunning(false), _drawnTimerColor(-1), _mainFrameValid(false), _mainFrameKey(0)
 {
+    _drawnTimerText[0] = '\0';
 }
 
 void UI::begin()
 {
-    // Configure display for landscape mode
-    _display.setRotation(DISPLAY_ROTATION);
-    _display.setBrightness(DISPLAY_BRIGHTNESS);
+    // Configure the panel for landscape mode (off-screen canvases are already landscape)
+    if (&_display == &M5.Display)
+    {
+        M5.Display.setRotation(DISPLAY_ROTATION);
+        M5.Display.setBrightness(DISPLAY_BRIGHTNESS);
+    }
     _display.fillScreen(COLOR_BACKGROUND);
 
+    // Off-screen framebuffer for flicker-free main screen updates
+    _compositor.begin();
+
+    // Header strip composed once, shared by every screen with a header
+    _header.begin();
+    _header.setBatteryLevel(M5.Power.getBatteryLevel());
+
+    // Per-degree span table for the activation ring (2px ring outside the status ring)
+    _activationRing.begin(ACTIVATION_RING_RADIUS, ACTIVATION_RING_RADIUS + 2);
+
+    // Pre-render countdown digits so a tick blits cells instead of rasterizing text
+    _timerAtlas.begin(FONT_TIMER, TIMER_ATLAS_GLYPHS,
+                      TIMER_ATLAS_COLORS, TIMER_ATLAS_COLOR_COUNT,
+                      COLOR_BACKGROUND, TIMER_DIRTY_HEIGHT);
+
     _needsFullRedraw = true;
 }
 
+void UI::setFixedTime(time_t now)
+{
+    _fixedTime = now;
+}
+
 // ============================================================================
 // Main Drawing Methods
 // ============================================================================
@@ -54,46 +113,88 @@ void UI::drawMainScreen(const ScreenTimer &timer,
                         bool isTimerRunning,
                         NetworkStatus networkStatus)
 {
+    RENDER_PROFILE_SCOPE(RenderSection::MAIN_FULL);
+
     // Update cached network status
     _currentNetworkStatus = networkStatus;
 
-    // Wait for any pending display operations to complete
-    _display.waitDisplay();
+    // Compose the whole frame off-screen, then push it in one pass.
+    // Falls back to drawing on the panel if the sprite is unavailable.
+    _gfx = &_compositor.target();
+    _gfx->startWrite();
 
-    // Batched Write #1 - Avatar
-    _display.startWrite();
     // Clear background
-    _display.fillScreen(COLOR_BACKGROUND);
+    _gfx->fillScreen(COLOR_BACKGROUND);
     drawAvatar(userInitial, userName, avatarName, AVATAR_X, AVATAR_Y);
-    _display.endWrite();
-    _display.display();
-
-    // Batched Write #2 - Everything else
-    _display.startWrite();
-    drawHeader(APP_NAME);
-    drawNetworkStatusInHeader();
+    drawStandardHeader(APP_NAME, networkStatus);
     drawDateOnMainScreen();
     drawChildName(userName, AVATAR_X, AVATAR_Y);
 
-    // Draw dynamic elements
+    // Draw dynamic elements (background was just cleared, redraw every timer cell)
+    _drawnTimerText[0] = '\0';
     TimerState timerState = timer.getState();
     drawTimerDisplay(timer.calculateRemainingSeconds(), timerState);
     drawProgressBar(timer);
     drawStatusRing(timer);
+    _activationRing.invalidate();
+    drawActivationRing(timer);
 
-    // End batched write and flush to display
-    _display.endWrite();
-    _display.display();
+    _gfx->endWrite();
+    _gfx = &_display;
+
+    // Panel content is unknown (menu, dialog or another screen), push everything
+    _compositor.markAllDirty();
+    _compositor.flush();
 
     // Cache the drawn state for change detection
     _lastDrawnSeconds = timer.calculateRemainingSeconds();
     _lastDrawnProgress = timer.getProgress();
     _lastDrawnRunning = isTimerRunning;
 
+    // The sprite now holds this frame until the next drawMainScreen()
+    _mainFrameValid = _compositor.isReady();
+    _mainFrameKey = mainFrameKey(userName, userInitial, avatarName);
+
     _needsFullRedraw = false;
     _lastUpdateMs = millis();
 }
 
+bool UI::restoreMainScreen(const ScreenTimer &timer,
+                           const char *userName,
+                           char userInitial,
+                           const char *avatarName,
+                           bool isTimerRunning,
+                           NetworkStatus networkStatus)
+{
+    RENDER_PROFILE_SCOPE(RenderSection::MAIN_RESTORE);
+
+    // Only the panel was overdrawn; the sprite still holds the last main
+    // frame unless it was never composed or shows another child or day
+    if (!_mainFrameValid || mainFrameKey(userName, userInitial, avatarName) != _mainFrameKey)
+    {
+        return false;
+    }
+
+    // Status may have changed without reaching UI; refresh the indicator icons
+    _currentNetworkStatus = networkStatus;
+    _header.setNetworkStatus(networkStatus);
+    _header.drawIndicators(_compositor.target());
+
+    // Catch up the elements that changed while covered, then push the frame.
+    // forceFullRedraw() reset the change-detection cache, so redraw the ring too.
+    if (_needsFullRedraw)
+    {
+        _lastDrawnRunning = !isTimerRunning;
+        _needsFullRedraw = false;
+    }
+    composeDynamicElements(timer, isTimerRunning);
+    _compositor.markAllDirty();
+    _compositor.flush();
+
+    _lastUpdateMs = millis();
+    return true;
+}
+
 void UI::updateDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
 {
     // Rate limit updates
@@ -109,6 +210,16 @@ void UI::updateDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
         return;
     }
 
+    RENDER_PROFILE_SCOPE(RenderSection::MAIN_DYNAMIC);
+    if (composeDynamicElements(timer, isTimerRunning))
+    {
+        _compositor.flush();
+        _lastUpdateMs = now;
+    }
+}
+
+bool UI::composeDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
+{
     // Get current values
     uint32_t currentSeconds = timer.calculateRemainingSeconds();
     float currentProgress = timer.getProgress();
@@ -123,7 +234,7 @@ void UI::updateDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
     bool needActivationUpdate = false;
     if (timer.isRunning() && timer.getSessionStartTime() > 0)
     {
-        time_t now_time = time(nullptr);
+        time_t now_time = currentTime();
         time_t sessionStart = timer.getSessionStartTime();
         uint32_t secondsSinceActivation = (uint32_t)(now_time - sessionStart);
         if (secondsSinceActivation < MINIMUM_SESSION_DURATION_SECONDS)
@@ -135,29 +246,18 @@ void UI::updateDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
     // Skip update if nothing changed and not in activation period
     if (!secondsChanged && !progressChanged && !runningChanged && !needActivationUpdate)
     {
-        return;
+        return false;
     }
 
-    // Wait for any pending display operations
-    _display.waitDisplay();
-
-    // Start batched write for better performance
-    _display.startWrite();
+    // Compose changed elements off-screen and push only their regions
+    _gfx = &_compositor.target();
+    _gfx->startWrite();
 
     // Only update timer display if seconds changed
     if (secondsChanged)
     {
-        // Clear timer area with fixed position and dimensions
-        // Timer baseline is at Y=61, clearance rectangle starts 42px above
-        int timerClearX = UI_PADDING * 2;
-        int timerClearY = 63;
-        int timerClearWidth = 152;
-        int timerClearHeight = 42;
-        _display.fillRect(timerClearX, timerClearY, timerClearWidth, timerClearHeight, COLOR_BACKGROUND);
+        // Marks only the timer cells that changed
         drawTimerDisplay(currentSeconds, timerState);
-
-        // Clear activation timer circle
-        clearActivationRing(timer);
         _lastDrawnSeconds = currentSeconds;
     }
 
@@ -165,21 +265,29 @@ void UI::updateDynamicElements(const ScreenTimer &timer, bool isTimerRunning)
     if (progressChanged || needActivationUpdate)
     {
         drawProgressBar(timer);
+        _compositor.markDirty(PROGRESS_DIRTY_X, PROGRESS_DIRTY_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT);
+        _compositor.markDirty(LABEL_DIRTY_X, LABEL_DIRTY_Y, LABEL_DIRTY_WIDTH, LABEL_DIRTY_HEIGHT);
         _lastDrawnProgress = currentProgress;
     }
 
-    // Only update status ring if running state changed or in activation period
-    if (runningChanged || needActivationUpdate)
+    // Only update status ring if running state changed
+    if (runningChanged)
     {
         drawStatusRing(timer);
+        _compositor.markDirty(RING_DIRTY_X, RING_DIRTY_Y, RING_DIRTY_SIZE, RING_DIRTY_SIZE);
         _lastDrawnRunning = isTimerRunning;
     }
 
-    // End batched write and flush to display
-    _display.endWrite();
-    _display.display();
+    // Activation ring: draws only the slice that changed (and erases it once over)
+    if (secondsChanged || runningChanged || needActivationUpdate)
+    {
+        drawActivationRing(timer);
+    }
 
-    _lastUpdateMs = now;
+    _gfx->endWrite();
+    _gfx = &_display;
+
+    return true;
 }
 
 void UI::forceFullRedraw()
@@ -189,6 +297,7 @@ void UI::forceFullRedraw()
     _lastDrawnSeconds = UINT32_MAX;
     _lastDrawnProgress = -1.0f;
     _lastDrawnRunning = false;
+    _drawnTimerText[0] = '\0';
 }
 
 bool UI::needsFullRedraw() const
@@ -196,63 +305,34 @@ bool UI::needsFullRedraw() const
     return _needsFullRedraw;
 }
 
-// ============================================================================
-// Static Element Drawing
-// ============================================================================
+const Compositor &UI::getCompositor() const
+{
+    return _compositor;
+}
 
-void UI::drawHeader(const char *appName)
+const ActivationRing &UI::getActivationRing() const
 {
-    // Draw header background (full width, no border)
-    int headerX = 0;
-    int headerWidth = SCREEN_WIDTH;
-
-    _display.fillRect(headerX, HEADER_Y, headerWidth, HEADER_HEIGHT, COLOR_HEADER_BG);
-
-    // Layout constants
-    constexpr int ITEM_GAP = 6;
-    constexpr int LOGO_WIDTH = 22;
-    constexpr int LOGO_HEIGHT = 14;
-
-    // Left-aligned items start position
-    int currentX = ITEM_GAP;
-
-    // 1. Draw logo placeholder (22x14 rounded white rectangle)
-    int logoY = HEADER_Y + (HEADER_HEIGHT - LOGO_HEIGHT) / 2;
-    _display.fillRoundRect(currentX, logoY, LOGO_WIDTH, LOGO_HEIGHT, 2, COLOR_TEXT_PRIMARY);
-
-    // Draw closed eyes (dark gray curved arcs inside logo)
-    constexpr uint16_t COLOR_LOGO_EYES = 0x4208; // Dark gray for eyes
-    int eyeY = logoY + 3;                        // Near-top of logo
-    int leftEyeX = currentX + 6;                 // Left eye center
-    int rightEyeX = currentX + 16;               // Right eye center
-    int eyeRadius = 3;
-
-    // Draw curved arcs for closed eyes (small arcs curving upward like smiles)
-    // Left eye - draw an arc by using fillArc or multiple small lines
-    for (int i = -2; i <= 2; i++)
-    {
-        int yOffset = 2 - (i * i) / 2; // Inverted parabolic curve (smile shape)
-        _display.drawPixel(leftEyeX + i, eyeY + yOffset, COLOR_LOGO_EYES);
-        _display.drawPixel(leftEyeX + i, eyeY + yOffset + 1, COLOR_LOGO_EYES);
-        _display.drawPixel(rightEyeX + i, eyeY + yOffset, COLOR_LOGO_EYES);
-        _display.drawPixel(rightEyeX + i, eyeY + yOffset + 1, COLOR_LOGO_EYES);
-    }
+    return _activationRing;
+}
 
-    // Mouth
-    _display.drawLine(leftEyeX + 2, eyeY + 6, rightEyeX - 2, eyeY + 6, COLOR_LOGO_EYES); // Mouth line
-    _display.drawLine(leftEyeX + 2, eyeY + 7, rightEyeX - 2, eyeY + 7, COLOR_LOGO_EYES); // Mouth line
+const HeaderLayer &UI::getHeader() const
+{
+    return _header;
+}
 
-    currentX += LOGO_WIDTH + ITEM_GAP;
+const MenuView &UI::getMenuView() const
+{
+    return _menuView;
+}
 
-    // 2. Draw app name with FreeSansBold9pt7b
-    _display.setTextColor(COLOR_TEXT_PRIMARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::FreeSans9pt7b);
+// ============================================================================
+// Static Element Drawing
+// ============================================================================
 
-    // Position text 4px below top of header
-    int textY = HEADER_Y + 4; // 4px from top + baseline offset
-    _display.setCursor(currentX, textY);
-    _display.print(appName);
+void UI::drawHeader(const char *appName)
+{
+    // Blit the cached strip (recomposed only if the title changed)
+    _header.draw(*_gfx, appName);
 }
 
 void UI::drawDateInHeader()
@@ -264,9 +344,8 @@ void UI::drawDateInHeader()
 void UI::drawDateOnMainScreen()
 {
     // Get current time
-    time_t now;
+    time_t now = currentTime();
     struct tm timeinfo;
-    time(&now);
     localtime_r(&now, &timeinfo);
 
     // Format: "Monday 9/Dec"
@@ -278,101 +357,42 @@ void UI::drawDateOnMainScreen()
     snprintf(dateBuffer, sizeof(dateBuffer), "%s %d %s",
              fullDays[timeinfo.tm_wday], timeinfo.tm_mday, monthStr);
 
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setTextSize(1);
-    _display.setFont(&fonts::FreeSans9pt7b);
+    _gfx->setTextColor(COLOR_TEXT_SECONDARY);
+    _gfx->setTextSize(1);
+    _gfx->setFont(&fonts::FreeSans9pt7b);
 
     // Fixed position for date
     int dateX = UI_PADDING * 2;
     int dateY = 39;
 
-    _display.setCursor(dateX, dateY);
-    _display.print(dateBuffer);
+    _gfx->setCursor(dateX, dateY);
+    _gfx->print(dateBuffer);
 }
 
 void UI::drawAvatar(char initial, const char *userName, const char *avatarName, int x, int y)
 {
-    // Try to load and draw PNG avatar if avatarName is provided
-    bool pngDrawn = false;
-
-    if (avatarName != nullptr && avatarName[0] != '\0')
-    {
-        // Construct full path: /avatars/[avatarName]
-        // Handle both cases: avatarName with or without .png extension
-        char avatarPath[64];
-
-        // Check if avatarName already ends with .png
-        size_t len = strlen(avatarName);
-        bool hasPngExtension = (len > 4 &&
-                                strcmp(&avatarName[len - 4], ".png") == 0);
-
-        if (hasPngExtension)
-        {
-            // Already has extension, use as-is
-            snprintf(avatarPath, sizeof(avatarPath), "/avatars/%s", avatarName);
-        }
-        else
-        {
-            // No extension, append .png
-            snprintf(avatarPath, sizeof(avatarPath), "/avatars/%s.png", avatarName);
-        }
-
-        // Try to load PNG from LittleFS
-        if (LittleFS.exists(avatarPath))
-        {
-            // Draw background circle first (in case PNG has transparency)
-            _display.fillCircle(x, y, AVATAR_RADIUS, COLOR_AVATAR_PRIMARY);
-
-            // Load and draw PNG centered in the circle
-            // PNG is 50x50, avatar circle is 32px diameter (16px radius)
-            File avatarFile = LittleFS.open(avatarPath, "r");
-            if (avatarFile)
-            {
-                // Calculate top-left position to center the image in the circle
-                int imgX = x - AVATAR_RADIUS;
-                int imgY = y - AVATAR_RADIUS;
-
-                // Draw PNG at position - don't pass size params as they set clipping, not scaling
-                _display.drawPng(&avatarFile, imgX, imgY);
-
-                avatarFile.close();
-                pngDrawn = true;
-
-                // Clear any clipping that may have been set by drawPng
-                _display.clearClipRect();
-
-                Serial.printf("[UI] Drew PNG avatar: %s at (%d,%d)\n", avatarPath, x, y);
-            }
-            else
-            {
-                Serial.printf("[UI] Failed to open avatar file: %s\n", avatarPath);
-            }
-        }
-        else
-        {
-            Serial.printf("[UI] Avatar PNG not found: %s\n", avatarPath);
-        }
-    }
+    // Blit the prebuilt avatar blob from the shared cache (loaded on first use)
+    bool pngDrawn = AvatarCache::getInstance().draw(*_gfx, avatarName, x, y, AVATAR_RADIUS);
 
     // Fallback: Draw initial letter if PNG not available
     if (!pngDrawn)
     {
         // Draw circular avatar with primary color
-        _display.fillCircle(x, y, AVATAR_RADIUS, COLOR_AVATAR_PRIMARY);
+        _gfx->fillCircle(x, y, AVATAR_RADIUS, COLOR_AVATAR_PRIMARY);
 
         // Draw initial centered in circle using FreeSansBold9pt7b
-        _display.setTextColor(COLOR_TEXT_PRIMARY); // White
-        _display.setFont(&fonts::FreeSansBold9pt7b);
-        _display.setTextSize(1);
+        _gfx->setTextColor(COLOR_TEXT_PRIMARY); // White
+        _gfx->setFont(&fonts::FreeSansBold9pt7b);
+        _gfx->setTextSize(1);
 
         // Calculate text position for centering
         char initialStr[2] = {initial, '\0'};
-        int textWidth = _display.textWidth(initialStr);
+        int textWidth = _gfx->textWidth(initialStr);
         int textX = x - (textWidth / 2);
         int textY = y - 6; // Center baseline vertically
 
-        _display.setCursor(textX, textY);
-        _display.print(initialStr);
+        _gfx->setCursor(textX, textY);
+        _gfx->print(initialStr);
     }
 }
 
@@ -381,17 +401,17 @@ void UI::drawChildName(const char *userName, int x, int y)
     // Draw the child's name below the avatar if provided
     if (userName != nullptr && userName[0] != '\0')
     {
-        _display.setTextColor(COLOR_TEXT_SECONDARY);
-        _display.setFont(&fonts::Font0); // Very small font
-        _display.setTextSize(1);
+        _gfx->setTextColor(COLOR_TEXT_SECONDARY);
+        _gfx->setFont(&fonts::Font0); // Very small font
+        _gfx->setTextSize(1);
 
         // Calculate position: below avatar circle + ring, centered horizontally
-        int nameWidth = _display.textWidth(userName);
+        int nameWidth = _gfx->textWidth(userName);
         int nameX = x - (nameWidth / 2);
         int nameY = y + AVATAR_RADIUS + STATUS_RING_THICKNESS + 4; // Below avatar + ring + small gap
 
-        _display.setCursor(nameX, nameY);
-        _display.print(userName);
+        _gfx->setCursor(nameX, nameY);
+        _gfx->print(userName);
     }
 }
 
@@ -420,49 +440,131 @@ void UI::drawTimerDisplay(uint32_t remainingSeconds, TimerState state)
     int timerX = UI_PADDING * 2;
     int timerY = 61;
 
+    // Format time as H:MM:SS (or "LOTS!" when out of range)
+    char timeBuffer[12];
+    formatTime(remainingSeconds, timeBuffer, sizeof(timeBuffer));
+
+    // Normal countdown: blit only the cells that changed since the last frame
+    if (!hasUnlimitedAllowance && state != TimerState::EXPIRED &&
+        drawTimerCells(timeBuffer, timerColor, timerX, timerY))
+    {
+        return;
+    }
+
+    // Text path: clear the whole timer area and redraw it
+    _gfx->fillRect(TIMER_CLEAR_X, TIMER_CLEAR_Y, TIMER_CLEAR_WIDTH, TIMER_CLEAR_HEIGHT, COLOR_BACKGROUND);
+    _compositor.markDirty(TIMER_DIRTY_X, TIMER_DIRTY_Y, TIMER_DIRTY_WIDTH, TIMER_DIRTY_HEIGHT);
+    _drawnTimerText[0] = '\0';
+
     if (hasUnlimitedAllowance)
     {
         // Display "NO LIMIT" with smaller bold font, wrapped onto two lines
-        _display.setTextColor(COLOR_ACCENT_SUCCESS, COLOR_BACKGROUND);
-        _display.setFont(&fonts::FreeSansBold12pt7b);
-        _display.setTextSize(1);
+        _gfx->setTextColor(COLOR_ACCENT_SUCCESS, COLOR_BACKGROUND);
+        _gfx->setFont(&fonts::FreeSansBold12pt7b);
+        _gfx->setTextSize(1);
 
         // Draw "NO" on first line
-        _display.setCursor(timerX, timerY - 10 + 5);
-        _display.print("NO");
+        _gfx->setCursor(timerX, timerY - 10 + 5);
+        _gfx->print("NO");
 
         // Draw "LIMIT" on second line
-        _display.setCursor(timerX, timerY + 10 + 5);
-        _display.print("LIMIT");
+        _gfx->setCursor(timerX, timerY + 10 + 5);
+        _gfx->print("LIMIT");
     }
     else if (state == TimerState::EXPIRED)
     {
         // Display "TIME UP" with smaller bold font, wrapped onto two lines
-        _display.setTextColor(timerColor, COLOR_BACKGROUND);
-        _display.setFont(&fonts::FreeSansBold12pt7b);
-        _display.setTextSize(1);
+        _gfx->setTextColor(timerColor, COLOR_BACKGROUND);
+        _gfx->setFont(&fonts::FreeSansBold12pt7b);
+        _gfx->setTextSize(1);
 
         // Draw "TIME" on first line
-        _display.setCursor(timerX, timerY - 10 + 5);
-        _display.print("TIME");
+        _gfx->setCursor(timerX, timerY - 10 + 5);
+        _gfx->print("TIME");
 
         // Draw "UP" on second line
-        _display.setCursor(timerX, timerY + 10 + 5);
-        _display.print("UP");
+        _gfx->setCursor(timerX, timerY + 10 + 5);
+        _gfx->print("UP");
     }
     else
     {
         // Display normal countdown timer
-        _display.setTextColor(timerColor, COLOR_BACKGROUND);
-        _display.setFont(&fonts::FreeSansBold24pt7b);
-        _display.setTextSize(1);
-        _display.setCursor(timerX, timerY);
-
-        // Format time as HH:MM:SS or MM:SS depending on duration
-        char timeBuffer[12];
-        formatTime(remainingSeconds, timeBuffer, sizeof(timeBuffer));
-        _display.print(timeBuffer);
+        _gfx->setTextColor(timerColor, COLOR_BACKGROUND);
+        _gfx->setFont(FONT_TIMER);
+        _gfx->setTextSize(1);
+        _gfx->setCursor(timerX, timerY);
+        _gfx->print(timeBuffer);
+    }
+}
+
+bool UI::drawTimerCells(const char *timeText, uint16_t timerColor, int timerX, int timerY)
+{
+    // Only strings made entirely of atlas glyphs ("H:MM:SS") take the cell path
+    size_t length = strlen(timeText);
+    if (!_timerAtlas.isReady() || length >= sizeof(_drawnTimerText))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        if (!_timerAtlas.hasGlyph(timeText[i]))
+        {
+            return false;
+        }
+    }
+
+    int colorIndex = 0;
+    for (int i = 0; i < TIMER_ATLAS_COLOR_COUNT; i++)
+    {
+        if (TIMER_ATLAS_COLORS[i] == timerColor)
+        {
+            colorIndex = i;
+            break;
+        }
+    }
+
+    // Previous frame wasn't drawn from cells (text, another screen): start clean
+    if (_drawnTimerText[0] == '\0' || strlen(_drawnTimerText) != length)
+    {
+        _gfx->fillRect(TIMER_CLEAR_X, TIMER_CLEAR_Y, TIMER_CLEAR_WIDTH, TIMER_CLEAR_HEIGHT, COLOR_BACKGROUND);
+        _compositor.markDirty(TIMER_DIRTY_X, TIMER_DIRTY_Y, TIMER_DIRTY_WIDTH, TIMER_DIRTY_HEIGHT);
+        memset(_drawnTimerText, 0, sizeof(_drawnTimerText));
+        _drawnTimerColor = -1;
+    }
+
+    bool colorChanged = (colorIndex != _drawnTimerColor);
+    bool shifted = false; // A cell changed width, everything to its right moved
+    int x = timerX;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        char c = timeText[i];
+        char previous = _drawnTimerText[i];
+        int width = _timerAtlas.glyphWidth(c);
+
+        if (colorChanged || shifted || c != previous)
+        {
+            _timerAtlas.drawGlyph(*_gfx, c, colorIndex, x, timerY);
+            _compositor.markDirty(x, timerY, width, _timerAtlas.cellHeight());
+        }
+        if (previous != '\0' && width != _timerAtlas.glyphWidth(previous))
+        {
+            shifted = true;
+        }
+        x += width;
+    }
+
+    // Clear whatever the old, wider string left to the right of the new one
+    if (shifted && x < TIMER_CLEAR_X + TIMER_CLEAR_WIDTH)
+    {
+        int tailWidth = TIMER_CLEAR_X + TIMER_CLEAR_WIDTH - x;
+        _gfx->fillRect(x, timerY, tailWidth, _timerAtlas.cellHeight(), COLOR_BACKGROUND);
+        _compositor.markDirty(x, timerY, tailWidth, _timerAtlas.cellHeight());
     }
+
+    memcpy(_drawnTimerText, timeText, length + 1);
+    _drawnTimerColor = (int8_t)colorIndex;
+    return true;
 }
 
 void UI::drawProgressBar(const ScreenTimer &timer)
@@ -490,28 +592,28 @@ void UI::drawProgressBar(const ScreenTimer &timer)
     if (hasUnlimitedAllowance)
     {
         // For unlimited allowance, draw empty progress bar
-        _display.fillRoundRect(progressBarX, progressBarY,
+        _gfx->fillRoundRect(progressBarX, progressBarY,
                                PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT,
                                PROGRESS_BAR_RADIUS,
                                COLOR_PROGRESS_BG);
 
         // Draw allowance label showing "Unlimited"
-        _display.setFont(&fonts::Font0); // Small font for label
-        _display.setTextSize(1);
-        _display.setTextColor(COLOR_TEXT_SECONDARY);
+        _gfx->setFont(&fonts::Font0); // Small font for label
+        _gfx->setTextSize(1);
+        _gfx->setTextColor(COLOR_TEXT_SECONDARY);
 
         const char *unlimitedText = "Today's allowance: Unlimited"; // Status label
-        int textWidth = _display.textWidth(unlimitedText);
+        int textWidth = _gfx->textWidth(unlimitedText);
         int textX = SCREEN_WIDTH - textWidth - UI_PADDING;
         int textY = SCREEN_HEIGHT - 8 - UI_PADDING;
 
-        _display.setCursor(textX, textY);
-        _display.print(unlimitedText);
+        _gfx->setCursor(textX, textY);
+        _gfx->print(unlimitedText);
         return;
     }
 
     // Draw background using the color from config.h
-    _display.fillRoundRect(progressBarX, progressBarY,
+    _gfx->fillRoundRect(progressBarX, progressBarY,
                            PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT,
                            PROGRESS_BAR_RADIUS,
                            COLOR_PROGRESS_BG);
@@ -528,7 +630,7 @@ void UI::drawProgressBar(const ScreenTimer &timer)
 
     if (progress > 0.01f)
     { // Only draw if there's meaningful progress
-        _display.fillRoundRect(progressBarX, progressBarY,
+        _gfx->fillRoundRect(progressBarX, progressBarY,
                                fillWidth, PROGRESS_BAR_HEIGHT,
                                PROGRESS_BAR_RADIUS,
                                fillColor);
@@ -543,7 +645,7 @@ void UI::drawProgressBar(const ScreenTimer &timer)
     // Check if timer is running and recently activated
     if (timer.isRunning() && timer.getSessionStartTime() > 0)
     {
-        time_t now = time(nullptr);
+        time_t now = currentTime();
         time_t sessionStart = timer.getSessionStartTime();
         uint32_t secondsSinceActivation = (uint32_t)(now - sessionStart);
 
@@ -567,96 +669,77 @@ void UI::drawProgressBar(const ScreenTimer &timer)
                  (unsigned long)hours, (unsigned long)minutes);
     }
 
-    _display.setFont(&fonts::Font0); // Small font for label
-    _display.setTextSize(1);
-    _display.setTextColor(COLOR_TEXT_SECONDARY); // Use secondary color for less emphasis
+    _gfx->setFont(&fonts::Font0); // Small font for label
+    _gfx->setTextSize(1);
+    _gfx->setTextColor(COLOR_TEXT_SECONDARY); // Use secondary color for less emphasis
 
     // Clear the status label area first to prevent text overlay
     int labelAreaX = SCREEN_WIDTH - 150; // Clear wider area for longest possible text
     int labelAreaY = SCREEN_HEIGHT - 8 - UI_PADDING - 2;
     int labelAreaWidth = 150;
     int labelAreaHeight = 10;
-    _display.fillRect(labelAreaX, labelAreaY, labelAreaWidth, labelAreaHeight, COLOR_BACKGROUND);
+    _gfx->fillRect(labelAreaX, labelAreaY, labelAreaWidth, labelAreaHeight, COLOR_BACKGROUND);
 
-    int textWidth = _display.textWidth(statusBuffer);
+    int textWidth = _gfx->textWidth(statusBuffer);
     int textX = SCREEN_WIDTH - textWidth - UI_PADDING; // Right-aligned with screen padding
     int textY = SCREEN_HEIGHT - 8 - UI_PADDING;        // Bottom of screen (Font0 is ~8px tall)
 
-    _display.setCursor(textX, textY);
-    _display.print(statusBuffer);
+    _gfx->setCursor(textX, textY);
+    _gfx->print(statusBuffer);
 }
 
-void UI::clearActivationRing(const ScreenTimer &timer)
+uint16_t UI::getStatusRingColor(const ScreenTimer &timer)
 {
-    // Always clear the activation ring area first (to remove any previous activation ring)
-    // Draw as circles to ensure complete coverage (fillArc with 0-360 may leave gaps)
-    int activationRingRadius = AVATAR_RADIUS + STATUS_RING_THICKNESS + 1;
-
-    _display.fillArc(AVATAR_X, AVATAR_Y,
-                     activationRingRadius, activationRingRadius + 2,
-                     270, 270 + 360,
-                     COLOR_BACKGROUND);
-}
-
-void UI::drawStatusRing(const ScreenTimer &timer)
-{
-    TimerState state = timer.getState();
-
-    // Draw status ring around avatar (circle stroke with no fill)
-    // Ring is drawn directly around the avatar with no gap
-    uint16_t ringColor;
-
-    switch (state)
+    switch (timer.getState())
     {
     case TimerState::EXPIRED:
-        ringColor = COLOR_ACCENT_DANGER;
-        break;
+        return COLOR_ACCENT_DANGER;
     case TimerState::RUNNING:
-        ringColor = COLOR_ACCENT_SUCCESS;
-        break;
+        return COLOR_ACCENT_SUCCESS;
     case TimerState::STOPPED:
     default:
-        ringColor = COLOR_TEXT_PRIMARY; // White when inactive
-        break;
+        return COLOR_TEXT_PRIMARY; // White when inactive
     }
+}
+
+void UI::drawStatusRing(const ScreenTimer &timer)
+{
+    // Draw status ring around avatar (circle stroke with no fill)
+    // Ring is drawn directly around the avatar with no gap
+    uint16_t ringColor = getStatusRingColor(timer);
 
     // Draw the ring as multiple circles for thickness, starting from avatar edge
     for (int i = 0; i < STATUS_RING_THICKNESS; i++)
     {
-        _display.drawCircle(AVATAR_X, AVATAR_Y, AVATAR_RADIUS + i + 1, ringColor);
+        _gfx->drawCircle(AVATAR_X, AVATAR_Y, AVATAR_RADIUS + i + 1, ringColor);
     }
+}
 
-    // NB: Activation ring has already been cleared in updateDynamicElements
-    int activationRingRadius = AVATAR_RADIUS + STATUS_RING_THICKNESS + 1;
-
-    // Draw activation progress ring during the minimum session period (ie recently activated)
+void UI::drawActivationRing(const ScreenTimer &timer)
+{
+    // Arc length in degrees: what fraction of the minimum session period remains?
+    // 0 hides the ring once the period is over or the timer stops
+    int arcDegrees = 0;
     if (timer.isRunning() && timer.getSessionStartTime() > 0)
     {
-        time_t now = time(nullptr);
+        time_t now = currentTime();
         time_t sessionStart = timer.getSessionStartTime();
         uint32_t secondsSinceActivation = (uint32_t)(now - sessionStart);
 
         if (secondsSinceActivation < MINIMUM_SESSION_DURATION_SECONDS)
         {
-            // Calculate progress: what fraction of minimum session period remains?
-            float remainingFraction = (float)(MINIMUM_SESSION_DURATION_SECONDS - secondsSinceActivation) / (float)MINIMUM_SESSION_DURATION_SECONDS;
-
-            // Draw activation ring 2px wide, outside the status ring
-            // Ring starts at 270 degrees (12 o'clock) and goes clockwise
-
-            // Calculate arc angle (270 degrees = 75% remaining, for example)
-            int arcDegrees = (int)(remainingFraction * 360.0f);
-
-            // M5GFX fillArc: fillArc(x, y, r0, r1, angle0, angle1, color)
-            // r0 = inner radius, r1 = outer radius
-            // angle0 = start angle (270 = 12 o'clock), angle1 = end angle
-            // Angles are in degrees, clockwise from 0 degrees (right/east)
-            _display.fillArc(AVATAR_X, AVATAR_Y,
-                             activationRingRadius, activationRingRadius + 2,
-                             270, 270 + arcDegrees,
-                             ringColor);
+            arcDegrees = (int)((MINIMUM_SESSION_DURATION_SECONDS - secondsSinceActivation) * 360 /
+                               MINIMUM_SESSION_DURATION_SECONDS);
         }
     }
+
+    // Ring starts at 12 o'clock and goes clockwise; only the changed slice is drawn
+    DirtyRect touched;
+    if (_activationRing.update(*_gfx, AVATAR_X, AVATAR_Y, arcDegrees,
+                               getStatusRingColor(timer), COLOR_BACKGROUND, touched))
+    {
+        _compositor.markDirty(touched.x, touched.y, touched.w, touched.h);
+    }
 }
 
 // ============================================================================
@@ -665,94 +748,28 @@ void UI::drawStatusRing(const ScreenTimer &timer)
 
 void UI::drawMenu(const DropdownMenu &menu)
 {
-    if (!menu.isVisible())
-    {
-        return;
-    }
-
-    int itemCount = menu.getItemCount();
-    int selectedIndex = menu.getSelectedIndex();
-
-    _display.startWrite();
-
-    // Fill entire area below header with dark gray background
-    _display.fillRect(0, MENU_Y, SCREEN_WIDTH, MENU_HEIGHT, COLOR_MENU_BG);
-
-    // Calculate content area (with padding, leaving space for chevron)
-    // Move content up by 24px from original position
-    int contentY = MENU_Y + MENU_PADDING - 24;
-    int contentHeight = MENU_HEIGHT - (2 * MENU_PADDING) - MENU_CHEVRON_AREA_HEIGHT;
-    int itemAreaHeight = contentHeight / MENU_VISIBLE_ITEMS;
-    int itemGap = 8; // 8px gap between items
-
-    // Draw the 3 visible items: previous, selected, next (with wrapping)
-    for (int slot = 0; slot < MENU_VISIBLE_ITEMS && itemCount > 0; slot++)
-    {
-        // Calculate which item index to show in this slot
-        int displayIndex;
-        if (slot == 0)
-        {
-            // Previous item (wraps to end if at start)
-            displayIndex = (selectedIndex - 1 + itemCount) % itemCount;
-        }
-        else if (slot == 1)
-        {
-            // Current selected item
-            displayIndex = selectedIndex;
-        }
-        else
-        {
-            // Next item (wraps to start if at end)
-            displayIndex = (selectedIndex + 1) % itemCount;
-        }
-
-        // Add gap spacing: slot 0 at base, slot 1 adds gap, slot 2 adds 2*gap
-        int itemY = contentY + (slot * itemAreaHeight) + (slot * itemGap);
-
-        // Set color based on slot (middle slot = selected = white, others = gray)
-        if (slot == 1)
-        {
-            _display.setTextColor(COLOR_TEXT_PRIMARY); // White for selected
-        }
-        else
-        {
-            _display.setTextColor(COLOR_MENU_ITEM_GRAY); // Gray for prev/next
-        }
-
-        // Use FreeSansBold12pt7b for ~16px bold look
-        _display.setFont(&fonts::FreeSansBold12pt7b);
-        _display.setTextSize(1);
-
-        // Get label and truncate to 18 characters max
-        const char *rawLabel = menu.getItemLabel(displayIndex);
-        char label[19]; // 18 chars + null terminator
-        strncpy(label, rawLabel, 18);
-        label[18] = '\0';
-
-        // Center the text horizontally
-        int textWidth = _display.textWidth(label);
-        int textX = (SCREEN_WIDTH - textWidth) / 2;
-        int textY = itemY + (itemAreaHeight + 12) / 2; // Center vertically (baseline adjustment for GFX font)
+    // Labels come from the cached strip; fonts are only rasterized when they change
+    _menuView.draw(_display, menu);
+}
 
-        _display.setCursor(textX, textY);
-        _display.print(label);
-    }
+void UI::scrollMenu(const DropdownMenu &menu)
+{
+    _menuView.scroll(_display, menu);
+}
 
-    // Draw downward chevron at bottom center
-    int chevronY = MENU_Y + MENU_HEIGHT - MENU_CHEVRON_AREA_HEIGHT + 2;
-    int chevronX = SCREEN_WIDTH / 2;
-    int chevronSize = 6;
+bool UI::updateMenu(const DropdownMenu &menu)
+{
+    return _menuView.update(_display, menu);
+}
 
-    _display.setColor(COLOR_TEXT_PRIMARY);
-    // Draw simple V chevron
-    _display.drawLine(chevronX - chevronSize, chevronY, chevronX, chevronY + chevronSize, COLOR_TEXT_PRIMARY);
-    _display.drawLine(chevronX, chevronY + chevronSize, chevronX + chevronSize, chevronY, COLOR_TEXT_PRIMARY);
-    // Make it slightly thicker
-    _display.drawLine(chevronX - chevronSize, chevronY + 1, chevronX, chevronY + chevronSize + 1, COLOR_TEXT_PRIMARY);
-    _display.drawLine(chevronX, chevronY + chevronSize + 1, chevronX + chevronSize, chevronY + 1, COLOR_TEXT_PRIMARY);
+bool UI::isMenuFlashing() const
+{
+    return _menuView.isFlashing();
+}
 
-    _display.endWrite();
-    _display.display();
+bool UI::isMenuAnimating() const
+{
+    return _menuView.isScrolling() || _menuView.isFlashing();
 }
 
 void UI::clearMenu(const ScreenTimer &timer,
@@ -773,53 +790,14 @@ void UI::flashMenuItem(const DropdownMenu &menu, int itemIndex)
         return;
     }
 
-    // The flashed item is always the selected one (shown in the middle slot)
-    int itemCount = menu.getItemCount();
-    int selectedIndex = menu.getSelectedIndex();
-
-    // Only flash if this is the selected item
-    if (itemIndex != selectedIndex)
+    // Only the selected item (shown in the middle slot) can be flashed
+    if (itemIndex != menu.getSelectedIndex())
     {
         return;
     }
 
-    // Calculate position (middle slot = slot 1)
-    // Move content up by 24px from original position
-    int contentY = MENU_Y + MENU_PADDING - 24;
-    int contentHeight = MENU_HEIGHT - (2 * MENU_PADDING) - MENU_CHEVRON_AREA_HEIGHT;
-    int itemAreaHeight = contentHeight / MENU_VISIBLE_ITEMS;
-    int itemGap = 8;                                 // 8px gap between items
-    int slotY = contentY + itemAreaHeight + itemGap; // Middle slot (slot 1)
-
-    _display.startWrite();
-
-    // Set font first so textWidth calculation is accurate
-    _display.setFont(&fonts::FreeSansBold12pt7b);
-    _display.setTextSize(1);
-
-    // Get label and truncate to 18 characters max
-    const char *rawLabel = menu.getItemLabel(itemIndex);
-    char label[19]; // 18 chars + null terminator
-    strncpy(label, rawLabel, 18);
-    label[18] = '\0';
-
-    int textWidth = _display.textWidth(label);
-    int textX = (SCREEN_WIDTH - textWidth) / 2;
-    int textY = slotY + (itemAreaHeight + 12) / 2; // Baseline adjustment for GFX font
-
-    // Clear only the text area for this menu item (not full width to avoid affecting other items)
-    // FreeSansBold12pt7b has approximate height of 20px
-    int textHeight = 2;     // Approximate text height with some padding
-    int clearY = textY - 6; // Adjust for baseline (ascent)
-    _display.fillRect(textX - 2, clearY, textWidth + 4, textHeight, COLOR_MENU_BG);
-
-    // Draw with flash color
-    _display.setTextColor(COLOR_MENU_FLASH);
-    _display.setCursor(textX, textY);
-    _display.print(label);
-
-    _display.endWrite();
-    _display.display();
+    // Non-blocking: updateMenu() reports when MENU_FLASH_DURATION_MS is over
+    _menuView.flash(_display, menu);
 }
 
 void UI::showNotification(const char *message, uint32_t durationMs)
@@ -876,80 +854,18 @@ void UI::showNotification(const char *message, uint32_t durationMs)
     _display.setTextColor(COLOR_TEXT_PRIMARY);
     _display.setTextSize(1);
 
-    // Word-wrap the message into up to 3 lines
-    char lines[3][48]; // Up to 3 lines, 47 chars each + null
-    int lineCount = 0;
+    // Word-wrap the message into up to 3 lines (reused if the message repeats)
+    _notificationLayout.layout(_display, message, &fonts::FreeSansBold12pt7b, textAreaWidth, 3);
+    int lineCount = _notificationLayout.getLineCount();
     int lineHeight = 20; // Approximate line height for 12pt font
 
-    // Simple word-wrap algorithm
-    const char *ptr = message;
-    for (int line = 0; line < 3 && *ptr; line++)
-    {
-        lines[line][0] = '\0';
-        char tempLine[48] = "";
-
-        while (*ptr)
-        {
-            // Skip leading spaces
-            while (*ptr == ' ')
-                ptr++;
-            if (!*ptr)
-                break;
-
-            // Extract next word
-            char word[48] = "";
-            int wordIdx = 0;
-            while (*ptr && *ptr != ' ' && wordIdx < 46)
-            {
-                word[wordIdx++] = *ptr++;
-            }
-            word[wordIdx] = '\0';
-
-            // Try adding word to current line
-            char testLine[96];
-            if (tempLine[0])
-            {
-                snprintf(testLine, sizeof(testLine), "%s %s", tempLine, word);
-            }
-            else
-            {
-                strncpy(testLine, word, sizeof(testLine) - 1);
-                testLine[sizeof(testLine) - 1] = '\0';
-            }
-
-            int testWidth = _display.textWidth(testLine);
-            if (testWidth <= textAreaWidth || tempLine[0] == '\0')
-            {
-                // Word fits, add it to current line
-                strncpy(tempLine, testLine, sizeof(tempLine) - 1);
-                tempLine[sizeof(tempLine) - 1] = '\0';
-            }
-            else
-            {
-                // Word doesn't fit, put it back and break to next line
-                ptr -= wordIdx; // Rewind to start of word
-                break;
-            }
-        }
-
-        strncpy(lines[line], tempLine, 47);
-        lines[line][47] = '\0';
-        if (lines[line][0])
-            lineCount++;
-    }
-
     // Calculate vertical starting position to center text block
     // For GFX fonts, Y is the baseline. Position first baseline near top of centered block.
     int totalTextHeight = lineCount * lineHeight;
     int textStartY = notifY + (NOTIF_HEIGHT - totalTextHeight) / 2 + lineHeight - 4 - 16;
 
     // Draw each line
-    for (int i = 0; i < lineCount; i++)
-    {
-        int lineY = textStartY + (i * lineHeight);
-        _display.setCursor(textAreaX, lineY);
-        _display.print(lines[i]);
-    }
+    _notificationLayout.draw(_display, textAreaX, textStartY, lineHeight);
 
     _display.endWrite();
     _display.display();
@@ -969,6 +885,37 @@ void UI::showNotification(const char *message, uint32_t durationMs)
 // Helper Methods
 // ============================================================================
 
+uint32_t UI::mainFrameKey(const char *userName, char userInitial, const char *avatarName)
+{
+    // FNV-1a over everything drawMainScreen() draws that isn't redrawn by
+    // updateDynamicElements(): child name, initial, avatar and the date
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const char *text)
+    {
+        for (; text != nullptr && *text != '\0'; text++)
+        {
+            hash = (hash ^ (uint8_t)*text) * 16777619u;
+        }
+        hash = (hash ^ 0xFFu) * 16777619u; // Field separator
+    };
+    mix(userName);
+    mix(avatarName);
+
+    time_t now = currentTime();
+    struct tm timeinfo;
+    localtime_r(&now, &timeinfo);
+    char extra[8];
+    snprintf(extra, sizeof(extra), "%c%d", userInitial, timeinfo.tm_yday);
+    mix(extra);
+
+    return hash;
+}
+
+time_t UI::currentTime() const
+{
+    return _fixedTime != 0 ? _fixedTime : time(nullptr);
+}
+
 void UI::formatTime(uint32_t seconds, char *buffer, size_t bufferSize)
 {
     uint32_t hours = seconds / 3600;
@@ -1036,225 +983,46 @@ void UI::getMonthStr(int month, char *buffer)
     }
 }
 
-char UI::getNetworkStatusChar(NetworkStatus status)
+void UI::drawNetworkStatusInHeader()
 {
-    switch (status)
-    {
-    case NetworkStatus::DISCONNECTED:
-        return '-';
-    case NetworkStatus::CONNECTING:
-        return '/';
-    case NetworkStatus::CONNECTED:
-        return 'O';
-    case NetworkStatus::ERROR:
-        return '!';
-    default:
-        return '?';
-    }
+    // Only the Wi-Fi and battery icons; the rest of the strip is unchanged
+    _header.setNetworkStatus(_currentNetworkStatus);
+    _header.drawIndicators(*_gfx);
 }
 
-void UI::drawNetworkStatusInHeader()
+void UI::updateNetworkStatus(NetworkStatus status)
 {
-    // Layout constants for right-aligned items
-    constexpr int ITEM_GAP = 6;
-    constexpr int WIFI_WIDTH = 24;
-    constexpr int WIFI_HEIGHT = 16;
-    constexpr int BATTERY_WIDTH = 12;
-    constexpr int BATTERY_HEIGHT = 16;
-
-    // Calculate positions from right edge
-    int batteryX = SCREEN_WIDTH - ITEM_GAP - BATTERY_WIDTH;
-    int wifiX = batteryX - ITEM_GAP - WIFI_WIDTH;
-
-    // Vertically center both indicators
-    int wifiY = HEADER_Y + (HEADER_HEIGHT - WIFI_HEIGHT) / 2;
-    int batteryY = HEADER_Y + (HEADER_HEIGHT - BATTERY_HEIGHT) / 2;
-
-    // Choose color based on WiFi status
-    uint16_t wifiColor = COLOR_TEXT_MUTED;
-    if (_currentNetworkStatus == NetworkStatus::CONNECTED)
-    {
-        wifiColor = COLOR_ACCENT_SUCCESS;
-    }
-    else if (_currentNetworkStatus == NetworkStatus::CONNECTING)
-    {
-        wifiColor = COLOR_ACCENT_WARNING;
-    }
-    else if (_currentNetworkStatus == NetworkStatus::ERROR)
-    {
-        wifiColor = COLOR_ACCENT_DANGER;
-    }
-
-    // Draw WiFi indicator as triangle (point at bottom)
-    // Triangle vertices: top-left, top-right, bottom-center
-    int triX1 = wifiX; // Top-left
-    int triY1 = wifiY;
-    int triX2 = wifiX + WIFI_WIDTH; // Top-right
-    int triY2 = wifiY;
-    int triX3 = wifiX + WIFI_WIDTH / 2; // Bottom-center
-    int triY3 = wifiY + WIFI_HEIGHT;
-
-    _display.fillTriangle(triX1, triY1, triX2, triY2, triX3, triY3, wifiColor);
-
-    // Overlay status character on triangle
-    char statusChar = getNetworkStatusChar(_currentNetworkStatus);
-    char statusStr[2] = {statusChar, '\0'};
-    _display.setTextColor(COLOR_HEADER_BG); // Contrast with triangle
-    _display.setTextSize(1);
-    _display.setFont(&fonts::Font0);
-
-    int textWidth = _display.textWidth(statusStr);
-    int statusTextX = wifiX + (WIFI_WIDTH - textWidth) / 2;
-    int statusTextY = wifiY + 2; // Near top of triangle
-    _display.setCursor(statusTextX, statusTextY);
-    _display.print(statusStr);
-
-    // Draw battery indicator as 4 vertically stacked rectangles
-    // Reflects real battery percentage:
-    // >80%: 4 bars, >60%: 3 bars, >40%: 2 bars, >20%: 1 bar, <20%: 0 bars
-    constexpr int RECT_HEIGHT = 3;
-    constexpr int RECT_GAP = 1;
-    int rectWidth = BATTERY_WIDTH;
-
-    // Get actual battery level (0-100) and charging status
-    int batteryLevel = M5.Power.getBatteryLevel();
-    // M5stickC plus2 does not support isCharging detection - see https://community.m5stack.com/topic/6006/m5stickcp2-ischarging-inf-power-class-does-not-function
-    bool isCharging = 0; // M5.Power.isCharging();
-
-    // Determine how many bars to illuminate based on battery percentage
-    int barsLit = 0;
-    if (batteryLevel > 80)
-    {
-        barsLit = 4;
-    }
-    else if (batteryLevel > 60)
-    {
-        barsLit = 3;
-    }
-    else if (batteryLevel > 40)
-    {
-        barsLit = 2;
-    }
-    else if (batteryLevel > 20)
-    {
-        barsLit = 1;
-    }
-    else
-    {
-        barsLit = 0;
-    }
-
-    // Colors: white when lit, 25% gray when not
-    constexpr uint16_t COLOR_BAR_LIT = 0xFFFF; // White
-    constexpr uint16_t COLOR_BAR_DIM = 0x4208; // 25% gray (RGB 64,64,64 in RGB565)
-
-    // Draw from bottom to top (bar 0 is bottom, bar 3 is top)
-    // Array index 0 = bottom bar, drawn last (highest Y)
-    for (int i = 0; i < 4; i++)
+    _currentNetworkStatus = status;
+    if (!_header.setNetworkStatus(status))
     {
-        // Calculate Y position: i=0 is bottom (highest Y), i=3 is top (lowest Y)
-        int barIndex = 3 - i; // Invert so we draw top to bottom
-        int rectY = batteryY + i * (RECT_HEIGHT + RECT_GAP);
-
-        // Bar at index barIndex is lit if barIndex < barsLit
-        // But we want bottom bars lit first, so:
-        // bar 0 (bottom) lit if barsLit >= 1
-        // bar 1 lit if barsLit >= 2
-        // bar 2 lit if barsLit >= 3
-        // bar 3 (top) lit if barsLit >= 4
-        bool isLit = (barIndex < barsLit);
-        uint16_t color = isLit ? COLOR_BAR_LIT : COLOR_BAR_DIM;
-
-        _display.fillRect(batteryX, rectY, rectWidth, RECT_HEIGHT, color);
+        return;
     }
+    updateHeaderIndicators();
+}
 
-    // If charging, overlay a lightning bolt
-    if (isCharging)
+void UI::updateBatteryIndicator()
+{
+    // Sampled here (every 5 minutes) rather than on every header draw
+    if (!_header.setBatteryLevel(M5.Power.getBatteryLevel()))
     {
-        // Lightning bolt centered on battery indicator
-        // Battery area: batteryX to batteryX+BATTERY_WIDTH, batteryY to batteryY+BATTERY_HEIGHT
-        int boltCenterX = batteryX + BATTERY_WIDTH / 2;
-        int boltCenterY = batteryY + BATTERY_HEIGHT / 2;
-
-        // Lightning bolt shape - small and centered
-        // Coordinates relative to center, scaled to fit in battery indicator
-        // Lightning bolt points (forms a zigzag shape):
-        //    /\
-        //   /  \
-        //  /----\
-        //     /
-        //    /
-
-        // Simple lightning bolt vertices (7-point polygon)
-        int x1 = boltCenterX + 1; // Top right of upper triangle
-        int y1 = boltCenterY - 6;
-        int x2 = boltCenterX - 3; // Left side
-        int y2 = boltCenterY - 1;
-        int x3 = boltCenterX; // Inner left
-        int y3 = boltCenterY - 1;
-        int x4 = boltCenterX - 2; // Bottom left of lower part
-        int y4 = boltCenterY + 6;
-        int x5 = boltCenterX + 2; // Right side
-        int y5 = boltCenterY + 1;
-        int x6 = boltCenterX - 1; // Inner right
-        int y6 = boltCenterY + 1;
-
-        // Draw lightning bolt as two triangles with stroke
-        // Upper triangle (pointing down-left)
-        // Draw black stroke (2px exterior) first
-        constexpr uint16_t COLOR_STROKE = 0x0000; // Black stroke
-        constexpr uint16_t COLOR_BOLT = 0xFFFF;   // White fill
-
-        // Draw stroke by drawing slightly larger shapes in black (2px offset)
-        _display.fillTriangle(x1 - 2, y1 - 2, x2 - 2, y2, x6 + 2, y6, COLOR_STROKE);
-        _display.fillTriangle(x3 - 2, y3, x4 - 2, y4 + 2, x5 + 2, y5, COLOR_STROKE);
-
-        // Draw white fill
-        _display.fillTriangle(x1, y1, x2, y2, x6, y6, COLOR_BOLT);
-        _display.fillTriangle(x3, y3, x4, y4, x5, y5, COLOR_BOLT);
+        return;
     }
+    updateHeaderIndicators();
 }
 
-void UI::updateNetworkStatus(NetworkStatus status)
+void UI::updateHeaderIndicators()
 {
-    _currentNetworkStatus = status;
-
-    // Only update the header area if not showing a dialog
-    if (!_infoDialogVisible)
+    // Keep the retained main frame current for restoreMainScreen()
+    if (_mainFrameValid)
     {
-        _display.startWrite();
-
-        // Clear the right-aligned indicators area (WiFi + Battery + gaps)
-        constexpr int INDICATORS_WIDTH = 24 + 6 + 12 + 6; // WiFi + gap + Battery + padding
-        int clearX = SCREEN_WIDTH - INDICATORS_WIDTH;
-        _display.fillRect(clearX, HEADER_Y, INDICATORS_WIDTH, HEADER_HEIGHT, COLOR_HEADER_BG);
-        drawNetworkStatusInHeader();
-
-        _display.endWrite();
-        _display.display();
+        _header.drawIndicators(_compositor.target());
     }
-}
 
-void UI::updateBatteryIndicator()
-{
-    // Only update if not showing a dialog
+    // Only update the panel if not showing a dialog
     if (!_infoDialogVisible)
     {
-        _display.startWrite();
-
-        // Clear just the battery indicator area and redraw
-        // Battery is at the right edge of header
-        constexpr int BATTERY_WIDTH = 12;
-        constexpr int ITEM_GAP = 6;
-        int batteryX = SCREEN_WIDTH - ITEM_GAP - BATTERY_WIDTH;
-
-        // Clear battery area
-        _display.fillRect(batteryX, HEADER_Y, BATTERY_WIDTH + ITEM_GAP, HEADER_HEIGHT, COLOR_HEADER_BG);
-
-        // Redraw network status (which includes battery indicator)
-        drawNetworkStatusInHeader();
-
-        _display.endWrite();
+        _display.waitDisplay();
+        _header.drawIndicators(_display);
         _display.display();
     }
 }
@@ -1272,8 +1040,8 @@ void UI::drawNetworkStatusInHeader(NetworkStatus networkStatus)
 void UI::drawStandardHeader(const char *title, NetworkStatus networkStatus)
 {
     _currentNetworkStatus = networkStatus;
-    drawHeader(title);
-    drawNetworkStatusInHeader();
+    _header.setNetworkStatus(networkStatus);
+    _header.draw(*_gfx, title);
 }
 
 // ============================================================================
@@ -1327,49 +1095,14 @@ void UI::showInfoDialog(const char *title,
     _display.setCursor(titleX, titleY);
     _display.print(title);
 
-    // Draw message text (word-wrapped, centered)
-    _display.setTextColor(COLOR_TEXT_SECONDARY);
-    _display.setFont(&fonts::Font0);
-    _display.setTextSize(1);
-
+    // Draw message text (word-wrapped once per message)
     int messageY = dialogY + titleBarHeight + 12;
     int messageAreaWidth = dialogWidth - 16;
     int messageX = dialogX + 8;
 
-    // Simple word wrap - split message by newlines and spaces
-    char msgBuffer[256];
-    strncpy(msgBuffer, message, sizeof(msgBuffer) - 1);
-    msgBuffer[sizeof(msgBuffer) - 1] = '\0';
-
-    char *line = msgBuffer;
-    int lineY = messageY;
-    int lineHeight = 12;
-
-    // Draw each character, wrapping at word boundaries
-    _display.setCursor(messageX, lineY);
-    int currentX = messageX;
-    for (size_t i = 0; i < strlen(message); i++)
-    {
-        char c = message[i];
-        if (c == '\n')
-        {
-            lineY += lineHeight;
-            currentX = messageX;
-            _display.setCursor(currentX, lineY);
-        }
-        else
-        {
-            int charWidth = _display.textWidth(String(c).c_str());
-            if (currentX + charWidth > dialogX + dialogWidth - 8)
-            {
-                lineY += lineHeight;
-                currentX = messageX;
-                _display.setCursor(currentX, lineY);
-            }
-            _display.print(c);
-            currentX += charWidth;
-        }
-    }
+    _infoDialogLayout.layout(_display, message, &fonts::Font0, messageAreaWidth);
+    _display.setTextColor(COLOR_TEXT_SECONDARY);
+    _infoDialogLayout.draw(_display, messageX, messageY, 12);
 
     // Draw button at bottom
     int buttonWidth = 60;
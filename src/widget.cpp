@@ -0,0 +1,558 @@
+/**
+ * widget.cpp - Retained-mode widgets implementation
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include "widget.h"
+#include "ui.h"
+#include "avatar_cache.h"
+#include "render_profiler.h"
+#include <Arduino.h>
+#include <cmath>
+
+// ============================================================================
+// Widget
+// ============================================================================
+
+Widget::Widget()
+    : _bounds{0, 0, 0, 0}
+    , _background(COLOR_BACKGROUND)
+    , _visible(true)
+    , _dirty(true)
+{
+}
+
+void Widget::setBounds(int x, int y, int w, int h) {
+    if (_bounds.x == x && _bounds.y == y && _bounds.w == w && _bounds.h == h) {
+        return;
+    }
+    _bounds = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+    _dirty = true;
+}
+
+const DirtyRect& Widget::getBounds() const {
+    return _bounds;
+}
+
+void Widget::setBackground(uint16_t color) {
+    if (_background != color) {
+        _background = color;
+        _dirty = true;
+    }
+}
+
+void Widget::setVisible(bool visible) {
+    if (_visible != visible) {
+        _visible = visible;
+        _dirty = true;
+    }
+}
+
+bool Widget::isVisible() const {
+    return _visible;
+}
+
+void Widget::invalidate() {
+    _dirty = true;
+}
+
+bool Widget::isDirty() const {
+    return _dirty;
+}
+
+uint32_t Widget::render(lgfx::LovyanGFX& gfx, bool full) {
+    if (!_dirty && !full) {
+        return 0;
+    }
+    _dirty = false;
+
+    // On a full repaint the caller has already cleared the screen
+    if (!full) {
+        clear(gfx);
+    } else if (!_visible) {
+        return 0;
+    }
+
+    if (_visible) {
+        paint(gfx);
+        RENDER_PROFILE_PRIMITIVES(1);
+    }
+    return (uint32_t)_bounds.w * _bounds.h;
+}
+
+void Widget::clear(lgfx::LovyanGFX& gfx) {
+    gfx.fillRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, _background);
+}
+
+// ============================================================================
+// LabelWidget
+// ============================================================================
+
+LabelWidget::LabelWidget()
+    : _font(&fonts::Font2)
+    , _color(COLOR_TEXT_PRIMARY)
+    , _align(WidgetAlign::LEFT)
+    , _anchorX(0)
+    , _anchorY(0)
+{
+    _text[0] = '\0';
+}
+
+void LabelWidget::setStyle(const lgfx::IFont* font, uint16_t color, WidgetAlign align) {
+    if (_font != font || _color != color || _align != align) {
+        _font = font;
+        _color = color;
+        _align = align;
+        invalidate();
+    }
+}
+
+void LabelWidget::setAnchor(int x, int y) {
+    if (_anchorX != x || _anchorY != y) {
+        _anchorX = x;
+        _anchorY = y;
+        invalidate();
+    }
+}
+
+void LabelWidget::setText(const char* text) {
+    if (text == nullptr) {
+        text = "";
+    }
+    if (strncmp(_text, text, sizeof(_text) - 1) == 0) {
+        return;
+    }
+    strncpy(_text, text, sizeof(_text) - 1);
+    _text[sizeof(_text) - 1] = '\0';
+    invalidate();
+}
+
+void LabelWidget::setColor(uint16_t color) {
+    if (_color != color) {
+        _color = color;
+        invalidate();
+    }
+}
+
+const char* LabelWidget::getText() const {
+    return _text;
+}
+
+void LabelWidget::paint(lgfx::LovyanGFX& gfx) {
+    if (_text[0] == '\0') {
+        return;
+    }
+
+    gfx.setTextDatum(textdatum_t::top_left);
+    gfx.setFont(_font);
+    gfx.setTextSize(1);
+    gfx.setTextColor(_color);
+
+    int x = _anchorX;
+    if (_align != WidgetAlign::LEFT) {
+        int textWidth = gfx.textWidth(_text);
+        // Same rounding as the (SCREEN_WIDTH - textWidth) / 2 used by the screens
+        x = (_align == WidgetAlign::CENTER) ? (2 * _anchorX - textWidth) / 2
+                                            : _anchorX - textWidth;
+    }
+
+    gfx.setCursor(x, _anchorY);
+    gfx.print(_text);
+}
+
+// ============================================================================
+// RectWidget
+// ============================================================================
+
+RectWidget::RectWidget()
+    : _color(COLOR_TEXT_PRIMARY)
+    , _radius(0)
+{
+}
+
+void RectWidget::setColor(uint16_t color) {
+    if (_color != color) {
+        _color = color;
+        invalidate();
+    }
+}
+
+void RectWidget::setRadius(int radius) {
+    if (_radius != radius) {
+        _radius = radius;
+        invalidate();
+    }
+}
+
+void RectWidget::paint(lgfx::LovyanGFX& gfx) {
+    if (_radius > 0) {
+        gfx.fillRoundRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, _radius, _color);
+    } else {
+        gfx.fillRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, _color);
+    }
+}
+
+// ============================================================================
+// ProgressBarWidget
+// ============================================================================
+
+ProgressBarWidget::ProgressBarWidget()
+    : _trackColor(COLOR_PROGRESS_BG)
+    , _fillColor(COLOR_PROGRESS_FILL)
+    , _borderColor(COLOR_BORDER)
+    , _fillWidth(0)
+{
+}
+
+void ProgressBarWidget::setColors(uint16_t track, uint16_t fill, uint16_t border) {
+    if (_trackColor != track || _fillColor != fill || _borderColor != border) {
+        _trackColor = track;
+        _fillColor = fill;
+        _borderColor = border;
+        invalidate();
+    }
+}
+
+void ProgressBarWidget::setProgress(float progress) {
+    if (progress < 0.0f) progress = 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+
+    int fillWidth = (int)(_bounds.w * progress);
+    if (_fillWidth != fillWidth) {
+        _fillWidth = fillWidth;
+        invalidate();
+    }
+}
+
+void ProgressBarWidget::paint(lgfx::LovyanGFX& gfx) {
+    int radius = _bounds.h / 2;
+
+    gfx.fillRoundRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, radius, _trackColor);
+    if (_fillWidth > 0) {
+        gfx.fillRoundRect(_bounds.x, _bounds.y, _fillWidth, _bounds.h, radius, _fillColor);
+    }
+    gfx.drawRoundRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, radius, _borderColor);
+}
+
+// ============================================================================
+// RingWidget
+// ============================================================================
+
+// Space around the track taken by the arc dots
+static constexpr int RING_MARGIN = 5;
+
+RingWidget::RingWidget()
+    : _centerX(0)
+    , _centerY(0)
+    , _radius(0)
+    , _trackColor(COLOR_BORDER)
+    , _arcColor(COLOR_ACCENT_PRIMARY)
+    , _frameCount(8)
+    , _frame(0)
+    , _paintedFrame(-1)
+    , _frameOnly(false)
+    , _deltaPaint(false)
+{
+}
+
+void RingWidget::setGeometry(int centerX, int centerY, int radius) {
+    if (_centerX != centerX || _centerY != centerY || _radius != radius) {
+        _frames.end();
+    }
+    _centerX = centerX;
+    _centerY = centerY;
+    _radius = radius;
+    setBounds(centerX - radius - RING_MARGIN, centerY - radius - RING_MARGIN,
+              (radius + RING_MARGIN) * 2 + 1, (radius + RING_MARGIN) * 2 + 1);
+}
+
+void RingWidget::setColors(uint16_t track, uint16_t arc) {
+    if (_trackColor != track || _arcColor != arc) {
+        _trackColor = track;
+        _arcColor = arc;
+        _frames.end();
+        invalidate();
+    }
+}
+
+void RingWidget::setFrameCount(uint8_t frames) {
+    frames = frames > 0 ? frames : 1;
+    if (_frameCount != frames) {
+        _frameCount = frames;
+        _frames.end();
+    }
+}
+
+void RingWidget::setFrame(uint8_t frame) {
+    frame %= _frameCount;
+    if (_frame != frame) {
+        _frame = frame;
+        _frameOnly = true;
+        invalidate();
+    }
+}
+
+void RingWidget::printStats(const char* name) const {
+    _frames.printStats(name);
+}
+
+void RingWidget::clear(lgfx::LovyanGFX& gfx) {
+    // Cached frames carry their background: a frame step overwrites only
+    // the pixels that changed, without clearing first
+    if (_frameOnly && _paintedFrame >= 0 && isVisible() && _frames.isReady()) {
+        _deltaPaint = true;
+        return;
+    }
+    gfx.fillCircle(_centerX, _centerY, _radius + RING_MARGIN, _background);
+    _paintedFrame = -1;
+}
+
+void RingWidget::paint(lgfx::LovyanGFX& gfx) {
+    // Frames are rendered on first use, once geometry and colors are final
+    _frames.begin(_bounds.w, _bounds.h, _frameCount, _background, renderFrame, this);
+
+    // Full repaints (no clear() call) and repaints after a clear push the whole frame
+    _frames.draw(gfx, _bounds.x, _bounds.y, _frame, _deltaPaint ? _paintedFrame : -1);
+
+    _paintedFrame = (int8_t)_frame;
+    _frameOnly = false;
+    _deltaPaint = false;
+}
+
+void RingWidget::renderFrame(lgfx::LovyanGFX& gfx, int frame, int x, int y, void* userData) {
+    RingWidget* ring = static_cast<RingWidget*>(userData);
+    ring->paintFrame(gfx, x + ring->_centerX - ring->_bounds.x,
+                     y + ring->_centerY - ring->_bounds.y, frame);
+}
+
+void RingWidget::paintFrame(lgfx::LovyanGFX& gfx, int centerX, int centerY, int frame) {
+    // Faint track
+    gfx.drawCircle(centerX, centerY, _radius, _trackColor);
+
+    // 90 degree arc of dots starting at the frame position
+    float startAngle = (frame * 360.0f / _frameCount) * DEG_TO_RAD;
+    float arcLength = 90.0f * DEG_TO_RAD;
+
+    for (int i = 0; i < 6; i++) {
+        float angle = startAngle + (arcLength * i / 5);
+        int x = centerX + (int)(_radius * cos(angle));
+        int y = centerY + (int)(_radius * sin(angle));
+        int dotRadius = (i == 0 || i == 1) ? 4 : 3;
+
+        gfx.fillCircle(x, y, dotRadius, _arcColor);
+    }
+}
+
+// ============================================================================
+// AvatarWidget
+// ============================================================================
+
+AvatarWidget::AvatarWidget()
+    : _initial('?')
+    , _centerX(0)
+    , _centerY(0)
+    , _radius(0)
+{
+    _avatarName[0] = '\0';
+}
+
+void AvatarWidget::setGeometry(int centerX, int centerY, int radius) {
+    _centerX = centerX;
+    _centerY = centerY;
+    _radius = radius;
+    // Include the two-pixel border
+    setBounds(centerX - radius - 1, centerY - radius - 1,
+              (radius + 1) * 2 + 1, (radius + 1) * 2 + 1);
+}
+
+void AvatarWidget::setAvatar(const char* avatarName, char initial) {
+    if (avatarName == nullptr) {
+        avatarName = "";
+    }
+    if (_initial == initial && strncmp(_avatarName, avatarName, sizeof(_avatarName) - 1) == 0) {
+        return;
+    }
+    strncpy(_avatarName, avatarName, sizeof(_avatarName) - 1);
+    _avatarName[sizeof(_avatarName) - 1] = '\0';
+    _initial = initial;
+    invalidate();
+}
+
+void AvatarWidget::paint(lgfx::LovyanGFX& gfx) {
+    bool blitted = AvatarCache::getInstance().draw(gfx, _avatarName, _centerX, _centerY, _radius);
+
+    if (!blitted) {
+        gfx.fillCircle(_centerX, _centerY, _radius, COLOR_AVATAR_PRIMARY);
+    }
+
+    gfx.drawCircle(_centerX, _centerY, _radius, COLOR_AVATAR_BORDER);
+    gfx.drawCircle(_centerX, _centerY, _radius + 1, COLOR_AVATAR_BORDER);
+
+    if (!blitted) {
+        // Initial letter centered in the circle
+        gfx.setTextDatum(textdatum_t::top_left);
+        gfx.setTextColor(COLOR_TEXT_PRIMARY);
+        gfx.setFont(&fonts::Font4);
+        gfx.setTextSize(1);
+
+        char initialStr[2] = {_initial, '\0'};
+        int textWidth = gfx.textWidth(initialStr);
+        gfx.setCursor(_centerX - textWidth / 2, _centerY - 12);
+        gfx.print(initialStr);
+    }
+}
+
+// ============================================================================
+// PageDotsWidget
+// ============================================================================
+
+PageDotsWidget::PageDotsWidget()
+    : _centerX(SCREEN_WIDTH / 2)
+    , _centerY(0)
+    , _count(0)
+    , _index(0)
+{
+}
+
+void PageDotsWidget::setCenter(int centerX, int centerY) {
+    if (_centerX != centerX || _centerY != centerY) {
+        _centerX = centerX;
+        _centerY = centerY;
+        invalidate();
+    }
+}
+
+void PageDotsWidget::setPages(int count, int index) {
+    if (_count != count || _index != index) {
+        _count = count;
+        _index = index;
+        invalidate();
+    }
+}
+
+void PageDotsWidget::paint(lgfx::LovyanGFX& gfx) {
+    // A single page needs no indicator
+    if (_count <= 1) {
+        return;
+    }
+
+    int totalWidth = _count * DOT_SPACING - 4;
+    int startX = (2 * _centerX - totalWidth) / 2;
+
+    for (int i = 0; i < _count; i++) {
+        uint16_t color = (i == _index) ? COLOR_ACCENT_PRIMARY : COLOR_TEXT_MUTED;
+        gfx.fillCircle(startX + i * DOT_SPACING, _centerY, DOT_RADIUS, color);
+    }
+}
+
+// ============================================================================
+// HeaderWidget
+// ============================================================================
+
+HeaderWidget::HeaderWidget(UI& ui)
+    : _ui(ui)
+    , _title("")
+    , _networkStatus(NetworkStatus::DISCONNECTED)
+{
+    setBounds(0, HEADER_Y, SCREEN_WIDTH, HEADER_HEIGHT);
+}
+
+void HeaderWidget::setTitle(const char* title) {
+    if (_title != title) {
+        _title = title;
+        invalidate();
+    }
+}
+
+void HeaderWidget::setNetworkStatus(NetworkStatus status) {
+    if (_networkStatus != status) {
+        _networkStatus = status;
+        invalidate();
+    }
+}
+
+void HeaderWidget::clear(lgfx::LovyanGFX& gfx) {
+    // The header bar fills its whole strip itself
+}
+
+void HeaderWidget::paint(lgfx::LovyanGFX& gfx) {
+    _ui.drawStandardHeader(_title, _networkStatus);
+}
+
+// ============================================================================
+// WidgetTree
+// ============================================================================
+
+WidgetTree::WidgetTree()
+    : _count(0)
+    , _fullRepaint(true)
+    , _stats{0, 0, 0, 0}
+{
+}
+
+bool WidgetTree::add(Widget& widget) {
+    if (_count >= WIDGET_TREE_MAX_WIDGETS) {
+        Serial.println("[Widgets] ERROR: Widget tree full");
+        return false;
+    }
+    _widgets[_count++] = &widget;
+    return true;
+}
+
+void WidgetTree::invalidateAll() {
+    _fullRepaint = true;
+}
+
+bool WidgetTree::needsFullRepaint() const {
+    return _fullRepaint;
+}
+
+bool WidgetTree::hasDirtyWidgets() const {
+    if (_fullRepaint) {
+        return true;
+    }
+    for (int i = 0; i < _count; i++) {
+        if (_widgets[i]->isDirty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int WidgetTree::render(lgfx::LovyanGFX& gfx) {
+    bool full = _fullRepaint;
+    _fullRepaint = false;
+
+    int painted = 0;
+    for (int i = 0; i < _count; i++) {
+        uint32_t pixels = _widgets[i]->render(gfx, full);
+        if (pixels > 0) {
+            painted++;
+            _stats.pixelsPainted += pixels;
+        }
+    }
+
+    if (full) {
+        _stats.fullRepaints++;
+    } else if (painted > 0) {
+        _stats.partialRepaints++;
+    }
+    _stats.widgetsPainted += painted;
+
+    return painted;
+}
+
+const WidgetTreeStats& WidgetTree::getStats() const {
+    return _stats;
+}
+
+void WidgetTree::printStats(const char* name) const {
+    Serial.printf("[Widgets] %s: %lu full, %lu partial, %lu widgets, %lu px\n",
+                  name,
+                  (unsigned long)_stats.fullRepaints,
+                  (unsigned long)_stats.partialRepaints,
+                  (unsigned long)_stats.widgetsPainted,
+                  (unsigned long)_stats.pixelsPainted);
+}
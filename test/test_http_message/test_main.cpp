@@ -0,0 +1,362 @@
+/**
+ * test_main.cpp - Host tests for the HTTP/1.1 framing (http_message.h)
+ *
+ * Feeds canned responses through HttpResponseReader, a few bytes at a
+ * time, in place of the TLS connection. Run with:  pio test -e native
+ *
+ * @author Screen Time Tracker
+ * @version 1.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include "http_message.h"
+
+// ============================================================================
+// Canned Connection
+// ============================================================================
+
+/**
+ * FakeStream - Serves a fixed byte string in small pieces
+ * After the last byte the peer either closes or keeps the connection open
+ * (then only the idle callback can end a read).
+ */
+class FakeStream : public HttpStream {
+public:
+    FakeStream(const std::string& data, bool closeAtEnd, size_t pieceSize = 7)
+        : _data(data)
+        , _position(0)
+        , _closeAtEnd(closeAtEnd)
+        , _pieceSize(pieceSize)
+    {
+    }
+
+    int available() override {
+        size_t left = _data.size() - _position;
+        return (int)(left < _pieceSize ? left : _pieceSize);
+    }
+
+    int read() override {
+        return _position < _data.size() ? (uint8_t)_data[_position++] : -1;
+    }
+
+    int read(uint8_t* buffer, size_t size) override {
+        size_t count = (size_t)available();
+        if (count > size) {
+            count = size;
+        }
+        memcpy(buffer, _data.data() + _position, count);
+        _position += count;
+        return (int)count;
+    }
+
+    bool connected() override {
+        return _position < _data.size() || !_closeAtEnd;
+    }
+
+    size_t unread() const {
+        return _data.size() - _position;
+    }
+
+private:
+    std::string _data;
+    size_t _position;
+    bool _closeAtEnd;
+    size_t _pieceSize;
+};
+
+/**
+ * IdleCounter - Idle callback state: fails with a given error after a
+ * number of waits (a deadline or cancel arriving while the server stalls)
+ */
+struct IdleCounter {
+    int calls;
+    int limit;
+    int error;
+};
+
+static int onIdle(void* userData) {
+    IdleCounter* idle = static_cast<IdleCounter*>(userData);
+    return ++idle->calls >= idle->limit ? idle->error : 0;
+}
+
+static IdleCounter idle;
+static char body[64];
+
+static int readResponse(FakeStream& stream, bool& keepAlive, size_t bodySize = sizeof(body)) {
+    HttpResponseReader reader(stream, onIdle, &idle);
+    return reader.read(body, bodySize, keepAlive);
+}
+
+void setUp() {
+    idle.calls = 0;
+    idle.limit = 100;
+    idle.error = API_ERROR_TIMED_OUT;
+    memset(body, 'x', sizeof(body));
+}
+
+void tearDown() {
+}
+
+// ============================================================================
+// Request
+// ============================================================================
+
+void test_request_header_get() {
+    char header[256];
+    int length = formatHttpRequestHeader(header, sizeof(header), "GET", "api.example.com",
+                                         "/api/", "family/default", "KEY", -1);
+    TEST_ASSERT_EQUAL((int)strlen(header), length);
+    TEST_ASSERT_EQUAL_STRING(
+        "GET /api/family/default HTTP/1.1\r\n"
+        "Host: api.example.com\r\n"
+        "Content-Type: application/json\r\n"
+        "Accept: application/json\r\n"
+        "Connection: keep-alive\r\n"
+        "X-API-Key: KEY\r\n"
+        "\r\n", header);
+}
+
+void test_request_header_post_has_length() {
+    char header[256];
+    formatHttpRequestHeader(header, sizeof(header), "POST", "h", "/", "grant", nullptr, 12);
+    TEST_ASSERT_NOT_NULL(strstr(header, "Content-Length: 12\r\n"));
+    TEST_ASSERT_NULL(strstr(header, "X-API-Key"));
+}
+
+void test_request_header_too_long() {
+    char header[32];
+    TEST_ASSERT_EQUAL(-1, formatHttpRequestHeader(header, sizeof(header), "GET", "api.example.com",
+                                                  "/api/", "family/default", nullptr, -1));
+}
+
+// ============================================================================
+// Response framing
+// ============================================================================
+
+void test_content_length_keeps_connection() {
+    FakeStream stream("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Content-Length: 11\r\n"
+                      "\r\n"
+                      "{\"ok\":true}", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("{\"ok\":true}", body);
+    TEST_ASSERT_TRUE(keepAlive);
+    TEST_ASSERT_EQUAL(0, idle.calls);
+}
+
+void test_connection_close_header() {
+    FakeStream stream("HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\n{}", true);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_http_10_does_not_keep_alive() {
+    FakeStream stream("HTTP/1.0 200 OK\r\nContent-Length: 2\r\n\r\n{}", true);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_chunked_with_extensions_and_trailers() {
+    FakeStream stream("HTTP/1.1 200 OK\r\n"
+                      "Transfer-Encoding: chunked\r\n"
+                      "\r\n"
+                      "5;name=value\r\n"
+                      "{\"a\":\r\n"
+                      "A\r\n"
+                      "1234567890\r\n"
+                      "1\r\n"
+                      "}\r\n"
+                      "0;last\r\n"
+                      "X-Trailer: yes\r\n"
+                      "\r\n", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("{\"a\":1234567890}", body);
+    TEST_ASSERT_TRUE(keepAlive);
+    TEST_ASSERT_EQUAL(0, (int)stream.unread());
+}
+
+void test_no_length_reads_until_close() {
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n{\"until\":\"close\"}", true);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("{\"until\":\"close\"}", body);
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_no_content_on_open_connection() {
+    // The server keeps the connection open and sends no length: must not wait
+    FakeStream stream("HTTP/1.1 204 No Content\r\nDate: today\r\n\r\n", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(204, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("", body);
+    TEST_ASSERT_TRUE(keepAlive);
+    TEST_ASSERT_EQUAL(0, idle.calls);
+}
+
+void test_not_modified_ignores_length() {
+    // A 304 describes the entity it would have sent; no bytes follow
+    FakeStream stream("HTTP/1.1 304 Not Modified\r\nContent-Length: 120\r\n\r\n"
+                      "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(304, readResponse(stream, keepAlive));
+    TEST_ASSERT_TRUE(keepAlive);
+    TEST_ASSERT_EQUAL(0, idle.calls);
+
+    // The connection is still in step for the next response
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("{}", body);
+}
+
+void test_head_response_has_no_body() {
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Length: 512\r\n\r\n", false);
+    HttpResponseReader reader(stream, onIdle, &idle);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(200, reader.read(body, sizeof(body), keepAlive, true));
+    TEST_ASSERT_EQUAL_STRING("", body);
+    TEST_ASSERT_TRUE(keepAlive);
+    TEST_ASSERT_EQUAL(0, idle.calls);
+}
+
+void test_interim_response_skipped() {
+    FakeStream stream("HTTP/1.1 100 Continue\r\n\r\n"
+                      "HTTP/1.1 103 Early Hints\r\nLink: </a>\r\n\r\n"
+                      "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("{}", body);
+    TEST_ASSERT_TRUE(keepAlive);
+}
+
+void test_error_status_keeps_body() {
+    FakeStream stream("HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nnot found", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(404, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("not found", body);
+}
+
+// ============================================================================
+// Failures
+// ============================================================================
+
+void test_body_that_just_fits() {
+    // 63 bytes plus the terminator fill the 64-byte buffer exactly
+    std::string content(63, 'a');
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Length: 63\r\n\r\n" + content, false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(200, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING(content.c_str(), body);
+}
+
+void test_overflow_content_length() {
+    std::string content = std::string(60, 'a') + std::string(200, 'z');
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Length: 260\r\n\r\n" + content, false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(API_ERROR_TOO_LARGE, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("", body);
+    // Drained to the end of the body, so the connection is still usable
+    TEST_ASSERT_EQUAL(0, (int)stream.unread());
+    TEST_ASSERT_TRUE(keepAlive);
+}
+
+void test_overflow_chunked() {
+    // The first chunk fits, the second does not, the third would fit again
+    FakeStream stream("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                      "10\r\n0123456789abcdef\r\n"
+                      "40\r\n" + std::string(64, 'm') + "\r\n"
+                      "4\r\ntail\r\n"
+                      "0\r\n\r\n", false);
+    bool keepAlive = false;
+    TEST_ASSERT_EQUAL(API_ERROR_TOO_LARGE, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("", body);
+    TEST_ASSERT_EQUAL(0, (int)stream.unread());
+    TEST_ASSERT_TRUE(keepAlive);
+}
+
+void test_overflow_until_close() {
+    FakeStream stream("HTTP/1.1 200 OK\r\n\r\n" + std::string(100, 'c'), true, 50);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_TOO_LARGE, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL_STRING("", body);
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_closed_before_response() {
+    FakeStream stream("", true);
+    HttpResponseReader reader(stream, onIdle, &idle);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_RESPONSE, reader.read(body, sizeof(body), keepAlive));
+    TEST_ASSERT_FALSE(reader.responseStarted());
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_closed_mid_body() {
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Length: 20\r\n\r\n{\"short\"", true);
+    HttpResponseReader reader(stream, onIdle, &idle);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_RESPONSE, reader.read(body, sizeof(body), keepAlive));
+    TEST_ASSERT_TRUE(reader.responseStarted());
+}
+
+void test_malformed_status_line() {
+    FakeStream stream("SSH-2.0-OpenSSH\r\n\r\n", true);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_RESPONSE, readResponse(stream, keepAlive));
+}
+
+void test_deadline_while_server_stalls() {
+    // Headers arrive, then the body never does
+    FakeStream stream("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n", false);
+    idle.limit = 3;
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_TIMED_OUT, readResponse(stream, keepAlive));
+    TEST_ASSERT_EQUAL(3, idle.calls);
+    TEST_ASSERT_FALSE(keepAlive);
+}
+
+void test_cancel_before_status_line() {
+    FakeStream stream("", false);
+    idle.limit = 1;
+    idle.error = API_ERROR_CANCELLED;
+    HttpResponseReader reader(stream, onIdle, &idle);
+    bool keepAlive = true;
+    TEST_ASSERT_EQUAL(API_ERROR_CANCELLED, reader.read(body, sizeof(body), keepAlive));
+    TEST_ASSERT_FALSE(reader.responseStarted());
+}
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_request_header_get);
+    RUN_TEST(test_request_header_post_has_length);
+    RUN_TEST(test_request_header_too_long);
+    RUN_TEST(test_content_length_keeps_connection);
+    RUN_TEST(test_connection_close_header);
+    RUN_TEST(test_http_10_does_not_keep_alive);
+    RUN_TEST(test_chunked_with_extensions_and_trailers);
+    RUN_TEST(test_no_length_reads_until_close);
+    RUN_TEST(test_no_content_on_open_connection);
+    RUN_TEST(test_not_modified_ignores_length);
+    RUN_TEST(test_head_response_has_no_body);
+    RUN_TEST(test_interim_response_skipped);
+    RUN_TEST(test_error_status_keeps_body);
+    RUN_TEST(test_body_that_just_fits);
+    RUN_TEST(test_overflow_content_length);
+    RUN_TEST(test_overflow_chunked);
+    RUN_TEST(test_overflow_until_close);
+    RUN_TEST(test_closed_before_response);
+    RUN_TEST(test_closed_mid_body);
+    RUN_TEST(test_malformed_status_line);
+    RUN_TEST(test_deadline_while_server_stalls);
+    RUN_TEST(test_cancel_before_status_line);
+    return UNITY_END();
+}